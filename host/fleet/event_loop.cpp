@@ -0,0 +1,90 @@
+#include "event_loop.h"
+#include <sys/epoll.h>
+#include <algorithm>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+// 한 번의 epoll_wait로 꺼내는 최대 이벤트 수
+static const int MAX_EVENTS = 512;
+
+EventLoop::EventLoop() : epollFd(epoll_create1(EPOLL_CLOEXEC)), running(false), nextTimerId(1) {
+    if (epollFd < 0) {
+        perror("[fleet] epoll_create1");
+    }
+}
+
+EventLoop::~EventLoop() {
+    if (epollFd >= 0) {
+        close(epollFd);
+    }
+}
+
+uint64_t EventLoop::nowMs() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000 + (uint64_t)now.tv_nsec / 1000000;
+}
+
+bool EventLoop::watch(int fd, uint32_t events, IoHandler* handler) {
+    struct epoll_event event = {};
+    event.events = events;
+    event.data.ptr = handler;
+    return epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) == 0;
+}
+
+bool EventLoop::modify(int fd, uint32_t events, IoHandler* handler) {
+    struct epoll_event event = {};
+    event.events = events;
+    event.data.ptr = handler;
+    return epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &event) == 0;
+}
+
+void EventLoop::unwatch(int fd) {
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+}
+
+EventLoop::TimerId EventLoop::after(uint64_t delayMs, std::function<void()> callback) {
+    TimerId id = nextTimerId++;
+    timers.push({nowMs() + delayMs, id});
+    callbacks.emplace(id, std::move(callback));
+    return id;
+}
+
+void EventLoop::cancel(TimerId id) {
+    // 힙에서는 지우지 않고, 꺼낼 때 콜백이 없으면 건너뜀
+    callbacks.erase(id);
+}
+
+void EventLoop::runDueTimers() {
+    uint64_t now = nowMs();
+    while (!timers.empty() && timers.top().atMs <= now) {
+        TimerId id = timers.top().id;
+        timers.pop();
+        auto found = callbacks.find(id);
+        if (found == callbacks.end()) {
+            continue;
+        }
+        std::function<void()> callback = std::move(found->second);
+        callbacks.erase(found);
+        callback();
+    }
+}
+
+void EventLoop::run() {
+    running = true;
+    struct epoll_event events[MAX_EVENTS];
+    while (running) {
+        runDueTimers();
+        int timeoutMs = 100;
+        if (!timers.empty()) {
+            uint64_t now = nowMs();
+            uint64_t at = timers.top().atMs;
+            timeoutMs = at <= now ? 0 : (int)std::min<uint64_t>(at - now, 100);
+        }
+        int count = epoll_wait(epollFd, events, MAX_EVENTS, timeoutMs);
+        for (int i = 0; i < count; i++) {
+            static_cast<IoHandler*>(events[i].data.ptr)->onIo(events[i].events);
+        }
+    }
+}
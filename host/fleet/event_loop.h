@@ -0,0 +1,89 @@
+#ifndef FLEET_EVENT_LOOP_H
+#define FLEET_EVENT_LOOP_H
+
+#include <stdint.h>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief epoll 소켓 이벤트 수신 대상
+ * 가상 장치 하나가 소켓마다 하나씩 구현합니다. (스레드 없이 한 루프에서 처리)
+ */
+class IoHandler {
+public:
+    virtual ~IoHandler() = default;
+    virtual void onIo(uint32_t events) = 0;
+};
+
+/**
+ * @brief 단일 스레드 epoll + 타이머 최소 힙 이벤트 루프
+ * 장치 수천 대의 소켓과 타이머를 한 스레드에서 처리하기 위해 사용합니다.
+ * 타이머 콜백과 소켓 콜백은 모두 run()을 호출한 스레드에서 실행됩니다.
+ */
+class EventLoop {
+public:
+    using TimerId = uint64_t;
+
+    EventLoop();
+    ~EventLoop();
+
+    /**
+     * @brief 단조 시계 기준 현재 시각 (밀리초, 시작 시 0 근처)
+     */
+    static uint64_t nowMs();
+
+    /**
+     * @brief 소켓을 감시 대상으로 등록합니다.
+     * @param events EPOLLIN/EPOLLOUT 조합
+     */
+    bool watch(int fd, uint32_t events, IoHandler* handler);
+
+    /**
+     * @brief 감시 중인 소켓의 이벤트 조합을 바꿉니다.
+     */
+    bool modify(int fd, uint32_t events, IoHandler* handler);
+
+    /**
+     * @brief 소켓 감시를 해제합니다. close() 전에 호출해야 합니다.
+     */
+    void unwatch(int fd);
+
+    /**
+     * @brief delayMs 후 콜백을 실행하도록 예약합니다.
+     * @return cancel()에 사용하는 ID (0은 사용하지 않음)
+     */
+    TimerId after(uint64_t delayMs, std::function<void()> callback);
+
+    /**
+     * @brief 예약된 타이머를 취소합니다. 이미 실행되었거나 0이면 무시합니다.
+     */
+    void cancel(TimerId id);
+
+    /**
+     * @brief stop()이 호출될 때까지 이벤트를 처리합니다.
+     */
+    void run();
+
+    void stop() { running = false; }
+
+private:
+    struct PendingTimer {
+        uint64_t atMs;
+        TimerId id;
+        bool operator>(const PendingTimer& other) const {
+            return atMs != other.atMs ? atMs > other.atMs : id > other.id;
+        }
+    };
+
+    void runDueTimers();
+
+    int epollFd;
+    bool running;
+    TimerId nextTimerId;
+    std::priority_queue<PendingTimer, std::vector<PendingTimer>, std::greater<PendingTimer>> timers;
+    std::unordered_map<TimerId, std::function<void()>> callbacks;
+};
+
+#endif // FLEET_EVENT_LOOP_H
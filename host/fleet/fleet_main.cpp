@@ -0,0 +1,499 @@
+// 가상 장치 부하 시험기: 한 프로세스, 한 이벤트 루프에서 장치 수천 대를 로컬 브로커에 붙여
+// 센서 발행률, 촬영 명령 → cdone 지연 백분위, 장애 주입 후 재연결 양상을 측정합니다.
+// 사용법은 README 8.5 참고.
+
+#include <Arduino.h>
+#include <arpa/inet.h>
+#include <getopt.h>
+#include <netdb.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "event_loop.h"
+#include "fleet_stats.h"
+#include "mqtt_connection.h"
+#include "virtual_device.h"
+#include "logger.h"
+
+struct OutageWindow {
+    uint32_t startSec;
+    uint32_t durationSec;
+    double fraction; // 영향받는 장치 비율 (0~1)
+};
+
+struct FleetOptions {
+    std::string broker = "127.0.0.1:1883";
+    std::string uploadServer = "127.0.0.1:8080";
+    uint32_t devices = 1000;
+    uint32_t rampSec = 10;
+    uint32_t durationSec = 60;
+    double captureRate = 1.0; // 전체 장치 대상 초당 촬영 명령 수
+    uint32_t captureTimeoutSec = 60;
+    uint32_t reportSec = 5;
+    bool watchSensors = false;
+    bool json = false;
+    const char* sensorTrace = nullptr;
+    std::vector<OutageWindow> outages;
+};
+
+static volatile sig_atomic_t stopRequested = 0;
+
+static uint64_t epochMs() {
+    struct timeval now;
+    gettimeofday(&now, nullptr);
+    return (uint64_t)now.tv_sec * 1000 + (uint64_t)now.tv_usec / 1000;
+}
+
+static bool resolveAddress(const std::string& text, sockaddr_in& address) {
+    size_t colon = text.rfind(':');
+    if (colon == std::string::npos) {
+        return false;
+    }
+    std::string host = text.substr(0, colon);
+    struct addrinfo hints = {};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    struct addrinfo* result = nullptr;
+    if (getaddrinfo(host.c_str(), text.c_str() + colon + 1, &hints, &result) != 0 || result == nullptr) {
+        return false;
+    }
+    memcpy(&address, result->ai_addr, sizeof(address));
+    freeaddrinfo(result);
+    return true;
+}
+
+// HOST_SENSOR_TRACE와 같은 CSV: proximity,lux,ax,ay,az,gx,gy,gz
+static std::vector<SensorData> loadSensorTrace(const char* path) {
+    std::vector<SensorData> rows;
+    FILE* file = fopen(path, "r");
+    if (file == nullptr) {
+        fprintf(stderr, "[fleet] 센서 트레이스를 열 수 없음: %s\n", path);
+        return rows;
+    }
+    char line[256];
+    while (fgets(line, sizeof(line), file) != nullptr) {
+        float proximity;
+        SensorData row;
+        if (sscanf(line, "%f,%f,%f,%f,%f,%f,%f,%f", &proximity, &row.ambientLight, &row.accelX, &row.accelY,
+                   &row.accelZ, &row.gyroX, &row.gyroY, &row.gyroZ) == 8) {
+            row.proximity = (uint16_t)proximity;
+            rows.push_back(row);
+        }
+    }
+    fclose(file);
+    return rows;
+}
+
+// 장치 번호를 섞어 장애 대상이 앞 번호에 몰리지 않게 함 (0~999)
+static uint32_t outageBucket(uint32_t index) {
+    uint32_t hash = index * 2654435761u;
+    return (hash >> 16) % 1000;
+}
+
+/**
+ * @brief 촬영 명령을 발행하고 cdone/센서 메시지를 받아 지연을 재는 운영 서버 역할 연결
+ */
+class FleetController : public MqttConnection {
+public:
+    FleetController(EventLoop& loop, const sockaddr_in& broker, const FleetOptions& options,
+                    const std::vector<std::unique_ptr<VirtualDevice>>& devices, FleetStats& stats)
+        : MqttConnection(loop, broker), options(options), devices(devices), stats(stats) {}
+
+    void start() {
+        open("mlx-fleet-controller", 30, 15000);
+        lastTickMs = EventLoop::nowMs();
+        tick();
+    }
+
+protected:
+    void onMqttConnected() override {
+        subscribe("+/cdone", 0);
+        if (options.watchSensors) {
+            subscribe("+/sensor", 0);
+        }
+    }
+
+    void onMqttMessage(const MqttPublish& message) override {
+        std::string topic(message.topic, message.topicLength);
+        if (topic.size() > 7 && topic.compare(topic.size() - 7, 7, "/sensor") == 0) {
+            FLEET_COUNT(stats, sensorDelivered);
+            return;
+        }
+        if (topic.size() <= 6 || topic.compare(topic.size() - 6, 6, "/cdone") != 0) {
+            return;
+        }
+        std::string payload((const char*)message.payload, message.payloadLength);
+        size_t idStart = payload.find("\"id\":\"");
+        if (idStart == std::string::npos) {
+            return;
+        }
+        idStart += 6;
+        std::string id = payload.substr(idStart, payload.find('"', idStart) - idStart);
+        auto pending = pendingCaptures.find(id);
+        if (pending == pendingCaptures.end()) {
+            return; // 이미 유실로 처리된 명령
+        }
+        FLEET_COUNT(stats, capturesDone);
+        if (payload.compare(0, 11, "{\"upload\":0") == 0) { // 추적 정보의 "upload" 구간과 구분
+            FLEET_COUNT(stats, uploadFailures);
+        }
+        stats.recordLatency((uint32_t)(EventLoop::nowMs() - pending->second));
+        pendingCaptures.erase(pending);
+    }
+
+    void onMqttClosed(bool wasConnected, const char* reason) override {
+        fprintf(stderr, "[fleet] 컨트롤러 연결 %s (%s), 1초 후 재시도\n", wasConnected ? "끊김" : "실패", reason);
+        loop.after(1000, [this]() { open("mlx-fleet-controller", 30, 15000); });
+    }
+
+private:
+    // 10ms마다 누적된 비율만큼 명령을 발행하고, 오래된 대기 명령은 유실로 처리
+    void tick() {
+        loop.after(10, [this]() { tick(); });
+        uint64_t now = EventLoop::nowMs();
+        tokens += options.captureRate * (double)(now - lastTickMs) / 1000.0;
+        lastTickMs = now;
+        while (tokens >= 1.0 && connected()) {
+            tokens -= 1.0;
+            sendCapture(now);
+        }
+        if (tokens > 1.0) {
+            tokens = 1.0; // 컨트롤러가 끊겨 있던 동안의 명령은 몰아서 보내지 않음
+        }
+        if (now - lastSweepMs >= 1000) {
+            lastSweepMs = now;
+            uint64_t timeoutMs = (uint64_t)options.captureTimeoutSec * 1000;
+            for (auto it = pendingCaptures.begin(); it != pendingCaptures.end();) {
+                if (now - it->second > timeoutMs) {
+                    FLEET_COUNT(stats, capturesLost);
+                    it = pendingCaptures.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+    }
+
+    void sendCapture(uint64_t now) {
+        const VirtualDevice& device = *devices[random(0, (long)devices.size())];
+        char id[24];
+        snprintf(id, sizeof(id), "f%llu", (unsigned long long)++commandNumber);
+        char topic[32];
+        snprintf(topic, sizeof(topic), "%s/capture", device.uid());
+        char payload[160];
+        int length = snprintf(payload, sizeof(payload),
+                              "{\"url\":\"https://fleet-upload.local/img/%s-%s.jpg\",\"id\":\"%s\",\"ts\":%llu}",
+                              device.uid(), id, id, (unsigned long long)epochMs());
+        if (publish(topic, payload, (size_t)length)) {
+            FLEET_COUNT(stats, capturesSent);
+            pendingCaptures.emplace(id, now);
+        }
+    }
+
+    const FleetOptions& options;
+    const std::vector<std::unique_ptr<VirtualDevice>>& devices;
+    FleetStats& stats;
+    std::unordered_map<std::string, uint64_t> pendingCaptures;
+    uint64_t commandNumber = 0;
+    uint64_t lastTickMs = 0;
+    uint64_t lastSweepMs = 0;
+    double tokens = 0.0;
+};
+
+/**
+ * @brief 장애 창 하나의 주입과 복구 시간 측정
+ */
+class OutageInjector {
+public:
+    OutageInjector(EventLoop& loop, const OutageWindow& window,
+                   const std::vector<std::unique_ptr<VirtualDevice>>& devices, uint64_t startedMs)
+        : loop(loop), window(window), devices(devices), startedMs(startedMs) {}
+
+    void arm() {
+        loop.after((uint64_t)window.startSec * 1000, [this]() { begin(); });
+    }
+
+private:
+    void begin() {
+        uint32_t threshold = (uint32_t)(window.fraction * 1000.0 + 0.5);
+        for (uint32_t i = 0; i < devices.size(); i++) {
+            if (outageBucket(i) < threshold) {
+                affected.push_back(i);
+                devices[i]->setLinkDown(true);
+            }
+        }
+        printf("[fleet] t=%3us 장애 주입: 장치 %zu대 링크 끊김 (%us 동안)\n", elapsedSec(), affected.size(),
+               window.durationSec);
+        loop.after((uint64_t)window.durationSec * 1000, [this]() { end(); });
+    }
+
+    void end() {
+        for (uint32_t i : affected) {
+            devices[i]->setLinkDown(false);
+        }
+        endedMs = EventLoop::nowMs();
+        printf("[fleet] t=%3us 장애 해제: 재연결 대기 %zu대\n", elapsedSec(), affected.size());
+        sample();
+    }
+
+    // 100ms마다 영향받은 장치의 복구 비율을 확인
+    void sample() {
+        size_t online = 0;
+        for (uint32_t i : affected) {
+            online += devices[i]->online() ? 1 : 0;
+        }
+        uint64_t recoveryMs = EventLoop::nowMs() - endedMs;
+        static const uint32_t MILESTONES[] = {50, 95, 100};
+        while (nextMilestone < 3 && online * 100 >= affected.size() * MILESTONES[nextMilestone]) {
+            printf("[fleet] t=%3us 장애 복구 %u%%: %llu ms (%zu/%zu대)\n", elapsedSec(), MILESTONES[nextMilestone],
+                   (unsigned long long)recoveryMs, online, affected.size());
+            nextMilestone++;
+        }
+        if (nextMilestone < 3) {
+            loop.after(100, [this]() { sample(); });
+        }
+    }
+
+    uint32_t elapsedSec() const { return (uint32_t)((EventLoop::nowMs() - startedMs) / 1000); }
+
+    EventLoop& loop;
+    OutageWindow window;
+    const std::vector<std::unique_ptr<VirtualDevice>>& devices;
+    uint64_t startedMs;
+    std::vector<uint32_t> affected;
+    uint64_t endedMs = 0;
+    int nextMilestone = 0;
+};
+
+static void printReport(const char* label, FleetCounters& counters, std::vector<uint32_t>& latencies,
+                        double seconds, size_t online, size_t total, size_t circuitOpen) {
+    uint32_t p50 = latencyPercentile(latencies, 50);
+    uint32_t p95 = latencyPercentile(latencies, 95);
+    uint32_t p99 = latencyPercentile(latencies, 99);
+    printf("[fleet] %s online %zu/%zu | 연결 시도 %llu 실패 %llu 재연결 %llu 끊김 %llu 서킷 open %llu회(현재 %zu대)"
+           " | 센서 %.0f/s 수신 %.0f/s 실패 %llu | 촬영 %llu→%llu p50/p95/p99 %u/%u/%u ms 업로드 실패 %llu 유실 %llu\n",
+           label, online, total, (unsigned long long)counters.connectAttempts,
+           (unsigned long long)counters.connectFailures, (unsigned long long)counters.reconnects,
+           (unsigned long long)counters.disconnects, (unsigned long long)counters.circuitOpens, circuitOpen,
+           seconds > 0 ? counters.sensorPublished / seconds : 0.0, seconds > 0 ? counters.sensorDelivered / seconds : 0.0,
+           (unsigned long long)counters.sensorFailed, (unsigned long long)counters.capturesSent,
+           (unsigned long long)counters.capturesDone, p50, p95, p99, (unsigned long long)counters.uploadFailures,
+           (unsigned long long)counters.capturesLost);
+    fflush(stdout);
+}
+
+static void printJson(const FleetCounters& counters, std::vector<uint32_t>& latencies, double seconds,
+                      uint32_t devices) {
+    printf("{\"devices\":%u,\"seconds\":%.1f,\"connect_attempts\":%llu,\"connect_failures\":%llu,"
+           "\"reconnects\":%llu,\"disconnects\":%llu,\"circuit_opens\":%llu,\"sensor_published\":%llu,"
+           "\"sensor_delivered\":%llu,\"sensor_failed\":%llu,\"captures_sent\":%llu,\"captures_done\":%llu,"
+           "\"captures_lost\":%llu,\"upload_failures\":%llu,\"latency_ms\":{\"p50\":%u,\"p95\":%u,\"p99\":%u}}\n",
+           devices, seconds, (unsigned long long)counters.connectAttempts,
+           (unsigned long long)counters.connectFailures, (unsigned long long)counters.reconnects,
+           (unsigned long long)counters.disconnects, (unsigned long long)counters.circuitOpens,
+           (unsigned long long)counters.sensorPublished, (unsigned long long)counters.sensorDelivered,
+           (unsigned long long)counters.sensorFailed, (unsigned long long)counters.capturesSent,
+           (unsigned long long)counters.capturesDone, (unsigned long long)counters.capturesLost,
+           (unsigned long long)counters.uploadFailures, latencyPercentile(latencies, 50),
+           latencyPercentile(latencies, 95), latencyPercentile(latencies, 99));
+}
+
+static void usage(const char* program) {
+    printf("사용법: %s [옵션]\n"
+           "  --broker HOST:PORT       MQTT 브로커 (기본 127.0.0.1:1883)\n"
+           "  --upload HOST:PORT       업로드 대체 서버 (기본 127.0.0.1:8080)\n"
+           "  --devices N              가상 장치 수 (기본 1000)\n"
+           "  --ramp S                 전원 투입을 S초에 걸쳐 분산 (기본 10)\n"
+           "  --duration S             시험 시간 (기본 60)\n"
+           "  --sensor-ms MS           센서 발행 주기 (기본 1000)\n"
+           "  --keepalive S            MQTT keepalive (기본 30)\n"
+           "  --sensor-trace CSV       센서 값 트레이스 (기본 HOST_SENSOR_TRACE)\n"
+           "  --capture-rate R         전체 장치 대상 초당 촬영 명령 수 (기본 1)\n"
+           "  --capture-ms MS          촬영 소요 시간 (기본 300)\n"
+           "  --capture-timeout S      cdone 대기 한도, 넘으면 유실 (기본 60)\n"
+           "  --image-bytes N          업로드 크기 (기본 190000, UXGA 품질 10 근사)\n"
+           "  --no-upload              업로드 없이 바로 cdone 발행\n"
+           "  --watch-sensors          +/sensor를 구독해 브로커 전달률 측정\n"
+           "  --outage START:DUR[:F]   START초부터 DUR초 동안 장치 비율 F(기본 1)의 링크 끊기 (반복 가능)\n"
+           "  --report S               구간 리포트 주기 (기본 5)\n"
+           "  --json                   종료 시 누적 결과를 JSON 한 줄로 출력\n",
+           program);
+}
+
+static bool parseOptions(int argc, char** argv, FleetOptions& options, DeviceOptions& deviceOptions) {
+    static const struct option LONG_OPTIONS[] = {
+        {"broker", required_argument, nullptr, 'b'},       {"upload", required_argument, nullptr, 'u'},
+        {"devices", required_argument, nullptr, 'n'},      {"ramp", required_argument, nullptr, 'r'},
+        {"duration", required_argument, nullptr, 'd'},     {"sensor-ms", required_argument, nullptr, 's'},
+        {"keepalive", required_argument, nullptr, 'k'},    {"sensor-trace", required_argument, nullptr, 't'},
+        {"capture-rate", required_argument, nullptr, 'c'}, {"capture-ms", required_argument, nullptr, 'm'},
+        {"capture-timeout", required_argument, nullptr, 'T'}, {"image-bytes", required_argument, nullptr, 'i'},
+        {"no-upload", no_argument, nullptr, 'U'},          {"watch-sensors", no_argument, nullptr, 'w'},
+        {"outage", required_argument, nullptr, 'o'},       {"report", required_argument, nullptr, 'R'},
+        {"json", no_argument, nullptr, 'j'},               {"help", no_argument, nullptr, 'h'},
+        {nullptr, 0, nullptr, 0},
+    };
+    int option;
+    while ((option = getopt_long(argc, argv, "h", LONG_OPTIONS, nullptr)) != -1) {
+        switch (option) {
+            case 'b': options.broker = optarg; break;
+            case 'u': options.uploadServer = optarg; break;
+            case 'n': options.devices = (uint32_t)strtoul(optarg, nullptr, 10); break;
+            case 'r': options.rampSec = (uint32_t)strtoul(optarg, nullptr, 10); break;
+            case 'd': options.durationSec = (uint32_t)strtoul(optarg, nullptr, 10); break;
+            case 's': deviceOptions.sensorIntervalMs = (uint32_t)strtoul(optarg, nullptr, 10); break;
+            case 'k': deviceOptions.keepAliveSec = (uint16_t)strtoul(optarg, nullptr, 10); break;
+            case 't': options.sensorTrace = optarg; break;
+            case 'c': options.captureRate = strtod(optarg, nullptr); break;
+            case 'm': deviceOptions.captureMs = (uint32_t)strtoul(optarg, nullptr, 10); break;
+            case 'T': options.captureTimeoutSec = (uint32_t)strtoul(optarg, nullptr, 10); break;
+            case 'i': deviceOptions.imageBytes = strtoul(optarg, nullptr, 10); break;
+            case 'U': deviceOptions.upload = false; break;
+            case 'w': options.watchSensors = true; break;
+            case 'j': options.json = true; break;
+            case 'R': options.reportSec = std::max<uint32_t>(1, (uint32_t)strtoul(optarg, nullptr, 10)); break;
+            case 'o': {
+                OutageWindow window = {0, 0, 1.0};
+                if (sscanf(optarg, "%u:%u:%lf", &window.startSec, &window.durationSec, &window.fraction) < 2) {
+                    fprintf(stderr, "[fleet] --outage 형식 오류: %s\n", optarg);
+                    return false;
+                }
+                options.outages.push_back(window);
+                break;
+            }
+            default:
+                usage(argv[0]);
+                return false;
+        }
+    }
+    if (deviceOptions.sensorIntervalMs == 0 || deviceOptions.keepAliveSec == 0) {
+        fprintf(stderr, "[fleet] --sensor-ms와 --keepalive는 0보다 커야 합니다\n");
+        return false;
+    }
+    return options.devices > 0;
+}
+
+// 장치마다 브로커/업로드 소켓 두 개 + 여유분
+static void raiseFileLimit(uint32_t devices) {
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) != 0) {
+        return;
+    }
+    limit.rlim_cur = limit.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &limit);
+    rlim_t needed = (rlim_t)devices * 2 + 64;
+    if (limit.rlim_cur != RLIM_INFINITY && limit.rlim_cur < needed) {
+        fprintf(stderr, "[fleet] 경고: 파일 디스크립터 한도 %llu < 필요 %llu (ulimit -n 확인)\n",
+                (unsigned long long)limit.rlim_cur, (unsigned long long)needed);
+    }
+}
+
+int main(int argc, char** argv) {
+    FleetOptions options;
+    options.sensorTrace = getenv("HOST_SENSOR_TRACE");
+    DeviceOptions deviceOptions = {1000, 30, 15000, 300, 190000, 30000, true, nullptr};
+    if (!parseOptions(argc, argv, options, deviceOptions)) {
+        return 1;
+    }
+
+    sockaddr_in broker;
+    sockaddr_in uploadServer;
+    if (!resolveAddress(options.broker, broker) || !resolveAddress(options.uploadServer, uploadServer)) {
+        fprintf(stderr, "[fleet] 주소를 해석할 수 없음: %s / %s\n", options.broker.c_str(),
+                options.uploadServer.c_str());
+        return 1;
+    }
+    raiseFileLimit(options.devices);
+    signal(SIGPIPE, SIG_IGN);
+    signal(SIGINT, [](int) { stopRequested = 1; });
+    signal(SIGTERM, [](int) { stopRequested = 1; });
+
+    // 재연결 정책의 서킷 로그가 장치 수만큼 쏟아지지 않도록 오류만 출력
+    initLogger();
+    setLogLevel(LogModule::system, LogLevel::error);
+    randomSeed((unsigned long)epochMs());
+
+    std::vector<SensorData> trace;
+    if (options.sensorTrace != nullptr) {
+        trace = loadSensorTrace(options.sensorTrace);
+    }
+    deviceOptions.trace = &trace;
+
+    EventLoop loop;
+    FleetStats stats;
+    uint64_t startedMs = EventLoop::nowMs();
+
+    std::vector<std::unique_ptr<VirtualDevice>> devices;
+    devices.reserve(options.devices);
+    for (uint32_t i = 0; i < options.devices; i++) {
+        devices.emplace_back(new VirtualDevice(loop, broker, uploadServer, deviceOptions, stats, i));
+        uint64_t rampMs = (uint64_t)options.rampSec * 1000;
+        devices.back()->powerOn(rampMs * i / options.devices);
+    }
+
+    FleetController controller(loop, broker, options, devices, stats);
+    controller.start();
+
+    std::vector<std::unique_ptr<OutageInjector>> injectors;
+    for (const OutageWindow& window : options.outages) {
+        injectors.emplace_back(new OutageInjector(loop, window, devices, startedMs));
+        injectors.back()->arm();
+    }
+
+    printf("[fleet] 장치 %u대, 브로커 %s, 업로드 %s, %u초 동안 실행 (센서 트레이스 %zu행)\n", options.devices,
+           options.broker.c_str(), deviceOptions.upload ? options.uploadServer.c_str() : "없음",
+           options.durationSec, trace.size());
+
+    auto countOnline = [&devices](size_t& circuitOpen) {
+        size_t online = 0;
+        circuitOpen = 0;
+        for (const auto& device : devices) {
+            online += device->online() ? 1 : 0;
+            circuitOpen += device->circuitOpen() ? 1 : 0;
+        }
+        return online;
+    };
+
+    std::function<void()> report = [&]() {
+        loop.after((uint64_t)options.reportSec * 1000, report);
+        size_t circuitOpen;
+        size_t online = countOnline(circuitOpen);
+        char label[24];
+        snprintf(label, sizeof(label), "t=%3us", (unsigned)((EventLoop::nowMs() - startedMs) / 1000));
+        printReport(label, stats.interval, stats.latencyIntervalMs, options.reportSec, online, devices.size(),
+                    circuitOpen);
+        stats.resetInterval();
+    };
+    loop.after((uint64_t)options.reportSec * 1000, report);
+
+    std::function<void()> watchStop = [&]() {
+        if (stopRequested || EventLoop::nowMs() - startedMs >= (uint64_t)options.durationSec * 1000) {
+            loop.stop();
+            return;
+        }
+        loop.after(100, watchStop);
+    };
+    watchStop();
+
+    loop.run();
+
+    double seconds = (double)(EventLoop::nowMs() - startedMs) / 1000.0;
+    size_t circuitOpen;
+    size_t online = countOnline(circuitOpen);
+    printReport("누적 ", stats.total, stats.latencyTotalMs, seconds, online, devices.size(), circuitOpen);
+    if (options.json) {
+        printJson(stats.total, stats.latencyTotalMs, seconds, options.devices);
+    }
+    fflush(stdout);
+    // 장치 소멸자가 소켓을 닫기 전에 루프/타이머가 먼저 사라지지 않도록 즉시 종료
+    _exit(0);
+}
@@ -0,0 +1,12 @@
+#include "fleet_stats.h"
+#include <algorithm>
+#include <math.h>
+
+uint32_t latencyPercentile(std::vector<uint32_t>& samples, double percentile) {
+    if (samples.empty()) {
+        return 0;
+    }
+    std::sort(samples.begin(), samples.end());
+    size_t rank = (size_t)ceil(percentile / 100.0 * (double)samples.size());
+    return samples[rank == 0 ? 0 : rank - 1];
+}
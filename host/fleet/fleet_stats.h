@@ -0,0 +1,59 @@
+#ifndef FLEET_STATS_H
+#define FLEET_STATS_H
+
+#include <stdint.h>
+#include <vector>
+
+/**
+ * @brief 부하 시험 집계 값
+ * 구간 값은 리포트마다 resetInterval()로 비우고, 누적 값은 종료 리포트에 사용합니다.
+ * 모든 갱신은 이벤트 루프 스레드에서만 일어나므로 잠금이 없습니다.
+ */
+struct FleetCounters {
+    uint64_t connectAttempts = 0;   // ReconnectPolicy가 허용한 연결 시도
+    uint64_t connectFailures = 0;   // 실패한 시도 (장애 주입 중 즉시 실패 포함)
+    uint64_t connects = 0;          // CONNACK까지 성공
+    uint64_t reconnects = 0;        // 두 번째 이후 연결 성공 (펌웨어 mqttReconnects와 같은 의미)
+    uint64_t disconnects = 0;       // 연결된 상태에서 끊김
+    uint64_t circuitOpens = 0;      // 서킷이 열린 횟수
+    uint64_t sensorPublished = 0;   // 장치가 송신 버퍼에 넣은 센서 메시지
+    uint64_t sensorFailed = 0;      // 연결 없음/송신 버퍼 초과로 실패한 발행
+    uint64_t sensorDelivered = 0;   // 컨트롤러가 받은 센서 메시지 (--watch-sensors)
+    uint64_t capturesSent = 0;      // 컨트롤러가 발행한 촬영 명령
+    uint64_t capturesReceived = 0;  // 장치가 받은 촬영 명령
+    uint64_t capturesDone = 0;      // 컨트롤러가 받은 cdone
+    uint64_t capturesLost = 0;      // 제한 시간 내 cdone이 오지 않은 명령
+    uint64_t uploadFailures = 0;    // cdone의 upload가 0인 경우
+};
+
+struct FleetStats {
+    FleetCounters total;
+    FleetCounters interval;
+    std::vector<uint32_t> latencyTotalMs;     // 촬영 명령 발행 → cdone 수신
+    std::vector<uint32_t> latencyIntervalMs;
+
+    void resetInterval() {
+        interval = FleetCounters();
+        latencyIntervalMs.clear();
+    }
+
+    void recordLatency(uint32_t latencyMs) {
+        latencyTotalMs.push_back(latencyMs);
+        latencyIntervalMs.push_back(latencyMs);
+    }
+};
+
+// FleetCounters의 같은 필드를 구간/누적 모두 증가
+#define FLEET_COUNT(stats, field) \
+    do {                          \
+        (stats).total.field++;    \
+        (stats).interval.field++; \
+    } while (0)
+
+/**
+ * @brief 표본의 백분위 값을 구합니다. (nearest-rank, 표본은 정렬됨)
+ * @return 표본이 없으면 0
+ */
+uint32_t latencyPercentile(std::vector<uint32_t>& samples, double percentile);
+
+#endif // FLEET_STATS_H
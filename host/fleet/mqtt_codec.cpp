@@ -0,0 +1,125 @@
+#include "mqtt_codec.h"
+#include <string.h>
+
+namespace mqtt {
+
+// 가변 길이 남은 길이 필드 (7비트씩, 최대 4바이트)
+static void appendRemainingLength(std::string& out, size_t length) {
+    do {
+        uint8_t digit = (uint8_t)(length % 128);
+        length /= 128;
+        if (length > 0) {
+            digit |= 0x80;
+        }
+        out.push_back((char)digit);
+    } while (length > 0);
+}
+
+static void appendU16(std::string& out, uint16_t value) {
+    out.push_back((char)(value >> 8));
+    out.push_back((char)(value & 0xFF));
+}
+
+static void appendString(std::string& out, const char* text, size_t length) {
+    appendU16(out, (uint16_t)length);
+    out.append(text, length);
+}
+
+void encodeConnect(std::string& out, const char* clientId, uint16_t keepAliveSec) {
+    size_t idLength = strlen(clientId);
+    out.push_back((char)(MQTT_CONNECT << 4));
+    appendRemainingLength(out, 10 + 2 + idLength);
+    appendString(out, "MQTT", 4);
+    out.push_back(4);    // 프로토콜 레벨 3.1.1
+    out.push_back(0x02); // clean session
+    appendU16(out, keepAliveSec);
+    appendString(out, clientId, idLength);
+}
+
+void encodeSubscribe(std::string& out, uint16_t packetId, const char* topicFilter, uint8_t qos) {
+    size_t topicLength = strlen(topicFilter);
+    out.push_back((char)((MQTT_SUBSCRIBE << 4) | 0x02));
+    appendRemainingLength(out, 2 + 2 + topicLength + 1);
+    appendU16(out, packetId);
+    appendString(out, topicFilter, topicLength);
+    out.push_back((char)qos);
+}
+
+void encodePublish(std::string& out, const char* topic, const char* payload, size_t payloadLength, uint8_t qos,
+                   uint16_t packetId) {
+    size_t topicLength = strlen(topic);
+    out.push_back((char)((MQTT_PUBLISH << 4) | (qos << 1)));
+    appendRemainingLength(out, 2 + topicLength + (qos > 0 ? 2 : 0) + payloadLength);
+    appendString(out, topic, topicLength);
+    if (qos > 0) {
+        appendU16(out, packetId);
+    }
+    out.append(payload, payloadLength);
+}
+
+void encodePuback(std::string& out, uint16_t packetId) {
+    out.push_back((char)(MQTT_PUBACK << 4));
+    out.push_back(2);
+    appendU16(out, packetId);
+}
+
+void encodePingreq(std::string& out) {
+    out.push_back((char)(MQTT_PINGREQ << 4));
+    out.push_back(0);
+}
+
+void encodeDisconnect(std::string& out) {
+    out.push_back((char)(MQTT_DISCONNECT << 4));
+    out.push_back(0);
+}
+
+size_t decodePacket(const uint8_t* data, size_t length, MqttPacket& packet) {
+    if (length < 2) {
+        return 0;
+    }
+    size_t remaining = 0;
+    size_t multiplier = 1;
+    size_t index = 1;
+    while (true) {
+        if (index >= length) {
+            return 0;
+        }
+        if (index > 4) {
+            return SIZE_MAX;
+        }
+        uint8_t digit = data[index++];
+        remaining += (digit & 0x7F) * multiplier;
+        multiplier *= 128;
+        if ((digit & 0x80) == 0) {
+            break;
+        }
+    }
+    if (length - index < remaining) {
+        return 0;
+    }
+    packet.type = data[0] >> 4;
+    packet.flags = data[0] & 0x0F;
+    packet.body = data + index;
+    packet.bodyLength = remaining;
+    return index + remaining;
+}
+
+bool parsePublish(const MqttPacket& packet, MqttPublish& publish) {
+    if (packet.bodyLength < 2) {
+        return false;
+    }
+    size_t topicLength = ((size_t)packet.body[0] << 8) | packet.body[1];
+    publish.qos = (packet.flags >> 1) & 0x03;
+    size_t header = 2 + topicLength + (publish.qos > 0 ? 2 : 0);
+    if (header > packet.bodyLength) {
+        return false;
+    }
+    publish.topic = (const char*)packet.body + 2;
+    publish.topicLength = topicLength;
+    publish.packetId = publish.qos > 0 ? (uint16_t)((packet.body[2 + topicLength] << 8) | packet.body[3 + topicLength]) : 0;
+    publish.payload = packet.body + header;
+    publish.payloadLength = packet.bodyLength - header;
+    return true;
+}
+
+} // namespace mqtt
@@ -0,0 +1,67 @@
+#ifndef FLEET_MQTT_CODEC_H
+#define FLEET_MQTT_CODEC_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+// MQTT 3.1.1 패킷 종류 (고정 헤더 상위 4비트)
+enum MqttPacketType : uint8_t {
+    MQTT_CONNECT = 1,
+    MQTT_CONNACK = 2,
+    MQTT_PUBLISH = 3,
+    MQTT_PUBACK = 4,
+    MQTT_SUBSCRIBE = 8,
+    MQTT_SUBACK = 9,
+    MQTT_PINGREQ = 12,
+    MQTT_PINGRESP = 13,
+    MQTT_DISCONNECT = 14,
+};
+
+// 수신 버퍼에서 잘라낸 패킷 한 개 (body는 수신 버퍼를 가리킴)
+struct MqttPacket {
+    uint8_t type;
+    uint8_t flags;
+    const uint8_t* body;
+    size_t bodyLength;
+};
+
+// 해석한 PUBLISH 패킷
+struct MqttPublish {
+    const char* topic;
+    size_t topicLength;
+    const uint8_t* payload;
+    size_t payloadLength;
+    uint8_t qos;
+    uint16_t packetId;
+};
+
+/**
+ * @brief 장치 펌웨어(PubSubClient)가 쓰는 범위의 MQTT 3.1.1 인코더/디코더
+ * CONNECT, SUBSCRIBE, PUBLISH(QoS 0/1), PUBACK, PINGREQ, DISCONNECT만 다룹니다.
+ * 인코더는 출력 문자열 끝에 패킷을 덧붙입니다.
+ */
+namespace mqtt {
+
+void encodeConnect(std::string& out, const char* clientId, uint16_t keepAliveSec);
+void encodeSubscribe(std::string& out, uint16_t packetId, const char* topicFilter, uint8_t qos);
+void encodePublish(std::string& out, const char* topic, const char* payload, size_t payloadLength,
+                   uint8_t qos = 0, uint16_t packetId = 0);
+void encodePuback(std::string& out, uint16_t packetId);
+void encodePingreq(std::string& out);
+void encodeDisconnect(std::string& out);
+
+/**
+ * @brief 버퍼 앞에서 완성된 패킷 한 개를 잘라냅니다.
+ * @return 패킷 전체 길이. 아직 덜 받았으면 0, 잘못된 길이 필드면 SIZE_MAX.
+ */
+size_t decodePacket(const uint8_t* data, size_t length, MqttPacket& packet);
+
+/**
+ * @brief PUBLISH 패킷 본문을 토픽/페이로드로 나눕니다.
+ */
+bool parsePublish(const MqttPacket& packet, MqttPublish& publish);
+
+} // namespace mqtt
+
+#endif // FLEET_MQTT_CODEC_H
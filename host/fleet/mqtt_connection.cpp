@@ -0,0 +1,259 @@
+#include "mqtt_connection.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// 송신 대기 상한: 넘으면 발행 실패로 처리 (장치의 작은 TCP 송신 창을 흉내)
+static const size_t MAX_OUTBOUND_BYTES = 256 * 1024;
+
+MqttConnection::MqttConnection(EventLoop& loop, const sockaddr_in& broker)
+    : loop(loop),
+      broker(broker),
+      fd(-1),
+      state(State::closed),
+      keepAliveSec(0),
+      outboundOffset(0),
+      wantWrite(false),
+      nextPacketId(1),
+      lastInboundMs(0),
+      timeoutTimer(0),
+      keepAliveTimer(0) {}
+
+MqttConnection::~MqttConnection() {
+    close();
+}
+
+bool MqttConnection::open(const char* id, uint16_t keepAlive, uint32_t timeoutMs) {
+    if (state != State::closed) {
+        return false;
+    }
+    fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        // 파일 디스크립터 고갈 등: 연결 실패로 처리
+        state = State::connecting;
+        fail("socket");
+        return false;
+    }
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+    clientId = id;
+    keepAliveSec = keepAlive;
+    outbound.clear();
+    outboundOffset = 0;
+    inbound.clear();
+    wantWrite = true;
+    state = State::connecting;
+
+    if (connect(fd, (const sockaddr*)&broker, sizeof(broker)) != 0 && errno != EINPROGRESS) {
+        fail("connect");
+        return false;
+    }
+    loop.watch(fd, EPOLLIN | EPOLLOUT, this);
+    timeoutTimer = loop.after(timeoutMs, [this]() {
+        timeoutTimer = 0;
+        fail("timeout");
+    });
+    return true;
+}
+
+void MqttConnection::close() {
+    loop.cancel(timeoutTimer);
+    loop.cancel(keepAliveTimer);
+    timeoutTimer = 0;
+    keepAliveTimer = 0;
+    if (fd >= 0) {
+        loop.unwatch(fd);
+        ::close(fd);
+        fd = -1;
+    }
+    state = State::closed;
+}
+
+void MqttConnection::fail(const char* reason) {
+    bool wasConnected = state == State::connected;
+    close();
+    onMqttClosed(wasConnected, reason);
+}
+
+bool MqttConnection::publish(const char* topic, const char* payload, size_t length, uint8_t qos) {
+    if (state != State::connected || outbound.size() - outboundOffset > MAX_OUTBOUND_BYTES) {
+        return false;
+    }
+    mqtt::encodePublish(outbound, topic, payload, length, qos, qos > 0 ? nextPacketId++ : 0);
+    if (nextPacketId == 0) {
+        nextPacketId = 1;
+    }
+    flush();
+    return true;
+}
+
+bool MqttConnection::subscribe(const char* topicFilter, uint8_t qos) {
+    if (state != State::connected) {
+        return false;
+    }
+    mqtt::encodeSubscribe(outbound, nextPacketId++, topicFilter, qos);
+    if (nextPacketId == 0) {
+        nextPacketId = 1;
+    }
+    flush();
+    return true;
+}
+
+void MqttConnection::flush() {
+    if (fd < 0 || state == State::connecting) {
+        return;
+    }
+    while (outboundOffset < outbound.size()) {
+        ssize_t sent = send(fd, outbound.data() + outboundOffset, outbound.size() - outboundOffset, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            }
+            fail("send");
+            return;
+        }
+        outboundOffset += (size_t)sent;
+    }
+    if (outboundOffset == outbound.size()) {
+        outbound.clear();
+        outboundOffset = 0;
+    } else if (outboundOffset > 64 * 1024) {
+        outbound.erase(0, outboundOffset);
+        outboundOffset = 0;
+    }
+    updateInterest();
+}
+
+void MqttConnection::updateInterest() {
+    bool pending = outboundOffset < outbound.size();
+    if (fd >= 0 && pending != wantWrite) {
+        wantWrite = pending;
+        loop.modify(fd, EPOLLIN | (pending ? (uint32_t)EPOLLOUT : 0u), this);
+    }
+}
+
+void MqttConnection::scheduleKeepAlive() {
+    keepAliveTimer = loop.after((uint64_t)keepAliveSec * 1000, [this]() {
+        keepAliveTimer = 0;
+        // PubSubClient와 같이 keepalive의 1.5배 동안 응답이 없으면 끊긴 것으로 판단
+        if (EventLoop::nowMs() - lastInboundMs > (uint64_t)keepAliveSec * 1500) {
+            fail("keepalive");
+            return;
+        }
+        mqtt::encodePingreq(outbound);
+        flush();
+        if (state == State::connected) {
+            scheduleKeepAlive();
+        }
+    });
+}
+
+void MqttConnection::onIo(uint32_t events) {
+    if (state == State::connecting) {
+        int error = 0;
+        socklen_t length = sizeof(error);
+        getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &length);
+        if (error != 0 || (events & (EPOLLERR | EPOLLHUP))) {
+            fail(error == ECONNREFUSED ? "refused" : "connect");
+            return;
+        }
+        if (!(events & EPOLLOUT)) {
+            return;
+        }
+        state = State::awaitingConnack;
+        mqtt::encodeConnect(outbound, clientId.c_str(), keepAliveSec);
+        flush();
+        return;
+    }
+    if (events & EPOLLIN) {
+        handleReadable();
+        if (state == State::closed) {
+            return;
+        }
+    }
+    if (events & (EPOLLERR | EPOLLHUP)) {
+        fail("hangup");
+        return;
+    }
+    if (events & EPOLLOUT) {
+        flush();
+    }
+}
+
+void MqttConnection::handleReadable() {
+    uint8_t buffer[16 * 1024];
+    while (true) {
+        ssize_t received = recv(fd, buffer, sizeof(buffer), 0);
+        if (received == 0) {
+            fail("closed");
+            return;
+        }
+        if (received < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            }
+            fail("recv");
+            return;
+        }
+        inbound.insert(inbound.end(), buffer, buffer + received);
+        lastInboundMs = EventLoop::nowMs();
+        if ((size_t)received < sizeof(buffer)) {
+            break;
+        }
+    }
+
+    size_t offset = 0;
+    while (offset < inbound.size()) {
+        MqttPacket packet;
+        size_t consumed = mqtt::decodePacket(inbound.data() + offset, inbound.size() - offset, packet);
+        if (consumed == 0) {
+            break;
+        }
+        if (consumed == SIZE_MAX) {
+            fail("protocol");
+            return;
+        }
+        handlePacket(packet);
+        if (state == State::closed) {
+            return;
+        }
+        offset += consumed;
+    }
+    inbound.erase(inbound.begin(), inbound.begin() + (long)offset);
+}
+
+void MqttConnection::handlePacket(const MqttPacket& packet) {
+    switch (packet.type) {
+        case MQTT_CONNACK:
+            if (state != State::awaitingConnack || packet.bodyLength < 2 || packet.body[1] != 0) {
+                fail("connack");
+                return;
+            }
+            loop.cancel(timeoutTimer);
+            timeoutTimer = 0;
+            state = State::connected;
+            scheduleKeepAlive();
+            onMqttConnected();
+            break;
+        case MQTT_PUBLISH: {
+            MqttPublish publish;
+            if (!mqtt::parsePublish(packet, publish)) {
+                fail("protocol");
+                return;
+            }
+            if (publish.qos == 1) {
+                mqtt::encodePuback(outbound, publish.packetId);
+                flush();
+            }
+            onMqttMessage(publish);
+            break;
+        }
+        default:
+            // SUBACK/PUBACK/PINGRESP는 수신 시각 갱신만으로 충분
+            break;
+    }
+}
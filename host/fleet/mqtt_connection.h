@@ -0,0 +1,78 @@
+#ifndef FLEET_MQTT_CONNECTION_H
+#define FLEET_MQTT_CONNECTION_H
+
+#include <netinet/in.h>
+#include <string>
+#include <vector>
+#include "event_loop.h"
+#include "mqtt_codec.h"
+
+/**
+ * @brief 논블로킹 MQTT 3.1.1 클라이언트 연결 하나
+ * 가상 장치와 컨트롤러가 공유합니다. 소켓 이벤트는 EventLoop가 전달하고,
+ * 결과는 상속한 클래스의 가상 함수로 알려 줍니다.
+ * 객체는 이벤트 루프가 도는 동안 해제하지 않습니다. (epoll이 포인터를 보관)
+ */
+class MqttConnection : public IoHandler {
+public:
+    MqttConnection(EventLoop& loop, const sockaddr_in& broker);
+    ~MqttConnection() override;
+
+    /**
+     * @brief 브로커 연결을 시작합니다. 결과는 onMqttConnected()/onMqttClosed()로 전달됩니다.
+     * @param timeoutMs CONNACK까지 기다리는 시간 (PubSubClient의 MQTT_SOCKET_TIMEOUT 대응)
+     */
+    bool open(const char* clientId, uint16_t keepAliveSec, uint32_t timeoutMs);
+
+    /**
+     * @brief 소켓을 닫습니다. onMqttClosed()는 호출하지 않습니다.
+     */
+    void close();
+
+    /**
+     * @brief PUBLISH를 송신 버퍼에 넣습니다.
+     * @return 연결되지 않았거나 송신 버퍼가 가득 차면 false (PubSubClient 발행 실패와 같음)
+     */
+    bool publish(const char* topic, const char* payload, size_t length, uint8_t qos = 0);
+
+    bool subscribe(const char* topicFilter, uint8_t qos);
+
+    bool connected() const { return state == State::connected; }
+    bool busy() const { return state != State::closed; }
+
+    void onIo(uint32_t events) override;
+
+protected:
+    virtual void onMqttConnected() = 0;
+    virtual void onMqttMessage(const MqttPublish& publish) = 0;
+    // wasConnected가 false면 연결 시도 실패 (reason은 로그/집계용 짧은 문자열)
+    virtual void onMqttClosed(bool wasConnected, const char* reason) = 0;
+
+    EventLoop& loop;
+
+private:
+    enum class State { closed, connecting, awaitingConnack, connected };
+
+    void fail(const char* reason);
+    void flush();
+    void handleReadable();
+    void handlePacket(const MqttPacket& packet);
+    void updateInterest();
+    void scheduleKeepAlive();
+
+    sockaddr_in broker;
+    int fd;
+    State state;
+    std::string clientId;
+    uint16_t keepAliveSec;
+    std::string outbound;
+    size_t outboundOffset;
+    std::vector<uint8_t> inbound;
+    bool wantWrite;
+    uint16_t nextPacketId;
+    uint64_t lastInboundMs;
+    EventLoop::TimerId timeoutTimer;
+    EventLoop::TimerId keepAliveTimer;
+};
+
+#endif // FLEET_MQTT_CONNECTION_H
@@ -0,0 +1,181 @@
+#include "upload_client.h"
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+
+// 모든 업로드가 공유하는 JPEG 모양 본문 조각 (SOI로 시작, 0xFF 없는 임의 데이터)
+static const size_t BODY_CHUNK_SIZE = 16 * 1024;
+
+static const uint8_t* bodyChunk() {
+    static uint8_t chunk[BODY_CHUNK_SIZE];
+    static bool filled = false;
+    if (!filled) {
+        uint32_t state = 0x9E3779B9u;
+        for (size_t i = 0; i < BODY_CHUNK_SIZE; i++) {
+            state = state * 1664525u + 1013904223u;
+            uint8_t value = (uint8_t)(state >> 24);
+            chunk[i] = value == 0xFF ? 0xFE : value;
+        }
+        chunk[0] = 0xFF;
+        chunk[1] = 0xD8;
+        filled = true;
+    }
+    return chunk;
+}
+
+UploadClient::UploadClient(EventLoop& loop, const sockaddr_in& server)
+    : loop(loop),
+      server(server),
+      fd(-1),
+      connected(false),
+      headerSent(0),
+      bodyLength(0),
+      bodySent(0),
+      timeoutTimer(0) {}
+
+UploadClient::~UploadClient() {
+    if (fd >= 0) {
+        loop.unwatch(fd);
+        close(fd);
+    }
+}
+
+bool UploadClient::start(const std::string& path, size_t length, uint32_t timeoutMs, Completion done) {
+    if (fd >= 0) {
+        return false;
+    }
+    completion = std::move(done);
+    fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        finish("socket");
+        return true;
+    }
+    char line[256];
+    snprintf(line, sizeof(line),
+             "PUT %s HTTP/1.1\r\nHost: upload\r\nContent-Type: image/jpeg\r\nContent-Length: %zu\r\n"
+             "Connection: close\r\n\r\n",
+             path.c_str(), length);
+    header = line;
+    headerSent = 0;
+    bodyLength = length;
+    bodySent = 0;
+    response.clear();
+    connected = false;
+
+    if (connect(fd, (const sockaddr*)&server, sizeof(server)) != 0 && errno != EINPROGRESS) {
+        finish("connect");
+        return true;
+    }
+    loop.watch(fd, EPOLLIN | EPOLLOUT, this);
+    timeoutTimer = loop.after(timeoutMs, [this]() {
+        timeoutTimer = 0;
+        finish("timeout");
+    });
+    return true;
+}
+
+void UploadClient::finish(const char* error) {
+    loop.cancel(timeoutTimer);
+    timeoutTimer = 0;
+    if (fd >= 0) {
+        loop.unwatch(fd);
+        close(fd);
+        fd = -1;
+    }
+    Completion done = std::move(completion);
+    completion = nullptr;
+    if (done) {
+        done(error);
+    }
+}
+
+void UploadClient::onIo(uint32_t events) {
+    if (!connected) {
+        int error = 0;
+        socklen_t length = sizeof(error);
+        getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &length);
+        if (error != 0 || (events & (EPOLLERR | EPOLLHUP))) {
+            finish(error == ECONNREFUSED ? "refused" : "connect");
+            return;
+        }
+        if (!(events & EPOLLOUT)) {
+            return;
+        }
+        connected = true;
+    }
+    if (events & EPOLLOUT) {
+        sendPending();
+        if (fd < 0) {
+            return;
+        }
+    }
+    if (events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+        readResponse();
+    }
+}
+
+void UploadClient::sendPending() {
+    while (headerSent < header.size() || bodySent < bodyLength) {
+        ssize_t sent;
+        if (headerSent < header.size()) {
+            sent = send(fd, header.data() + headerSent, header.size() - headerSent, MSG_NOSIGNAL);
+        } else {
+            size_t offset = bodySent % BODY_CHUNK_SIZE;
+            size_t chunk = std::min(BODY_CHUNK_SIZE - offset, bodyLength - bodySent);
+            sent = send(fd, bodyChunk() + offset, chunk, MSG_NOSIGNAL);
+        }
+        if (sent < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                return;
+            }
+            finish("send");
+            return;
+        }
+        if (headerSent < header.size()) {
+            headerSent += (size_t)sent;
+        } else {
+            bodySent += (size_t)sent;
+        }
+    }
+    // 본문을 다 보냈으면 응답만 기다림
+    loop.modify(fd, EPOLLIN, this);
+}
+
+void UploadClient::readResponse() {
+    char buffer[1024];
+    bool peerClosed = false;
+    while (true) {
+        ssize_t received = recv(fd, buffer, sizeof(buffer), 0);
+        if (received > 0) {
+            response.append(buffer, (size_t)received);
+            continue;
+        }
+        peerClosed = received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK);
+        break;
+    }
+    if (response.find("\r\n") == std::string::npos) {
+        // 상태 줄을 받기 전에 상대가 닫으면 실패
+        if (peerClosed) {
+            finish("closed");
+        }
+        return;
+    }
+    // "HTTP/1.1 200 OK"
+    int status = 0;
+    if (sscanf(response.c_str(), "HTTP/%*d.%*d %d", &status) != 1) {
+        finish("http");
+        return;
+    }
+    if (status >= 200 && status < 300) {
+        finish(nullptr);
+    } else {
+        static char errorText[16];
+        snprintf(errorText, sizeof(errorText), "http_%d", status);
+        finish(errorText);
+    }
+}
@@ -0,0 +1,49 @@
+#ifndef FLEET_UPLOAD_CLIENT_H
+#define FLEET_UPLOAD_CLIENT_H
+
+#include <netinet/in.h>
+#include <functional>
+#include <string>
+#include "event_loop.h"
+
+/**
+ * @brief 논블로킹 HTTP PUT 업로드 한 건
+ * 카메라 핸들러의 presigned URL 업로드를 대신해 합성 JPEG 바이트를 업로드 대체 서버
+ * (tools/host_upload_server.py)로 보냅니다. 장치마다 하나를 두고 재사용합니다.
+ */
+class UploadClient : public IoHandler {
+public:
+    // error가 nullptr이면 2xx 응답을 받은 성공
+    using Completion = std::function<void(const char* error)>;
+
+    UploadClient(EventLoop& loop, const sockaddr_in& server);
+    ~UploadClient() override;
+
+    /**
+     * @brief 업로드를 시작합니다. 진행 중인 업로드가 있으면 false.
+     */
+    bool start(const std::string& path, size_t bodyLength, uint32_t timeoutMs, Completion completion);
+
+    bool busy() const { return fd >= 0; }
+
+    void onIo(uint32_t events) override;
+
+private:
+    void finish(const char* error);
+    void sendPending();
+    void readResponse();
+
+    EventLoop& loop;
+    sockaddr_in server;
+    int fd;
+    bool connected;
+    std::string header;
+    size_t headerSent;
+    size_t bodyLength;
+    size_t bodySent;
+    std::string response;
+    EventLoop::TimerId timeoutTimer;
+    Completion completion;
+};
+
+#endif // FLEET_UPLOAD_CLIENT_H
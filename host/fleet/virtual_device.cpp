@@ -0,0 +1,247 @@
+#include "virtual_device.h"
+#include <stdio.h>
+#include <string.h>
+#include "config.h"
+
+// 펌웨어 스케줄러의 mqtt 잡 주기 (연결이 없을 때 재연결 정책을 확인하는 간격)
+static const uint32_t CONNECTION_POLL_MS = 100;
+
+// 펌웨어 subscribeToTopics()와 같은 구독 목록 (토픽 접미사, QoS)
+static const struct {
+    const char* suffix;
+    uint8_t qos;
+} DEVICE_SUBSCRIPTIONS[] = {
+    {"capture", 0}, {"ble", 0}, {"tsq", 0}, {"config", 1}, {"statreq", 0}, {"urls", 1},
+};
+
+// {"key":"value"} 형태에서 문자열 값을 꺼냄 (컨트롤러가 만든 명령만 해석하면 되므로 단순 검색)
+static bool extractString(const char* json, size_t length, const char* key, std::string& value) {
+    std::string text(json, length);
+    std::string pattern = std::string("\"") + key + "\":\"";
+    size_t start = text.find(pattern);
+    if (start == std::string::npos) {
+        return false;
+    }
+    start += pattern.size();
+    size_t end = text.find('"', start);
+    if (end == std::string::npos) {
+        return false;
+    }
+    value = text.substr(start, end - start);
+    return true;
+}
+
+VirtualDevice::VirtualDevice(EventLoop& loop, const sockaddr_in& broker, const sockaddr_in& uploadServer,
+                             const DeviceOptions& options, FleetStats& stats, uint32_t index)
+    : MqttConnection(loop, broker),
+      options(options),
+      stats(stats),
+      index(index),
+      policy(MQTT_RECONNECT_BASE_MS, MQTT_RECONNECT_MAX_MS, MQTT_RECONNECT_FAILURE_THRESHOLD, MQTT_RECONNECT_OPEN_MS),
+      poweredOn(false),
+      linkDown(false),
+      hasConnectedOnce(false),
+      pollTimer(0),
+      sensorTimer(0),
+      sampleNumber(0),
+      uploadClient(loop, uploadServer),
+      capturing(false),
+      captureStartMs(0) {
+    // 호스트 빌드 기본 MAC과 같은 Espressif OUI + 장치 번호 (getMacAddressCStr() 형식)
+    snprintf(deviceUid, sizeof(deviceUid), "7CDFA1%06X", (unsigned)(index & 0xFFFFFF));
+    snprintf(clientId, sizeof(clientId), "mlx-%s", deviceUid);
+    snprintf(captureTopic, sizeof(captureTopic), "%s/capture", deviceUid);
+    snprintf(captureDoneTopic, sizeof(captureDoneTopic), "%s/cdone", deviceUid);
+    snprintf(sensorTopic, sizeof(sensorTopic), "%s/sensor", deviceUid);
+}
+
+void VirtualDevice::powerOn(uint64_t delayMs) {
+    loop.after(delayMs, [this]() {
+        poweredOn = true;
+        policy.reset(EventLoop::nowMs());
+        pollConnection();
+    });
+}
+
+void VirtualDevice::setLinkDown(bool down) {
+    linkDown = down;
+    if (down && busy()) {
+        bool wasConnected = connected();
+        close();
+        onMqttClosed(wasConnected, "outage");
+    }
+}
+
+void VirtualDevice::schedulePoll() {
+    if (pollTimer == 0) {
+        pollTimer = loop.after(CONNECTION_POLL_MS, [this]() {
+            pollTimer = 0;
+            pollConnection();
+        });
+    }
+}
+
+// 펌웨어 handleMqttConnection()의 연결 없음 분기와 같은 흐름
+void VirtualDevice::pollConnection() {
+    if (!poweredOn || busy()) {
+        return;
+    }
+    unsigned long now = (unsigned long)EventLoop::nowMs();
+    if (policy.ready(now)) {
+        policy.onAttempt();
+        FLEET_COUNT(stats, connectAttempts);
+        if (linkDown) {
+            recordConnectFailure();
+        } else {
+            open(clientId, options.keepAliveSec, options.connectTimeoutMs);
+            if (busy()) {
+                return; // 결과는 onMqttConnected()/onMqttClosed()에서 처리
+            }
+        }
+    }
+    schedulePoll();
+}
+
+// 시도 결과가 실패로 나왔을 때 (펌웨어의 연결 실패 분기와 같이 결과 시점에 백오프/서킷 갱신)
+void VirtualDevice::recordConnectFailure() {
+    bool wasOpen = policy.state() == ReconnectState::open;
+    policy.onFailed((unsigned long)EventLoop::nowMs());
+    FLEET_COUNT(stats, connectFailures);
+    if (!wasOpen && policy.state() == ReconnectState::open) {
+        FLEET_COUNT(stats, circuitOpens);
+    }
+}
+
+void VirtualDevice::onMqttConnected() {
+    FLEET_COUNT(stats, connects);
+    if (hasConnectedOnce) {
+        FLEET_COUNT(stats, reconnects);
+    }
+    hasConnectedOnce = true;
+    policy.onConnected();
+
+    char topic[32];
+    for (const auto& subscription : DEVICE_SUBSCRIPTIONS) {
+        snprintf(topic, sizeof(topic), "%s/%s", deviceUid, subscription.suffix);
+        subscribe(topic, subscription.qos);
+    }
+
+    // 장치마다 부팅 시각이 달라 발행 위상이 흩어지는 것을 재현
+    sensorTimer = loop.after(random(0, options.sensorIntervalMs), [this]() {
+        sensorTimer = 0;
+        publishSensor();
+    });
+}
+
+void VirtualDevice::onMqttClosed(bool wasConnected, const char* reason) {
+    (void)reason;
+    loop.cancel(sensorTimer);
+    sensorTimer = 0;
+    if (wasConnected) {
+        FLEET_COUNT(stats, disconnects);
+        // 지터가 적용된 시각에 첫 재시도 예약
+        policy.onDisconnected((unsigned long)EventLoop::nowMs());
+    } else {
+        recordConnectFailure();
+    }
+    schedulePoll();
+}
+
+SensorData VirtualDevice::nextSample() {
+    uint32_t number = sampleNumber++;
+    if (options.trace != nullptr && !options.trace->empty()) {
+        // 장치마다 다른 행에서 시작해 같은 트레이스로도 값이 겹치지 않게 함
+        return (*options.trace)[(index + number) % options.trace->size()];
+    }
+    SensorData data;
+    data.proximity = (uint16_t)random(0, 30);
+    data.ambientLight = (float)random(100, 400);
+    data.accelX = (float)random(-50, 51) / 1000.0f;
+    data.accelY = (float)random(-50, 51) / 1000.0f;
+    data.accelZ = 1.0f + (float)random(-50, 51) / 1000.0f;
+    data.gyroX = (float)random(-100, 101) / 100.0f;
+    data.gyroY = (float)random(-100, 101) / 100.0f;
+    data.gyroZ = (float)random(-100, 101) / 100.0f;
+    return data;
+}
+
+void VirtualDevice::publishSensor() {
+    sensorTimer = loop.after(options.sensorIntervalMs, [this]() {
+        sensorTimer = 0;
+        publishSensor();
+    });
+    // 촬영 중에는 펌웨어 메인 루프가 멈춰 센서 발행도 건너뜀
+    if (capturing) {
+        return;
+    }
+    char json[SENSOR_JSON_BUFFER_SIZE];
+    size_t length = formatSensorJson(nextSample(), json, sizeof(json));
+    if (length > 0 && publish(sensorTopic, json, length)) {
+        FLEET_COUNT(stats, sensorPublished);
+    } else {
+        FLEET_COUNT(stats, sensorFailed);
+    }
+}
+
+void VirtualDevice::onMqttMessage(const MqttPublish& message) {
+    if (message.topicLength != strlen(captureTopic) ||
+        memcmp(message.topic, captureTopic, message.topicLength) != 0) {
+        return;
+    }
+    const char* payload = (const char*)message.payload;
+    CaptureCommand command;
+    std::string url;
+    if (!extractString(payload, message.payloadLength, "url", url)) {
+        return;
+    }
+    extractString(payload, message.payloadLength, "id", command.id);
+    // presigned URL의 경로만 업로드 대체 서버로 전달
+    size_t scheme = url.find("://");
+    size_t pathStart = url.find('/', scheme == std::string::npos ? 0 : scheme + 3);
+    command.path = pathStart == std::string::npos ? "/" : url.substr(pathStart);
+
+    FLEET_COUNT(stats, capturesReceived);
+    captureQueue.push_back(std::move(command));
+    if (!capturing) {
+        startNextCapture();
+    }
+}
+
+void VirtualDevice::startNextCapture() {
+    if (captureQueue.empty()) {
+        capturing = false;
+        return;
+    }
+    capturing = true;
+    captureStartMs = EventLoop::nowMs();
+    loop.after(options.captureMs, [this]() {
+        uint64_t captureUs = (EventLoop::nowMs() - captureStartMs) * 1000;
+        if (!options.upload) {
+            finishCapture(nullptr, captureUs, 0);
+            return;
+        }
+        uint64_t uploadStartMs = EventLoop::nowMs();
+        uploadClient.start(captureQueue.front().path, options.imageBytes, options.uploadTimeoutMs,
+                           [this, captureUs, uploadStartMs](const char* error) {
+                               finishCapture(error, captureUs, (EventLoop::nowMs() - uploadStartMs) * 1000);
+                           });
+    });
+}
+
+// 펌웨어 publishCaptureDone()과 같은 형식: {"upload":N[,"error":".."],"trace":{"id":"..","us":{...}}}
+void VirtualDevice::finishCapture(const char* error, uint64_t captureUs, uint64_t uploadUs) {
+    const CaptureCommand& command = captureQueue.front();
+    char payload[256];
+    int written = snprintf(payload, sizeof(payload), "{\"upload\":%d", error == nullptr ? 1 : 0);
+    if (error != nullptr) {
+        written += snprintf(payload + written, sizeof(payload) - written, ",\"error\":\"%s\"", error);
+    }
+    written += snprintf(payload + written, sizeof(payload) - written,
+                        ",\"trace\":{\"id\":\"%s\",\"us\":{\"capture\":%llu,\"upload\":%llu}}}",
+                        command.id.c_str(), (unsigned long long)captureUs, (unsigned long long)uploadUs);
+    if (written > 0 && (size_t)written < sizeof(payload)) {
+        publish(captureDoneTopic, payload, (size_t)written);
+    }
+    captureQueue.pop_front();
+    startNextCapture();
+}
@@ -0,0 +1,93 @@
+#ifndef FLEET_VIRTUAL_DEVICE_H
+#define FLEET_VIRTUAL_DEVICE_H
+
+#include <deque>
+#include <string>
+#include <vector>
+#include "mqtt_connection.h"
+#include "upload_client.h"
+#include "fleet_stats.h"
+#include "reconnect_policy.h"
+#include "sensor_handler.h"
+
+// 모든 가상 장치가 공유하는 동작 설정
+struct DeviceOptions {
+    uint32_t sensorIntervalMs;        // 센서 발행 주기 (sensor_int_ms 기본값 1000)
+    uint16_t keepAliveSec;            // mqtt_keepalive 기본값 30
+    uint32_t connectTimeoutMs;        // CONNACK 대기 (PubSubClient MQTT_SOCKET_TIMEOUT 15초)
+    uint32_t captureMs;               // 촬영(대기~fb_get)에 걸리는 시간
+    size_t imageBytes;                // 업로드할 JPEG 크기
+    uint32_t uploadTimeoutMs;
+    bool upload;                      // false면 업로드 없이 바로 cdone
+    const std::vector<SensorData>* trace; // 비어 있으면 합성 값
+};
+
+/**
+ * @brief 이벤트 루프 위에서 도는 가상 장치 한 대
+ * 펌웨어 모듈은 전역 상태라 한 프로세스에 여러 벌 둘 수 없으므로, 연결 관리(mqtt 잡의
+ * handleMqttConnection)와 센서 발행, 촬영 명령 처리 흐름을 같은 토픽/페이로드/재연결 정책으로
+ * 재현합니다. 재연결 간격은 펌웨어의 ReconnectPolicy를 그대로 사용합니다.
+ */
+class VirtualDevice : public MqttConnection {
+public:
+    VirtualDevice(EventLoop& loop, const sockaddr_in& broker, const sockaddr_in& uploadServer,
+                  const DeviceOptions& options, FleetStats& stats, uint32_t index);
+
+    /**
+     * @brief delayMs 후 장치를 켭니다. (접속 램프업용)
+     */
+    void powerOn(uint64_t delayMs);
+
+    /**
+     * @brief 장애 주입: 링크를 끊거나 복구합니다.
+     * 끊긴 동안의 연결 시도는 네트워크 없음과 같이 즉시 실패합니다.
+     */
+    void setLinkDown(bool down);
+
+    const char* uid() const { return deviceUid; }
+    bool online() const { return connected(); }
+    bool circuitOpen() const { return policy.state() == ReconnectState::open; }
+
+protected:
+    void onMqttConnected() override;
+    void onMqttMessage(const MqttPublish& publish) override;
+    void onMqttClosed(bool wasConnected, const char* reason) override;
+
+private:
+    struct CaptureCommand {
+        std::string id;
+        std::string path;
+    };
+
+    void schedulePoll();
+    void pollConnection();
+    void recordConnectFailure();
+    void publishSensor();
+    void startNextCapture();
+    void finishCapture(const char* error, uint64_t captureUs, uint64_t uploadUs);
+    SensorData nextSample();
+
+    const DeviceOptions& options;
+    FleetStats& stats;
+    uint32_t index;
+    char deviceUid[13];
+    char clientId[20];
+    char captureTopic[32];
+    char captureDoneTopic[32];
+    char sensorTopic[32];
+
+    ReconnectPolicy policy;
+    bool poweredOn;
+    bool linkDown;
+    bool hasConnectedOnce;
+    EventLoop::TimerId pollTimer;
+    EventLoop::TimerId sensorTimer;
+    uint32_t sampleNumber;
+
+    UploadClient uploadClient;
+    std::deque<CaptureCommand> captureQueue; // 펌웨어는 촬영 중 MQTT 루프가 멈추므로 순서대로 처리
+    bool capturing;
+    uint64_t captureStartMs;
+};
+
+#endif // FLEET_VIRTUAL_DEVICE_H
@@ -0,0 +1,63 @@
+#ifndef HOST_ADAFRUIT_VCNL4040_H
+#define HOST_ADAFRUIT_VCNL4040_H
+
+#include "Arduino.h"
+
+typedef enum {
+    VCNL4040_LED_CURRENT_50MA,
+    VCNL4040_LED_CURRENT_75MA,
+    VCNL4040_LED_CURRENT_100MA,
+    VCNL4040_LED_CURRENT_120MA,
+    VCNL4040_LED_CURRENT_140MA,
+    VCNL4040_LED_CURRENT_160MA,
+    VCNL4040_LED_CURRENT_180MA,
+    VCNL4040_LED_CURRENT_200MA,
+} VCNL4040_LEDCurrent;
+
+typedef enum {
+    VCNL4040_PROXIMITY_INTEGRATION_TIME_1T,
+    VCNL4040_PROXIMITY_INTEGRATION_TIME_1_5T,
+    VCNL4040_PROXIMITY_INTEGRATION_TIME_2T,
+    VCNL4040_PROXIMITY_INTEGRATION_TIME_2_5T,
+    VCNL4040_PROXIMITY_INTEGRATION_TIME_3T,
+    VCNL4040_PROXIMITY_INTEGRATION_TIME_3_5T,
+    VCNL4040_PROXIMITY_INTEGRATION_TIME_4T,
+    VCNL4040_PROXIMITY_INTEGRATION_TIME_8T,
+} VCNL4040_ProximityIntegration;
+
+typedef enum {
+    VCNL4040_LED_DUTY_1_40,
+    VCNL4040_LED_DUTY_1_80,
+    VCNL4040_LED_DUTY_1_160,
+    VCNL4040_LED_DUTY_1_320,
+} VCNL4040_LEDDutyCycle;
+
+typedef enum {
+    VCNL4040_AMBIENT_INTEGRATION_TIME_80MS,
+    VCNL4040_AMBIENT_INTEGRATION_TIME_160MS,
+    VCNL4040_AMBIENT_INTEGRATION_TIME_320MS,
+    VCNL4040_AMBIENT_INTEGRATION_TIME_640MS,
+} VCNL4040_AmbientIntegration;
+
+/**
+ * @brief 근접/조도 센서 대체
+ * HOST_SENSOR_TRACE CSV가 있으면 그 값을 재생하고, 없으면 느린 사인파 값을 만듦
+ */
+class Adafruit_VCNL4040 {
+public:
+    bool begin(uint8_t address = 0x60, void* wire = nullptr);
+    void setProximityLEDCurrent(VCNL4040_LEDCurrent current) { (void)current; }
+    void setProximityIntegrationTime(VCNL4040_ProximityIntegration integration) { (void)integration; }
+    void setProximityLEDDutyCycle(VCNL4040_LEDDutyCycle dutyCycle) { (void)dutyCycle; }
+    void setAmbientIntegrationTime(VCNL4040_AmbientIntegration integration) { (void)integration; }
+    void enableProximity(bool enabled) { (void)enabled; }
+    void enableAmbientLight(bool enabled) { (void)enabled; }
+    void enableWhiteLight(bool enabled) { (void)enabled; }
+
+    uint16_t getProximity();
+    uint16_t getAmbientLight();
+    uint16_t getWhiteLight();
+    float getLux();
+};
+
+#endif // HOST_ADAFRUIT_VCNL4040_H
@@ -0,0 +1,100 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+// 호스트(Linux) 빌드용 Arduino 코어 대체 헤더
+// 펌웨어 소스를 수정하지 않고 컴파일하기 위해 arduino-esp32가 제공하는 것 중
+// 이 저장소와 PubSubClient/ArduinoJson이 사용하는 부분만 같은 의미로 구현함
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <algorithm>
+
+#include "WString.h"
+#include "Print.h"
+#include "Stream.h"
+#include "HardwareSerial.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_system.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+using std::max;
+using std::min;
+
+#define HIGH 0x1
+#define LOW 0x0
+
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define PULLUP 0x04
+#define INPUT_PULLUP 0x05
+#define PULLDOWN 0x08
+#define INPUT_PULLDOWN 0x09
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define RTC_NOINIT_ATTR
+#define RTC_DATA_ATTR
+#define EXT_RAM_ATTR
+
+// PubSubClient의 publish_P 등에서 사용 (호스트는 플래시/RAM 구분이 없음)
+#define PROGMEM
+#define PSTR(text) (text)
+#define pgm_read_byte(address) (*(const uint8_t*)(address))
+#define pgm_read_byte_near(address) pgm_read_byte(address)
+#define strlen_P strlen
+#define memcpy_P memcpy
+
+#define constrain(amount, low, high) ((amount) < (low) ? (low) : ((amount) > (high) ? (high) : (amount)))
+
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+
+long random(long howBig);
+long random(long howSmall, long howBig);
+void randomSeed(unsigned long seed);
+
+bool psramFound();
+void* ps_malloc(size_t size);
+
+// glibc 2.38 이전에는 strlcpy가 없음
+size_t hostStrlcpy(char* destination, const char* source, size_t size);
+#define strlcpy hostStrlcpy
+
+// SNTP 대체: 호스트 시계는 이미 동기화되어 있으므로 아무것도 하지 않음
+void configTime(long gmtOffsetSec, int daylightOffsetSec, const char* server1,
+                const char* server2 = nullptr, const char* server3 = nullptr);
+
+class EspClass {
+public:
+    uint32_t getHeapSize();
+    uint32_t getFreeHeap();
+    uint32_t getMinFreeHeap();
+    uint32_t getMaxAllocHeap();
+    uint32_t getPsramSize();
+    uint32_t getFreePsram();
+    uint32_t getMinFreePsram();
+    uint32_t getMaxAllocPsram();
+    // 같은 인자로 프로세스를 다시 실행 (RTC_NOINIT 변수는 유지되지 않음)
+    [[noreturn]] void restart();
+};
+
+extern EspClass ESP;
+
+#endif // HOST_ARDUINO_H
@@ -0,0 +1,20 @@
+#ifndef HOST_BLE2902_H
+#define HOST_BLE2902_H
+
+#include "BLEDevice.h"
+
+// Client Characteristic Configuration 디스크립터
+class BLE2902 : public BLEDescriptor {
+public:
+    BLE2902() : BLEDescriptor("2902") {}
+    bool getNotifications() const { return notifications; }
+    void setNotifications(bool enabled) { notifications = enabled; }
+    bool getIndications() const { return indications; }
+    void setIndications(bool enabled) { indications = enabled; }
+
+private:
+    bool notifications = false;
+    bool indications = false;
+};
+
+#endif // HOST_BLE2902_H
@@ -0,0 +1,6 @@
+#ifndef HOST_BLECHARACTERISTIC_H
+#define HOST_BLECHARACTERISTIC_H
+
+#include "BLEDevice.h"
+
+#endif // HOST_BLECHARACTERISTIC_H
@@ -0,0 +1,182 @@
+#ifndef HOST_BLE_DEVICE_H
+#define HOST_BLE_DEVICE_H
+
+// Bluedroid BLE 대체: 호스트에는 BLE 스택이 없으므로 광고/서비스 객체는 상태만 보관하고
+// 연결 콜백은 호출되지 않음 (프로비저닝은 HOST_WIFI_SSID/HOST_WIFI_PASS로 대신함)
+// hostBleSetLink()로 링크 모델을 켜면 notify가 컨트롤러 버퍼를 거쳐 전달되고 혼잡 이벤트가 발생함
+
+#include <string>
+#include <vector>
+#include "Arduino.h"
+#include "esp_gap_ble_api.h"
+
+class BLEServer;
+class BLEService;
+class BLECharacteristic;
+class BLEAdvertising;
+class BLEDescriptor;
+
+typedef union {
+    struct {
+        uint16_t conn_id;
+        esp_bd_addr_t remote_bda;
+    } connect;
+    struct {
+        uint16_t conn_id;
+        esp_bd_addr_t remote_bda;
+        int reason;
+    } disconnect;
+    struct {
+        uint16_t conn_id;
+        uint16_t mtu;
+    } mtu;
+    struct {
+        uint16_t conn_id;
+        bool congested;
+    } congest;
+} esp_ble_gatts_cb_param_t;
+
+// 이 저장소가 사용하는 GATTS 이벤트만 정의 (값은 ESP-IDF와 동일)
+typedef enum {
+    ESP_GATTS_REG_EVT = 0,
+    ESP_GATTS_CONF_EVT = 5,
+    ESP_GATTS_CONGEST_EVT = 24
+} esp_gatts_cb_event_t;
+typedef uint8_t esp_gatt_if_t;
+typedef void (*gatts_event_handler)(esp_gatts_cb_event_t event, esp_gatt_if_t gatts_if,
+                                    esp_ble_gatts_cb_param_t* param);
+
+class BLEServerCallbacks {
+public:
+    virtual ~BLEServerCallbacks() {}
+    virtual void onConnect(BLEServer* server) { (void)server; }
+    virtual void onConnect(BLEServer* server, esp_ble_gatts_cb_param_t* param) { (void)server; (void)param; }
+    virtual void onDisconnect(BLEServer* server) { (void)server; }
+    virtual void onDisconnect(BLEServer* server, esp_ble_gatts_cb_param_t* param) { (void)server; (void)param; }
+    virtual void onMtuChanged(BLEServer* server, esp_ble_gatts_cb_param_t* param) { (void)server; (void)param; }
+};
+
+class BLECharacteristicCallbacks {
+public:
+    typedef enum {
+        SUCCESS_INDICATE,
+        SUCCESS_NOTIFY,
+        ERROR_INDICATE_DISABLED,
+        ERROR_NOTIFY_DISABLED,
+        ERROR_GATT,
+        ERROR_NO_CLIENT,
+        ERROR_INDICATE_TIMEOUT,
+        ERROR_INDICATE_FAILURE
+    } Status;
+
+    virtual ~BLECharacteristicCallbacks() {}
+    virtual void onWrite(BLECharacteristic* characteristic) { (void)characteristic; }
+    virtual void onRead(BLECharacteristic* characteristic) { (void)characteristic; }
+    virtual void onStatus(BLECharacteristic* characteristic, Status status, uint32_t code) {
+        (void)characteristic;
+        (void)status;
+        (void)code;
+    }
+};
+
+class BLEDescriptor {
+public:
+    explicit BLEDescriptor(const char* uuid = "") : uuid(uuid) {}
+    virtual ~BLEDescriptor() {}
+    const std::string& getUUID() const { return uuid; }
+
+private:
+    std::string uuid;
+};
+
+class BLECharacteristic {
+public:
+    static const uint32_t PROPERTY_READ = 1 << 0;
+    static const uint32_t PROPERTY_WRITE = 1 << 1;
+    static const uint32_t PROPERTY_NOTIFY = 1 << 2;
+    static const uint32_t PROPERTY_BROADCAST = 1 << 3;
+    static const uint32_t PROPERTY_INDICATE = 1 << 4;
+    static const uint32_t PROPERTY_WRITE_NR = 1 << 5;
+
+    BLECharacteristic(const char* uuid, uint32_t properties) : uuid(uuid), properties(properties) {}
+
+    void setCallbacks(BLECharacteristicCallbacks* newCallbacks) { callbacks = newCallbacks; }
+    void addDescriptor(BLEDescriptor* descriptor) { descriptors.push_back(descriptor); }
+    BLEDescriptor* getDescriptorByUUID(const char* descriptorUuid);
+    void setValue(const char* text) { value = text; }
+    void setValue(uint8_t* data, size_t length) { value.assign((const char*)data, length); }
+    void setValue(const std::string& text) { value = text; }
+    std::string getValue() { return value; }
+    // 링크 모델이 꺼져 있으면 구독자가 없으므로 전송 없이 ERROR_NOTIFY_DISABLED 상태만 알림
+    // 켜져 있으면 실제 스택처럼 큐에 넣기만 하고 SUCCESS_NOTIFY를 알림 (버퍼가 넘치면 조용히 유실)
+    void notify(bool isNotification = true);
+    void indicate() { notify(false); }
+
+private:
+    std::string uuid;
+    uint32_t properties;
+    std::string value;
+    std::vector<BLEDescriptor*> descriptors;
+    BLECharacteristicCallbacks* callbacks = nullptr;
+};
+
+class BLEService {
+public:
+    ~BLEService();
+    BLECharacteristic* createCharacteristic(const char* uuid, uint32_t properties);
+    void start() {}
+    void stop() {}
+
+private:
+    std::vector<BLECharacteristic*> characteristics;
+};
+
+class BLEAdvertising {
+public:
+    void addServiceUUID(const char* uuid) { (void)uuid; }
+    void setScanResponse(bool enabled) { (void)enabled; }
+    void setMinPreferred(uint16_t interval) { (void)interval; }
+    void setMaxPreferred(uint16_t interval) { (void)interval; }
+    void start() { advertising = true; }
+    void stop() { advertising = false; }
+    bool isAdvertising() const { return advertising; }
+
+private:
+    bool advertising = false;
+};
+
+class BLEServer {
+public:
+    ~BLEServer();
+    void setCallbacks(BLEServerCallbacks* newCallbacks) { callbacks = newCallbacks; }
+    BLEService* createService(const char* uuid);
+    void removeService(BLEService* service);
+    BLEAdvertising* getAdvertising();
+    uint16_t getPeerMTU(uint16_t connId) { (void)connId; return 23; }
+    uint16_t getConnId() { return 0; }
+    uint32_t getConnectedCount() { return 0; }
+    void disconnect(uint16_t connId) { (void)connId; }
+    void updateConnParams(esp_bd_addr_t address, uint16_t minInterval, uint16_t maxInterval, uint16_t latency,
+                          uint16_t timeout);
+
+private:
+    std::vector<BLEService*> services;
+    BLEServerCallbacks* callbacks = nullptr;
+};
+
+class BLEDevice {
+public:
+    static void init(const std::string& deviceName);
+    static void deinit(bool releaseMemory = false);
+    static bool getInitialized();
+    static BLEServer* createServer();
+    static BLEAdvertising* getAdvertising();
+    static void startAdvertising();
+    static void stopAdvertising();
+    static esp_err_t setMTU(uint16_t mtu);
+    static uint16_t getMTU();
+    static void setPower(int powerLevel);
+    static void setCustomGattsHandler(gatts_event_handler handler);
+};
+
+#endif // HOST_BLE_DEVICE_H
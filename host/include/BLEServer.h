@@ -0,0 +1,6 @@
+#ifndef HOST_BLESERVER_H
+#define HOST_BLESERVER_H
+
+#include "BLEDevice.h"
+
+#endif // HOST_BLESERVER_H
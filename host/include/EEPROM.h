@@ -0,0 +1,28 @@
+#ifndef HOST_EEPROM_H
+#define HOST_EEPROM_H
+
+#include "Arduino.h"
+
+// 파일 기반 EEPROM 대체 (HOST_STATE_DIR/eeprom.bin), commit() 때 파일에 기록
+class EEPROMClass {
+public:
+    bool begin(size_t size);
+    void end();
+    uint8_t read(int address);
+    void write(int address, uint8_t value);
+    bool commit();
+    size_t length() const { return size; }
+    uint8_t* getDataPtr();
+
+    String readString(int address);
+    size_t writeString(int address, const String& value);
+
+private:
+    uint8_t* data = nullptr;
+    size_t size = 0;
+    bool dirty = false;
+};
+
+extern EEPROMClass EEPROM;
+
+#endif // HOST_EEPROM_H
@@ -0,0 +1,27 @@
+#ifndef HOST_HARDWARE_SERIAL_H
+#define HOST_HARDWARE_SERIAL_H
+
+#include "Stream.h"
+
+// 시리얼 출력은 표준 출력으로 보냄 (입력은 없음)
+class HardwareSerial : public Stream {
+public:
+    void begin(unsigned long baud) { (void)baud; }
+    void end() {}
+
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+
+    size_t write(uint8_t value) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+    int availableForWrite() override { return 4096; }
+    void flush() override;
+
+    operator bool() const { return true; }
+};
+
+extern HardwareSerial Serial;
+
+#endif // HOST_HARDWARE_SERIAL_H
@@ -0,0 +1,37 @@
+#ifndef HOST_IPADDRESS_H
+#define HOST_IPADDRESS_H
+
+#include <stdint.h>
+#include <string.h>
+#include "WString.h"
+
+class IPAddress {
+public:
+    IPAddress() {}
+    IPAddress(uint8_t first, uint8_t second, uint8_t third, uint8_t fourth) {
+        bytes[0] = first;
+        bytes[1] = second;
+        bytes[2] = third;
+        bytes[3] = fourth;
+    }
+    // ESP32와 같이 네트워크 바이트 순서(첫 옥텟이 최하위 바이트)의 32비트 값
+    IPAddress(uint32_t address) { memcpy(bytes, &address, sizeof(bytes)); }
+
+    operator uint32_t() const {
+        uint32_t address;
+        memcpy(&address, bytes, sizeof(address));
+        return address;
+    }
+    bool operator==(const IPAddress& other) const { return memcmp(bytes, other.bytes, sizeof(bytes)) == 0; }
+    bool operator!=(const IPAddress& other) const { return !(*this == other); }
+    uint8_t operator[](int index) const { return bytes[index]; }
+    uint8_t& operator[](int index) { return bytes[index]; }
+
+    String toString() const;
+    bool fromString(const char* address);
+
+private:
+    uint8_t bytes[4] = {0, 0, 0, 0};
+};
+
+#endif // HOST_IPADDRESS_H
@@ -0,0 +1,66 @@
+#ifndef HOST_PREFERENCES_H
+#define HOST_PREFERENCES_H
+
+#include "Arduino.h"
+
+/**
+ * @brief 파일 기반 NVS 대체 (HOST_STATE_DIR/nvs/<namespace>)
+ * ESP32 NVS와 같이 키는 15자까지, 읽기 전용으로 연 없는 네임스페이스는 begin()이 실패하고
+ * 타입이 다른 값을 읽으면 기본값을 돌려줌. put*은 즉시 파일에 기록됨
+ */
+class Preferences {
+public:
+    Preferences();
+    ~Preferences();
+
+    bool begin(const char* name, bool readOnly = false, const char* partitionLabel = nullptr);
+    void end();
+    bool clear();
+    bool remove(const char* key);
+    bool isKey(const char* key);
+
+    size_t putChar(const char* key, int8_t value);
+    size_t putUChar(const char* key, uint8_t value);
+    size_t putShort(const char* key, int16_t value);
+    size_t putUShort(const char* key, uint16_t value);
+    size_t putInt(const char* key, int32_t value);
+    size_t putUInt(const char* key, uint32_t value);
+    size_t putLong(const char* key, int32_t value) { return putInt(key, value); }
+    size_t putULong(const char* key, uint32_t value) { return putUInt(key, value); }
+    size_t putLong64(const char* key, int64_t value);
+    size_t putULong64(const char* key, uint64_t value);
+    size_t putFloat(const char* key, float value);
+    size_t putDouble(const char* key, double value);
+    size_t putBool(const char* key, bool value);
+    size_t putString(const char* key, const char* value);
+    size_t putString(const char* key, const String& value) { return putString(key, value.c_str()); }
+    size_t putBytes(const char* key, const void* value, size_t length);
+
+    int8_t getChar(const char* key, int8_t defaultValue = 0);
+    uint8_t getUChar(const char* key, uint8_t defaultValue = 0);
+    int16_t getShort(const char* key, int16_t defaultValue = 0);
+    uint16_t getUShort(const char* key, uint16_t defaultValue = 0);
+    int32_t getInt(const char* key, int32_t defaultValue = 0);
+    uint32_t getUInt(const char* key, uint32_t defaultValue = 0);
+    int32_t getLong(const char* key, int32_t defaultValue = 0) { return getInt(key, defaultValue); }
+    uint32_t getULong(const char* key, uint32_t defaultValue = 0) { return getUInt(key, defaultValue); }
+    int64_t getLong64(const char* key, int64_t defaultValue = 0);
+    uint64_t getULong64(const char* key, uint64_t defaultValue = 0);
+    float getFloat(const char* key, float defaultValue = NAN);
+    double getDouble(const char* key, double defaultValue = NAN);
+    bool getBool(const char* key, bool defaultValue = false);
+    String getString(const char* key, const String& defaultValue = String());
+    size_t getString(const char* key, char* value, size_t maxLength);
+    size_t getBytesLength(const char* key);
+    size_t getBytes(const char* key, void* buffer, size_t maxLength);
+
+    size_t freeEntries();
+
+    // 파일 내용을 담는 구현 전용 구조체 (preferences.cpp)
+    struct Store;
+
+private:
+    Store* store;
+};
+
+#endif // HOST_PREFERENCES_H
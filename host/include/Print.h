@@ -0,0 +1,52 @@
+#ifndef HOST_PRINT_H
+#define HOST_PRINT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "WString.h"
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+class Print {
+public:
+    virtual ~Print() {}
+
+    virtual size_t write(uint8_t value) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size);
+    size_t write(const char* text) { return text ? write((const uint8_t*)text, strlen(text)) : 0; }
+    size_t write(const char* buffer, size_t size) { return write((const uint8_t*)buffer, size); }
+    virtual int availableForWrite() { return 0; }
+    virtual void flush() {}
+
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+    size_t print(const String& text) { return write(text.c_str(), text.length()); }
+    size_t print(const char* text) { return write(text); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(unsigned char number, int base = DEC) { return print((unsigned long long)number, base); }
+    size_t print(int number, int base = DEC) { return print((long long)number, base); }
+    size_t print(unsigned int number, int base = DEC) { return print((unsigned long long)number, base); }
+    size_t print(long number, int base = DEC) { return print((long long)number, base); }
+    size_t print(unsigned long number, int base = DEC) { return print((unsigned long long)number, base); }
+    size_t print(long long number, int base = DEC);
+    size_t print(unsigned long long number, int base = DEC);
+    size_t print(double number, int digits = 2);
+
+    template <typename T>
+    size_t println(const T& value) {
+        size_t written = print(value);
+        return written + println();
+    }
+    template <typename T>
+    size_t println(const T& value, int format) {
+        size_t written = print(value, format);
+        return written + println();
+    }
+    size_t println() { return write("\r\n"); }
+};
+
+#endif // HOST_PRINT_H
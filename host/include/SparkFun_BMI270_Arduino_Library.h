@@ -0,0 +1,34 @@
+#ifndef HOST_SPARKFUN_BMI270_H
+#define HOST_SPARKFUN_BMI270_H
+
+#include "Arduino.h"
+
+#define BMI2_OK 0
+#define BMI2_E_DEV_NOT_FOUND -2
+#define BMI2_I2C_PRIM_ADDR 0x68
+#define BMI2_I2C_SEC_ADDR 0x69
+
+struct BMI270_SensorData {
+    float accelX;
+    float accelY;
+    float accelZ;
+    float gyroX;
+    float gyroY;
+    float gyroZ;
+    uint32_t auxData[4];
+    uint32_t sensorTimeMillis;
+};
+
+/**
+ * @brief 6축 IMU 대체
+ * HOST_SENSOR_TRACE CSV가 있으면 그 값을 재생하고, 없으면 정지 상태(1g)에 작은 흔들림을 더한 값을 만듦
+ */
+class BMI270 {
+public:
+    int8_t beginI2C(uint8_t address = BMI2_I2C_PRIM_ADDR, void* wire = nullptr);
+    int8_t getSensorData();
+
+    BMI270_SensorData data = {};
+};
+
+#endif // HOST_SPARKFUN_BMI270_H
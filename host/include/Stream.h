@@ -0,0 +1,29 @@
+#ifndef HOST_STREAM_H
+#define HOST_STREAM_H
+
+#include "Print.h"
+
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+
+    void setTimeout(unsigned long timeoutMs) { timeout = timeoutMs; }
+    unsigned long getTimeout() const { return timeout; }
+
+    // 요청한 길이를 채우거나 타임아웃까지 읽음
+    virtual size_t readBytes(char* buffer, size_t length);
+    size_t readBytes(uint8_t* buffer, size_t length) { return readBytes((char*)buffer, length); }
+    size_t readBytesUntil(char terminator, char* buffer, size_t length);
+    String readString();
+    String readStringUntil(char terminator);
+
+protected:
+    int timedRead();
+    int timedPeek();
+
+    unsigned long timeout = 1000;
+};
+
+#endif // HOST_STREAM_H
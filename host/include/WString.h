@@ -0,0 +1,158 @@
+#ifndef HOST_WSTRING_H
+#define HOST_WSTRING_H
+
+// 호스트 빌드용 Arduino String (std::string 기반, arduino-esp32와 같은 의미)
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+class String {
+public:
+    String() {}
+    String(const char* text) : value(text ? text : "") {}
+    String(const char* text, unsigned int length) : value(text ? text : "", text ? length : 0) {}
+    String(const String& other) = default;
+    String(String&& other) = default;
+    explicit String(char c) : value(1, c) {}
+    explicit String(unsigned char number, unsigned char base = 10);
+    explicit String(int number, unsigned char base = 10);
+    explicit String(unsigned int number, unsigned char base = 10);
+    explicit String(long number, unsigned char base = 10);
+    explicit String(unsigned long number, unsigned char base = 10);
+    explicit String(long long number, unsigned char base = 10);
+    explicit String(unsigned long long number, unsigned char base = 10);
+    explicit String(float number, unsigned int decimalPlaces = 2);
+    explicit String(double number, unsigned int decimalPlaces = 2);
+
+    String& operator=(const String& other) = default;
+    String& operator=(String&& other) = default;
+    String& operator=(const char* text) {
+        value = text ? text : "";
+        return *this;
+    }
+
+    unsigned int length() const { return (unsigned int)value.size(); }
+    bool isEmpty() const { return value.empty(); }
+    const char* c_str() const { return value.c_str(); }
+    bool reserve(unsigned int size) {
+        value.reserve(size);
+        return true;
+    }
+    void clear() { value.clear(); }
+
+    bool concat(const String& other) {
+        value += other.value;
+        return true;
+    }
+    bool concat(const char* text) {
+        if (text == nullptr) {
+            return false;
+        }
+        value += text;
+        return true;
+    }
+    bool concat(const char* text, unsigned int length) {
+        if (text == nullptr) {
+            return false;
+        }
+        value.append(text, length);
+        return true;
+    }
+    bool concat(char c) {
+        value += c;
+        return true;
+    }
+    template <typename T>
+    bool concat(T number) {
+        return concat(String(number));
+    }
+
+    template <typename T>
+    String& operator+=(const T& other) {
+        concat(other);
+        return *this;
+    }
+
+    bool equals(const String& other) const { return value == other.value; }
+    bool equals(const char* text) const { return value == (text ? text : ""); }
+    bool equalsIgnoreCase(const String& other) const;
+    int compareTo(const String& other) const { return value.compare(other.value); }
+    bool startsWith(const String& prefix) const { return value.compare(0, prefix.value.size(), prefix.value) == 0; }
+    bool endsWith(const String& suffix) const;
+
+    bool operator==(const String& other) const { return equals(other); }
+    bool operator==(const char* text) const { return equals(text); }
+    bool operator!=(const String& other) const { return !equals(other); }
+    bool operator!=(const char* text) const { return !equals(text); }
+    bool operator<(const String& other) const { return value < other.value; }
+
+    char charAt(unsigned int index) const { return index < value.size() ? value[index] : '\0'; }
+    void setCharAt(unsigned int index, char c) {
+        if (index < value.size()) {
+            value[index] = c;
+        }
+    }
+    char operator[](unsigned int index) const { return charAt(index); }
+    char& operator[](unsigned int index) { return value[index]; }
+
+    int indexOf(char c, unsigned int from = 0) const { return toIndex(value.find(c, from)); }
+    int indexOf(const char* text, unsigned int from = 0) const { return toIndex(value.find(text, from)); }
+    int indexOf(const String& text, unsigned int from = 0) const { return toIndex(value.find(text.value, from)); }
+    int lastIndexOf(char c) const { return toIndex(value.rfind(c)); }
+    int lastIndexOf(const String& text) const { return toIndex(value.rfind(text.value)); }
+
+    String substring(unsigned int beginIndex) const { return substring(beginIndex, length()); }
+    String substring(unsigned int beginIndex, unsigned int endIndex) const;
+
+    void replace(char find, char replacement);
+    void replace(const String& find, const String& replacement);
+    void remove(unsigned int index) { remove(index, (unsigned int)-1); }
+    void remove(unsigned int index, unsigned int count);
+    void toLowerCase();
+    void toUpperCase();
+    void trim();
+
+    long toInt() const;
+    float toFloat() const { return (float)toDouble(); }
+    double toDouble() const;
+
+    void getBytes(unsigned char* buffer, unsigned int bufferSize, unsigned int index = 0) const;
+    void toCharArray(char* buffer, unsigned int bufferSize, unsigned int index = 0) const {
+        getBytes((unsigned char*)buffer, bufferSize, index);
+    }
+
+    char* begin() { return &value[0]; }
+    char* end() { return &value[0] + value.size(); }
+
+private:
+    static int toIndex(size_t position) { return position == std::string::npos ? -1 : (int)position; }
+
+    std::string value;
+};
+
+inline String operator+(const String& left, const String& right) {
+    String result(left);
+    result.concat(right);
+    return result;
+}
+
+inline String operator+(const String& left, const char* right) {
+    String result(left);
+    result.concat(right);
+    return result;
+}
+
+inline String operator+(const char* left, const String& right) {
+    String result(left);
+    result.concat(right);
+    return result;
+}
+
+inline String operator+(const String& left, char right) {
+    String result(left);
+    result.concat(right);
+    return result;
+}
+
+#endif // HOST_WSTRING_H
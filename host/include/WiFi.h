@@ -0,0 +1,76 @@
+#ifndef HOST_WIFI_H
+#define HOST_WIFI_H
+
+#include "Arduino.h"
+#include "IPAddress.h"
+#include "WiFiClient.h"
+#include "esp_wifi_types.h"
+
+typedef enum {
+    WL_NO_SHIELD = 255,
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL = 1,
+    WL_SCAN_COMPLETED = 2,
+    WL_CONNECTED = 3,
+    WL_CONNECT_FAILED = 4,
+    WL_CONNECTION_LOST = 5,
+    WL_DISCONNECTED = 6
+} wl_status_t;
+
+typedef enum { WIFI_OFF = 0, WIFI_STA, WIFI_AP, WIFI_AP_STA } wifi_mode_t;
+typedef enum { WIFI_PS_NONE, WIFI_PS_MIN_MODEM, WIFI_PS_MAX_MODEM } wifi_ps_type_t;
+
+#define WIFI_SCAN_RUNNING (-1)
+#define WIFI_SCAN_FAILED (-2)
+
+/**
+ * @brief 호스트의 네트워크를 그대로 쓰는 가상 스테이션
+ * begin() 후 HOST_WIFI_CONNECT_MS(기본 300ms)가 지나면 연결됨으로 바뀌고,
+ * SSID가 비어 있으면 WL_NO_SSID_AVAIL을 보고함. 스캔은 고정된 AP 목록을 비동기로 돌려줌
+ */
+class WiFiClass {
+public:
+    bool mode(wifi_mode_t newMode);
+    wifi_mode_t getMode();
+    void persistent(bool enabled) { (void)enabled; }
+    bool setAutoReconnect(bool enabled);
+    bool getAutoReconnect();
+    bool setSleep(bool enabled);
+    bool setSleep(wifi_ps_type_t type);
+
+    wl_status_t begin(const char* ssid, const char* passphrase = nullptr, int32_t channel = 0,
+                      const uint8_t* bssid = nullptr, bool connect = true);
+    wl_status_t status();
+    bool isConnected() { return status() == WL_CONNECTED; }
+    bool disconnect(bool wifiOff = false, bool eraseAp = false);
+    bool reconnect();
+    bool config(IPAddress localIp, IPAddress gateway, IPAddress subnet, IPAddress dns1 = IPAddress(),
+                IPAddress dns2 = IPAddress());
+
+    IPAddress localIP();
+    IPAddress gatewayIP();
+    IPAddress subnetMask();
+    IPAddress dnsIP(uint8_t index = 0);
+    String macAddress();
+
+    String SSID();
+    int8_t RSSI();
+    uint8_t* BSSID();
+    int32_t channel();
+
+    int16_t scanNetworks(bool async = false, bool showHidden = false, bool passive = false,
+                         uint32_t maxMsPerChannel = 300, uint8_t channel = 0, const char* ssid = nullptr,
+                         const uint8_t* bssid = nullptr);
+    int16_t scanComplete();
+    void scanDelete();
+    void* getScanInfoByIndex(int index);
+    String SSID(uint8_t index);
+    int32_t RSSI(uint8_t index);
+    wifi_auth_mode_t encryptionType(uint8_t index);
+    uint8_t* BSSID(uint8_t index);
+    int32_t channel(uint8_t index);
+};
+
+extern WiFiClass WiFi;
+
+#endif // HOST_WIFI_H
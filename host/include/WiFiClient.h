@@ -0,0 +1,57 @@
+#ifndef HOST_WIFI_CLIENT_H
+#define HOST_WIFI_CLIENT_H
+
+#include "Client.h"
+
+/**
+ * @brief POSIX TCP 소켓 위의 WiFiClient
+ * 연결 대상 포트에 HOST_REDIRECT_<port>=host:port 환경 변수가 있으면 그 주소로 연결함
+ * (기본값: 8883 → 127.0.0.1:1883, 443 → 127.0.0.1:8080)
+ * HOST_LINK_KBPS가 있으면 HOST_LINK_PORT(기본 443) 연결에 약한 WiFi 링크를 흉내 냄 (wifi.cpp 참조)
+ */
+struct HostLinkState;
+
+class WiFiClient : public Client {
+public:
+    WiFiClient();
+    ~WiFiClient() override;
+
+    // 소켓을 공유하지 않도록 복사는 막음 (이 저장소는 클라이언트를 복사하지 않음)
+    WiFiClient(const WiFiClient&) = delete;
+    WiFiClient& operator=(const WiFiClient&) = delete;
+
+    int connect(IPAddress ip, uint16_t port) override;
+    int connect(const char* host, uint16_t port) override;
+    int connect(const char* host, uint16_t port, int32_t timeoutMs);
+
+    size_t write(uint8_t value) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+    int available() override;
+    int read() override;
+    int read(uint8_t* buffer, size_t size) override;
+    int peek() override;
+    void flush() override {}
+    void stop() override;
+    uint8_t connected() override;
+    operator bool() override { return connected(); }
+
+    int fd() const { return socketFd; }
+    int setNoDelay(bool noDelay);
+    int setSocketOption(int option, char* value, size_t length);
+    int setSocketOption(int level, int option, const void* value, size_t length);
+
+private:
+    int fillBuffer(int timeoutMs);
+    size_t sendAll(const uint8_t* buffer, size_t size, unsigned long startMs);
+    size_t writeShaped(const uint8_t* buffer, size_t size);
+    bool linkInFlight();
+
+    int socketFd = -1;
+    HostLinkState* link = nullptr;
+    uint8_t rxBuffer[1436];
+    size_t rxStart = 0;
+    size_t rxEnd = 0;
+};
+
+#endif // HOST_WIFI_CLIENT_H
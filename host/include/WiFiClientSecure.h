@@ -0,0 +1,17 @@
+#ifndef HOST_WIFI_CLIENT_SECURE_H
+#define HOST_WIFI_CLIENT_SECURE_H
+
+#include "WiFi.h"
+
+// 호스트 빌드는 TLS 없이 평문 TCP로 연결함 (로컬 mosquitto/HTTP 대체 서버용)
+// 인증서 설정은 기록만 하고 검증에 사용하지 않음
+class WiFiClientSecure : public WiFiClient {
+public:
+    void setCACert(const char* rootCa) { (void)rootCa; }
+    void setCertificate(const char* clientCert) { (void)clientCert; }
+    void setPrivateKey(const char* privateKey) { (void)privateKey; }
+    void setInsecure() {}
+    void setHandshakeTimeout(unsigned long timeoutSec) { (void)timeoutSec; }
+};
+
+#endif // HOST_WIFI_CLIENT_SECURE_H
@@ -0,0 +1,16 @@
+#ifndef HOST_WIRE_H
+#define HOST_WIRE_H
+
+#include "Arduino.h"
+
+// 센서 드라이버 대체가 I2C를 쓰지 않으므로 버스 설정만 받아 둠
+class TwoWire {
+public:
+    bool begin(int sda = -1, int scl = -1, uint32_t frequency = 0);
+    bool end();
+    void setClock(uint32_t frequency);
+};
+
+extern TwoWire Wire;
+
+#endif // HOST_WIRE_H
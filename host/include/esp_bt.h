@@ -0,0 +1,18 @@
+#ifndef HOST_ESP_BT_H
+#define HOST_ESP_BT_H
+
+#include "esp_system.h"
+
+typedef enum { ESP_BT_MODE_IDLE, ESP_BT_MODE_BLE, ESP_BT_MODE_CLASSIC_BT, ESP_BT_MODE_BTDM } esp_bt_mode_t;
+typedef enum {
+    ESP_BT_CONTROLLER_STATUS_IDLE,
+    ESP_BT_CONTROLLER_STATUS_INITED,
+    ESP_BT_CONTROLLER_STATUS_ENABLED
+} esp_bt_controller_status_t;
+
+// 호스트에는 BT 컨트롤러가 없으므로 메모리 해제는 항상 성공
+esp_err_t esp_bt_controller_mem_release(esp_bt_mode_t mode);
+esp_err_t esp_bt_mem_release(esp_bt_mode_t mode);
+esp_bt_controller_status_t esp_bt_controller_get_status();
+
+#endif // HOST_ESP_BT_H
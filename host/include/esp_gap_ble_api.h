@@ -0,0 +1,18 @@
+#ifndef HOST_ESP_GAP_BLE_API_H
+#define HOST_ESP_GAP_BLE_API_H
+
+#include "esp_system.h"
+
+typedef uint8_t esp_bd_addr_t[6];
+
+typedef struct {
+    esp_bd_addr_t bda;
+    uint16_t min_int;
+    uint16_t max_int;
+    uint16_t latency;
+    uint16_t timeout;
+} esp_ble_conn_update_params_t;
+
+esp_err_t esp_ble_gap_update_conn_params(esp_ble_conn_update_params_t* params);
+
+#endif // HOST_ESP_GAP_BLE_API_H
@@ -0,0 +1,23 @@
+#ifndef HOST_ESP_HEAP_CAPS_H
+#define HOST_ESP_HEAP_CAPS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define MALLOC_CAP_EXEC (1 << 0)
+#define MALLOC_CAP_32BIT (1 << 1)
+#define MALLOC_CAP_8BIT (1 << 2)
+#define MALLOC_CAP_DMA (1 << 3)
+#define MALLOC_CAP_SPIRAM (1 << 10)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+#define MALLOC_CAP_DEFAULT (1 << 12)
+
+// 호스트에는 힙 구분이 없으므로 ESP32-S3 (내부 SRAM + 8MB PSRAM) 기준의 고정 값을 보고함
+size_t heap_caps_get_total_size(uint32_t caps);
+size_t heap_caps_get_free_size(uint32_t caps);
+size_t heap_caps_get_minimum_free_size(uint32_t caps);
+size_t heap_caps_get_largest_free_block(uint32_t caps);
+void* heap_caps_malloc(size_t size, uint32_t caps);
+void heap_caps_free(void* pointer);
+
+#endif // HOST_ESP_HEAP_CAPS_H
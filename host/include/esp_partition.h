@@ -0,0 +1,39 @@
+#ifndef HOST_ESP_PARTITION_H
+#define HOST_ESP_PARTITION_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_system.h"
+
+#define SPI_FLASH_SEC_SIZE 4096
+
+typedef enum { ESP_PARTITION_TYPE_APP = 0x00, ESP_PARTITION_TYPE_DATA = 0x01, ESP_PARTITION_TYPE_ANY = 0xff } esp_partition_type_t;
+
+typedef enum {
+    ESP_PARTITION_SUBTYPE_APP_FACTORY = 0x00,
+    ESP_PARTITION_SUBTYPE_DATA_OTA = 0x00,
+    ESP_PARTITION_SUBTYPE_DATA_NVS = 0x02,
+    ESP_PARTITION_SUBTYPE_DATA_SPIFFS = 0x82,
+    ESP_PARTITION_SUBTYPE_ANY = 0xff
+} esp_partition_subtype_t;
+
+typedef struct {
+    esp_partition_type_t type;
+    esp_partition_subtype_t subtype;
+    uint32_t address;
+    uint32_t size;
+    uint32_t erase_size;
+    char label[17];
+    bool encrypted;
+    bool readonly;
+} esp_partition_t;
+
+// 파티션은 실행 디렉터리의 partitions.csv에서 읽고, 내용은 HOST_STATE_DIR/<label>.bin 파일에 저장
+// 쓰기는 NOR 플래시처럼 1 → 0 비트만 바꾸므로 지우지 않고 덮어쓰는 버그도 장치와 같이 드러남
+const esp_partition_t* esp_partition_find_first(esp_partition_type_t type, esp_partition_subtype_t subtype,
+                                                const char* label);
+esp_err_t esp_partition_read(const esp_partition_t* partition, size_t offset, void* destination, size_t size);
+esp_err_t esp_partition_write(const esp_partition_t* partition, size_t offset, const void* source, size_t size);
+esp_err_t esp_partition_erase_range(const esp_partition_t* partition, size_t offset, size_t size);
+
+#endif // HOST_ESP_PARTITION_H
@@ -0,0 +1,11 @@
+#ifndef HOST_ESP_ROM_CRC_H
+#define HOST_ESP_ROM_CRC_H
+
+#include <stdint.h>
+
+/**
+ * @brief ROM의 CRC32 (다항식 0xEDB88320, 입출력 반전)와 같은 결과
+ */
+uint32_t esp_rom_crc32_le(uint32_t crc, const uint8_t* buffer, uint32_t length);
+
+#endif // HOST_ESP_ROM_CRC_H
@@ -0,0 +1,27 @@
+#ifndef HOST_ESP_SYSTEM_H
+#define HOST_ESP_SYSTEM_H
+
+#include <stdint.h>
+
+typedef int esp_err_t;
+
+#define ESP_OK 0
+#define ESP_FAIL -1
+#define ESP_ERR_NO_MEM 0x101
+#define ESP_ERR_INVALID_ARG 0x102
+#define ESP_ERR_INVALID_STATE 0x103
+#define ESP_ERR_INVALID_SIZE 0x104
+#define ESP_ERR_NOT_FOUND 0x105
+#define ESP_ERR_TIMEOUT 0x107
+
+typedef enum { ESP_MAC_WIFI_STA, ESP_MAC_WIFI_SOFTAP, ESP_MAC_BT, ESP_MAC_ETH } esp_mac_type_t;
+
+/**
+ * @brief 장치 MAC 주소 (HOST_MAC 환경 변수, 없으면 호스트 이름으로 만든 고정 값)
+ * ESP32와 같이 BT 주소는 STA 주소의 마지막 바이트 + 2
+ */
+esp_err_t esp_read_mac(uint8_t* mac, esp_mac_type_t type);
+
+uint32_t esp_random();
+
+#endif // HOST_ESP_SYSTEM_H
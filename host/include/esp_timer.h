@@ -0,0 +1,11 @@
+#ifndef HOST_ESP_TIMER_H
+#define HOST_ESP_TIMER_H
+
+#include <stdint.h>
+
+/**
+ * @brief 프로세스 시작 이후 단조 증가 시각 (us)
+ */
+int64_t esp_timer_get_time();
+
+#endif // HOST_ESP_TIMER_H
@@ -0,0 +1,25 @@
+#ifndef HOST_ESP_WIFI_TYPES_H
+#define HOST_ESP_WIFI_TYPES_H
+
+#include <stdint.h>
+
+typedef enum {
+    WIFI_AUTH_OPEN = 0,
+    WIFI_AUTH_WEP,
+    WIFI_AUTH_WPA_PSK,
+    WIFI_AUTH_WPA2_PSK,
+    WIFI_AUTH_WPA_WPA2_PSK,
+    WIFI_AUTH_WPA2_ENTERPRISE,
+    WIFI_AUTH_WPA3_PSK,
+    WIFI_AUTH_WPA2_WPA3_PSK,
+} wifi_auth_mode_t;
+
+typedef struct {
+    uint8_t bssid[6];
+    uint8_t ssid[33];
+    uint8_t primary;
+    int8_t rssi;
+    wifi_auth_mode_t authmode;
+} wifi_ap_record_t;
+
+#endif // HOST_ESP_WIFI_TYPES_H
@@ -0,0 +1,59 @@
+#ifndef HOST_FREERTOS_H
+#define HOST_FREERTOS_H
+
+// 호스트 빌드용 FreeRTOS 대체: 태스크는 std::thread, 큐/세마포어는 mutex + condition_variable로 구현
+// 틱은 1ms이고 우선순위와 코어 고정은 무시됨 (Linux 스케줄러에 맡김)
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint8_t StackType_t;
+
+struct HostTask;
+struct HostQueue;
+struct HostEventGroup;
+
+typedef HostTask* TaskHandle_t;
+typedef HostQueue* QueueHandle_t;
+typedef HostQueue* SemaphoreHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+#define configTICK_RATE_HZ 1000
+#define portTICK_PERIOD_MS 1
+#define portMAX_DELAY ((TickType_t)0xffffffffUL)
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+#define pdTICKS_TO_MS(ticks) ((uint32_t)(ticks))
+
+#define pdFALSE 0
+#define pdTRUE 1
+#define pdFAIL pdFALSE
+#define pdPASS pdTRUE
+#define errQUEUE_EMPTY pdFALSE
+#define errQUEUE_FULL pdFALSE
+
+#define tskNO_AFFINITY 0x7FFFFFFF
+#define tskIDLE_PRIORITY 0
+#define configMAX_PRIORITIES 25
+
+// 임계 구역은 프로세스 전체에서 하나의 재귀 mutex로 직렬화
+typedef struct {
+    int owner;
+} portMUX_TYPE;
+
+#define portMUX_INITIALIZER_UNLOCKED {0}
+
+void vPortEnterCritical(portMUX_TYPE* mux);
+void vPortExitCritical(portMUX_TYPE* mux);
+
+#define portENTER_CRITICAL(mux) vPortEnterCritical(mux)
+#define portEXIT_CRITICAL(mux) vPortExitCritical(mux)
+#define portENTER_CRITICAL_ISR(mux) vPortEnterCritical(mux)
+#define portEXIT_CRITICAL_ISR(mux) vPortExitCritical(mux)
+#define taskENTER_CRITICAL(mux) vPortEnterCritical(mux)
+#define taskEXIT_CRITICAL(mux) vPortExitCritical(mux)
+#define portYIELD_FROM_ISR(...) ((void)0)
+
+#endif // HOST_FREERTOS_H
@@ -0,0 +1,16 @@
+#ifndef HOST_FREERTOS_SEMPHR_H
+#define HOST_FREERTOS_SEMPHR_H
+
+#include "queue.h"
+
+// FreeRTOS와 같이 세마포어는 항목 크기가 0인 큐 (mutex는 소유 태스크를 확인하지 않음)
+SemaphoreHandle_t xSemaphoreCreateMutex();
+SemaphoreHandle_t xSemaphoreCreateBinary();
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t maxCount, UBaseType_t initialCount);
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticksToWait);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore);
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t semaphore, BaseType_t* higherPriorityTaskWoken);
+UBaseType_t uxSemaphoreGetCount(SemaphoreHandle_t semaphore);
+void vSemaphoreDelete(SemaphoreHandle_t semaphore);
+
+#endif // HOST_FREERTOS_SEMPHR_H
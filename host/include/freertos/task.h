@@ -0,0 +1,28 @@
+#ifndef HOST_FREERTOS_TASK_H
+#define HOST_FREERTOS_TASK_H
+
+#include "FreeRTOS.h"
+
+/**
+ * @brief 분리된(detached) 스레드로 태스크 생성
+ * 스택 크기와 우선순위는 기록만 하며, vTaskDelete(nullptr)는 호출한 스레드를 종료함
+ */
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char* name, uint32_t stackDepth, void* parameter,
+                                   UBaseType_t priority, TaskHandle_t* createdTask, BaseType_t coreId);
+BaseType_t xTaskCreate(TaskFunction_t function, const char* name, uint32_t stackDepth, void* parameter,
+                       UBaseType_t priority, TaskHandle_t* createdTask);
+void vTaskDelete(TaskHandle_t task);
+
+void vTaskDelay(TickType_t ticks);
+void vTaskDelayUntil(TickType_t* previousWakeTime, TickType_t increment);
+TickType_t xTaskGetTickCount();
+
+TaskHandle_t xTaskGetCurrentTaskHandle();
+const char* pcTaskGetName(TaskHandle_t task);
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task);
+BaseType_t xPortGetCoreID();
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+uint32_t ulTaskNotifyTake(BaseType_t clearCountOnExit, TickType_t ticksToWait);
+
+#endif // HOST_FREERTOS_TASK_H
@@ -0,0 +1,83 @@
+#ifndef HOST_RUNTIME_H
+#define HOST_RUNTIME_H
+
+// 호스트 빌드 전용 런타임 (펌웨어 소스는 이 헤더를 포함하지 않음)
+
+#include <stdint.h>
+#include "WString.h"
+
+/**
+ * @brief 시각 기준점과 상태 디렉터리를 준비 (main()에서 setup() 전에 한 번 호출)
+ * ESP.restart()가 같은 인자로 다시 실행할 수 있도록 argv를 보관함
+ */
+void hostInit(int argc, char** argv);
+
+/**
+ * @brief 상태 디렉터리(HOST_STATE_DIR, 기본 .host_state) 아래 경로를 반환
+ */
+String hostStatePath(const char* name);
+
+/**
+ * @brief 환경 변수 값 (없거나 비어 있으면 fallback)
+ */
+const char* hostEnv(const char* name, const char* fallback);
+uint32_t hostEnvU32(const char* name, uint32_t fallback);
+
+/**
+ * @brief 입력 핀의 값을 바꿈 (digitalRead로 읽힘, 버튼 입력 흉내용)
+ */
+void hostSetPin(uint8_t pin, int value);
+
+/**
+ * @brief 근접 센서 값을 고정 (-1이면 해제하고 HOST_SENSOR_TRACE/합성 값으로 돌아감, 물체 접근 흉내용)
+ */
+void hostSetProximity(int value);
+
+/**
+ * @brief 카메라 시뮬레이터 집계(버퍼 풀, fb_get 대기, 프레임 나이)를 stdout에 출력
+ */
+void hostCameraReport();
+
+/**
+ * @brief NVS 대체 구현의 쓰기 집계 (프로세스 시작 이후 누적, EEPROM.commit 포함)
+ * 실제 NVS와 같이 32바이트 항목 단위로 센 근사값이며 플래시 마모 비교용
+ */
+struct HostNvsStats {
+    uint32_t commits;       // put/remove/clear와 EEPROM.commit 횟수
+    uint64_t bytesWritten;  // 플래시에 기록한 바이트 (항목 헤더 + 데이터 칸)
+};
+HostNvsStats hostNvsStats();
+
+/**
+ * @brief 파일 기반 플래시 파티션 집계 (프로세스 시작 이후 누적, 모든 파티션 합계)
+ */
+struct HostFlashStats {
+    uint32_t reads;
+    uint32_t writes;
+    uint64_t bytesRead;
+    uint64_t bytesWritten;
+    uint32_t sectorErases;     // 지운 4KB 섹터 수
+    uint32_t maxSectorErases;  // 가장 많이 지운 섹터의 소거 횟수 (마모 평준화 확인용)
+};
+HostFlashStats hostFlashStats();
+
+/**
+ * @brief BLE 링크 모델 집계 (hostBleSetLink 이후 누적)
+ */
+struct HostBleLinkStats {
+    uint32_t deliveredPackets; // 연결 이벤트에서 실제로 전송된 notify 수
+    uint64_t deliveredBytes;
+    uint32_t droppedPackets;   // 컨트롤러 버퍼가 가득 차 조용히 버려진 notify 수
+    uint32_t congestEvents;    // ESP_GATTS_CONGEST_EVT(congested=true) 발생 횟수
+    uint32_t queuedPackets;    // 아직 전송되지 않은 notify 수
+};
+
+/**
+ * @brief BLE 링크 모델을 켬 (intervalMs 0이면 끔)
+ * notify는 컨트롤러 버퍼에 쌓이고 연결 간격마다 packetsPerEvent개씩 전송되며,
+ * 버퍼가 차면 혼잡 이벤트를 보내고 한도를 넘으면 조용히 버림 (처리량/유실 측정용)
+ */
+void hostBleSetLink(uint16_t intervalMs, uint8_t packetsPerEvent);
+HostBleLinkStats hostBleLinkStats();
+
+#endif // HOST_RUNTIME_H
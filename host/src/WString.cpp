@@ -0,0 +1,152 @@
+#include "WString.h"
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// 부호 없는 정수를 진법 base의 문자열로 변환 (Arduino ultoa와 같은 결과)
+static std::string formatUnsigned(unsigned long long number, unsigned char base) {
+    if (base < 2 || base > 36) {
+        base = 10;
+    }
+    char digits[66];
+    size_t position = sizeof(digits);
+    digits[--position] = '\0';
+    do {
+        unsigned digit = (unsigned)(number % base);
+        digits[--position] = (char)(digit < 10 ? '0' + digit : 'a' + digit - 10);
+        number /= base;
+    } while (number > 0);
+    return std::string(digits + position);
+}
+
+static std::string formatSigned(long long number, unsigned char base) {
+    // Arduino와 같이 음수는 10진수일 때만 부호를 붙이고, 그 외 진법은 2의 보수 그대로 표시
+    if (number < 0 && base == 10) {
+        return "-" + formatUnsigned(0ULL - (unsigned long long)number, base);
+    }
+    return formatUnsigned((unsigned long long)number, base);
+}
+
+static std::string formatFloat(double number, unsigned int decimalPlaces) {
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%.*f", (int)decimalPlaces, number);
+    return buffer;
+}
+
+String::String(unsigned char number, unsigned char base) : value(formatUnsigned(number, base)) {}
+String::String(int number, unsigned char base)
+    : value(base == 10 ? formatSigned(number, base) : formatUnsigned((unsigned int)number, base)) {}
+String::String(unsigned int number, unsigned char base) : value(formatUnsigned(number, base)) {}
+String::String(long number, unsigned char base)
+    : value(base == 10 ? formatSigned(number, base) : formatUnsigned((unsigned long)number, base)) {}
+String::String(unsigned long number, unsigned char base) : value(formatUnsigned(number, base)) {}
+String::String(long long number, unsigned char base) : value(formatSigned(number, base)) {}
+String::String(unsigned long long number, unsigned char base) : value(formatUnsigned(number, base)) {}
+String::String(float number, unsigned int decimalPlaces) : value(formatFloat(number, decimalPlaces)) {}
+String::String(double number, unsigned int decimalPlaces) : value(formatFloat(number, decimalPlaces)) {}
+
+bool String::equalsIgnoreCase(const String& other) const {
+    if (value.size() != other.value.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < value.size(); i++) {
+        if (tolower((unsigned char)value[i]) != tolower((unsigned char)other.value[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool String::endsWith(const String& suffix) const {
+    return value.size() >= suffix.value.size() &&
+           value.compare(value.size() - suffix.value.size(), suffix.value.size(), suffix.value) == 0;
+}
+
+String String::substring(unsigned int beginIndex, unsigned int endIndex) const {
+    if (beginIndex > endIndex) {
+        unsigned int swap = beginIndex;
+        beginIndex = endIndex;
+        endIndex = swap;
+    }
+    if (beginIndex >= value.size()) {
+        return String();
+    }
+    if (endIndex > value.size()) {
+        endIndex = (unsigned int)value.size();
+    }
+    return String(value.c_str() + beginIndex, endIndex - beginIndex);
+}
+
+void String::replace(char find, char replacement) {
+    for (char& c : value) {
+        if (c == find) {
+            c = replacement;
+        }
+    }
+}
+
+void String::replace(const String& find, const String& replacement) {
+    if (find.value.empty()) {
+        return;
+    }
+    size_t position = 0;
+    while ((position = value.find(find.value, position)) != std::string::npos) {
+        value.replace(position, find.value.size(), replacement.value);
+        position += replacement.value.size();
+    }
+}
+
+void String::remove(unsigned int index, unsigned int count) {
+    if (index < value.size()) {
+        value.erase(index, count);
+    }
+}
+
+void String::toLowerCase() {
+    for (char& c : value) {
+        c = (char)tolower((unsigned char)c);
+    }
+}
+
+void String::toUpperCase() {
+    for (char& c : value) {
+        c = (char)toupper((unsigned char)c);
+    }
+}
+
+void String::trim() {
+    size_t first = 0;
+    while (first < value.size() && isspace((unsigned char)value[first])) {
+        first++;
+    }
+    size_t last = value.size();
+    while (last > first && isspace((unsigned char)value[last - 1])) {
+        last--;
+    }
+    value = value.substr(first, last - first);
+}
+
+long String::toInt() const {
+    return atol(value.c_str());
+}
+
+double String::toDouble() const {
+    return atof(value.c_str());
+}
+
+void String::getBytes(unsigned char* buffer, unsigned int bufferSize, unsigned int index) const {
+    if (buffer == nullptr || bufferSize == 0) {
+        return;
+    }
+    if (index >= value.size()) {
+        buffer[0] = '\0';
+        return;
+    }
+    size_t count = value.size() - index;
+    if (count > bufferSize - 1) {
+        count = bufferSize - 1;
+    }
+    memcpy(buffer, value.data() + index, count);
+    buffer[count] = '\0';
+}
@@ -0,0 +1,335 @@
+#include <Arduino.h>
+#include <IPAddress.h>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <stdarg.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "host_runtime.h"
+
+HardwareSerial Serial;
+EspClass ESP;
+
+static std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+static std::vector<char*> restartArgs;
+static String stateDir = ".host_state";
+static std::atomic<int> pinLevels[64];
+static std::mt19937 randomEngine(12345);
+static std::mutex randomMutex;
+
+// --- 런타임 ---
+
+void hostInit(int argc, char** argv) {
+    startTime = std::chrono::steady_clock::now();
+    restartArgs.assign(argv, argv + argc);
+    restartArgs.push_back(nullptr);
+
+    stateDir = hostEnv("HOST_STATE_DIR", ".host_state");
+    mkdir(stateDir.c_str(), 0755);
+    mkdir(hostStatePath("nvs").c_str(), 0755);
+
+    // 버튼 등 풀업 입력은 눌리지 않은 상태(HIGH)로 시작
+    for (auto& level : pinLevels) {
+        level = HIGH;
+    }
+    setvbuf(stdout, nullptr, _IOLBF, 0);
+}
+
+String hostStatePath(const char* name) {
+    return stateDir + "/" + name;
+}
+
+const char* hostEnv(const char* name, const char* fallback) {
+    const char* value = getenv(name);
+    return value != nullptr && value[0] != '\0' ? value : fallback;
+}
+
+uint32_t hostEnvU32(const char* name, uint32_t fallback) {
+    const char* value = getenv(name);
+    if (value == nullptr || value[0] == '\0') {
+        return fallback;
+    }
+    return (uint32_t)strtoul(value, nullptr, 0);
+}
+
+void hostSetPin(uint8_t pin, int value) {
+    if (pin < 64) {
+        pinLevels[pin] = value;
+    }
+}
+
+// --- 시간 ---
+
+int64_t esp_timer_get_time() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime)
+        .count();
+}
+
+unsigned long millis() {
+    return (unsigned long)(esp_timer_get_time() / 1000);
+}
+
+unsigned long micros() {
+    return (unsigned long)esp_timer_get_time();
+}
+
+void delay(uint32_t ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void delayMicroseconds(uint32_t us) {
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+void yield() {
+    std::this_thread::yield();
+}
+
+void configTime(long gmtOffsetSec, int daylightOffsetSec, const char* server1, const char* server2,
+                const char* server3) {
+    (void)gmtOffsetSec;
+    (void)daylightOffsetSec;
+    (void)server1;
+    (void)server2;
+    (void)server3;
+}
+
+// --- GPIO ---
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    if (pin < 64 && (mode & PULLDOWN)) {
+        pinLevels[pin] = LOW;
+    }
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+    if (pin < 64) {
+        pinLevels[pin] = value ? HIGH : LOW;
+    }
+}
+
+int digitalRead(uint8_t pin) {
+    return pin < 64 ? pinLevels[pin].load() : LOW;
+}
+
+// --- 난수 ---
+
+long random(long howBig) {
+    if (howBig <= 0) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(randomMutex);
+    return (long)(randomEngine() % (unsigned long)howBig);
+}
+
+long random(long howSmall, long howBig) {
+    if (howSmall >= howBig) {
+        return howSmall;
+    }
+    return howSmall + random(howBig - howSmall);
+}
+
+void randomSeed(unsigned long seed) {
+    if (seed != 0) {
+        std::lock_guard<std::mutex> lock(randomMutex);
+        randomEngine.seed((uint32_t)seed);
+    }
+}
+
+uint32_t esp_random() {
+    static std::random_device device;
+    static std::mutex deviceMutex;
+    std::lock_guard<std::mutex> lock(deviceMutex);
+    return device();
+}
+
+size_t hostStrlcpy(char* destination, const char* source, size_t size) {
+    size_t length = strlen(source);
+    if (size > 0) {
+        size_t copied = length < size - 1 ? length : size - 1;
+        memcpy(destination, source, copied);
+        destination[copied] = '\0';
+    }
+    return length;
+}
+
+// --- 메모리 ---
+
+bool psramFound() {
+    return true;
+}
+
+void* ps_malloc(size_t size) {
+    return malloc(size);
+}
+
+uint32_t EspClass::getHeapSize() { return (uint32_t)heap_caps_get_total_size(MALLOC_CAP_INTERNAL); }
+uint32_t EspClass::getFreeHeap() { return (uint32_t)heap_caps_get_free_size(MALLOC_CAP_INTERNAL); }
+uint32_t EspClass::getMinFreeHeap() { return (uint32_t)heap_caps_get_minimum_free_size(MALLOC_CAP_INTERNAL); }
+uint32_t EspClass::getMaxAllocHeap() { return (uint32_t)heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL); }
+uint32_t EspClass::getPsramSize() { return (uint32_t)heap_caps_get_total_size(MALLOC_CAP_SPIRAM); }
+uint32_t EspClass::getFreePsram() { return (uint32_t)heap_caps_get_free_size(MALLOC_CAP_SPIRAM); }
+uint32_t EspClass::getMinFreePsram() { return (uint32_t)heap_caps_get_minimum_free_size(MALLOC_CAP_SPIRAM); }
+uint32_t EspClass::getMaxAllocPsram() { return (uint32_t)heap_caps_get_largest_free_block(MALLOC_CAP_SPIRAM); }
+
+void EspClass::restart() {
+    fflush(stdout);
+    if (!restartArgs.empty()) {
+        execv("/proc/self/exe", restartArgs.data());
+        fprintf(stderr, "[host] 재시작 실패: %s\n", strerror(errno));
+    }
+    _exit(1);
+}
+
+// --- Print / Stream ---
+
+size_t Print::write(const uint8_t* buffer, size_t size) {
+    size_t written = 0;
+    while (size-- > 0) {
+        if (write(*buffer++) == 0) {
+            break;
+        }
+        written++;
+    }
+    return written;
+}
+
+size_t Print::printf(const char* format, ...) {
+    char small[128];
+    va_list args;
+    va_start(args, format);
+    va_list copy;
+    va_copy(copy, args);
+    int length = vsnprintf(small, sizeof(small), format, copy);
+    va_end(copy);
+    if (length < 0) {
+        va_end(args);
+        return 0;
+    }
+    if ((size_t)length < sizeof(small)) {
+        va_end(args);
+        return write((const uint8_t*)small, (size_t)length);
+    }
+    std::vector<char> large((size_t)length + 1);
+    vsnprintf(large.data(), large.size(), format, args);
+    va_end(args);
+    return write((const uint8_t*)large.data(), (size_t)length);
+}
+
+size_t Print::print(long long number, int base) {
+    return print(String(number, (unsigned char)base));
+}
+
+size_t Print::print(unsigned long long number, int base) {
+    return print(String(number, (unsigned char)base));
+}
+
+size_t Print::print(double number, int digits) {
+    return print(String(number, (unsigned int)digits));
+}
+
+int Stream::timedRead() {
+    unsigned long start = millis();
+    do {
+        int value = read();
+        if (value >= 0) {
+            return value;
+        }
+        delay(1);
+    } while (millis() - start < timeout);
+    return -1;
+}
+
+int Stream::timedPeek() {
+    unsigned long start = millis();
+    do {
+        int value = peek();
+        if (value >= 0) {
+            return value;
+        }
+        delay(1);
+    } while (millis() - start < timeout);
+    return -1;
+}
+
+size_t Stream::readBytes(char* buffer, size_t length) {
+    size_t count = 0;
+    while (count < length) {
+        int value = timedRead();
+        if (value < 0) {
+            break;
+        }
+        buffer[count++] = (char)value;
+    }
+    return count;
+}
+
+size_t Stream::readBytesUntil(char terminator, char* buffer, size_t length) {
+    size_t count = 0;
+    while (count < length) {
+        int value = timedRead();
+        if (value < 0 || value == terminator) {
+            break;
+        }
+        buffer[count++] = (char)value;
+    }
+    return count;
+}
+
+String Stream::readString() {
+    String result;
+    int value;
+    while ((value = timedRead()) >= 0) {
+        result += (char)value;
+    }
+    return result;
+}
+
+String Stream::readStringUntil(char terminator) {
+    String result;
+    int value;
+    while ((value = timedRead()) >= 0 && value != terminator) {
+        result += (char)value;
+    }
+    return result;
+}
+
+size_t HardwareSerial::write(uint8_t value) {
+    return fwrite(&value, 1, 1, stdout);
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+    return fwrite(buffer, 1, size, stdout);
+}
+
+void HardwareSerial::flush() {
+    fflush(stdout);
+}
+
+// --- IPAddress ---
+
+String IPAddress::toString() const {
+    char text[16];
+    snprintf(text, sizeof(text), "%u.%u.%u.%u", bytes[0], bytes[1], bytes[2], bytes[3]);
+    return String(text);
+}
+
+bool IPAddress::fromString(const char* address) {
+    unsigned parts[4];
+    char extra;
+    if (sscanf(address, "%u.%u.%u.%u%c", &parts[0], &parts[1], &parts[2], &parts[3], &extra) != 4) {
+        return false;
+    }
+    for (int i = 0; i < 4; i++) {
+        if (parts[i] > 255) {
+            return false;
+        }
+        bytes[i] = (uint8_t)parts[i];
+    }
+    return true;
+}
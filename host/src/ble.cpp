@@ -0,0 +1,235 @@
+#include <BLEDevice.h>
+#include <BLE2902.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include "host_runtime.h"
+
+// 링크 모델: Bluedroid L2CAP 큐처럼 높은 수위에서 혼잡을 알리고 낮은 수위에서 해제하며,
+// 한도를 넘는 notify는 스택이 이미 성공을 알린 뒤라 조용히 버려짐
+static const size_t LINK_QUEUE_LIMIT = 16;
+static const size_t LINK_CONGEST_HIGH = 10;
+static const size_t LINK_CONGEST_LOW = 5;
+
+static bool bleInitialized = false;
+static uint16_t localMtu = 23;
+static BLEServer* server = nullptr;
+static BLEAdvertising advertising;
+static gatts_event_handler customGattsHandler = nullptr;
+
+static std::mutex linkMutex;
+static std::thread linkThread;
+static std::atomic<bool> linkRunning(false);
+static std::deque<size_t> linkQueue; // 대기 중인 notify의 길이
+static bool linkCongested = false;
+static HostBleLinkStats linkStats = {};
+
+// 혼잡 상태가 바뀌면 실제 스택과 같이 GATTS 이벤트로 알림 (잠금 밖에서 호출)
+static void sendCongestEvent(bool congested) {
+    if (customGattsHandler == nullptr) {
+        return;
+    }
+    esp_ble_gatts_cb_param_t param;
+    memset(&param, 0, sizeof(param));
+    param.congest.congested = congested;
+    customGattsHandler(ESP_GATTS_CONGEST_EVT, 0, &param);
+}
+
+// 연결 간격마다 버퍼에서 packetsPerEvent개를 전송 (BT 컨트롤러 태스크 역할)
+static void runLink(uint16_t intervalMs, uint8_t packetsPerEvent) {
+    while (linkRunning) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs));
+        bool uncongested = false;
+        {
+            std::lock_guard<std::mutex> lock(linkMutex);
+            for (uint8_t i = 0; i < packetsPerEvent && !linkQueue.empty(); i++) {
+                linkStats.deliveredPackets++;
+                linkStats.deliveredBytes += linkQueue.front();
+                linkQueue.pop_front();
+            }
+            if (linkCongested && linkQueue.size() <= LINK_CONGEST_LOW) {
+                linkCongested = false;
+                uncongested = true;
+            }
+        }
+        if (uncongested) {
+            sendCongestEvent(false);
+        }
+    }
+}
+
+void hostBleSetLink(uint16_t intervalMs, uint8_t packetsPerEvent) {
+    if (linkRunning) {
+        linkRunning = false;
+        linkThread.join();
+    }
+    {
+        std::lock_guard<std::mutex> lock(linkMutex);
+        linkQueue.clear();
+        linkCongested = false;
+        linkStats = HostBleLinkStats();
+    }
+    if (intervalMs == 0) {
+        return;
+    }
+    linkRunning = true;
+    linkThread = std::thread(runLink, intervalMs, packetsPerEvent);
+}
+
+HostBleLinkStats hostBleLinkStats() {
+    std::lock_guard<std::mutex> lock(linkMutex);
+    HostBleLinkStats stats = linkStats;
+    stats.queuedPackets = (uint32_t)linkQueue.size();
+    return stats;
+}
+
+BLEDescriptor* BLECharacteristic::getDescriptorByUUID(const char* descriptorUuid) {
+    for (BLEDescriptor* descriptor : descriptors) {
+        if (descriptor->getUUID() == descriptorUuid) {
+            return descriptor;
+        }
+    }
+    return nullptr;
+}
+
+void BLECharacteristic::notify(bool isNotification) {
+    if (!linkRunning) {
+        if (callbacks != nullptr) {
+            callbacks->onStatus(this, isNotification ? BLECharacteristicCallbacks::ERROR_NOTIFY_DISABLED
+                                                     : BLECharacteristicCallbacks::ERROR_INDICATE_DISABLED, 0);
+        }
+        return;
+    }
+
+    bool congested = false;
+    {
+        std::lock_guard<std::mutex> lock(linkMutex);
+        if (linkQueue.size() >= LINK_QUEUE_LIMIT) {
+            linkStats.droppedPackets++;
+        } else {
+            linkQueue.push_back(value.size());
+        }
+        if (!linkCongested && linkQueue.size() >= LINK_CONGEST_HIGH) {
+            linkCongested = true;
+            linkStats.congestEvents++;
+            congested = true;
+        }
+    }
+    // Arduino BLE 라이브러리는 전송 요청이 큐에 들어가면 바로 성공을 알림 (전달 여부와 무관)
+    if (callbacks != nullptr) {
+        callbacks->onStatus(this, isNotification ? BLECharacteristicCallbacks::SUCCESS_NOTIFY
+                                                 : BLECharacteristicCallbacks::SUCCESS_INDICATE, 0);
+    }
+    if (congested) {
+        sendCongestEvent(true);
+    }
+}
+
+BLEService::~BLEService() {
+    for (BLECharacteristic* characteristic : characteristics) {
+        delete characteristic;
+    }
+}
+
+BLECharacteristic* BLEService::createCharacteristic(const char* uuid, uint32_t properties) {
+    BLECharacteristic* characteristic = new BLECharacteristic(uuid, properties);
+    characteristics.push_back(characteristic);
+    return characteristic;
+}
+
+BLEServer::~BLEServer() {
+    for (BLEService* service : services) {
+        delete service;
+    }
+}
+
+BLEService* BLEServer::createService(const char* uuid) {
+    (void)uuid;
+    BLEService* service = new BLEService();
+    services.push_back(service);
+    return service;
+}
+
+void BLEServer::removeService(BLEService* service) {
+    for (size_t i = 0; i < services.size(); i++) {
+        if (services[i] == service) {
+            services.erase(services.begin() + (long)i);
+            delete service;
+            return;
+        }
+    }
+}
+
+BLEAdvertising* BLEServer::getAdvertising() {
+    return &advertising;
+}
+
+void BLEServer::updateConnParams(esp_bd_addr_t address, uint16_t minInterval, uint16_t maxInterval,
+                                 uint16_t latency, uint16_t timeout) {
+    esp_ble_conn_update_params_t params;
+    memcpy(params.bda, address, sizeof(esp_bd_addr_t));
+    params.min_int = minInterval;
+    params.max_int = maxInterval;
+    params.latency = latency;
+    params.timeout = timeout;
+    esp_ble_gap_update_conn_params(&params);
+}
+
+void BLEDevice::init(const std::string& deviceName) {
+    (void)deviceName;
+    bleInitialized = true;
+}
+
+void BLEDevice::deinit(bool releaseMemory) {
+    (void)releaseMemory;
+    advertising.stop();
+    // Arduino BLE 라이브러리와 같이 서버 객체는 해제하지 않고 다음 init에서 새로 만듦
+    server = nullptr;
+    bleInitialized = false;
+}
+
+bool BLEDevice::getInitialized() {
+    return bleInitialized;
+}
+
+BLEServer* BLEDevice::createServer() {
+    if (server == nullptr) {
+        server = new BLEServer();
+    }
+    return server;
+}
+
+BLEAdvertising* BLEDevice::getAdvertising() {
+    return &advertising;
+}
+
+void BLEDevice::startAdvertising() {
+    advertising.start();
+}
+
+void BLEDevice::stopAdvertising() {
+    advertising.stop();
+}
+
+esp_err_t BLEDevice::setMTU(uint16_t mtu) {
+    if (mtu < 23 || mtu > 517) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    localMtu = mtu;
+    return ESP_OK;
+}
+
+uint16_t BLEDevice::getMTU() {
+    return localMtu;
+}
+
+void BLEDevice::setPower(int powerLevel) {
+    (void)powerLevel;
+}
+
+void BLEDevice::setCustomGattsHandler(gatts_event_handler handler) {
+    customGattsHandler = handler;
+}
@@ -0,0 +1,674 @@
+#include <Arduino.h>
+#include <esp_camera.h>
+#include <esp_timer.h>
+#include <dirent.h>
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "host_runtime.h"
+
+// 센서가 프레임을 계속 만들어 내는 시간축을 두고, esp_camera_fb_get()/fb_return()이 불릴 때
+// 그 시각까지의 프레임 완료를 한꺼번에 반영합니다 (별도 스레드 없음).
+// 버퍼 풀은 드라이버의 grab_mode 의미를 따릅니다.
+//   CAMERA_GRAB_WHEN_EMPTY: 빈 버퍼가 있을 때만 캡처, 가득 차면 센서 프레임을 버림 → fb_get은 가장 오래된(낡은) 프레임
+//   CAMERA_GRAB_LATEST: 대기열에 최근 fb_count-1장만 유지하며 오래된 것을 덮어씀 → fb_get은 최근 프레임
+// 대기 모드(OV3660 SYSTEM CTROL0 0x3008 bit6)에서는 프레임을 만들지 않고, 깨우면 HOST_CAMERA_WAKE_MS 뒤부터
+// 다시 노출을 시작합니다. 깨운 뒤 HOST_CAMERA_AE_FRAMES개 프레임은 자동 노출 미수렴 프레임으로 집계합니다.
+
+// framesize_t 순서와 같아야 함
+const resolution_info_t resolution[FRAMESIZE_INVALID] = {
+    {96, 96, ASPECT_RATIO_1X1},     {160, 120, ASPECT_RATIO_4X3},   {176, 144, ASPECT_RATIO_5X4},
+    {240, 176, ASPECT_RATIO_3X2},   {240, 240, ASPECT_RATIO_1X1},   {320, 240, ASPECT_RATIO_4X3},
+    {400, 296, ASPECT_RATIO_4X3},   {480, 320, ASPECT_RATIO_3X2},   {640, 480, ASPECT_RATIO_4X3},
+    {800, 600, ASPECT_RATIO_4X3},   {1024, 768, ASPECT_RATIO_4X3},  {1280, 720, ASPECT_RATIO_16X9},
+    {1280, 1024, ASPECT_RATIO_5X4}, {1600, 1200, ASPECT_RATIO_4X3},
+};
+
+// 드라이버의 fb_get 대기 한도 (esp32-camera FB_GET_TIMEOUT)
+static const uint32_t DEFAULT_FB_TIMEOUT_MS = 4000;
+
+// OV3660 SYSTEM CTROL0: bit6 소프트웨어 전원 차단
+static const int REG_SYSTEM_CTROL0 = 0x3008;
+static const int SYSTEM_CTROL0_POWER_DOWN = 0x40;
+
+// 버퍼에 담긴 프레임: 캡처 당시의 센서 설정을 함께 기록
+// (설정 변경 전에 채워진 버퍼는 이전 해상도/품질 그대로 나옴)
+struct CapturedFrame {
+    uint64_t index;
+    int64_t endUs;
+    framesize_t framesize;
+    uint8_t quality;
+    pixformat_t pixformat;
+    bool converged; // 자동 노출 수렴 후 프레임
+};
+
+struct SourceFile {
+    std::string name;
+    std::vector<uint8_t> data;
+};
+
+// 시뮬레이터 집계 (hostCameraReport()로 출력)
+struct CameraStats {
+    uint64_t framesCaptured = 0;  // 버퍼에 들어간 센서 프레임
+    uint64_t framesDropped = 0;   // 빈 버퍼가 없거나 덮어써져 버려진 프레임
+    uint64_t framesDelivered = 0; // fb_get으로 전달된 프레임
+    uint64_t fbGetCalls = 0;
+    uint64_t fbGetTimeouts = 0;   // NULL 반환 (버퍼 고갈/장애 주입)
+    uint64_t poolExhausted = 0;   // 모든 버퍼가 반환되지 않은 상태에서 fb_get 호출
+    uint64_t injectedDrops = 0;
+    uint64_t injectedCorrupt = 0;
+    uint64_t bytesDelivered = 0;
+    uint64_t unconvergedDelivered = 0; // 깨운 뒤 노출이 수렴하기 전 프레임을 전달한 횟수
+    uint64_t wakeUps = 0;              // 대기 모드 해제 횟수
+    int64_t standbyUs = 0;             // 대기 모드로 보낸 시간
+    std::vector<uint32_t> waitUs;  // fb_get 안에서 기다린 시간
+    std::vector<uint32_t> ageUs;   // 전달 시점의 프레임 나이 (캡처 완료 → fb_get 반환)
+};
+
+static std::mutex cameraMutex;
+static std::condition_variable bufferReturned;
+static bool cameraInitialized = false;
+static sensor_t cameraSensor;
+static camera_grab_mode_t grabMode = CAMERA_GRAB_WHEN_EMPTY;
+static size_t frameBufferCount = 1;
+static size_t framesOutstanding = 0;
+static std::deque<CapturedFrame> filledBuffers;
+static int64_t timelineStartUs = 0;
+static int64_t framePeriodUs = 60000;
+static uint64_t nextFrameIndex = 0;
+static uint32_t fbTimeoutMs = DEFAULT_FB_TIMEOUT_MS;
+static uint32_t dropPermille = 0;
+static uint32_t failPermille = 0;
+static uint32_t corruptPermille = 0;
+static std::vector<SourceFile> jpegFiles;
+static std::vector<SourceFile> rawFiles;
+static CameraStats stats;
+static bool standby = false;
+static int64_t standbyStartUs = 0;
+static int64_t wakeDelayUs = 50000;
+static uint32_t aeFrames = 12;
+static uint64_t convergedFromIndex = 0; // 이 번호부터 노출 수렴 프레임
+static int64_t initializedAtUs = 0;
+
+static void advanceFrames(int64_t nowUs);
+
+// --- 센서 레지스터 대체: 값은 status에만 기록 ---
+
+#define SENSOR_SETTER(name, field)                                    \
+    static int name(sensor_t* sensor, int value) {                    \
+        sensor->status.field = (decltype(sensor->status.field))value; \
+        return 0;                                                     \
+    }
+
+SENSOR_SETTER(setContrast, contrast)
+SENSOR_SETTER(setBrightness, brightness)
+SENSOR_SETTER(setSaturation, saturation)
+SENSOR_SETTER(setSharpness, sharpness)
+SENSOR_SETTER(setDenoise, denoise)
+SENSOR_SETTER(setColorbar, colorbar)
+SENSOR_SETTER(setWhitebal, awb)
+SENSOR_SETTER(setGainCtrl, agc)
+SENSOR_SETTER(setExposureCtrl, aec)
+SENSOR_SETTER(setHmirror, hmirror)
+SENSOR_SETTER(setVflip, vflip)
+SENSOR_SETTER(setAec2, aec2)
+SENSOR_SETTER(setAwbGain, awb_gain)
+SENSOR_SETTER(setAgcGain, agc_gain)
+SENSOR_SETTER(setAecValue, aec_value)
+SENSOR_SETTER(setSpecialEffect, special_effect)
+SENSOR_SETTER(setWbMode, wb_mode)
+SENSOR_SETTER(setAeLevel, ae_level)
+SENSOR_SETTER(setDcw, dcw)
+SENSOR_SETTER(setBpc, bpc)
+SENSOR_SETTER(setWpc, wpc)
+SENSOR_SETTER(setRawGma, raw_gma)
+SENSOR_SETTER(setLenc, lenc)
+
+static int setGainceiling(sensor_t* sensor, gainceiling_t gainceiling) {
+    sensor->status.gainceiling = (uint8_t)gainceiling;
+    return 0;
+}
+
+// 출력 형식을 바꾸는 설정은 그 전에 완료된 프레임을 이전 설정으로 확정한 뒤 적용
+static int setFramesize(sensor_t* sensor, framesize_t framesize) {
+    if (framesize < 0 || framesize >= FRAMESIZE_INVALID) {
+        return -1;
+    }
+    std::lock_guard<std::mutex> lock(cameraMutex);
+    advanceFrames(esp_timer_get_time());
+    sensor->status.framesize = framesize;
+    return 0;
+}
+
+static int setQuality(sensor_t* sensor, int quality) {
+    if (quality < 0 || quality > 63) {
+        return -1;
+    }
+    std::lock_guard<std::mutex> lock(cameraMutex);
+    advanceFrames(esp_timer_get_time());
+    sensor->status.quality = (uint8_t)quality;
+    return 0;
+}
+
+static int setPixformat(sensor_t* sensor, pixformat_t pixformat) {
+    std::lock_guard<std::mutex> lock(cameraMutex);
+    advanceFrames(esp_timer_get_time());
+    sensor->pixformat = pixformat;
+    return 0;
+}
+
+static int getReg(sensor_t* sensor, int reg, int mask) {
+    (void)sensor;
+    std::lock_guard<std::mutex> lock(cameraMutex);
+    if (reg == REG_SYSTEM_CTROL0) {
+        return (standby ? SYSTEM_CTROL0_POWER_DOWN : 0) & mask;
+    }
+    return 0;
+}
+
+// 대기 모드 진입/해제만 반영 (다른 레지스터는 무시)
+static int setReg(sensor_t* sensor, int reg, int mask, int value) {
+    (void)sensor;
+    if (reg != REG_SYSTEM_CTROL0 || (mask & SYSTEM_CTROL0_POWER_DOWN) == 0) {
+        return 0;
+    }
+    bool enter = (value & SYSTEM_CTROL0_POWER_DOWN) != 0;
+    std::lock_guard<std::mutex> lock(cameraMutex);
+    int64_t nowUs = esp_timer_get_time();
+    if (enter && !standby) {
+        // 그때까지 완료된 프레임만 버퍼에 남고 노출 중이던 프레임은 버려짐
+        advanceFrames(nowUs);
+        standby = true;
+        standbyStartUs = nowUs;
+    } else if (!enter && standby) {
+        standby = false;
+        stats.standbyUs += nowUs - standbyStartUs;
+        stats.wakeUps++;
+        // 다음 프레임은 깨운 뒤 HOST_CAMERA_WAKE_MS가 지나야 노출을 시작 (프레임 번호는 이어서 사용)
+        timelineStartUs = nowUs + wakeDelayUs - (int64_t)nextFrameIndex * framePeriodUs;
+        convergedFromIndex = nextFrameIndex + aeFrames;
+        bufferReturned.notify_all();
+    }
+    return 0;
+}
+
+static int setXclk(sensor_t* sensor, int timer, int xclk) {
+    (void)timer;
+    sensor->xclk_freq_hz = xclk * 1000000;
+    return 0;
+}
+
+static int initStatus(sensor_t* sensor) {
+    (void)sensor;
+    return 0;
+}
+
+static int resetSensor(sensor_t* sensor) {
+    sensor->status.brightness = 0;
+    sensor->status.contrast = 0;
+    sensor->status.saturation = 0;
+    return 0;
+}
+
+static void setupSensor(const camera_config_t* config) {
+    cameraSensor = sensor_t();
+    cameraSensor.id.PID = OV3660_PID; // ESP32-S3-EYE 기본 센서
+    cameraSensor.slv_addr = 0x3C;
+    cameraSensor.pixformat = config->pixel_format;
+    cameraSensor.xclk_freq_hz = config->xclk_freq_hz;
+    cameraSensor.status.framesize = config->frame_size;
+    cameraSensor.status.quality = (uint8_t)config->jpeg_quality;
+
+    cameraSensor.init_status = initStatus;
+    cameraSensor.reset = resetSensor;
+    cameraSensor.set_pixformat = setPixformat;
+    cameraSensor.set_framesize = setFramesize;
+    cameraSensor.set_contrast = setContrast;
+    cameraSensor.set_brightness = setBrightness;
+    cameraSensor.set_saturation = setSaturation;
+    cameraSensor.set_sharpness = setSharpness;
+    cameraSensor.set_denoise = setDenoise;
+    cameraSensor.set_gainceiling = setGainceiling;
+    cameraSensor.set_quality = setQuality;
+    cameraSensor.set_colorbar = setColorbar;
+    cameraSensor.set_whitebal = setWhitebal;
+    cameraSensor.set_gain_ctrl = setGainCtrl;
+    cameraSensor.set_exposure_ctrl = setExposureCtrl;
+    cameraSensor.set_hmirror = setHmirror;
+    cameraSensor.set_vflip = setVflip;
+    cameraSensor.set_aec2 = setAec2;
+    cameraSensor.set_awb_gain = setAwbGain;
+    cameraSensor.set_agc_gain = setAgcGain;
+    cameraSensor.set_aec_value = setAecValue;
+    cameraSensor.set_special_effect = setSpecialEffect;
+    cameraSensor.set_wb_mode = setWbMode;
+    cameraSensor.set_ae_level = setAeLevel;
+    cameraSensor.set_dcw = setDcw;
+    cameraSensor.set_bpc = setBpc;
+    cameraSensor.set_wpc = setWpc;
+    cameraSensor.set_raw_gma = setRawGma;
+    cameraSensor.set_lenc = setLenc;
+    cameraSensor.get_reg = getReg;
+    cameraSensor.set_reg = setReg;
+    cameraSensor.set_xclk = setXclk;
+}
+
+// --- 프레임 원본 ---
+
+static bool loadFile(const std::string& path, SourceFile& file) {
+    FILE* handle = fopen(path.c_str(), "rb");
+    if (handle == nullptr) {
+        return false;
+    }
+    fseek(handle, 0, SEEK_END);
+    long size = ftell(handle);
+    fseek(handle, 0, SEEK_SET);
+    if (size > 0) {
+        file.data.resize((size_t)size);
+        file.data.resize(fread(file.data.data(), 1, file.data.size(), handle));
+    }
+    fclose(handle);
+    file.name = path;
+    return !file.data.empty();
+}
+
+static bool hasSuffix(const std::string& name, const char* suffix) {
+    size_t length = strlen(suffix);
+    return name.size() >= length && strcasecmp(name.c_str() + name.size() - length, suffix) == 0;
+}
+
+// HOST_CAMERA_DIR의 *.jpg/*.jpeg는 JPEG 형식, *.raw/*.rgb/*.yuv/*.gray는 그 외 형식 출력에 이름 순으로 반복 사용
+// HOST_CAMERA_JPEG 하나만 지정하면 그 파일을 계속 사용
+static void loadSourceFiles() {
+    jpegFiles.clear();
+    rawFiles.clear();
+    const char* single = hostEnv("HOST_CAMERA_JPEG", nullptr);
+    if (single != nullptr) {
+        SourceFile file;
+        if (loadFile(single, file)) {
+            jpegFiles.push_back(std::move(file));
+        } else {
+            fprintf(stderr, "[host] HOST_CAMERA_JPEG 파일을 열 수 없음: %s\n", single);
+        }
+    }
+    const char* directory = hostEnv("HOST_CAMERA_DIR", nullptr);
+    if (directory == nullptr) {
+        return;
+    }
+    DIR* dir = opendir(directory);
+    if (dir == nullptr) {
+        fprintf(stderr, "[host] HOST_CAMERA_DIR 디렉터리를 열 수 없음: %s\n", directory);
+        return;
+    }
+    std::vector<std::string> names;
+    while (struct dirent* entry = readdir(dir)) {
+        names.push_back(entry->d_name);
+    }
+    closedir(dir);
+    std::sort(names.begin(), names.end());
+    for (const std::string& name : names) {
+        bool jpeg = hasSuffix(name, ".jpg") || hasSuffix(name, ".jpeg");
+        bool raw = hasSuffix(name, ".raw") || hasSuffix(name, ".rgb") || hasSuffix(name, ".yuv") ||
+                   hasSuffix(name, ".gray");
+        SourceFile file;
+        if ((jpeg || raw) && loadFile(std::string(directory) + "/" + name, file)) {
+            (jpeg ? jpegFiles : rawFiles).push_back(std::move(file));
+        }
+    }
+    fprintf(stderr, "[host] 카메라 프레임 원본: JPEG %zu개, RAW %zu개 (%s)\n", jpegFiles.size(), rawFiles.size(),
+            directory);
+}
+
+// SOF 마커에서 실제 해상도를 읽음 (파일 프레임의 width/height 보고용)
+static bool readJpegDimension(const std::vector<uint8_t>& data, size_t& width, size_t& height) {
+    size_t i = 2;
+    while (i + 9 < data.size()) {
+        if (data[i] != 0xFF) {
+            return false;
+        }
+        uint8_t marker = data[i + 1];
+        size_t length = ((size_t)data[i + 2] << 8) | data[i + 3];
+        if (marker >= 0xC0 && marker <= 0xC3) {
+            height = ((size_t)data[i + 5] << 8) | data[i + 6];
+            width = ((size_t)data[i + 7] << 8) | data[i + 8];
+            return true;
+        }
+        i += 2 + length;
+    }
+    return false;
+}
+
+// 해상도와 품질에 따른 실제 JPEG 크기 근사 (품질 10 UXGA ≈ 190KB), 장면 변화로 ±20% 흔들림
+static size_t syntheticFrameLength(const resolution_info_t& dimension, uint8_t quality) {
+    double pixels = (double)dimension.width * dimension.height;
+    double length = pixels * 1.2 / ((double)quality + 2.0);
+    double variation = 0.8 + (double)random(0, 401) / 1000.0;
+    return std::max<size_t>(1024, (size_t)(length * variation));
+}
+
+// SOI + 임의 데이터(0xFF 제외) + EOI 형태의 JPEG 모양 버퍼
+static void fillSyntheticFrame(uint8_t* buffer, size_t length, uint64_t index) {
+    static const uint8_t HEADER[] = {0xFF, 0xD8, 0xFF, 0xE0, 0x00, 0x10, 'J', 'F', 'I', 'F', 0x00};
+    memcpy(buffer, HEADER, sizeof(HEADER));
+    uint32_t state = 0x9E3779B9u ^ (uint32_t)index;
+    for (size_t i = sizeof(HEADER); i < length - 2; i++) {
+        state = state * 1664525u + 1013904223u;
+        uint8_t value = (uint8_t)(state >> 24);
+        buffer[i] = value == 0xFF ? 0xFE : value;
+    }
+    buffer[length - 2] = 0xFF;
+    buffer[length - 1] = 0xD9;
+}
+
+// 픽셀당 바이트 수 x2 (YUV420의 1.5바이트 표현용)
+static size_t rawBytesTimesTwo(pixformat_t format) {
+    switch (format) {
+        case PIXFORMAT_GRAYSCALE:
+        case PIXFORMAT_RAW:
+            return 2;
+        case PIXFORMAT_YUV420:
+            return 3;
+        case PIXFORMAT_RGB888:
+            return 6;
+        default:
+            return 4;
+    }
+}
+
+static bool chance(uint32_t permille) {
+    return permille > 0 && (uint32_t)random(0, 1000) < permille;
+}
+
+// --- 버퍼 풀 ---
+
+static int64_t frameEndUs(uint64_t index) {
+    return timelineStartUs + (int64_t)(index + 1) * framePeriodUs;
+}
+
+// nowUs까지 완료된 프레임 수
+static uint64_t framesCompletedBy(int64_t nowUs) {
+    return nowUs <= timelineStartUs ? 0 : (uint64_t)((nowUs - timelineStartUs) / framePeriodUs);
+}
+
+// nowUs 이후에 노출을 시작하는 첫 프레임 번호
+static uint64_t firstFrameStartingAt(int64_t nowUs) {
+    if (nowUs <= timelineStartUs) {
+        return 0;
+    }
+    return (uint64_t)((nowUs - timelineStartUs + framePeriodUs - 1) / framePeriodUs);
+}
+
+// LATEST 대기열 길이: 드라이버가 하나는 계속 쓰고 있으므로 최근 fb_count-1장 (fb_count가 1이면 1장)
+static size_t latestQueueCapacity() {
+    if (framesOutstanding >= frameBufferCount) {
+        return 0;
+    }
+    size_t free = frameBufferCount - framesOutstanding;
+    return std::max<size_t>(1, free - 1);
+}
+
+static void captureFrame(uint64_t index) {
+    CapturedFrame frame = {index, frameEndUs(index), cameraSensor.status.framesize, cameraSensor.status.quality,
+                           cameraSensor.pixformat, index >= convergedFromIndex};
+    filledBuffers.push_back(frame);
+    stats.framesCaptured++;
+}
+
+// 마지막 반영 이후 nowUs까지 완료된 센서 프레임을 버퍼 풀에 반영 (cameraMutex 보유 상태에서 호출)
+static void advanceFrames(int64_t nowUs) {
+    if (!cameraInitialized || standby) {
+        return;
+    }
+    uint64_t completed = framesCompletedBy(nowUs);
+    if (completed <= nextFrameIndex) {
+        return;
+    }
+    if (grabMode == CAMERA_GRAB_LATEST) {
+        // 대기열보다 오래된 프레임은 어차피 덮어써지므로 한꺼번에 버림
+        size_t capacity = latestQueueCapacity();
+        uint64_t keepFrom = completed > capacity ? completed - capacity : 0;
+        if (keepFrom > nextFrameIndex) {
+            stats.framesDropped += keepFrom - nextFrameIndex;
+            nextFrameIndex = keepFrom;
+        }
+        for (; nextFrameIndex < completed; nextFrameIndex++) {
+            if (capacity == 0) {
+                stats.framesDropped++;
+                continue;
+            }
+            if (chance(dropPermille)) {
+                stats.framesDropped++;
+                stats.injectedDrops++;
+                continue;
+            }
+            captureFrame(nextFrameIndex);
+            while (filledBuffers.size() > capacity) {
+                filledBuffers.pop_front();
+                stats.framesDropped++;
+            }
+        }
+        return;
+    }
+    // WHEN_EMPTY: 빈 버퍼가 있는 동안만 캡처, 가득 찬 뒤의 프레임은 모두 버림
+    for (; nextFrameIndex < completed; nextFrameIndex++) {
+        if (filledBuffers.size() + framesOutstanding >= frameBufferCount) {
+            stats.framesDropped += completed - nextFrameIndex;
+            nextFrameIndex = completed;
+            break;
+        }
+        if (chance(dropPermille)) {
+            stats.framesDropped++;
+            stats.injectedDrops++;
+            continue;
+        }
+        captureFrame(nextFrameIndex);
+    }
+}
+
+static camera_fb_t* buildFrameBuffer(const CapturedFrame& frame) {
+    const resolution_info_t& dimension = resolution[frame.framesize];
+    camera_fb_t* fb = new camera_fb_t();
+    fb->width = dimension.width;
+    fb->height = dimension.height;
+    fb->format = frame.pixformat;
+
+    const std::vector<SourceFile>& sources = frame.pixformat == PIXFORMAT_JPEG ? jpegFiles : rawFiles;
+    if (!sources.empty()) {
+        const SourceFile& source = sources[frame.index % sources.size()];
+        fb->len = source.data.size();
+        fb->buf = (uint8_t*)malloc(fb->len);
+        memcpy(fb->buf, source.data.data(), fb->len);
+        if (frame.pixformat == PIXFORMAT_JPEG) {
+            readJpegDimension(source.data, fb->width, fb->height);
+        }
+    } else if (frame.pixformat == PIXFORMAT_JPEG) {
+        fb->len = syntheticFrameLength(dimension, frame.quality);
+        fb->buf = (uint8_t*)malloc(fb->len);
+        fillSyntheticFrame(fb->buf, fb->len, frame.index);
+    } else {
+        // 프레임 번호만큼 밀린 가로 그라데이션
+        fb->len = (size_t)dimension.width * dimension.height * rawBytesTimesTwo(frame.pixformat) / 2;
+        fb->buf = (uint8_t*)malloc(fb->len);
+        for (size_t i = 0; i < fb->len; i++) {
+            fb->buf[i] = (uint8_t)(i + frame.index);
+        }
+    }
+
+    // 장애 주입: EOI 없이 잘린 JPEG (버퍼 넘침 프레임 흉내)
+    if (frame.pixformat == PIXFORMAT_JPEG && fb->len > 4 && chance(corruptPermille)) {
+        fb->len = fb->len * 3 / 4;
+        stats.injectedCorrupt++;
+    }
+
+    // 캡처 완료 시각을 벽시계로 환산
+    struct timeval now;
+    gettimeofday(&now, nullptr);
+    int64_t ageUs = esp_timer_get_time() - frame.endUs;
+    int64_t stampUs = (int64_t)now.tv_sec * 1000000 + now.tv_usec - ageUs;
+    fb->timestamp.tv_sec = (time_t)(stampUs / 1000000);
+    fb->timestamp.tv_usec = (suseconds_t)(stampUs % 1000000);
+    return fb;
+}
+
+esp_err_t esp_camera_init(const camera_config_t* config) {
+    std::lock_guard<std::mutex> lock(cameraMutex);
+    if (config == nullptr || config->frame_size >= FRAMESIZE_INVALID) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (cameraInitialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (hostEnvU32("HOST_CAMERA_FAIL_INIT", 0) != 0) {
+        return ESP_FAIL;
+    }
+    setupSensor(config);
+    grabMode = config->grab_mode;
+    frameBufferCount = config->fb_count > 0 ? (size_t)config->fb_count : 1;
+    framesOutstanding = 0;
+    filledBuffers.clear();
+    nextFrameIndex = 0;
+
+    // HOST_CAMERA_FPS가 있으면 우선, 없으면 HOST_CAMERA_FRAME_MS 주기
+    uint32_t fps = hostEnvU32("HOST_CAMERA_FPS", 0);
+    framePeriodUs = fps > 0 ? 1000000 / fps : (int64_t)std::max<uint32_t>(1, hostEnvU32("HOST_CAMERA_FRAME_MS", 60)) * 1000;
+    fbTimeoutMs = hostEnvU32("HOST_CAMERA_FB_TIMEOUT_MS", DEFAULT_FB_TIMEOUT_MS);
+    wakeDelayUs = (int64_t)hostEnvU32("HOST_CAMERA_WAKE_MS", 50) * 1000;
+    aeFrames = hostEnvU32("HOST_CAMERA_AE_FRAMES", 12);
+    dropPermille = hostEnvU32("HOST_CAMERA_DROP_PERMILLE", 0);
+    failPermille = hostEnvU32("HOST_CAMERA_FAIL_PERMILLE", 0);
+    corruptPermille = hostEnvU32("HOST_CAMERA_CORRUPT_PERMILLE", 0);
+    loadSourceFiles();
+
+    timelineStartUs = esp_timer_get_time();
+    initializedAtUs = timelineStartUs;
+    standby = false;
+    convergedFromIndex = aeFrames;
+    cameraInitialized = true;
+    return ESP_OK;
+}
+
+esp_err_t esp_camera_deinit() {
+    std::lock_guard<std::mutex> lock(cameraMutex);
+    if (!cameraInitialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    cameraInitialized = false;
+    filledBuffers.clear();
+    bufferReturned.notify_all();
+    return ESP_OK;
+}
+
+camera_fb_t* esp_camera_fb_get() {
+    std::unique_lock<std::mutex> lock(cameraMutex);
+    if (!cameraInitialized) {
+        return nullptr;
+    }
+    int64_t startUs = esp_timer_get_time();
+    int64_t deadlineUs = startUs + (int64_t)fbTimeoutMs * 1000;
+    stats.fbGetCalls++;
+
+    // 장애 주입: 센서가 멈춘 것처럼 대기 한도까지 기다린 뒤 NULL
+    bool stalled = chance(failPermille);
+    bool exhaustedCounted = false;
+    CapturedFrame frame;
+    while (true) {
+        int64_t nowUs = esp_timer_get_time();
+        advanceFrames(nowUs);
+        if (!stalled && !filledBuffers.empty()) {
+            frame = filledBuffers.front();
+            filledBuffers.pop_front();
+            break;
+        }
+        if (nowUs >= deadlineUs || !cameraInitialized) {
+            stats.fbGetTimeouts++;
+            return nullptr;
+        }
+        if (!stalled && framesOutstanding >= frameBufferCount) {
+            // 모든 버퍼가 호출자에게 있음: 반환될 때까지 대기 (실제 드라이버와 같이 한도 후 NULL)
+            if (!exhaustedCounted) {
+                stats.poolExhausted++;
+                exhaustedCounted = true;
+            }
+            bufferReturned.wait_for(lock, std::chrono::microseconds(deadlineUs - nowUs));
+            continue;
+        }
+        // 대기 모드면 깨울 때까지(notify) 또는 대기 한도까지 기다림
+        int64_t wakeUs = stalled || standby ? deadlineUs : std::min(deadlineUs, frameEndUs(nextFrameIndex));
+        bufferReturned.wait_for(lock, std::chrono::microseconds(std::max<int64_t>(wakeUs - nowUs, 1)));
+    }
+    framesOutstanding++;
+    int64_t returnedUs = esp_timer_get_time();
+    stats.framesDelivered++;
+    if (!frame.converged) {
+        stats.unconvergedDelivered++;
+    }
+    stats.waitUs.push_back((uint32_t)(returnedUs - startUs));
+    stats.ageUs.push_back((uint32_t)(returnedUs - frame.endUs));
+    camera_fb_t* fb = buildFrameBuffer(frame);
+    stats.bytesDelivered += fb->len;
+    return fb;
+}
+
+void esp_camera_fb_return(camera_fb_t* fb) {
+    if (fb == nullptr) {
+        return;
+    }
+    free(fb->buf);
+    delete fb;
+    std::lock_guard<std::mutex> lock(cameraMutex);
+    int64_t nowUs = esp_timer_get_time();
+    advanceFrames(nowUs);
+    bool poolWasFull = filledBuffers.size() + framesOutstanding >= frameBufferCount;
+    if (framesOutstanding > 0) {
+        framesOutstanding--;
+    }
+    if (grabMode == CAMERA_GRAB_WHEN_EMPTY && poolWasFull) {
+        // 반환된 버퍼에는 지금 이후 시작하는 프레임부터 기록됨 (진행 중이던 프레임은 버림)
+        uint64_t nextStart = firstFrameStartingAt(nowUs);
+        if (nextStart > nextFrameIndex) {
+            stats.framesDropped += nextStart - nextFrameIndex;
+            nextFrameIndex = nextStart;
+        }
+    }
+    bufferReturned.notify_all();
+}
+
+sensor_t* esp_camera_sensor_get() {
+    std::lock_guard<std::mutex> lock(cameraMutex);
+    return cameraInitialized ? &cameraSensor : nullptr;
+}
+
+// --- 벤치마크 집계 ---
+
+static uint32_t percentileOf(std::vector<uint32_t> samples, double percentile) {
+    if (samples.empty()) {
+        return 0;
+    }
+    std::sort(samples.begin(), samples.end());
+    size_t rank = (size_t)(percentile / 100.0 * (double)(samples.size() - 1) + 0.5);
+    return samples[rank];
+}
+
+void hostCameraReport() {
+    std::lock_guard<std::mutex> lock(cameraMutex);
+    printf("[host] 카메라: 모드 %s, 버퍼 %zu개, 프레임 주기 %.1f ms\n",
+           grabMode == CAMERA_GRAB_LATEST ? "LATEST" : "WHEN_EMPTY", frameBufferCount, framePeriodUs / 1000.0);
+    printf("[host]   센서 프레임 캡처 %llu, 버림 %llu (주입 %llu), 전달 %llu (%.1f MB), 손상 주입 %llu\n",
+           (unsigned long long)stats.framesCaptured, (unsigned long long)stats.framesDropped,
+           (unsigned long long)stats.injectedDrops, (unsigned long long)stats.framesDelivered,
+           stats.bytesDelivered / 1048576.0, (unsigned long long)stats.injectedCorrupt);
+    printf("[host]   fb_get %llu회, NULL %llu회, 버퍼 고갈 대기 %llu회\n", (unsigned long long)stats.fbGetCalls,
+           (unsigned long long)stats.fbGetTimeouts, (unsigned long long)stats.poolExhausted);
+    printf("[host]   fb_get 대기 p50/p95/max %.1f/%.1f/%.1f ms, 프레임 나이 p50/p95/max %.1f/%.1f/%.1f ms\n",
+           percentileOf(stats.waitUs, 50) / 1000.0, percentileOf(stats.waitUs, 95) / 1000.0,
+           percentileOf(stats.waitUs, 100) / 1000.0, percentileOf(stats.ageUs, 50) / 1000.0,
+           percentileOf(stats.ageUs, 95) / 1000.0, percentileOf(stats.ageUs, 100) / 1000.0);
+    int64_t standbyUs = stats.standbyUs + (standby ? esp_timer_get_time() - standbyStartUs : 0);
+    int64_t totalUs = esp_timer_get_time() - initializedAtUs;
+    printf("[host]   대기 모드 %.1f초 (%.0f%%), 깨움 %llu회, 노출 미수렴 프레임 전달 %llu회\n", standbyUs / 1e6,
+           totalUs > 0 ? standbyUs * 100.0 / totalUs : 0.0, (unsigned long long)stats.wakeUps,
+           (unsigned long long)stats.unconvergedDelivered);
+}
@@ -0,0 +1,298 @@
+#include <Arduino.h>
+#include <esp_system.h>
+#include <esp_heap_caps.h>
+#include <esp_rom_crc.h>
+#include <esp_partition.h>
+#include <esp_bt.h>
+#include <esp_gap_ble_api.h>
+#include <mutex>
+#include <vector>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "host_runtime.h"
+
+// --- MAC ---
+
+esp_err_t esp_read_mac(uint8_t* mac, esp_mac_type_t type) {
+    if (mac == nullptr) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    unsigned parts[6];
+    const char* configured = hostEnv("HOST_MAC", nullptr);
+    if (configured != nullptr && sscanf(configured, "%x:%x:%x:%x:%x:%x", &parts[0], &parts[1], &parts[2],
+                                        &parts[3], &parts[4], &parts[5]) == 6) {
+        for (int i = 0; i < 6; i++) {
+            mac[i] = (uint8_t)parts[i];
+        }
+    } else {
+        // 호스트 이름의 FNV-1a 해시로 재실행해도 같은 장치 ID를 만듦 (Espressif OUI 사용)
+        char hostname[64] = "host";
+        gethostname(hostname, sizeof(hostname) - 1);
+        uint32_t hash = 2166136261u;
+        for (const char* c = hostname; *c != '\0'; c++) {
+            hash = (hash ^ (uint8_t)*c) * 16777619u;
+        }
+        mac[0] = 0x7C;
+        mac[1] = 0xDF;
+        mac[2] = 0xA1;
+        mac[3] = (uint8_t)(hash >> 16);
+        mac[4] = (uint8_t)(hash >> 8);
+        mac[5] = (uint8_t)hash;
+    }
+    // ESP32와 같이 파생 주소는 기본(STA) 주소의 마지막 바이트에 더함
+    static const uint8_t OFFSETS[] = {0, 1, 2, 3};
+    mac[5] = (uint8_t)(mac[5] + OFFSETS[type]);
+    return ESP_OK;
+}
+
+// --- 힙 ---
+
+// ESP32-S3 + 8MB PSRAM 장치에서 관측되는 값과 비슷한 고정 보고 값
+static const size_t INTERNAL_TOTAL = 320 * 1024;
+static const size_t INTERNAL_FREE = 180 * 1024;
+static const size_t INTERNAL_LARGEST = 110 * 1024;
+static const size_t SPIRAM_TOTAL = 8 * 1024 * 1024;
+static const size_t SPIRAM_FREE = 8 * 1024 * 1024 - 400 * 1024;
+
+size_t heap_caps_get_total_size(uint32_t caps) {
+    return (caps & MALLOC_CAP_SPIRAM) ? SPIRAM_TOTAL : INTERNAL_TOTAL;
+}
+
+size_t heap_caps_get_free_size(uint32_t caps) {
+    return (caps & MALLOC_CAP_SPIRAM) ? SPIRAM_FREE : INTERNAL_FREE;
+}
+
+size_t heap_caps_get_minimum_free_size(uint32_t caps) {
+    return heap_caps_get_free_size(caps) * 9 / 10;
+}
+
+size_t heap_caps_get_largest_free_block(uint32_t caps) {
+    return (caps & MALLOC_CAP_SPIRAM) ? SPIRAM_FREE - 64 * 1024 : INTERNAL_LARGEST;
+}
+
+void* heap_caps_malloc(size_t size, uint32_t caps) {
+    (void)caps;
+    return malloc(size);
+}
+
+void heap_caps_free(void* pointer) {
+    free(pointer);
+}
+
+// --- CRC ---
+
+uint32_t esp_rom_crc32_le(uint32_t crc, const uint8_t* buffer, uint32_t length) {
+    crc = ~crc;
+    while (length-- > 0) {
+        crc ^= *buffer++;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+    }
+    return ~crc;
+}
+
+// --- 파티션 ---
+
+struct HostPartition {
+    esp_partition_t info;
+    FILE* file;
+    std::vector<uint32_t> sectorErases;
+};
+
+static std::vector<HostPartition> partitions;
+static std::mutex partitionMutex;
+static bool partitionsLoaded = false;
+static HostFlashStats flashStats = {};
+
+HostFlashStats hostFlashStats() {
+    std::lock_guard<std::mutex> lock(partitionMutex);
+    return flashStats;
+}
+
+static bool parseSubtype(const char* text, esp_partition_type_t type, esp_partition_subtype_t& subtype) {
+    if (type == ESP_PARTITION_TYPE_APP) {
+        subtype = ESP_PARTITION_SUBTYPE_APP_FACTORY;
+        return true;
+    }
+    if (strcmp(text, "nvs") == 0) {
+        subtype = ESP_PARTITION_SUBTYPE_DATA_NVS;
+    } else if (strcmp(text, "ota") == 0) {
+        subtype = ESP_PARTITION_SUBTYPE_DATA_OTA;
+    } else if (strcmp(text, "spiffs") == 0) {
+        subtype = ESP_PARTITION_SUBTYPE_DATA_SPIFFS;
+    } else {
+        subtype = (esp_partition_subtype_t)strtoul(text, nullptr, 0);
+    }
+    return true;
+}
+
+// 실행 디렉터리의 partitions.csv (HOST_PARTITIONS로 변경 가능)를 읽음
+static void loadPartitionTable() {
+    partitionsLoaded = true;
+    FILE* table = fopen(hostEnv("HOST_PARTITIONS", "partitions.csv"), "r");
+    if (table == nullptr) {
+        fprintf(stderr, "[host] partitions.csv 없음, 파티션 없이 실행\n");
+        return;
+    }
+    char line[256];
+    while (fgets(line, sizeof(line), table) != nullptr) {
+        char name[17], typeText[16], subtypeText[16];
+        char offsetText[16], sizeText[16];
+        for (char* c = line; *c != '\0'; c++) {
+            if (*c == ',') {
+                *c = ' ';
+            }
+        }
+        if (line[0] == '#' ||
+            sscanf(line, "%16s %15s %15s %15s %15s", name, typeText, subtypeText, offsetText, sizeText) != 5) {
+            continue;
+        }
+        HostPartition partition = {};
+        partition.info.type = strcmp(typeText, "app") == 0 ? ESP_PARTITION_TYPE_APP : ESP_PARTITION_TYPE_DATA;
+        parseSubtype(subtypeText, partition.info.type, partition.info.subtype);
+        partition.info.address = (uint32_t)strtoul(offsetText, nullptr, 0);
+        partition.info.size = (uint32_t)strtoul(sizeText, nullptr, 0);
+        partition.info.erase_size = SPI_FLASH_SEC_SIZE;
+        partition.sectorErases.assign(partition.info.size / SPI_FLASH_SEC_SIZE, 0);
+        strlcpy(partition.info.label, name, sizeof(partition.info.label));
+        partitions.push_back(partition);
+    }
+    fclose(table);
+}
+
+// 파티션 내용 파일을 열고, 없으면 지운 플래시(0xFF)로 만듦
+static FILE* openBacking(HostPartition& partition) {
+    if (partition.file != nullptr) {
+        return partition.file;
+    }
+    String path = hostStatePath(partition.info.label) + ".bin";
+    partition.file = fopen(path.c_str(), "r+b");
+    if (partition.file != nullptr) {
+        return partition.file;
+    }
+    partition.file = fopen(path.c_str(), "w+b");
+    if (partition.file == nullptr) {
+        return nullptr;
+    }
+    std::vector<uint8_t> erased(SPI_FLASH_SEC_SIZE, 0xFF);
+    for (uint32_t offset = 0; offset < partition.info.size; offset += SPI_FLASH_SEC_SIZE) {
+        fwrite(erased.data(), 1, erased.size(), partition.file);
+    }
+    fflush(partition.file);
+    return partition.file;
+}
+
+static HostPartition* findBacking(const esp_partition_t* info) {
+    for (HostPartition& partition : partitions) {
+        if (&partition.info == info) {
+            return openBacking(partition) != nullptr ? &partition : nullptr;
+        }
+    }
+    return nullptr;
+}
+
+const esp_partition_t* esp_partition_find_first(esp_partition_type_t type, esp_partition_subtype_t subtype,
+                                                const char* label) {
+    std::lock_guard<std::mutex> lock(partitionMutex);
+    if (!partitionsLoaded) {
+        loadPartitionTable();
+    }
+    for (HostPartition& partition : partitions) {
+        if ((type == ESP_PARTITION_TYPE_ANY || partition.info.type == type) &&
+            (subtype == ESP_PARTITION_SUBTYPE_ANY || partition.info.subtype == subtype) &&
+            (label == nullptr || strcmp(partition.info.label, label) == 0)) {
+            return &partition.info;
+        }
+    }
+    return nullptr;
+}
+
+esp_err_t esp_partition_read(const esp_partition_t* partition, size_t offset, void* destination, size_t size) {
+    std::lock_guard<std::mutex> lock(partitionMutex);
+    HostPartition* backing = findBacking(partition);
+    if (backing == nullptr || destination == nullptr) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (offset > partition->size || size > partition->size - offset) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    flashStats.reads++;
+    flashStats.bytesRead += size;
+    fseek(backing->file, (long)offset, SEEK_SET);
+    return fread(destination, 1, size, backing->file) == size ? ESP_OK : ESP_FAIL;
+}
+
+esp_err_t esp_partition_write(const esp_partition_t* partition, size_t offset, const void* source, size_t size) {
+    std::lock_guard<std::mutex> lock(partitionMutex);
+    HostPartition* backing = findBacking(partition);
+    if (backing == nullptr || source == nullptr) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (offset > partition->size || size > partition->size - offset) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    flashStats.writes++;
+    flashStats.bytesWritten += size;
+    // NOR 플래시는 지우지 않고 쓰면 1 → 0 비트만 바뀜
+    std::vector<uint8_t> current(size);
+    fseek(backing->file, (long)offset, SEEK_SET);
+    if (fread(current.data(), 1, size, backing->file) != size) {
+        return ESP_FAIL;
+    }
+    const uint8_t* bytes = (const uint8_t*)source;
+    for (size_t i = 0; i < size; i++) {
+        current[i] &= bytes[i];
+    }
+    fseek(backing->file, (long)offset, SEEK_SET);
+    bool ok = fwrite(current.data(), 1, size, backing->file) == size;
+    fflush(backing->file);
+    return ok ? ESP_OK : ESP_FAIL;
+}
+
+esp_err_t esp_partition_erase_range(const esp_partition_t* partition, size_t offset, size_t size) {
+    std::lock_guard<std::mutex> lock(partitionMutex);
+    HostPartition* backing = findBacking(partition);
+    if (backing == nullptr) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (offset % SPI_FLASH_SEC_SIZE != 0 || size % SPI_FLASH_SEC_SIZE != 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (offset > partition->size || size > partition->size - offset) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    for (size_t sector = offset / SPI_FLASH_SEC_SIZE; sector < (offset + size) / SPI_FLASH_SEC_SIZE; sector++) {
+        flashStats.sectorErases++;
+        flashStats.maxSectorErases = max(flashStats.maxSectorErases, ++backing->sectorErases[sector]);
+    }
+    std::vector<uint8_t> erased(size, 0xFF);
+    fseek(backing->file, (long)offset, SEEK_SET);
+    bool ok = fwrite(erased.data(), 1, size, backing->file) == size;
+    fflush(backing->file);
+    return ok ? ESP_OK : ESP_FAIL;
+}
+
+// --- BT 컨트롤러 / GAP ---
+
+static esp_bt_controller_status_t controllerStatus = ESP_BT_CONTROLLER_STATUS_IDLE;
+
+esp_err_t esp_bt_controller_mem_release(esp_bt_mode_t mode) {
+    (void)mode;
+    return ESP_OK;
+}
+
+esp_err_t esp_bt_mem_release(esp_bt_mode_t mode) {
+    (void)mode;
+    return ESP_OK;
+}
+
+esp_bt_controller_status_t esp_bt_controller_get_status() {
+    return controllerStatus;
+}
+
+esp_err_t esp_ble_gap_update_conn_params(esp_ble_conn_update_params_t* params) {
+    return params != nullptr ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
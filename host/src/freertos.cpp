@@ -0,0 +1,363 @@
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <freertos/event_groups.h>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <stdio.h>
+#include <string.h>
+#include <esp_timer.h>
+
+struct HostTask {
+    HostTask(const char* name, uint32_t stackDepth) : name(name), stackDepth(stackDepth) {}
+
+    std::string name;
+    uint32_t stackDepth;
+    std::mutex mutex;
+    std::condition_variable notified;
+    uint32_t notifyCount = 0;
+};
+
+struct HostQueue {
+    std::mutex mutex;
+    std::condition_variable notEmpty;
+    std::condition_variable notFull;
+    UBaseType_t length;
+    UBaseType_t itemSize;
+    UBaseType_t count = 0;
+    UBaseType_t head = 0;
+    std::vector<uint8_t> storage;
+};
+
+struct HostEventGroup {
+    std::mutex mutex;
+    std::condition_variable changed;
+    EventBits_t bits = 0;
+};
+
+// vTaskDelete(nullptr)로 태스크 스레드를 끝내기 위한 예외 (태스크 래퍼에서만 잡음)
+struct HostTaskExit {};
+
+static std::recursive_mutex criticalMutex;
+static thread_local HostTask* currentTask = nullptr;
+
+static HostTask* taskOfCurrentThread() {
+    if (currentTask == nullptr) {
+        // Arduino 코어와 같이 태스크로 만들지 않은 스레드(main)는 loopTask로 취급
+        currentTask = new HostTask("loopTask", 8192);
+    }
+    return currentTask;
+}
+
+// 틱 대기를 condition_variable 대기로 변환 (portMAX_DELAY는 무한 대기)
+template <typename Lock, typename Predicate>
+static bool waitTicks(std::condition_variable& condition, Lock& lock, TickType_t ticks, Predicate ready) {
+    if (ticks == portMAX_DELAY) {
+        condition.wait(lock, ready);
+        return true;
+    }
+    return condition.wait_for(lock, std::chrono::milliseconds(ticks), ready);
+}
+
+// --- 임계 구역 ---
+
+void vPortEnterCritical(portMUX_TYPE* mux) {
+    (void)mux;
+    criticalMutex.lock();
+}
+
+void vPortExitCritical(portMUX_TYPE* mux) {
+    (void)mux;
+    criticalMutex.unlock();
+}
+
+// --- 태스크 ---
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char* name, uint32_t stackDepth, void* parameter,
+                                   UBaseType_t priority, TaskHandle_t* createdTask, BaseType_t coreId) {
+    (void)priority;
+    (void)coreId;
+    HostTask* task = new HostTask(name != nullptr ? name : "task", stackDepth);
+    try {
+        std::thread([task, function, parameter]() {
+            currentTask = task;
+            try {
+                function(parameter);
+                // FreeRTOS에서는 태스크 함수가 반환하면 안 됨
+                fprintf(stderr, "[host] 태스크 %s가 vTaskDelete 없이 반환됨\n", task->name.c_str());
+            } catch (const HostTaskExit&) {
+            }
+        }).detach();
+    } catch (const std::system_error&) {
+        delete task;
+        return pdFAIL;
+    }
+    if (createdTask != nullptr) {
+        *createdTask = task;
+    }
+    return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t function, const char* name, uint32_t stackDepth, void* parameter,
+                       UBaseType_t priority, TaskHandle_t* createdTask) {
+    return xTaskCreatePinnedToCore(function, name, stackDepth, parameter, priority, createdTask, tskNO_AFFINITY);
+}
+
+void vTaskDelete(TaskHandle_t task) {
+    if (task == nullptr || task == currentTask) {
+        throw HostTaskExit();
+    }
+    // 다른 스레드는 강제로 끝낼 수 없음 (이 저장소는 자기 자신만 삭제함)
+    fprintf(stderr, "[host] 다른 태스크(%s) 삭제는 지원하지 않음\n", task->name.c_str());
+}
+
+void vTaskDelay(TickType_t ticks) {
+    if (ticks == 0) {
+        std::this_thread::yield();
+        return;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(ticks));
+}
+
+void vTaskDelayUntil(TickType_t* previousWakeTime, TickType_t increment) {
+    TickType_t wakeTime = *previousWakeTime + increment;
+    TickType_t now = xTaskGetTickCount();
+    if ((int32_t)(wakeTime - now) > 0) {
+        vTaskDelay(wakeTime - now);
+    }
+    *previousWakeTime = wakeTime;
+}
+
+TickType_t xTaskGetTickCount() {
+    return (TickType_t)(esp_timer_get_time() / 1000);
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+    return taskOfCurrentThread();
+}
+
+const char* pcTaskGetName(TaskHandle_t task) {
+    return (task != nullptr ? task : taskOfCurrentThread())->name.c_str();
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task) {
+    // 호스트 스택은 충분히 크므로 할당한 크기의 절반을 여유로 보고
+    return (task != nullptr ? task : taskOfCurrentThread())->stackDepth / 2;
+}
+
+BaseType_t xPortGetCoreID() {
+    return 1;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+    {
+        std::lock_guard<std::mutex> lock(task->mutex);
+        task->notifyCount++;
+    }
+    task->notified.notify_one();
+    return pdPASS;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearCountOnExit, TickType_t ticksToWait) {
+    HostTask* task = taskOfCurrentThread();
+    std::unique_lock<std::mutex> lock(task->mutex);
+    waitTicks(task->notified, lock, ticksToWait, [task]() { return task->notifyCount > 0; });
+    uint32_t count = task->notifyCount;
+    if (count > 0) {
+        task->notifyCount = clearCountOnExit ? 0 : count - 1;
+    }
+    return count;
+}
+
+// --- 큐 ---
+
+static HostQueue* createQueue(UBaseType_t length, UBaseType_t itemSize, UBaseType_t initialCount) {
+    HostQueue* queue = new HostQueue();
+    queue->length = length;
+    queue->itemSize = itemSize;
+    queue->count = initialCount;
+    queue->storage.resize((size_t)length * itemSize);
+    return queue;
+}
+
+static BaseType_t queueSend(QueueHandle_t queue, const void* item, TickType_t ticksToWait, bool toFront) {
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    if (!waitTicks(queue->notFull, lock, ticksToWait, [queue]() { return queue->count < queue->length; })) {
+        return errQUEUE_FULL;
+    }
+    if (queue->itemSize > 0) {
+        UBaseType_t slot;
+        if (toFront) {
+            queue->head = (queue->head + queue->length - 1) % queue->length;
+            slot = queue->head;
+        } else {
+            slot = (queue->head + queue->count) % queue->length;
+        }
+        memcpy(&queue->storage[(size_t)slot * queue->itemSize], item, queue->itemSize);
+    }
+    queue->count++;
+    lock.unlock();
+    queue->notEmpty.notify_one();
+    return pdPASS;
+}
+
+static BaseType_t queueReceive(QueueHandle_t queue, void* item, TickType_t ticksToWait, bool remove) {
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    if (!waitTicks(queue->notEmpty, lock, ticksToWait, [queue]() { return queue->count > 0; })) {
+        return errQUEUE_EMPTY;
+    }
+    if (queue->itemSize > 0 && item != nullptr) {
+        memcpy(item, &queue->storage[(size_t)queue->head * queue->itemSize], queue->itemSize);
+    }
+    if (!remove) {
+        return pdPASS;
+    }
+    if (queue->itemSize > 0) {
+        queue->head = (queue->head + 1) % queue->length;
+    }
+    queue->count--;
+    lock.unlock();
+    queue->notFull.notify_one();
+    return pdPASS;
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize) {
+    return length > 0 ? createQueue(length, itemSize, 0) : nullptr;
+}
+
+void vQueueDelete(QueueHandle_t queue) {
+    delete queue;
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticksToWait) {
+    return queueSend(queue, item, ticksToWait, false);
+}
+
+BaseType_t xQueueSendToBack(QueueHandle_t queue, const void* item, TickType_t ticksToWait) {
+    return queueSend(queue, item, ticksToWait, false);
+}
+
+BaseType_t xQueueSendToFront(QueueHandle_t queue, const void* item, TickType_t ticksToWait) {
+    return queueSend(queue, item, ticksToWait, true);
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t queue, const void* item, BaseType_t* higherPriorityTaskWoken) {
+    if (higherPriorityTaskWoken != nullptr) {
+        *higherPriorityTaskWoken = pdFALSE;
+    }
+    return queueSend(queue, item, 0, false);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t ticksToWait) {
+    return queueReceive(queue, item, ticksToWait, true);
+}
+
+BaseType_t xQueuePeek(QueueHandle_t queue, void* item, TickType_t ticksToWait) {
+    return queueReceive(queue, item, ticksToWait, false);
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue) {
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    return queue->count;
+}
+
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t queue) {
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    return queue->length - queue->count;
+}
+
+BaseType_t xQueueReset(QueueHandle_t queue) {
+    {
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        queue->count = 0;
+        queue->head = 0;
+    }
+    queue->notFull.notify_all();
+    return pdPASS;
+}
+
+// --- 세마포어 ---
+
+SemaphoreHandle_t xSemaphoreCreateMutex() {
+    return createQueue(1, 0, 1);
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary() {
+    return createQueue(1, 0, 0);
+}
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t maxCount, UBaseType_t initialCount) {
+    return maxCount > 0 && initialCount <= maxCount ? createQueue(maxCount, 0, initialCount) : nullptr;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticksToWait) {
+    return queueReceive(semaphore, nullptr, ticksToWait, true);
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) {
+    return queueSend(semaphore, nullptr, 0, false);
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t semaphore, BaseType_t* higherPriorityTaskWoken) {
+    return xQueueSendFromISR(semaphore, nullptr, higherPriorityTaskWoken);
+}
+
+UBaseType_t uxSemaphoreGetCount(SemaphoreHandle_t semaphore) {
+    return uxQueueMessagesWaiting(semaphore);
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t semaphore) {
+    delete semaphore;
+}
+
+// --- 이벤트 그룹 ---
+
+EventGroupHandle_t xEventGroupCreate() {
+    return new HostEventGroup();
+}
+
+void vEventGroupDelete(EventGroupHandle_t group) {
+    delete group;
+}
+
+EventBits_t xEventGroupSetBits(EventGroupHandle_t group, EventBits_t bits) {
+    EventBits_t result;
+    {
+        std::lock_guard<std::mutex> lock(group->mutex);
+        group->bits |= bits;
+        result = group->bits;
+    }
+    group->changed.notify_all();
+    return result;
+}
+
+EventBits_t xEventGroupClearBits(EventGroupHandle_t group, EventBits_t bits) {
+    std::lock_guard<std::mutex> lock(group->mutex);
+    EventBits_t previous = group->bits;
+    group->bits &= ~bits;
+    return previous;
+}
+
+EventBits_t xEventGroupGetBits(EventGroupHandle_t group) {
+    std::lock_guard<std::mutex> lock(group->mutex);
+    return group->bits;
+}
+
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t group, EventBits_t bits, BaseType_t clearOnExit,
+                                BaseType_t waitForAllBits, TickType_t ticksToWait) {
+    std::unique_lock<std::mutex> lock(group->mutex);
+    auto satisfied = [group, bits, waitForAllBits]() {
+        return waitForAllBits ? (group->bits & bits) == bits : (group->bits & bits) != 0;
+    };
+    bool ready = waitTicks(group->changed, lock, ticksToWait, satisfied);
+    EventBits_t result = group->bits;
+    if (ready && clearOnExit) {
+        group->bits &= ~bits;
+    }
+    return result;
+}
@@ -0,0 +1,127 @@
+#include <Arduino.h>
+#include <Preferences.h>
+#include <algorithm>
+#include <vector>
+#include "host_runtime.h"
+#include "uplink_shaper.h"
+#include "camera_power.h"
+
+// 단위 테스트(pio test -e native)는 테스트 파일이 main()을 정의하므로 이 파일의 실행 진입점은 빼고 빌드
+#ifndef PIO_UNIT_TESTING
+
+// Arduino 코어의 app_main/loopTask 대체: setup()을 한 번, loop()를 계속 호출
+void setup();
+void loop();
+
+// 촬영 벤치마크 대상 (camera_handler.h)
+void triggerCameraCapture(const String& uploadUrl, uint32_t targetBytes);
+void testCameraCapture();
+void requestLocalCapture(const char* reason);
+void handleLocalCapture();
+void flushLogs();
+
+// BLE 프로비저닝 대신 환경 변수로 받은 Wi-Fi 정보(와 업로드 경로)를 설정 저장소에 미리 기록
+// 키 이름은 config_store.cpp의 CONFIG_ENTRIES와 같아야 함
+static void seedWifiCredentials() {
+    const char* ssid = hostEnv("HOST_WIFI_SSID", nullptr);
+    if (ssid == nullptr) {
+        return;
+    }
+    Preferences prefs;
+    if (!prefs.begin("config", false)) {
+        return;
+    }
+    if (prefs.getString("wifi_ssid") != ssid) {
+        prefs.putString("wifi_ssid", ssid);
+        prefs.putString("wifi_pass", hostEnv("HOST_WIFI_PASS", ""));
+    }
+    // HOST_UPLOAD_TRANSPORT=0/1: upload_transport (HTTPS/MQTT 청크 전송), 지정하지 않으면 저장된 값 유지
+    const char* transport = hostEnv("HOST_UPLOAD_TRANSPORT", nullptr);
+    if (transport != nullptr) {
+        prefs.putUInt("cam_upload_via", (uint32_t)atoi(transport));
+    }
+    prefs.end();
+}
+
+// HOST_BENCH_CAPTURES=N: 워밍업 후 메인 루프 자리에서 촬영을 N번 연속 실행하고 집계를 출력한 뒤 종료
+// 장치와 같이 촬영 중에는 loop()가 돌지 않고, 촬영 사이에만 loop()를 한 번씩 호출
+static void runCaptureBenchmark(uint32_t captures) {
+    unsigned long warmupEnd = millis() + hostEnvU32("HOST_BENCH_WARMUP_MS", 3000);
+    while ((long)(millis() - warmupEnd) < 0) {
+        loop();
+    }
+    String url = hostEnv("HOST_BENCH_URL", "https://bench.local/img/bench.jpg");
+    bool testMode = hostEnvU32("HOST_BENCH_TEST", 0) != 0;
+    // HOST_BENCH_LOCAL=1: 버튼 촬영과 같이 URL 풀에서 URL을 꺼내 업로드 (tools/host_url_vendor.py 필요)
+    bool localMode = hostEnvU32("HOST_BENCH_LOCAL", 0) != 0;
+    uint32_t intervalMs = hostEnvU32("HOST_BENCH_INTERVAL_MS", 0);
+    // 촬영 명령의 "target"과 같음 (없으면 설정 저장소의 jpeg_target_bytes)
+    uint32_t targetBytes = hostEnvU32("HOST_BENCH_TARGET", UINT32_MAX);
+    // HOST_BENCH_APPROACH_MS=N: 촬영마다 N ms 전에 근접 값을 올려 물체가 다가온 것처럼 만듦 (센서 미리 켜기 확인용)
+    uint32_t approachMs = hostEnvU32("HOST_BENCH_APPROACH_MS", 0);
+    int approachProximity = (int)hostEnvU32("HOST_BENCH_APPROACH_PROXIMITY", 200);
+
+    std::vector<uint32_t> latencyMs;
+    unsigned long startMs = millis();
+    for (uint32_t i = 0; i < captures; i++) {
+        if (approachMs > 0) {
+            hostSetProximity(approachProximity);
+            unsigned long approachEnd = millis() + approachMs;
+            do {
+                loop();
+            } while ((long)(millis() - approachEnd) < 0);
+        }
+        unsigned long captureStartMs = millis();
+        if (testMode) {
+            testCameraCapture();
+        } else if (localMode) {
+            requestLocalCapture("벤치");
+            handleLocalCapture();
+        } else {
+            triggerCameraCapture(url, targetBytes);
+        }
+        latencyMs.push_back((uint32_t)(millis() - captureStartMs));
+        hostSetProximity(-1);
+        unsigned long idleEnd = millis() + intervalMs;
+        do {
+            loop();
+        } while ((long)(millis() - idleEnd) < 0);
+    }
+    double seconds = (millis() - startMs) / 1000.0;
+
+    flushLogs();
+    std::sort(latencyMs.begin(), latencyMs.end());
+    printf("[host] 촬영 벤치마크: %u회 %.1f초 (%.2f회/s), 촬영 1회 p50/p95/max %u/%u/%u ms\n", captures, seconds,
+           seconds > 0 ? captures / seconds : 0.0, latencyMs[(latencyMs.size() * 50 + 99) / 100 - 1],
+           latencyMs[(latencyMs.size() * 95 + 99) / 100 - 1], latencyMs.back());
+    hostCameraReport();
+    CameraPowerStats power = getCameraPowerStats();
+    printf("[host]   카메라 전원: 수렴 상태 %u회, 켜는 중 %u회, 꺼진 상태 %u회, 미리 켬 %u회 (헛켬 %u회), 켜진 시간 %.0f%%\n",
+           power.warmHits, power.partialHits, power.coldStarts, power.wakeUps, power.wastedWakeUps,
+           power.trackedMs > 0 ? power.poweredMs * 100.0 / power.trackedMs : 0.0);
+    // 업링크 클래스별 대기 시간 (이미지 전송 중 제어/텔레메트리가 얼마나 기다렸는지, 이미지는 얼마나 밀렸는지)
+    static const char* const CLASS_NAMES[] = {"제어/상태", "텔레메트리", "이미지(밀림)"};
+    for (uint8_t c = 0; c < (uint8_t)UplinkClass::count; c++) {
+        UplinkClassStats stats = getUplinkStats((UplinkClass)c);
+        printf("[host]   업링크 %s: %u건, 대기 평균/최대 %.1f/%u ms (대기열 경유 %u, 폐기 %u, 발행 실패 %u)\n",
+               CLASS_NAMES[c], stats.sent, stats.sent > 0 ? (double)stats.totalDelayMs / stats.sent : 0.0,
+               stats.maxDelayMs, stats.queued, stats.dropped, stats.failed);
+    }
+    fflush(stdout);
+    exit(0);
+}
+
+int main(int argc, char** argv) {
+    hostInit(argc, argv);
+    seedWifiCredentials();
+    setup();
+    uint32_t benchCaptures = hostEnvU32("HOST_BENCH_CAPTURES", 0);
+    if (benchCaptures > 0) {
+        runCaptureBenchmark(benchCaptures);
+    }
+    for (;;) {
+        loop();
+    }
+}
+
+#endif // PIO_UNIT_TESTING
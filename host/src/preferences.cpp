@@ -0,0 +1,389 @@
+#include <Preferences.h>
+#include <EEPROM.h>
+#include <Wire.h>
+#include <map>
+#include <string>
+#include <vector>
+#include "host_runtime.h"
+
+// NVS와 같은 항목 타입 (다른 타입으로 읽으면 기본값)
+enum class EntryType : uint8_t { u8, i8, u16, i16, u32, i32, u64, i64, str, blob };
+
+struct Entry {
+    EntryType type;
+    std::vector<uint8_t> data;
+};
+
+struct Preferences::Store {
+    String path;
+    bool readOnly = false;
+    std::map<std::string, Entry> entries;
+};
+
+// ESP32 NVS의 키/네임스페이스 최대 길이
+static const size_t NVS_KEY_MAX_LENGTH = 15;
+// 8MB 플래시의 nvs 파티션(20KB) 기준 항목 수 근사값
+static const size_t NVS_TOTAL_ENTRIES = 630;
+// NVS 항목 하나의 크기 (문자열/blob은 항목 헤더 뒤에 32바이트 칸을 더 씀)
+static const size_t NVS_ENTRY_SIZE = 32;
+
+static HostNvsStats nvsStats = {};
+
+// 값 하나를 기록할 때 플래시에 쓰는 바이트 (8바이트 이하 숫자는 헤더 항목에 들어감)
+static size_t entryFlashBytes(size_t dataLength) {
+    size_t spans = dataLength > 8 ? (dataLength + NVS_ENTRY_SIZE - 1) / NVS_ENTRY_SIZE : 0;
+    return (1 + spans) * NVS_ENTRY_SIZE;
+}
+
+// 삭제/초기화는 항목 상태 비트만 바꾸므로 바이트는 세지 않음
+static void recordCommit(size_t bytes) {
+    nvsStats.commits++;
+    nvsStats.bytesWritten += bytes;
+}
+
+HostNvsStats hostNvsStats() {
+    return nvsStats;
+}
+
+// 파일 형식: 한 줄에 "키 타입 16진수데이터"
+static bool loadStore(const String& path, std::map<std::string, Entry>& entries) {
+    FILE* file = fopen(path.c_str(), "r");
+    if (file == nullptr) {
+        return false;
+    }
+    char line[8192];
+    while (fgets(line, sizeof(line), file) != nullptr) {
+        char key[NVS_KEY_MAX_LENGTH + 1];
+        unsigned type;
+        int consumed = 0;
+        if (sscanf(line, "%15s %u %n", key, &type, &consumed) < 2) {
+            continue;
+        }
+        Entry entry{static_cast<EntryType>(type), {}};
+        for (const char* hex = line + consumed; hex[0] != '\0' && hex[1] != '\0' && hex[0] != '\n'; hex += 2) {
+            unsigned value;
+            if (sscanf(hex, "%2x", &value) != 1) {
+                break;
+            }
+            entry.data.push_back((uint8_t)value);
+        }
+        entries[key] = entry;
+    }
+    fclose(file);
+    return true;
+}
+
+static bool saveStore(const Preferences::Store* store);
+
+Preferences::Preferences() : store(nullptr) {}
+
+Preferences::~Preferences() {
+    end();
+}
+
+bool Preferences::begin(const char* name, bool readOnly, const char* partitionLabel) {
+    (void)partitionLabel;
+    if (store != nullptr) {
+        return false;
+    }
+    if (name == nullptr || name[0] == '\0' || strlen(name) > NVS_KEY_MAX_LENGTH) {
+        return false;
+    }
+    Store* opened = new Store();
+    opened->path = hostStatePath("nvs") + "/" + name;
+    opened->readOnly = readOnly;
+    if (!loadStore(opened->path, opened->entries) && readOnly) {
+        // NVS와 같이 읽기 전용으로는 없는 네임스페이스를 만들 수 없음
+        delete opened;
+        return false;
+    }
+    store = opened;
+    return true;
+}
+
+void Preferences::end() {
+    delete store;
+    store = nullptr;
+}
+
+// 파일은 put/remove마다 다시 씀 (NVS 커밋과 같은 시점)
+static bool saveStore(const Preferences::Store* store) {
+    String temporaryPath = store->path + ".tmp";
+    FILE* file = fopen(temporaryPath.c_str(), "w");
+    if (file == nullptr) {
+        return false;
+    }
+    for (const auto& item : store->entries) {
+        fprintf(file, "%s %u ", item.first.c_str(), (unsigned)item.second.type);
+        for (uint8_t value : item.second.data) {
+            fprintf(file, "%02x", value);
+        }
+        fputc('\n', file);
+    }
+    bool ok = fclose(file) == 0;
+    return ok && rename(temporaryPath.c_str(), store->path.c_str()) == 0;
+}
+
+static bool isKeyValid(const char* key) {
+    return key != nullptr && key[0] != '\0' && strlen(key) <= NVS_KEY_MAX_LENGTH;
+}
+
+static size_t putEntry(Preferences::Store* store, const char* key, EntryType type, const void* data, size_t length) {
+    if (store == nullptr || store->readOnly || !isKeyValid(key)) {
+        return 0;
+    }
+    Entry entry{type, std::vector<uint8_t>((const uint8_t*)data, (const uint8_t*)data + length)};
+    store->entries[key] = entry;
+    recordCommit(entryFlashBytes(length));
+    return saveStore(store) ? length : 0;
+}
+
+static const Entry* findEntry(const Preferences::Store* store, const char* key, EntryType type) {
+    if (store == nullptr || !isKeyValid(key)) {
+        return nullptr;
+    }
+    auto item = store->entries.find(key);
+    if (item == store->entries.end() || item->second.type != type) {
+        return nullptr;
+    }
+    return &item->second;
+}
+
+template <typename T>
+static T getNumber(const Preferences::Store* store, const char* key, EntryType type, T defaultValue) {
+    const Entry* entry = findEntry(store, key, type);
+    if (entry == nullptr || entry->data.size() != sizeof(T)) {
+        return defaultValue;
+    }
+    T value;
+    memcpy(&value, entry->data.data(), sizeof(T));
+    return value;
+}
+
+bool Preferences::clear() {
+    if (store == nullptr || store->readOnly) {
+        return false;
+    }
+    store->entries.clear();
+    recordCommit(0);
+    return saveStore(store);
+}
+
+bool Preferences::remove(const char* key) {
+    if (store == nullptr || store->readOnly || !isKeyValid(key)) {
+        return false;
+    }
+    if (store->entries.erase(key) == 0) {
+        return false;
+    }
+    recordCommit(0);
+    return saveStore(store);
+}
+
+bool Preferences::isKey(const char* key) {
+    return store != nullptr && isKeyValid(key) && store->entries.count(key) > 0;
+}
+
+size_t Preferences::putChar(const char* key, int8_t value) { return putEntry(store, key, EntryType::i8, &value, 1); }
+size_t Preferences::putUChar(const char* key, uint8_t value) { return putEntry(store, key, EntryType::u8, &value, 1); }
+size_t Preferences::putShort(const char* key, int16_t value) { return putEntry(store, key, EntryType::i16, &value, 2); }
+size_t Preferences::putUShort(const char* key, uint16_t value) { return putEntry(store, key, EntryType::u16, &value, 2); }
+size_t Preferences::putInt(const char* key, int32_t value) { return putEntry(store, key, EntryType::i32, &value, 4); }
+size_t Preferences::putUInt(const char* key, uint32_t value) { return putEntry(store, key, EntryType::u32, &value, 4); }
+size_t Preferences::putLong64(const char* key, int64_t value) { return putEntry(store, key, EntryType::i64, &value, 8); }
+size_t Preferences::putULong64(const char* key, uint64_t value) { return putEntry(store, key, EntryType::u64, &value, 8); }
+// arduino-esp32와 같이 float/double/bool은 blob/u8로 저장
+size_t Preferences::putFloat(const char* key, float value) { return putEntry(store, key, EntryType::blob, &value, sizeof(value)); }
+size_t Preferences::putDouble(const char* key, double value) { return putEntry(store, key, EntryType::blob, &value, sizeof(value)); }
+size_t Preferences::putBool(const char* key, bool value) { return putUChar(key, value ? 1 : 0); }
+
+size_t Preferences::putString(const char* key, const char* value) {
+    if (value == nullptr) {
+        return 0;
+    }
+    // NVS는 종료 문자까지 저장하고, 반환 값은 문자열 길이
+    size_t length = strlen(value);
+    return putEntry(store, key, EntryType::str, value, length + 1) > 0 ? length : 0;
+}
+
+size_t Preferences::putBytes(const char* key, const void* value, size_t length) {
+    if (value == nullptr || length == 0) {
+        return 0;
+    }
+    return putEntry(store, key, EntryType::blob, value, length);
+}
+
+int8_t Preferences::getChar(const char* key, int8_t defaultValue) { return getNumber(store, key, EntryType::i8, defaultValue); }
+uint8_t Preferences::getUChar(const char* key, uint8_t defaultValue) { return getNumber(store, key, EntryType::u8, defaultValue); }
+int16_t Preferences::getShort(const char* key, int16_t defaultValue) { return getNumber(store, key, EntryType::i16, defaultValue); }
+uint16_t Preferences::getUShort(const char* key, uint16_t defaultValue) { return getNumber(store, key, EntryType::u16, defaultValue); }
+int32_t Preferences::getInt(const char* key, int32_t defaultValue) { return getNumber(store, key, EntryType::i32, defaultValue); }
+uint32_t Preferences::getUInt(const char* key, uint32_t defaultValue) { return getNumber(store, key, EntryType::u32, defaultValue); }
+int64_t Preferences::getLong64(const char* key, int64_t defaultValue) { return getNumber(store, key, EntryType::i64, defaultValue); }
+uint64_t Preferences::getULong64(const char* key, uint64_t defaultValue) { return getNumber(store, key, EntryType::u64, defaultValue); }
+float Preferences::getFloat(const char* key, float defaultValue) { return getNumber(store, key, EntryType::blob, defaultValue); }
+double Preferences::getDouble(const char* key, double defaultValue) { return getNumber(store, key, EntryType::blob, defaultValue); }
+bool Preferences::getBool(const char* key, bool defaultValue) { return getUChar(key, defaultValue ? 1 : 0) != 0; }
+
+String Preferences::getString(const char* key, const String& defaultValue) {
+    const Entry* entry = findEntry(store, key, EntryType::str);
+    if (entry == nullptr || entry->data.empty()) {
+        return defaultValue;
+    }
+    return String((const char*)entry->data.data());
+}
+
+size_t Preferences::getString(const char* key, char* value, size_t maxLength) {
+    const Entry* entry = findEntry(store, key, EntryType::str);
+    if (entry == nullptr || value == nullptr) {
+        return 0;
+    }
+    // 저장된 길이(종료 문자 포함)가 버퍼보다 크면 NVS와 같이 실패
+    if (entry->data.size() > maxLength) {
+        return 0;
+    }
+    memcpy(value, entry->data.data(), entry->data.size());
+    return entry->data.size();
+}
+
+size_t Preferences::getBytesLength(const char* key) {
+    const Entry* entry = findEntry(store, key, EntryType::blob);
+    return entry != nullptr ? entry->data.size() : 0;
+}
+
+size_t Preferences::getBytes(const char* key, void* buffer, size_t maxLength) {
+    const Entry* entry = findEntry(store, key, EntryType::blob);
+    if (entry == nullptr || buffer == nullptr || entry->data.size() > maxLength) {
+        return 0;
+    }
+    memcpy(buffer, entry->data.data(), entry->data.size());
+    return entry->data.size();
+}
+
+size_t Preferences::freeEntries() {
+    size_t used = 0;
+    if (store != nullptr) {
+        for (const auto& item : store->entries) {
+            // 32바이트 항목 하나 + 32바이트를 넘는 데이터 분량
+            used += 1 + (item.second.data.size() > 8 ? (item.second.data.size() + 31) / 32 : 0);
+        }
+    }
+    return used < NVS_TOTAL_ENTRIES ? NVS_TOTAL_ENTRIES - used : 0;
+}
+
+// --- EEPROM ---
+
+EEPROMClass EEPROM;
+
+bool EEPROMClass::begin(size_t newSize) {
+    if (newSize == 0) {
+        return false;
+    }
+    end();
+    data = (uint8_t*)malloc(newSize);
+    if (data == nullptr) {
+        return false;
+    }
+    // 지운 플래시와 같이 0xFF로 채운 뒤 저장된 내용을 덮어씀
+    memset(data, 0xFF, newSize);
+    size = newSize;
+    FILE* file = fopen(hostStatePath("eeprom.bin").c_str(), "rb");
+    if (file != nullptr) {
+        size_t loaded = fread(data, 1, size, file);
+        (void)loaded;
+        fclose(file);
+    }
+    dirty = false;
+    return true;
+}
+
+void EEPROMClass::end() {
+    if (data == nullptr) {
+        return;
+    }
+    commit();
+    free(data);
+    data = nullptr;
+    size = 0;
+}
+
+uint8_t EEPROMClass::read(int address) {
+    if (data == nullptr || address < 0 || (size_t)address >= size) {
+        return 0;
+    }
+    return data[address];
+}
+
+void EEPROMClass::write(int address, uint8_t value) {
+    if (data == nullptr || address < 0 || (size_t)address >= size) {
+        return;
+    }
+    if (data[address] != value) {
+        data[address] = value;
+        dirty = true;
+    }
+}
+
+bool EEPROMClass::commit() {
+    if (data == nullptr) {
+        return false;
+    }
+    if (!dirty) {
+        return true;
+    }
+    // arduino-esp32 EEPROM은 전체 버퍼를 NVS blob 하나로 다시 씀
+    recordCommit(entryFlashBytes(size));
+    FILE* file = fopen(hostStatePath("eeprom.bin").c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    bool ok = fwrite(data, 1, size, file) == size;
+    ok = fclose(file) == 0 && ok;
+    dirty = !ok;
+    return ok;
+}
+
+uint8_t* EEPROMClass::getDataPtr() {
+    dirty = true;
+    return data;
+}
+
+String EEPROMClass::readString(int address) {
+    String result;
+    if (data == nullptr || address < 0) {
+        return result;
+    }
+    for (size_t i = (size_t)address; i < size && data[i] != '\0'; i++) {
+        result += (char)data[i];
+    }
+    return result;
+}
+
+size_t EEPROMClass::writeString(int address, const String& value) {
+    if (data == nullptr || address < 0 || (size_t)address + value.length() + 1 > size) {
+        return 0;
+    }
+    for (unsigned int i = 0; i <= value.length(); i++) {
+        write(address + (int)i, (uint8_t)value.c_str()[i]);
+    }
+    return value.length();
+}
+
+// --- Wire ---
+
+TwoWire Wire;
+
+bool TwoWire::begin(int sda, int scl, uint32_t frequency) {
+    (void)sda;
+    (void)scl;
+    (void)frequency;
+    return true;
+}
+
+bool TwoWire::end() {
+    return true;
+}
+
+void TwoWire::setClock(uint32_t frequency) {
+    (void)frequency;
+}
@@ -0,0 +1,120 @@
+#include <Adafruit_VCNL4040.h>
+#include <SparkFun_BMI270_Arduino_Library.h>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include "host_runtime.h"
+
+// HOST_SENSOR_TRACE CSV 한 줄: proximity,lux,accelX,accelY,accelZ,gyroX,gyroY,gyroZ
+// 행은 HOST_SENSOR_TRACE_INTERVAL_MS(기본 100ms)마다 하나씩 넘어가고 끝나면 처음부터 반복
+struct SensorRow {
+    float values[8];
+};
+
+static std::vector<SensorRow> traceRows;
+static std::once_flag traceLoaded;
+static std::atomic<int> proximityOverride{-1}; // hostSetProximity() 값 (-1이면 없음)
+
+static void loadTrace() {
+    const char* path = hostEnv("HOST_SENSOR_TRACE", nullptr);
+    if (path == nullptr) {
+        return;
+    }
+    FILE* file = fopen(path, "r");
+    if (file == nullptr) {
+        fprintf(stderr, "[host] HOST_SENSOR_TRACE 파일을 열 수 없음: %s\n", path);
+        return;
+    }
+    char line[256];
+    while (fgets(line, sizeof(line), file) != nullptr) {
+        SensorRow row;
+        if (sscanf(line, "%f,%f,%f,%f,%f,%f,%f,%f", &row.values[0], &row.values[1], &row.values[2], &row.values[3],
+                   &row.values[4], &row.values[5], &row.values[6], &row.values[7]) == 8) {
+            traceRows.push_back(row);
+        }
+    }
+    fclose(file);
+}
+
+static const SensorRow* currentRow() {
+    std::call_once(traceLoaded, loadTrace);
+    if (traceRows.empty()) {
+        return nullptr;
+    }
+    uint32_t interval = std::max<uint32_t>(1, hostEnvU32("HOST_SENSOR_TRACE_INTERVAL_MS", 100));
+    return &traceRows[(millis() / interval) % traceRows.size()];
+}
+
+// 잡음 [-amplitude, amplitude]
+static float noise(float amplitude) {
+    return amplitude * (float)(random(-1000, 1001)) / 1000.0f;
+}
+
+bool Adafruit_VCNL4040::begin(uint8_t address, void* wire) {
+    (void)address;
+    (void)wire;
+    return hostEnvU32("HOST_VCNL4040_MISSING", 0) == 0;
+}
+
+void hostSetProximity(int value) {
+    proximityOverride = value;
+}
+
+uint16_t Adafruit_VCNL4040::getProximity() {
+    int fixed = proximityOverride;
+    if (fixed >= 0) {
+        return (uint16_t)fixed;
+    }
+    const SensorRow* row = currentRow();
+    if (row != nullptr) {
+        return (uint16_t)row->values[0];
+    }
+    // 20초 주기로 물체가 다가왔다 멀어지는 모양
+    float phase = (float)(millis() % 20000) / 20000.0f * 2.0f * (float)M_PI;
+    return (uint16_t)std::max(0.0f, 40.0f + 30.0f * sinf(phase) + noise(3.0f));
+}
+
+uint16_t Adafruit_VCNL4040::getAmbientLight() {
+    return (uint16_t)(getLux() / 0.1f);
+}
+
+uint16_t Adafruit_VCNL4040::getWhiteLight() {
+    return getAmbientLight();
+}
+
+float Adafruit_VCNL4040::getLux() {
+    const SensorRow* row = currentRow();
+    if (row != nullptr) {
+        return row->values[1];
+    }
+    float phase = (float)(millis() % 60000) / 60000.0f * 2.0f * (float)M_PI;
+    return std::max(0.0f, 250.0f + 150.0f * sinf(phase) + noise(5.0f));
+}
+
+int8_t BMI270::beginI2C(uint8_t address, void* wire) {
+    (void)address;
+    (void)wire;
+    return hostEnvU32("HOST_BMI270_MISSING", 0) == 0 ? BMI2_OK : BMI2_E_DEV_NOT_FOUND;
+}
+
+int8_t BMI270::getSensorData() {
+    const SensorRow* row = currentRow();
+    if (row != nullptr) {
+        data.accelX = row->values[2];
+        data.accelY = row->values[3];
+        data.accelZ = row->values[4];
+        data.gyroX = row->values[5];
+        data.gyroY = row->values[6];
+        data.gyroZ = row->values[7];
+    } else {
+        // 책상 위에 놓인 상태 (z축 1g) + 작은 진동
+        data.accelX = noise(0.02f);
+        data.accelY = noise(0.02f);
+        data.accelZ = 1.0f + noise(0.02f);
+        data.gyroX = noise(0.5f);
+        data.gyroY = noise(0.5f);
+        data.gyroZ = noise(0.5f);
+    }
+    data.sensorTimeMillis = (uint32_t)millis();
+    return BMI2_OK;
+}
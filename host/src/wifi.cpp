@@ -0,0 +1,604 @@
+#include <WiFi.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <deque>
+#include "host_runtime.h"
+
+WiFiClass WiFi;
+
+// --- 가상 스테이션 ---
+
+static wifi_mode_t wifiMode = WIFI_OFF;
+static wl_status_t wifiStatus = WL_IDLE_STATUS;
+static bool autoReconnect = true;
+static unsigned long beginMs = 0;
+static char connectedSsid[33] = "";
+static uint8_t connectedBssid[6] = {0x02, 0x00, 0x00, 0x00, 0x00, 0x01};
+static int32_t connectedChannel = 6;
+static IPAddress staticIp;
+static IPAddress staticGateway;
+static IPAddress staticSubnet;
+
+// 스캔 결과로 돌려줄 고정 AP 목록 (연결 중인 SSID가 있으면 맨 앞에 추가)
+static const wifi_ap_record_t FAKE_ACCESS_POINTS[] = {
+    {{0x02, 0x00, 0x00, 0x00, 0x00, 0x02}, "host-lab-2g", 1, -48, WIFI_AUTH_WPA2_PSK},
+    {{0x02, 0x00, 0x00, 0x00, 0x00, 0x03}, "host-guest", 11, -71, WIFI_AUTH_OPEN},
+    {{0x02, 0x00, 0x00, 0x00, 0x00, 0x04}, "", 6, -83, WIFI_AUTH_WPA2_PSK},
+};
+static const int16_t FAKE_ACCESS_POINT_COUNT = sizeof(FAKE_ACCESS_POINTS) / sizeof(FAKE_ACCESS_POINTS[0]);
+static const unsigned long SCAN_DURATION_MS = 1500;
+
+static wifi_ap_record_t scanResults[FAKE_ACCESS_POINT_COUNT + 1];
+static int16_t scanResultCount = 0;
+static bool scanRunning = false;
+static unsigned long scanStartMs = 0;
+
+// begin() 후 HOST_WIFI_CONNECT_MS가 지나면 연결 완료로 전환
+static void updateStatus() {
+    if (wifiStatus == WL_DISCONNECTED && connectedSsid[0] != '\0' &&
+        millis() - beginMs >= hostEnvU32("HOST_WIFI_CONNECT_MS", 300)) {
+        wifiStatus = WL_CONNECTED;
+    }
+}
+
+bool WiFiClass::mode(wifi_mode_t newMode) {
+    wifiMode = newMode;
+    if (newMode == WIFI_OFF) {
+        wifiStatus = WL_IDLE_STATUS;
+    }
+    return true;
+}
+
+wifi_mode_t WiFiClass::getMode() {
+    return wifiMode;
+}
+
+bool WiFiClass::setAutoReconnect(bool enabled) {
+    autoReconnect = enabled;
+    return true;
+}
+
+bool WiFiClass::getAutoReconnect() {
+    return autoReconnect;
+}
+
+bool WiFiClass::setSleep(bool enabled) {
+    (void)enabled;
+    return true;
+}
+
+bool WiFiClass::setSleep(wifi_ps_type_t type) {
+    (void)type;
+    return true;
+}
+
+wl_status_t WiFiClass::begin(const char* ssid, const char* passphrase, int32_t channel, const uint8_t* bssid,
+                             bool connect) {
+    (void)passphrase;
+    if (wifiMode == WIFI_OFF) {
+        wifiMode = WIFI_STA;
+    }
+    if (ssid == nullptr || ssid[0] == '\0' || strlen(ssid) > 32) {
+        wifiStatus = WL_NO_SSID_AVAIL;
+        return wifiStatus;
+    }
+    strlcpy(connectedSsid, ssid, sizeof(connectedSsid));
+    connectedChannel = channel > 0 ? channel : 6;
+    if (bssid != nullptr) {
+        memcpy(connectedBssid, bssid, sizeof(connectedBssid));
+    }
+    if (connect) {
+        wifiStatus = WL_DISCONNECTED;
+        beginMs = millis();
+    }
+    return wifiStatus;
+}
+
+wl_status_t WiFiClass::status() {
+    updateStatus();
+    return wifiStatus;
+}
+
+bool WiFiClass::disconnect(bool wifiOff, bool eraseAp) {
+    wifiStatus = WL_DISCONNECTED;
+    connectedSsid[0] = '\0';
+    if (eraseAp) {
+        staticIp = IPAddress();
+    }
+    if (wifiOff) {
+        wifiMode = WIFI_OFF;
+        wifiStatus = WL_IDLE_STATUS;
+    }
+    return true;
+}
+
+bool WiFiClass::reconnect() {
+    if (connectedSsid[0] == '\0') {
+        return false;
+    }
+    wifiStatus = WL_DISCONNECTED;
+    beginMs = millis();
+    return true;
+}
+
+bool WiFiClass::config(IPAddress localIp, IPAddress gateway, IPAddress subnet, IPAddress dns1, IPAddress dns2) {
+    (void)dns1;
+    (void)dns2;
+    staticIp = localIp;
+    staticGateway = gateway;
+    staticSubnet = subnet;
+    return true;
+}
+
+IPAddress WiFiClass::localIP() {
+    if (status() != WL_CONNECTED) {
+        return IPAddress();
+    }
+    return (uint32_t)staticIp != 0 ? staticIp : IPAddress(127, 0, 0, 1);
+}
+
+IPAddress WiFiClass::gatewayIP() {
+    if (status() != WL_CONNECTED) {
+        return IPAddress();
+    }
+    return (uint32_t)staticGateway != 0 ? staticGateway : IPAddress(127, 0, 0, 1);
+}
+
+IPAddress WiFiClass::subnetMask() {
+    if (status() != WL_CONNECTED) {
+        return IPAddress();
+    }
+    return (uint32_t)staticSubnet != 0 ? staticSubnet : IPAddress(255, 0, 0, 0);
+}
+
+IPAddress WiFiClass::dnsIP(uint8_t index) {
+    (void)index;
+    return gatewayIP();
+}
+
+String WiFiClass::macAddress() {
+    uint8_t mac[6];
+    esp_read_mac(mac, ESP_MAC_WIFI_STA);
+    char text[18];
+    snprintf(text, sizeof(text), "%02X:%02X:%02X:%02X:%02X:%02X", mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+    return String(text);
+}
+
+String WiFiClass::SSID() {
+    return status() == WL_CONNECTED ? String(connectedSsid) : String();
+}
+
+int8_t WiFiClass::RSSI() {
+    return status() == WL_CONNECTED ? (int8_t)atoi(hostEnv("HOST_WIFI_RSSI", "-55")) : 0;
+}
+
+uint8_t* WiFiClass::BSSID() {
+    return status() == WL_CONNECTED ? connectedBssid : nullptr;
+}
+
+int32_t WiFiClass::channel() {
+    return status() == WL_CONNECTED ? connectedChannel : 0;
+}
+
+// --- 스캔 ---
+
+int16_t WiFiClass::scanNetworks(bool async, bool showHidden, bool passive, uint32_t maxMsPerChannel,
+                                uint8_t channel, const char* ssid, const uint8_t* bssid) {
+    (void)showHidden;
+    (void)passive;
+    (void)maxMsPerChannel;
+    (void)channel;
+    (void)ssid;
+    (void)bssid;
+    if (scanRunning) {
+        return WIFI_SCAN_RUNNING;
+    }
+    scanDelete();
+    scanRunning = true;
+    scanStartMs = millis();
+    if (async) {
+        return WIFI_SCAN_RUNNING;
+    }
+    delay(SCAN_DURATION_MS);
+    return scanComplete();
+}
+
+int16_t WiFiClass::scanComplete() {
+    if (!scanRunning) {
+        return scanResultCount > 0 ? scanResultCount : WIFI_SCAN_FAILED;
+    }
+    if (millis() - scanStartMs < SCAN_DURATION_MS) {
+        return WIFI_SCAN_RUNNING;
+    }
+    scanRunning = false;
+    scanResultCount = 0;
+    if (connectedSsid[0] != '\0') {
+        wifi_ap_record_t& own = scanResults[scanResultCount++];
+        memset(&own, 0, sizeof(own));
+        memcpy(own.bssid, connectedBssid, sizeof(own.bssid));
+        strlcpy((char*)own.ssid, connectedSsid, sizeof(own.ssid));
+        own.primary = (uint8_t)connectedChannel;
+        own.rssi = (int8_t)atoi(hostEnv("HOST_WIFI_RSSI", "-55"));
+        own.authmode = WIFI_AUTH_WPA2_PSK;
+    }
+    for (int16_t i = 0; i < FAKE_ACCESS_POINT_COUNT; i++) {
+        scanResults[scanResultCount++] = FAKE_ACCESS_POINTS[i];
+    }
+    return scanResultCount;
+}
+
+void WiFiClass::scanDelete() {
+    scanResultCount = 0;
+}
+
+void* WiFiClass::getScanInfoByIndex(int index) {
+    if (index < 0 || index >= scanResultCount) {
+        return nullptr;
+    }
+    return &scanResults[index];
+}
+
+String WiFiClass::SSID(uint8_t index) {
+    const wifi_ap_record_t* record = (const wifi_ap_record_t*)getScanInfoByIndex(index);
+    return record != nullptr ? String((const char*)record->ssid) : String();
+}
+
+int32_t WiFiClass::RSSI(uint8_t index) {
+    const wifi_ap_record_t* record = (const wifi_ap_record_t*)getScanInfoByIndex(index);
+    return record != nullptr ? record->rssi : 0;
+}
+
+wifi_auth_mode_t WiFiClass::encryptionType(uint8_t index) {
+    const wifi_ap_record_t* record = (const wifi_ap_record_t*)getScanInfoByIndex(index);
+    return record != nullptr ? record->authmode : WIFI_AUTH_OPEN;
+}
+
+uint8_t* WiFiClass::BSSID(uint8_t index) {
+    wifi_ap_record_t* record = (wifi_ap_record_t*)getScanInfoByIndex(index);
+    return record != nullptr ? record->bssid : nullptr;
+}
+
+int32_t WiFiClass::channel(uint8_t index) {
+    const wifi_ap_record_t* record = (const wifi_ap_record_t*)getScanInfoByIndex(index);
+    return record != nullptr ? record->primary : 0;
+}
+
+// --- TCP 클라이언트 ---
+
+// 포트별 연결 대상 변경 (TLS 포트를 로컬 평문 서버로 보냄)
+static void resolveRedirect(const char* host, uint16_t port, String& targetHost, uint16_t& targetPort) {
+    char name[32];
+    snprintf(name, sizeof(name), "HOST_REDIRECT_%u", port);
+    const char* fallback = port == 8883 ? "127.0.0.1:1883" : port == 443 ? "127.0.0.1:8080" : nullptr;
+    const char* redirect = hostEnv(name, fallback);
+    targetHost = host;
+    targetPort = port;
+    if (redirect == nullptr) {
+        return;
+    }
+    const char* colon = strrchr(redirect, ':');
+    if (colon == nullptr) {
+        targetHost = redirect;
+        return;
+    }
+    targetHost = String(redirect, (unsigned int)(colon - redirect));
+    targetPort = (uint16_t)atoi(colon + 1);
+}
+
+// --- 링크 에뮬레이션 ---
+// tc/netem 없이 장치의 약한 업링크를 재현 (HOST_LINK_KBPS가 0이면 사용 안 함)
+//   HOST_LINK_KBPS: 링크 속도 (KB/s)           HOST_LINK_RTT_MS: 왕복 지연 (기본 30)
+//   HOST_LINK_LOSS_PERMILLE: 세그먼트 손실률     HOST_LINK_RTO_MS: 손실 시 재전송 대기 (기본 250)
+//   HOST_LINK_SNDBUF: 송신 버퍼 (기본 5744, lwIP TCP_SND_BUF)   HOST_LINK_PORT: 적용할 원래 포트 (기본 443, 쉼표로 여러 개)
+// 여러 연결에 적용하면 송신 버퍼는 연결마다 따로 두고 링크 전송 시간은 함께 씀 (업로드와 MQTT가 같은 WiFi 업링크를 나눔)
+// 송신 버퍼가 ACK로 비워질 때까지 write()가 막히고, 손실된 세그먼트는 RTO 후 재전송되며 뒤 세그먼트도 함께 밀림
+// (송신 창이 4세그먼트라 중복 ACK 3개로 빠른 재전송이 일어나기 어려움)
+// write() 1회를 TLS 레코드로 보고 4096바이트마다 레코드 오버헤드 29바이트를 링크 사용량에 더함
+static const size_t LINK_MSS = 1436;
+static const size_t LINK_RECORD_PAYLOAD = 4096;
+static const size_t LINK_RECORD_OVERHEAD = 29;
+
+struct LinkSegment {
+    size_t bytes;
+    int64_t ackUs;
+};
+
+struct HostLinkState {
+    double bytesPerUs;
+    int64_t rttUs;
+    int64_t rtoUs;
+    uint32_t lossPermille;
+    size_t sendBuffer;
+    size_t inFlight = 0;
+    int64_t connectionFreeUs = 0; // 이 연결의 다음 세그먼트가 나갈 수 있는 시각 (재전송 대기 포함)
+    std::deque<LinkSegment> segments;
+};
+
+// 링크 에뮬레이션을 쓰는 모든 연결이 공유하는 링크가 비는 시각
+static int64_t linkFreeUs = 0;
+
+static int64_t monotonicUs() {
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+static HostLinkState* createLink(uint16_t port) {
+    uint32_t kbps = hostEnvU32("HOST_LINK_KBPS", 0);
+    if (kbps == 0) {
+        return nullptr;
+    }
+    bool shaped = false;
+    for (const char* ports = hostEnv("HOST_LINK_PORT", "443"); ports != nullptr && *ports != '\0';) {
+        char* end;
+        if (strtoul(ports, &end, 10) == port) {
+            shaped = true;
+        }
+        ports = *end == ',' ? end + 1 : nullptr;
+    }
+    if (!shaped) {
+        return nullptr;
+    }
+    HostLinkState* link = new HostLinkState();
+    link->bytesPerUs = kbps * 1024.0 / 1e6;
+    link->rttUs = (int64_t)hostEnvU32("HOST_LINK_RTT_MS", 30) * 1000;
+    link->rtoUs = (int64_t)hostEnvU32("HOST_LINK_RTO_MS", 250) * 1000;
+    link->lossPermille = hostEnvU32("HOST_LINK_LOSS_PERMILLE", 0);
+    link->sendBuffer = std::max<size_t>(LINK_MSS, hostEnvU32("HOST_LINK_SNDBUF", 5744));
+    return link;
+}
+
+WiFiClient::WiFiClient() {}
+
+WiFiClient::~WiFiClient() {
+    stop();
+}
+
+int WiFiClient::connect(IPAddress ip, uint16_t port) {
+    return connect(ip.toString().c_str(), port);
+}
+
+int WiFiClient::connect(const char* host, uint16_t port) {
+    return connect(host, port, (int32_t)timeout);
+}
+
+int WiFiClient::connect(const char* host, uint16_t port, int32_t timeoutMs) {
+    stop();
+    if (WiFi.status() != WL_CONNECTED) {
+        return 0;
+    }
+
+    String targetHost;
+    uint16_t targetPort;
+    resolveRedirect(host, port, targetHost, targetPort);
+
+    addrinfo hints = {};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* addresses = nullptr;
+    char portText[8];
+    snprintf(portText, sizeof(portText), "%u", targetPort);
+    if (getaddrinfo(targetHost.c_str(), portText, &hints, &addresses) != 0) {
+        return 0;
+    }
+
+    for (addrinfo* address = addresses; address != nullptr && socketFd < 0; address = address->ai_next) {
+        int candidate = socket(address->ai_family, address->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                               address->ai_protocol);
+        if (candidate < 0) {
+            continue;
+        }
+        int result = ::connect(candidate, address->ai_addr, address->ai_addrlen);
+        if (result < 0 && errno == EINPROGRESS) {
+            pollfd waiter = {candidate, POLLOUT, 0};
+            int error = 0;
+            socklen_t errorLength = sizeof(error);
+            if (poll(&waiter, 1, timeoutMs) == 1 &&
+                getsockopt(candidate, SOL_SOCKET, SO_ERROR, &error, &errorLength) == 0 && error == 0) {
+                result = 0;
+            }
+        }
+        if (result == 0) {
+            socketFd = candidate;
+        } else {
+            close(candidate);
+        }
+    }
+    freeaddrinfo(addresses);
+    rxStart = rxEnd = 0;
+    if (socketFd >= 0) {
+        link = createLink(port);
+    }
+    return socketFd >= 0 ? 1 : 0;
+}
+
+// 수신 버퍼가 비어 있을 때 소켓에서 읽음 (timeoutMs 동안 데이터를 기다림)
+int WiFiClient::fillBuffer(int timeoutMs) {
+    if (rxStart < rxEnd) {
+        return (int)(rxEnd - rxStart);
+    }
+    if (socketFd < 0) {
+        return 0;
+    }
+    if (linkInFlight()) {
+        return 0; // 보낸 데이터가 아직 상대에 닿지 않았으므로 응답도 없음
+    }
+    if (timeoutMs > 0) {
+        pollfd waiter = {socketFd, POLLIN, 0};
+        poll(&waiter, 1, timeoutMs);
+    }
+    ssize_t received = recv(socketFd, rxBuffer, sizeof(rxBuffer), MSG_DONTWAIT);
+    if (received > 0) {
+        rxStart = 0;
+        rxEnd = (size_t)received;
+        return (int)received;
+    }
+    if (received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+        // 상대가 연결을 닫음: 이미 받은 데이터는 없으므로 소켓 정리
+        stop();
+    }
+    return 0;
+}
+
+size_t WiFiClient::write(uint8_t value) {
+    return write(&value, 1);
+}
+
+size_t WiFiClient::write(const uint8_t* buffer, size_t size) {
+    if (link != nullptr) {
+        return writeShaped(buffer, size);
+    }
+    return sendAll(buffer, size, millis());
+}
+
+size_t WiFiClient::sendAll(const uint8_t* buffer, size_t size, unsigned long startMs) {
+    size_t sent = 0;
+    while (sent < size && socketFd >= 0) {
+        ssize_t result = send(socketFd, buffer + sent, size - sent, MSG_NOSIGNAL);
+        if (result > 0) {
+            sent += (size_t)result;
+            continue;
+        }
+        if (result < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+            if (millis() - startMs >= timeout) {
+                break;
+            }
+            pollfd waiter = {socketFd, POLLOUT, 0};
+            poll(&waiter, 1, 10);
+            continue;
+        }
+        stop();
+    }
+    return sent;
+}
+
+// 송신 버퍼에 자리가 날 때까지 기다리며 세그먼트 단위로 링크 시간축에 올림
+size_t WiFiClient::writeShaped(const uint8_t* buffer, size_t size) {
+    unsigned long startMs = millis();
+    size_t overhead = LINK_RECORD_OVERHEAD * ((size + LINK_RECORD_PAYLOAD - 1) / LINK_RECORD_PAYLOAD);
+    size_t sent = 0;
+    while (sent < size && socketFd >= 0) {
+        int64_t now = monotonicUs();
+        while (!link->segments.empty() && link->segments.front().ackUs <= now) {
+            link->inFlight -= link->segments.front().bytes;
+            link->segments.pop_front();
+        }
+        size_t space = link->sendBuffer - link->inFlight;
+        if (space == 0) {
+            if (millis() - startMs >= timeout) {
+                break;
+            }
+            int64_t waitUs = link->segments.front().ackUs - now;
+            usleep((useconds_t)std::min<int64_t>(waitUs, 10000));
+            continue;
+        }
+        size_t length = std::min(std::min(space, size - sent), LINK_MSS);
+        size_t wireBytes = length + overhead;
+        overhead = 0;
+        int64_t departUs = std::max(std::max(now, linkFreeUs), link->connectionFreeUs) +
+                           (int64_t)(wireBytes / link->bytesPerUs);
+        linkFreeUs = departUs;
+        // 손실률은 MSS 크기 세그먼트 기준 (버퍼 자리에 맞춰 잘린 작은 세그먼트는 그만큼 덜 잃음)
+        // 재전송 대기는 이 연결만 밀고 다른 연결은 그동안 링크를 씀
+        if (link->lossPermille > 0 && (size_t)random(0, 1000 * (long)LINK_MSS) < link->lossPermille * length) {
+            departUs += link->rtoUs;
+        }
+        link->connectionFreeUs = departUs;
+        link->segments.push_back({length, departUs + link->rttUs});
+        link->inFlight += length;
+        size_t written = sendAll(buffer + sent, length, startMs);
+        sent += written;
+        if (written != length) {
+            break;
+        }
+    }
+    return sent;
+}
+
+bool WiFiClient::linkInFlight() {
+    if (link == nullptr || link->segments.empty()) {
+        return false;
+    }
+    if (link->segments.back().ackUs <= monotonicUs()) {
+        link->segments.clear();
+        link->inFlight = 0;
+        return false;
+    }
+    return true;
+}
+
+int WiFiClient::available() {
+    return fillBuffer(0);
+}
+
+int WiFiClient::read() {
+    if (fillBuffer(0) <= 0) {
+        return -1;
+    }
+    return rxBuffer[rxStart++];
+}
+
+int WiFiClient::read(uint8_t* buffer, size_t size) {
+    if (fillBuffer(0) <= 0) {
+        return -1;
+    }
+    size_t count = std::min(size, rxEnd - rxStart);
+    memcpy(buffer, rxBuffer + rxStart, count);
+    rxStart += count;
+    return (int)count;
+}
+
+int WiFiClient::peek() {
+    if (fillBuffer(0) <= 0) {
+        return -1;
+    }
+    return rxBuffer[rxStart];
+}
+
+void WiFiClient::stop() {
+    if (socketFd >= 0) {
+        close(socketFd);
+        socketFd = -1;
+    }
+    delete link;
+    link = nullptr;
+}
+
+uint8_t WiFiClient::connected() {
+    if (socketFd < 0) {
+        return rxStart < rxEnd;
+    }
+    if (rxStart < rxEnd) {
+        return 1;
+    }
+    uint8_t probe;
+    ssize_t result = recv(socketFd, &probe, 1, MSG_PEEK | MSG_DONTWAIT);
+    if (result == 0 || (result < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+        stop();
+        return 0;
+    }
+    return 1;
+}
+
+int WiFiClient::setNoDelay(bool noDelay) {
+    int flag = noDelay ? 1 : 0;
+    return setSocketOption(IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+}
+
+int WiFiClient::setSocketOption(int option, char* value, size_t length) {
+    return setSocketOption(SOL_SOCKET, option, value, length);
+}
+
+int WiFiClient::setSocketOption(int level, int option, const void* value, size_t length) {
+    if (socketFd < 0) {
+        return -1;
+    }
+    return setsockopt(socketFd, level, option, value, (socklen_t)length);
+}
@@ -0,0 +1,113 @@
+#include "ble_event_queue.h"
+#include <atomic>
+#include "ble_transport.h"
+
+// Vyukov 방식의 유한 MPSC 큐
+// 각 슬롯의 sequence 값으로 슬롯 소유권을 넘기므로 뮤텍스나 임계 구역이 필요 없음
+struct QueueCell {
+    std::atomic<uint32_t> sequence;
+    BleEvent event;
+};
+
+static_assert((BLE_EVENT_QUEUE_CAPACITY & (BLE_EVENT_QUEUE_CAPACITY - 1)) == 0,
+              "BLE_EVENT_QUEUE_CAPACITY는 2의 거듭제곱이어야 합니다");
+
+// 최대 MTU의 프레임으로 나눈 메시지 하나와 클라이언트의 ACK/NACK이 쓰기 슬롯에 모두 들어가야 함
+static_assert(BLE_EVENT_QUEUE_CAPACITY - BLE_EVENT_RESERVED_SLOTS >=
+                  (BLE_MAX_MESSAGE_SIZE + BLE_MAX_MTU - 3 - BLE_FRAME_HEADER_SIZE - 1) /
+                          (BLE_MAX_MTU - 3 - BLE_FRAME_HEADER_SIZE) + 1,
+              "BLE 이벤트 큐가 프레임 메시지 하나를 담지 못합니다");
+
+static const uint32_t QUEUE_MASK = BLE_EVENT_QUEUE_CAPACITY - 1;
+
+// 모듈 내부에서만 사용할 변수
+static QueueCell cells[BLE_EVENT_QUEUE_CAPACITY];
+static std::atomic<uint32_t> enqueuePosition(0);
+static uint32_t dequeuePosition = 0; // 소비자(메인 루프)만 접근
+static std::atomic<uint32_t> droppedEvents(0);
+
+// 정적 초기화 시점에 슬롯 순번을 설정 (BLE 스택 시작 전에 실행됨)
+static struct CellInitializer {
+    CellInitializer() {
+        for (uint32_t i = 0; i < BLE_EVENT_QUEUE_CAPACITY; i++) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+} cellInitializer;
+
+// 함수 구현
+
+bool pushBleEvent(BleEventType type, const uint8_t* data, size_t length, uint16_t value) {
+    QueueCell* cell;
+    uint32_t position = enqueuePosition.load(std::memory_order_relaxed);
+    // 쓰기는 자기 위치 뒤로 예약 슬롯만큼 더 비어 있어야 들어감
+    // (소비자는 순서대로 반납하므로 그 슬롯이 비었으면 사이의 슬롯도 모두 비어 있음)
+    uint32_t reserved = type == BleEventType::write ? BLE_EVENT_RESERVED_SLOTS : 0;
+
+    while (true) {
+        cell = &cells[position & QUEUE_MASK];
+        uint32_t sequence = cell->sequence.load(std::memory_order_acquire);
+        int32_t difference = (int32_t)sequence - (int32_t)position;
+        if (difference == 0 && reserved > 0) {
+            uint32_t reservedPosition = position + reserved;
+            uint32_t reservedSequence = cells[reservedPosition & QUEUE_MASK].sequence.load(std::memory_order_acquire);
+            if ((int32_t)reservedSequence - (int32_t)reservedPosition < 0) {
+                difference = -1; // 예약 슬롯만 남음: 쓰기는 가득 찬 것으로 처리
+            }
+        }
+        if (difference == 0) {
+            // 빈 슬롯: 위치를 선점 (다른 생산자와 경쟁 시 재시도)
+            if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            // 가득 참: 블로킹하지 않고 버림
+            droppedEvents.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            position = enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    BleEvent& event = cell->event;
+    event.type = type;
+    event.value = value;
+    if (length > BLE_EVENT_MAX_PAYLOAD) {
+        length = BLE_EVENT_MAX_PAYLOAD;
+    }
+    if (data != nullptr && length > 0) {
+        memcpy(event.data, data, length);
+    } else {
+        length = 0;
+    }
+    event.data[length] = '\0';
+    event.length = length;
+
+    // 소비자에게 슬롯을 넘김
+    cell->sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+const BleEvent* peekBleEvent() {
+    QueueCell* cell = &cells[dequeuePosition & QUEUE_MASK];
+    uint32_t sequence = cell->sequence.load(std::memory_order_acquire);
+    if ((int32_t)sequence - (int32_t)(dequeuePosition + 1) < 0) {
+        return nullptr; // 비어 있음 (또는 생산자가 아직 기록 중)
+    }
+    return &cell->event;
+}
+
+void releaseBleEvent() {
+    QueueCell* cell = &cells[dequeuePosition & QUEUE_MASK];
+    // 다음 바퀴의 생산자가 사용할 수 있도록 슬롯을 반납
+    cell->sequence.store(dequeuePosition + BLE_EVENT_QUEUE_CAPACITY, std::memory_order_release);
+    dequeuePosition++;
+}
+
+uint32_t getBleEventDropCount() {
+    return droppedEvents.load(std::memory_order_relaxed);
+}
+
+uint32_t getBleEventQueueDepth() {
+    return enqueuePosition.load(std::memory_order_relaxed) - dequeuePosition;
+}
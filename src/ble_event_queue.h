@@ -0,0 +1,60 @@
+#ifndef BLE_EVENT_QUEUE_H
+#define BLE_EVENT_QUEUE_H
+
+#include <Arduino.h>
+
+// 큐 용량 (2의 거듭제곱이어야 함)
+// 최대 MTU에서 메시지 하나(BLE_MAX_MESSAGE_SIZE)의 프레임 전체와 ACK/NACK, 예약 슬롯이 들어가는 크기
+#define BLE_EVENT_QUEUE_CAPACITY 16
+// 연결 상태 이벤트(connect/disconnect/mtuChanged)만 쓸 수 있는 슬롯 수
+// 쓰기가 몰려 큐가 차도 연결/해제가 버려지지 않도록 남겨 둠
+#define BLE_EVENT_RESERVED_SLOTS 4
+// 쓰기 이벤트 한 건의 최대 페이로드 (ATT 속성 최대 길이)
+#define BLE_EVENT_MAX_PAYLOAD 512
+
+// BLE 스택 콜백에서 메인 루프로 전달하는 이벤트 종류
+enum class BleEventType : uint8_t { connect, disconnect, write, mtuChanged };
+
+// 이벤트 한 건. 페이로드는 큐 슬롯(고정 풀)에 복사되어 힙 할당이 없음
+struct BleEvent {
+    BleEventType type;
+    uint16_t value;                            // mtuChanged: MTU
+    uint16_t length;                           // write: 페이로드 길이, connect: 6
+    uint8_t data[BLE_EVENT_MAX_PAYLOAD + 1];   // write: 페이로드 (NUL 종료), connect: 상대 BD 주소
+};
+
+/**
+ * @brief 이벤트를 큐에 넣습니다. (다중 생산자, 락 없음, 블로킹 없음)
+ * BLE 스택 콜백처럼 오래 걸리면 안 되는 곳에서 호출합니다.
+ * write 이벤트는 예약 슬롯(BLE_EVENT_RESERVED_SLOTS)을 남겨 두고 들어가므로
+ * 큐가 쓰기로 가득 차도 연결 상태 이벤트는 순서대로 전달됩니다.
+ * @param data write 이벤트의 페이로드 (없으면 nullptr)
+ * @param length 페이로드 길이 (BLE_EVENT_MAX_PAYLOAD 초과분은 잘림)
+ * @param value 이벤트별 부가 값
+ * @return 큐가 가득 차서 버려졌으면 false
+ */
+bool pushBleEvent(BleEventType type, const uint8_t* data = nullptr, size_t length = 0, uint16_t value = 0);
+
+/**
+ * @brief 가장 오래된 이벤트를 가리키는 포인터를 반환합니다. (단일 소비자)
+ * 처리가 끝나면 반드시 releaseBleEvent()로 슬롯을 반납해야 합니다.
+ * @return 이벤트가 없으면 nullptr
+ */
+const BleEvent* peekBleEvent();
+
+/**
+ * @brief peekBleEvent()로 얻은 이벤트 슬롯을 반납합니다.
+ */
+void releaseBleEvent();
+
+/**
+ * @brief 큐가 가득 차서 버려진 이벤트 수를 반환합니다.
+ */
+uint32_t getBleEventDropCount();
+
+/**
+ * @brief 처리를 기다리는 이벤트 수를 반환합니다. (소비자 쪽에서 호출)
+ */
+uint32_t getBleEventQueueDepth();
+
+#endif // BLE_EVENT_QUEUE_H
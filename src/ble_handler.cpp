@@ -1,17 +1,22 @@
 #include "ble_handler.h"
 #include <BLE2902.h>
 #include "config.h"         // BLE_DEVICE_NAME 등 설정 값을 위해 포함
-#include "wifi_handler.h"   // scanWifiNetworks() 함수를 사용하기 위해 포함
-#include "eeprom_handler.h" // EEPROM에 저장된 WiFi 정보를 사용하기 위해 포함
+#include "wifi_handler.h"   // getMacAddress() 등을 사용하기 위해 포함
+#include "wifi_scanner.h"   // 캐시된 WiFi 스캔 결과를 사용하기 위해 포함
+#include "ble_transport.h"  // MTU 기반 프레임 전송/재조립
+#include "ble_event_queue.h" // 스택 콜백 → 메인 루프 이벤트 전달
+#include "ble_sensor_stream.h" // 실시간 센서 스트림 특성
+#include "config_store.h"  // 수신한 WiFi 정보를 저장하기 위해 포함
 #include <ArduinoJson.h>
+#include "logger.h"
 
 // 모듈 내부에서만 사용할 변수 및 객체들
 static BLEServer* pServer = nullptr;
 static BLECharacteristic* pCharacteristic = nullptr;
-static bool newBleDataReceived = false;
-static String receivedBleData = "";
-static String apListJson = ""; // 스캔된 WiFi AP 목록을 저장할 변수
+static bool wifiListReplyPending = false; // 스캔 완료 후 WiFi 목록을 보내야 하는지
+static unsigned long lastScanRequestMs = 0;
 static bool requestFirstMsgSend = false;
+static unsigned long firstMsgSendAtMs = 0; // 첫 메시지(AP 목록) 전송 예정 시각
 static int bleRetryCounter = 0;
 static bool rebootRequested = false;
 static bool awaitingMqttResult = false;
@@ -19,27 +24,24 @@ static bool awaitingMqttResult = false;
 // isBleClientConnected는 main.cpp에서 이미 정의됨 - 중복 정의 제거
 
 // BLE 콜백 클래스 정의
+// 콜백은 BLE 호스트 태스크에서 실행되므로 이벤트 큐에 넣는 O(1) 작업만 수행하고,
+// 실제 처리는 메인 루프의 handleBLE()에서 진행
 
 // 클라이언트 연결 및 해제 이벤트를 처리하는 콜백 클래스
 class ServerCallbacks : public BLEServerCallbacks {
-    void onConnect(BLEServer* pServer) {
-        isBleClientConnected = true;
-        requestFirstMsgSend = true; // 연결되면 첫 메시지(AP 목록) 전송을 요청
-        Serial.println("BLE 클라이언트 연결");
+    void onConnect(BLEServer* pServer, esp_ble_gatts_cb_param_t* param) {
+        // 연결 간격 협상에 필요한 상대 주소를 함께 전달
+        pushBleEvent(BleEventType::connect, param->connect.remote_bda, sizeof(param->connect.remote_bda));
+    }
+
+    void onMtuChanged(BLEServer* pServer, esp_ble_gatts_cb_param_t* param) {
+        pushBleEvent(BleEventType::mtuChanged, nullptr, 0, param->mtu.mtu);
     }
 
     void onDisconnect(BLEServer* pServer) {
+        // 진행 중인 전송이 바로 중단되도록 상태 플래그만 즉시 갱신
         isBleClientConnected = false;
-        Serial.println("BLE 클라이언트 연결 끊김");
-        // 연결이 끊어지면 다시 광고를 시작하여 다른 기기가 찾을 수 있도록 함
-        pServer->getAdvertising()->start();
-        
-        // 재부팅이 요청된 상태에서 연결이 끊어졌다면 재부팅 수행
-        if (rebootRequested) {
-            Serial.println("재부팅 요청됨...");
-            delay(500);
-            ESP.restart();
-        }
+        pushBleEvent(BleEventType::disconnect);
     }
 };
 
@@ -48,19 +50,34 @@ class CharacteristicCallbacks : public BLECharacteristicCallbacks {
     void onWrite(BLECharacteristic* pCharacteristic) {
         std::string value = pCharacteristic->getValue();
         if (value.length() > 0) {
-            receivedBleData = String(value.c_str());
-            newBleDataReceived = true; // 새로운 데이터가 수신되었음을 표시
+            // 페이로드는 큐의 고정 슬롯에 복사되므로 연속 쓰기도 유실/손상되지 않음
+            pushBleEvent(BleEventType::write, reinterpret_cast<const uint8_t*>(value.data()), value.length());
         }
     }
+
+    void onStatus(BLECharacteristic* pCharacteristic, Status status, uint32_t code) {
+        onBleNotifyStatus(status == SUCCESS_NOTIFY || status == SUCCESS_INDICATE);
+    }
 };
 
+// 컨트롤러 혼잡은 특성 콜백으로 오지 않고 GATTS 이벤트로만 전달되므로 직접 받아 전송 계층에 알림
+static void gattsEventHandler(esp_gatts_cb_event_t event, esp_gatt_if_t gattsIf, esp_ble_gatts_cb_param_t* param) {
+    if (event == ESP_GATTS_CONGEST_EVT) {
+        onBleCongestion(param->congest.congested);
+    }
+}
+
 void processBleData(const String& data); // 내부에서만 사용할 함수이므로 미리 선언
+static void sendWifiList();
+static void handleBleEvent(const BleEvent& event);
 
-void initBLE(const String& uid, const String& preScannedWifiList) {
-    Serial.println("BLE 초기화 시작...");
+void initBLE() {
+    LOG_I(ble, "BLE 초기화 시작...");
 
-    // 1. BLE 장치 초기화 및 이름 설정
+    // 1. BLE 장치 초기화 및 이름 설정 (큰 MTU를 허용하여 프레임당 전송량 확대)
     BLEDevice::init(BLE_DEVICE_NAME);
+    BLEDevice::setMTU(BLE_MAX_MTU);
+    BLEDevice::setCustomGattsHandler(gattsEventHandler);
 
     // 2. BLE 서버 생성
     pServer = BLEDevice::createServer();
@@ -78,6 +95,10 @@ void initBLE(const String& uid, const String& preScannedWifiList) {
     );
     pCharacteristic->setCallbacks(new CharacteristicCallbacks());
     pCharacteristic->addDescriptor(new BLE2902()); // 클라이언트가 Notify를 받을 수 있도록 설정
+    initBleTransport(pCharacteristic);
+
+    // 센서 스트림 특성 (구독 중일 때만 샘플링/전송)
+    initBleSensorStream(pServer, pService);
 
     // 5. 서비스 시작
     pService->start();
@@ -88,83 +109,148 @@ void initBLE(const String& uid, const String& preScannedWifiList) {
     pAdvertising->setScanResponse(true);
     BLEDevice::startAdvertising();
 
-    Serial.println("BLE 서버 시작. 클라이언트 연결 대기...");
-    
-    // 7. 미리 스캔된 WiFi 목록 저장 (setup에서 전달받음)
-    if (preScannedWifiList.length() > 0) {
-        apListJson = preScannedWifiList;
-        Serial.println("미리 스캔된 WiFi 목록 저장 완료");
-    } else {
-        apListJson = "";
-        Serial.println("WiFi 목록이 비어있음");
+    LOG_I(ble, "BLE 서버 시작. 클라이언트 연결 대기...");
+}
+
+void deinitBLE(bool releaseControllerMemory) {
+    if (pServer == nullptr) {
+        return;
+    }
+    LOG_I(ble, "BLE 정지...");
+
+    // 연결된 클라이언트에게 정상 종료를 알린 뒤 광고와 스택을 정지
+    if (isBleClientConnected) {
+        pServer->disconnect(pServer->getConnId());
     }
+    BLEDevice::stopAdvertising();
+    BLEDevice::deinit(releaseControllerMemory);
+
+    // 스택이 정지되었으므로 남은 이벤트와 전송 상태는 폐기
+    while (peekBleEvent() != nullptr) {
+        releaseBleEvent();
+    }
+    resetBleTransport();
+    resetBleSensorStream();
+    isBleClientConnected = false;
+    requestFirstMsgSend = false;
+    wifiListReplyPending = false;
+
+    // Arduino BLE 라이브러리는 서버/서비스 객체 해제를 지원하지 않으므로
+    // 다시 시작할 때 initBLE()에서 새로 생성함 (수동 트리거 시에만 발생하는 소량의 누수)
+    pServer = nullptr;
+    pCharacteristic = nullptr;
 }
 
 void handleBLE() {
+    // 스택 콜백에서 쌓인 이벤트를 순서대로 처리
+    const BleEvent* event;
+    while ((event = peekBleEvent()) != nullptr) {
+        handleBleEvent(*event);
+        releaseBleEvent();
+    }
+
     // 클라이언트가 방금 연결되어 첫 메시지 전송이 필요할 경우
-    if (requestFirstMsgSend) {
+    // (클라이언트가 서비스를 탐색할 시간을 준 뒤 전송, 루프는 블로킹하지 않음)
+    if (requestFirstMsgSend && (long)(millis() - firstMsgSendAtMs) >= 0) {
         requestFirstMsgSend = false;
-        delay(500); // 클라이언트가 서비스를 탐색할 시간을 줌
         bleRetryCounter = 0;
         
-        // 미리 스캔된 WiFi 목록 전송
-        Serial.println("BLE 클라이언트 연결됨, 저장된 WiFi 목록 전송");
-        if (apListJson.length() > 0) {
-            sendBleData(apListJson);
-        } else {
-            Serial.println("저장된 WiFi 목록이 없음");
-            String uid = getMacAddress();
-            String emptyList = "{\"macid\":\"" + uid + "\",\"numAp\":0,\"aplist\":[]}";
-            sendBleData(emptyList);
+        // 캐시된 WiFi 목록 전송 (캐시가 없으면 스캔 완료 후 전송)
+        LOG_I(ble, "BLE 클라이언트 연결됨, 저장된 WiFi 목록 전송");
+        sendWifiList();
+    }
+
+    // 스캔 완료를 기다리던 WiFi 목록 응답 처리
+    if (wifiListReplyPending) {
+        if (hasWifiScanResults()) {
+            wifiListReplyPending = false;
+            sendBleData(getWifiScanJson(getMacAddress()));
+        } else if (!isWifiScanInProgress() && millis() - lastScanRequestMs >= 1000) {
+            // 드라이버가 스캔을 거부한 경우(연결 진행 중 등) 1초 후 재시도
+            lastScanRequestMs = millis();
+            startWifiScan();
         }
     }
     
-    // 클라이언트로부터 새로운 데이터가 수신되었을 경우
-    if (newBleDataReceived) {
-        newBleDataReceived = false;
-        Serial.print("BLE로 수신된 데이터: ");
-        Serial.println(receivedBleData);
-        processBleData(receivedBleData);
+    // 전송 계층의 ACK/NACK 응답 및 재전송 처리
+    handleBleTransport();
+
+    // 센서 스트림 배치 전송
+    handleBleSensorStream();
+
+}
+
+// 이벤트 한 건을 메인 루프 컨텍스트에서 처리
+static void handleBleEvent(const BleEvent& event) {
+    switch (event.type) {
+        case BleEventType::connect:
+            resetBleTransport();
+            isBleClientConnected = true;
+            if (event.length == 6) {
+                setBleSensorStreamPeer(event.data);
+            }
+            requestFirstMsgSend = true; // 연결되면 첫 메시지(AP 목록) 전송을 요청
+            firstMsgSendAtMs = millis() + 500;
+            LOG_I(ble, "BLE 클라이언트 연결");
+            break;
+
+        case BleEventType::mtuChanged:
+            setBleTransportMtu(event.value);
+            setBleSensorStreamMtu(event.value);
+            LOG_I(ble, "BLE MTU 협상: %u", (unsigned)event.value);
+            break;
+
+        case BleEventType::write: {
+            if (isBleFrame(event.data, event.length)) {
+                // 프레임은 재조립하여 메시지가 완성되었을 때만 처리
+                const char* message = nullptr;
+                size_t messageLength = 0;
+                if (handleBleFrame(event.data, event.length, &message, &messageLength)) {
+                    LOG_D(ble, "BLE로 수신된 데이터: %s", message);
+                    processBleData(String(message));
+                }
+            } else {
+                const char* message = reinterpret_cast<const char*>(event.data);
+                LOG_D(ble, "BLE로 수신된 데이터: %s", message);
+                processBleData(String(message));
+            }
+            break;
+        }
+
+        case BleEventType::disconnect:
+            isBleClientConnected = false;
+            requestFirstMsgSend = false;
+            resetBleTransport();
+            resetBleSensorStream();
+            LOG_I(ble, "BLE 클라이언트 연결 끊김");
+            // 연결이 끊어지면 다시 광고를 시작하여 다른 기기가 찾을 수 있도록 함
+            pServer->getAdvertising()->start();
+
+            // 재부팅이 요청된 상태에서 연결이 끊어졌다면 재부팅 수행
+            if (rebootRequested) {
+                LOG_I(ble, "재부팅 요청됨...");
+                flushLogs();
+                delay(500);
+                ESP.restart();
+            }
+            break;
+    }
+
+    if (getBleEventDropCount() > 0) {
+        static uint32_t reportedDrops = 0;
+        if (getBleEventDropCount() != reportedDrops) {
+            reportedDrops = getBleEventDropCount();
+            LOG_W(ble, "BLE 이벤트 큐 가득 참, 누적 유실 %lu건", (unsigned long)reportedDrops);
+        }
     }
 }
 
 void sendBleData(const String& data) {
     if (isBleClientConnected) {
-        const int maxChunkSize = 500; // BLE MTU 제한을 고려한 청크 크기
-        int dataLength = data.length();
-        
-        if (dataLength <= maxChunkSize) {
-            // 데이터가 작으면 한 번에 전송
-            pCharacteristic->setValue(data.c_str());
-            pCharacteristic->notify();
-            Serial.print("BLE로 전송된 데이터: ");
-            Serial.println(data);
-        } else {
-            // 데이터가 크면 청크로 나누어 전송
-            Serial.print("큰 데이터를 청크로 나누어 전송 (총 ");
-            Serial.print(dataLength);
-            Serial.println(" 바이트)");
-            
-            for (int i = 0; i < dataLength; i += maxChunkSize) {
-                int chunkSize = min(maxChunkSize, dataLength - i);
-                String chunk = data.substring(i, i + chunkSize);
-                
-                pCharacteristic->setValue(chunk.c_str());
-                pCharacteristic->notify();
-                
-                Serial.print("청크 ");
-                Serial.print(i / maxChunkSize + 1);
-                Serial.print(" 전송 (");
-                Serial.print(chunkSize);
-                Serial.print(" 바이트): ");
-                Serial.println(chunk.substring(0, min(50, chunkSize)) + "...");
-                
-                delay(50); // 청크 간 짧은 지연
-            }
-            Serial.println("모든 청크 전송 완료");
-        }
+        // MTU 크기 프레임으로 나누어 전송 (프레임 모드가 아니면 기존 청크 방식)
+        sendBleMessage(data.c_str(), data.length());
     } else {
-        Serial.println("데이터 전송 실패, BLE 클라이언트가 연결되지 않음.");
+        LOG_W(ble, "데이터 전송 실패, BLE 클라이언트가 연결되지 않음.");
     }
 }
 
@@ -174,13 +260,12 @@ void processBleData(const String& data) {
     DeserializationError error = deserializeJson(doc, data);
 
     if (error) {
-        Serial.print("deserializeJson() 실패: ");
-        Serial.println(error.c_str());
+        LOG_W(ble, "deserializeJson() 실패: %s", error.c_str());
         
         // JSON 파싱 실패 시 스캔 명령어만 확인
         if (data == "scan" || data.indexOf("scan") >= 0) {
-            Serial.println("스캔 명령어 감지, Wi-Fi 목록 재전송");
-            sendBleData(apListJson);
+            LOG_I(ble, "스캔 명령어 감지, Wi-Fi 목록 재전송");
+            sendWifiList();
             return;
         }
         
@@ -189,21 +274,21 @@ void processBleData(const String& data) {
 
     // 클라이언트가 Wi-Fi 목록을 요청하는 경우 추가
     if (doc["request_wifi_list"].is<JsonVariant>()) {
-        Serial.println("Wi-Fi 목록 재요청 받음");
-        sendBleData(apListJson);
+        LOG_I(ble, "Wi-Fi 목록 재요청 받음");
+        sendWifiList();
         return;
     }
 
     // 클라이언트가 AP 목록을 잘 받았다는 응답 처리
     if (doc["received_ap_list"].is<JsonVariant>()) {
         if (doc["received_ap_list"] == 1) {
-            Serial.println("클라이언트가 AP 목록을 잘 받았다는 응답");
+            LOG_I(ble, "클라이언트가 AP 목록을 잘 받았다는 응답");
             bleRetryCounter = 0;
         } else {
-            Serial.println("클라이언트가 AP 목록을 잘 받지 못함. 재시도...");
+            LOG_I(ble, "클라이언트가 AP 목록을 잘 받지 못함. 재시도...");
             if (bleRetryCounter < MAX_BLE_RETRY) {
                 bleRetryCounter++;
-                sendBleData(apListJson);
+                sendWifiList();
             }
         }
     }
@@ -212,13 +297,11 @@ void processBleData(const String& data) {
         String new_ssid = doc["ssid"];
         String new_password = doc["passwd"];
 
-        Serial.println("BLE로 수신된 새로운 WiFi 자격 증명:");
-        Serial.print("SSID: ");
-        Serial.println(new_ssid);
-        Serial.print("Password: ");
-        Serial.println(new_password);
+        LOG_I(ble, "BLE로 수신된 새로운 WiFi 자격 증명:");
+        LOG_I(ble, "SSID: %s", new_ssid.c_str());
+        LOG_D(ble, "Password: %u자", (unsigned)new_password.length());
 
-        // 새 정보를 EEPROM에 저장
+        // 새 정보를 설정 저장소(NVS)에 저장
         saveWiFiCredentials(new_ssid, new_password);
 
         // 전역 ssid/password 갱신 후 즉시 Wi‑Fi 재연결 시도
@@ -229,7 +312,21 @@ void processBleData(const String& data) {
 
         // 응답 전송
         sendBleData("{\"status\":\"credentials_received\"}");
-        Serial.println("자격 증명 저장 및 즉시 WiFi 재연결 시도 완료.");
+        LOG_I(ble, "자격 증명 저장 및 즉시 WiFi 재연결 시도 완료.");
+    }
+}
+
+// 캐시된 WiFi 목록을 즉시 전송하고, 만료되었으면 연결을 유지한 채 백그라운드로 갱신
+static void sendWifiList() {
+    if (!isWifiScanCacheFresh()) {
+        lastScanRequestMs = millis();
+        startWifiScan();
+    }
+    if (hasWifiScanResults()) {
+        sendBleData(getWifiScanJson(getMacAddress()));
+    } else {
+        LOG_I(ble, "저장된 WiFi 목록 없음, 스캔 완료 후 전송");
+        wifiListReplyPending = true;
     }
 }
 
@@ -11,9 +11,16 @@
 
 /**
  * @brief BLE 서버를 초기화하고 광고를 시작
- * @param uid 디바이스의 고유 ID(MAC 주소)로, Wi-Fi 스캔 결과를 전송할 때 사용
+ * Wi-Fi 목록은 wifi_scanner의 캐시를 사용하므로 미리 스캔할 필요가 없음
  */
-void initBLE(const String& uid, const String& preScannedWifiList = "");
+void initBLE();
+
+/**
+ * @brief BLE 연결을 끊고 Bluedroid 호스트와 컨트롤러를 정지하여 메모리를 해제
+ * 수명 주기 관리는 ble_lifecycle 모듈에서 담당하며, 정지 후 initBLE()로 다시 시작할 수 있음
+ * @param releaseControllerMemory true면 컨트롤러 메모리까지 힙으로 반환 (재부팅 전까지 재초기화 불가)
+ */
+void deinitBLE(bool releaseControllerMemory);
 
 /**
  * @brief BLE 통신을 처리하는 메인 핸들러 함수
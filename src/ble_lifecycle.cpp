@@ -0,0 +1,161 @@
+#include "ble_lifecycle.h"
+#include <esp_heap_caps.h>
+#include "config.h"
+#include "globals.h"
+#include "ble_handler.h"
+#include "wifi_handler.h"   // areWiFiCredentialsAvailable()
+#include "camera_handler.h" // 짧게 누르면 로컬 촬영
+#include "camera_power.h"   // 누르는 순간 센서를 미리 켬
+#include "logger.h"
+
+// 재부팅 후에도 유지되는 BLE 창 요청 표시 (컨트롤러 메모리 반환 후 다시 켤 때 사용)
+// 전원 인가 직후에는 값이 임의이므로 매직 값과 일치할 때만 유효한 요청으로 봄
+#define BLE_WINDOW_REQUEST_MAGIC 0xB1E0C0DEUL
+RTC_NOINIT_ATTR static uint32_t bleWindowRequest;
+
+static BleLifecycleState lifecycleState = BleLifecycleState::off;
+static unsigned long windowEndMs = 0;      // 트리거로 열린 창의 종료 시각 (0이면 창 없음)
+static unsigned long shutdownAtMs = 0;     // 종료 조건이 만족된 뒤 실제 종료 예정 시각 (0이면 미예약)
+static unsigned long buttonPressedAtMs = 0;
+static bool buttonHandled = false;
+static unsigned long offlineSinceMs = 0;
+static size_t reclaimedBytes = 0;
+
+static size_t getFreeInternalHeap() {
+    return heap_caps_get_free_size(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+}
+
+static void startBle() {
+    size_t freeBefore = getFreeInternalHeap();
+    initBLE();
+    lifecycleState = BleLifecycleState::active;
+    shutdownAtMs = 0;
+    size_t freeAfter = getFreeInternalHeap();
+    LOG_I(ble, "BLE 시작: 내부 DRAM %u → %u bytes (사용 %d bytes)",
+               (unsigned)freeBefore, (unsigned)freeAfter, (int)(freeBefore - freeAfter));
+}
+
+static void stopBle() {
+    size_t freeBefore = getFreeInternalHeap();
+#ifdef BLE_RELEASE_CONTROLLER_MEMORY
+    deinitBLE(true);
+    lifecycleState = BleLifecycleState::released;
+#else
+    deinitBLE(false);
+    lifecycleState = BleLifecycleState::off;
+#endif
+    windowEndMs = 0;
+    shutdownAtMs = 0;
+    size_t freeAfter = getFreeInternalHeap();
+    reclaimedBytes = freeAfter > freeBefore ? freeAfter - freeBefore : 0;
+    LOG_I(ble, "BLE 종료%s: 내부 DRAM %u → %u bytes (확보 %u bytes)",
+               lifecycleState == BleLifecycleState::released ? " (컨트롤러 메모리 반환)" : "",
+               (unsigned)freeBefore, (unsigned)freeAfter, (unsigned)reclaimedBytes);
+}
+
+// 트리거 버튼을 BLE_TRIGGER_HOLD_MS 이상 누르면 BLE 창을 엶 (누르고 있는 동안 1회만)
+// 그보다 짧게 눌렀다 떼면 로컬 촬영 (LOCAL_CAPTURE_PRESS_MIN_MS 미만은 채터링으로 무시)
+static void pollTriggerButton(unsigned long now) {
+    if (digitalRead(BLE_TRIGGER_BUTTON_PIN) != LOW) {
+        if (buttonPressedAtMs != 0 && !buttonHandled && now - buttonPressedAtMs >= LOCAL_CAPTURE_PRESS_MIN_MS) {
+            requestLocalCapture("버튼");
+        }
+        buttonPressedAtMs = 0;
+        buttonHandled = false;
+        return;
+    }
+    if (buttonPressedAtMs == 0) {
+        buttonPressedAtMs = now;
+        requestCameraWarmUp("버튼"); // 떼는 순간 촬영하므로 누르는 동안 노출을 수렴시킴
+    } else if (!buttonHandled && now - buttonPressedAtMs >= BLE_TRIGGER_HOLD_MS) {
+        buttonHandled = true;
+        requestBleWindow("버튼");
+    }
+}
+
+void initBleLifecycle(bool provisioned) {
+    pinMode(BLE_TRIGGER_BUTTON_PIN, INPUT_PULLUP);
+
+    bool windowRequested = bleWindowRequest == BLE_WINDOW_REQUEST_MAGIC;
+    bleWindowRequest = 0;
+
+    if (!provisioned) {
+        LOG_I(ble, "미프로비저닝 상태, BLE 시작");
+        startBle();
+    } else if (windowRequested) {
+        LOG_I(ble, "재부팅 전 요청된 BLE 창 시작");
+        startBle();
+        windowEndMs = millis() + BLE_WINDOW_MS;
+    } else {
+        LOG_I(ble, "프로비저닝 완료 상태, BLE 비활성 (버튼으로 활성화 가능)");
+    }
+}
+
+void handleBleLifecycle() {
+    unsigned long now = millis();
+
+    pollTriggerButton(now);
+
+    // 자격 증명이 있어도 오랫동안 WiFi에 연결하지 못하면 재프로비저닝할 수 있도록 BLE 창을 엶
+    if (isWifiConnected) {
+        offlineSinceMs = 0;
+    } else if (offlineSinceMs == 0) {
+        offlineSinceMs = now;
+    } else if (lifecycleState != BleLifecycleState::active && now - offlineSinceMs >= BLE_OFFLINE_TRIGGER_MS) {
+        offlineSinceMs = now;
+        requestBleWindow("WiFi 장기 미연결");
+    }
+
+    if (lifecycleState != BleLifecycleState::active) {
+        return;
+    }
+
+    // 프로비저닝이 끝나 클라우드에 연결되었고 클라이언트가 없으며 트리거 창도 지났을 때만 종료
+    bool windowOpen = windowEndMs != 0 && (long)(now - windowEndMs) < 0;
+    bool canShutdown = areWiFiCredentialsAvailable() && isMqttConnected && !isBleClientConnected && !windowOpen;
+    if (!canShutdown) {
+        shutdownAtMs = 0;
+        return;
+    }
+    if (shutdownAtMs == 0) {
+        // 클라이언트가 결과 메시지를 받고 스스로 연결을 끊을 시간을 줌
+        shutdownAtMs = now + BLE_SHUTDOWN_GRACE_MS;
+        LOG_I(ble, "프로비저닝 완료, %lu ms 후 BLE 종료 예정", (unsigned long)BLE_SHUTDOWN_GRACE_MS);
+    } else if ((long)(now - shutdownAtMs) >= 0) {
+        stopBle();
+    }
+}
+
+void requestBleWindow(const char* reason) {
+    LOG_I(ble, "BLE 창 요청: %s", reason);
+    switch (lifecycleState) {
+        case BleLifecycleState::active:
+            windowEndMs = millis() + BLE_WINDOW_MS;
+            shutdownAtMs = 0;
+            break;
+        case BleLifecycleState::off:
+            startBle();
+            windowEndMs = millis() + BLE_WINDOW_MS;
+            break;
+        case BleLifecycleState::released:
+            // 반환된 컨트롤러 메모리는 되돌릴 수 없으므로 재부팅 후 BLE를 시작
+            LOG_I(ble, "BLE 컨트롤러 메모리가 반환된 상태, 재부팅 후 BLE 시작");
+            bleWindowRequest = BLE_WINDOW_REQUEST_MAGIC;
+            flushLogs();
+            delay(100);
+            ESP.restart();
+            break;
+    }
+}
+
+bool isBleActive() {
+    return lifecycleState == BleLifecycleState::active;
+}
+
+BleLifecycleState getBleLifecycleState() {
+    return lifecycleState;
+}
+
+size_t getBleReclaimedBytes() {
+    return reclaimedBytes;
+}
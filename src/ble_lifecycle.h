@@ -0,0 +1,53 @@
+#ifndef BLE_LIFECYCLE_H
+#define BLE_LIFECYCLE_H
+
+#include <Arduino.h>
+
+/**
+ * @brief BLE 스택의 수명 주기 상태
+ * released는 컨트롤러 메모리까지 힙으로 반환한 상태로, 다시 켜려면 재부팅이 필요함
+ */
+enum class BleLifecycleState : uint8_t {
+    off,
+    active,
+    released
+};
+
+/**
+ * @brief BLE 수명 주기 관리자를 초기화
+ * 미프로비저닝 상태이거나 재부팅 전에 BLE 창이 요청된 경우에만 BLE를 시작함
+ * @param provisioned WiFi 자격 증명이 저장되어 있는지 여부
+ */
+void initBleLifecycle(bool provisioned);
+
+/**
+ * @brief 트리거 버튼 확인 및 프로비저닝 완료 후 BLE 종료를 처리
+ * 메인 loop()에서 계속 호출되어야 함
+ */
+void handleBleLifecycle();
+
+/**
+ * @brief BLE 창을 BLE_WINDOW_MS 동안 열도록 요청 (버튼, MQTT 명령 등)
+ * 컨트롤러 메모리가 반환된 상태라면 재부팅 후 BLE를 시작함
+ * @param reason 로그에 남길 요청 사유
+ */
+void requestBleWindow(const char* reason);
+
+/**
+ * @brief BLE 스택이 현재 동작 중인지 확인
+ * @return true면 handleBLE()를 호출해야 함
+ */
+bool isBleActive();
+
+/**
+ * @brief 현재 BLE 수명 주기 상태를 반환
+ */
+BleLifecycleState getBleLifecycleState();
+
+/**
+ * @brief 마지막 BLE 종료 시 확보된 내부 DRAM 크기를 반환
+ * @return 바이트 단위 (아직 종료된 적이 없으면 0)
+ */
+size_t getBleReclaimedBytes();
+
+#endif // BLE_LIFECYCLE_H
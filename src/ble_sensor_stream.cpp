@@ -0,0 +1,297 @@
+#include "ble_sensor_stream.h"
+#include <BLE2902.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "config.h"
+#include "globals.h"
+#include "sensor_handler.h"
+#include "boot_manager.h"   // 센서 초기화 완료 여부 확인
+#include "ble_transport.h"  // 컨트롤러 혼잡 상태
+#include "logger.h"
+
+// 연결 간격 단위 1.25ms, 감독 타임아웃 단위 10ms
+#define STREAM_CONN_INTERVAL_MIN 6      // 7.5ms
+#define STREAM_CONN_INTERVAL_MAX 12     // 15ms
+#define IDLE_CONN_INTERVAL_MIN 24       // 30ms
+#define IDLE_CONN_INTERVAL_MAX 40       // 50ms
+#define CONN_SUPERVISION_TIMEOUT 400    // 4초
+
+static BLEServer* streamServer = nullptr;
+static BLECharacteristic* streamCharacteristic = nullptr;
+static BLE2902* streamCccd = nullptr;
+static uint8_t peerAddress[6] = {0};
+static bool peerKnown = false;
+static uint16_t streamMtu = 23;
+static bool streaming = false;
+static bool mtuWarned = false;              // MTU 부족 경고는 연결당 한 번만
+
+// 샘플러 태스크 → 메인 루프 링 버퍼
+// 가득 차면 가장 오래된 프레임을 덮어써서 샘플러가 전송 속도에 막히지 않도록 함
+static uint8_t ring[BLE_STREAM_RING_SIZE][BLE_STREAM_FRAME_SIZE];
+static uint16_t ringHead = 0;               // 가장 오래된 프레임 위치
+static uint16_t ringCount = 0;
+static uint32_t ringDropped = 0;            // 누적 유실 수
+static portMUX_TYPE ringMux = portMUX_INITIALIZER_UNLOCKED;
+
+static TaskHandle_t samplerTask = nullptr;
+static volatile bool samplingEnabled = false;
+static uint16_t frameSeq = 0;
+
+// 통계
+static BleStreamStats stats = {0, 0, 0};
+static uint32_t reportedDrops = 0;          // 마지막 배치 헤더에 반영한 유실 수
+static uint32_t windowNotifications = 0;
+static uint32_t windowFrames = 0;
+static unsigned long windowStartMs = 0;
+static unsigned long lastFlushMs = 0;
+
+static void putU16(uint8_t* p, uint16_t v) {
+    p[0] = v & 0xFF;
+    p[1] = v >> 8;
+}
+
+static void putU32(uint8_t* p, uint32_t v) {
+    putU16(p, v & 0xFFFF);
+    putU16(p + 2, v >> 16);
+}
+
+static int16_t clampI16(float v) {
+    if (v > 32767.0f) return 32767;
+    if (v < -32768.0f) return -32768;
+    return (int16_t)v;
+}
+
+static void packFrame(uint8_t* frame, uint16_t seq, uint32_t timestampMs, const SensorData& data) {
+    float lux10 = data.ambientLight * 10.0f;
+    putU16(frame + 0, seq);
+    putU32(frame + 2, timestampMs);
+    putU16(frame + 6, data.proximity);
+    putU16(frame + 8, lux10 >= 65535.0f ? 65535 : (lux10 <= 0.0f ? 0 : (uint16_t)lux10));
+    putU16(frame + 10, (uint16_t)clampI16(data.accelX * 1000.0f));
+    putU16(frame + 12, (uint16_t)clampI16(data.accelY * 1000.0f));
+    putU16(frame + 14, (uint16_t)clampI16(data.accelZ * 1000.0f));
+    putU16(frame + 16, (uint16_t)clampI16(data.gyroX * 10.0f));
+    putU16(frame + 18, (uint16_t)clampI16(data.gyroY * 10.0f));
+    putU16(frame + 20, (uint16_t)clampI16(data.gyroZ * 10.0f));
+}
+
+static void pushFrame(const uint8_t* frame) {
+    portENTER_CRITICAL(&ringMux);
+    if (ringCount == BLE_STREAM_RING_SIZE) {
+        ringHead = (ringHead + 1) % BLE_STREAM_RING_SIZE;
+        ringCount--;
+        ringDropped++;
+    }
+    memcpy(ring[(ringHead + ringCount) % BLE_STREAM_RING_SIZE], frame, BLE_STREAM_FRAME_SIZE);
+    ringCount++;
+    portEXIT_CRITICAL(&ringMux);
+}
+
+// 최대 maxFrames개를 꺼내 out에 연속으로 복사하고 꺼낸 개수를 반환
+static uint16_t popFrames(uint8_t* out, uint16_t maxFrames, uint32_t* droppedTotal) {
+    portENTER_CRITICAL(&ringMux);
+    uint16_t count = ringCount < maxFrames ? ringCount : maxFrames;
+    for (uint16_t i = 0; i < count; i++) {
+        memcpy(out + i * BLE_STREAM_FRAME_SIZE, ring[ringHead], BLE_STREAM_FRAME_SIZE);
+        ringHead = (ringHead + 1) % BLE_STREAM_RING_SIZE;
+    }
+    ringCount -= count;
+    *droppedTotal = ringDropped;
+    portEXIT_CRITICAL(&ringMux);
+    return count;
+}
+
+static uint16_t pendingFrames() {
+    portENTER_CRITICAL(&ringMux);
+    uint16_t count = ringCount;
+    portEXIT_CRITICAL(&ringMux);
+    return count;
+}
+
+static uint32_t droppedFrames() {
+    portENTER_CRITICAL(&ringMux);
+    uint32_t dropped = ringDropped;
+    portEXIT_CRITICAL(&ringMux);
+    return dropped;
+}
+
+static void clearRing() {
+    portENTER_CRITICAL(&ringMux);
+    ringHead = 0;
+    ringCount = 0;
+    ringDropped = 0;
+    portEXIT_CRITICAL(&ringMux);
+}
+
+// 구독 중일 때만 BLE_STREAM_RATE_HZ 주기로 센서를 읽어 링 버퍼에 넣는 태스크
+static void samplerTaskMain(void* parameter) {
+    const TickType_t period = pdMS_TO_TICKS(1000 / BLE_STREAM_RATE_HZ);
+    TickType_t lastWake = xTaskGetTickCount();
+    uint8_t frame[BLE_STREAM_FRAME_SIZE];
+
+    while (true) {
+        if (!samplingEnabled) {
+            vTaskDelay(pdMS_TO_TICKS(50));
+            lastWake = xTaskGetTickCount();
+            continue;
+        }
+        vTaskDelayUntil(&lastWake, period);
+
+        SensorData data = readSensorSample();
+        packFrame(frame, frameSeq++, millis(), data);
+        pushFrame(frame);
+    }
+}
+
+static void requestConnParams(uint16_t minInterval, uint16_t maxInterval) {
+    if (streamServer == nullptr || !peerKnown) {
+        return;
+    }
+    // 실제 간격은 중앙 장치가 결정하므로 요청만 하고 결과는 처리량 통계로 확인
+    streamServer->updateConnParams(peerAddress, minInterval, maxInterval, 0, CONN_SUPERVISION_TIMEOUT);
+}
+
+static void startStreaming() {
+    clearRing();
+    reportedDrops = 0;
+    stats = {0, 0, 0};
+    windowNotifications = 0;
+    windowFrames = 0;
+    windowStartMs = millis();
+    lastFlushMs = windowStartMs;
+    streaming = true;
+
+    if (samplerTask == nullptr) {
+        xTaskCreate(samplerTaskMain, "bleStream", 3072, nullptr, 2, &samplerTask);
+    }
+    samplingEnabled = true;
+
+    requestConnParams(STREAM_CONN_INTERVAL_MIN, STREAM_CONN_INTERVAL_MAX);
+    LOG_I(ble, "BLE 센서 스트림 시작 (%d Hz)", BLE_STREAM_RATE_HZ);
+}
+
+static void stopStreaming() {
+    samplingEnabled = false;
+    streaming = false;
+    stats.droppedFrames = droppedFrames();
+    clearRing();
+    LOG_I(ble, "BLE 센서 스트림 중지 (누적 유실 %lu 프레임)", (unsigned long)stats.droppedFrames);
+}
+
+static void sendBatch(uint16_t maxFrames) {
+    static uint8_t batch[BLE_STREAM_BATCH_HEADER_SIZE + BLE_STREAM_FRAME_SIZE * BLE_STREAM_RING_SIZE];
+    uint32_t droppedTotal = 0;
+    uint16_t count = popFrames(batch + BLE_STREAM_BATCH_HEADER_SIZE, maxFrames, &droppedTotal);
+    if (count == 0) {
+        return;
+    }
+
+    uint32_t droppedDelta = droppedTotal - reportedDrops;
+    reportedDrops = droppedTotal;
+    stats.droppedFrames = droppedTotal;
+
+    batch[0] = BLE_STREAM_BATCH_TYPE;
+    batch[1] = (uint8_t)count;
+    putU16(batch + 2, droppedDelta > 0xFFFF ? 0xFFFF : (uint16_t)droppedDelta);
+
+    streamCharacteristic->setValue(batch, BLE_STREAM_BATCH_HEADER_SIZE + count * BLE_STREAM_FRAME_SIZE);
+    streamCharacteristic->notify();
+
+    windowNotifications++;
+    windowFrames += count;
+}
+
+void initBleSensorStream(BLEServer* server, BLEService* service) {
+    streamServer = server;
+    streamCharacteristic = service->createCharacteristic(
+        SENSOR_STREAM_CHARACTERISTIC_UUID,
+        BLECharacteristic::PROPERTY_NOTIFY
+    );
+    streamCccd = new BLE2902();
+    streamCharacteristic->addDescriptor(streamCccd);
+    streaming = false;
+    peerKnown = false;
+    streamMtu = 23;
+    mtuWarned = false;
+}
+
+void setBleSensorStreamPeer(const uint8_t* address) {
+    memcpy(peerAddress, address, sizeof(peerAddress));
+    peerKnown = true;
+}
+
+void setBleSensorStreamMtu(uint16_t mtu) {
+    streamMtu = mtu;
+}
+
+void resetBleSensorStream() {
+    if (streaming) {
+        stopStreaming();
+    }
+    peerKnown = false;
+    streamMtu = 23;
+    mtuWarned = false;
+}
+
+void handleBleSensorStream() {
+    if (streamCharacteristic == nullptr) {
+        return;
+    }
+
+    // 클라이언트가 CCCD로 알림을 켰을 때만 샘플링 (센서 초기화 완료 후)
+    bool subscribed = isBleClientConnected && streamCccd->getNotifications() &&
+                      isBootPhaseDone(BootPhase::sensors);
+    if (subscribed && streamMtu < BLE_STREAM_MIN_MTU) {
+        if (!mtuWarned) {
+            mtuWarned = true;
+            LOG_W(ble, "BLE 스트림: MTU %u < %d, 프레임이 잘리므로 MTU 협상 전까지 시작하지 않음",
+                       streamMtu, BLE_STREAM_MIN_MTU);
+        }
+        subscribed = false;
+    }
+    if (subscribed != streaming) {
+        if (subscribed) {
+            startStreaming();
+        } else {
+            stopStreaming();
+            if (isBleClientConnected) {
+                requestConnParams(IDLE_CONN_INTERVAL_MIN, IDLE_CONN_INTERVAL_MAX);
+            }
+        }
+    }
+    if (!streaming) {
+        return;
+    }
+
+    // MTU가 허용하는 만큼 프레임을 모았거나 BLE_STREAM_FLUSH_MS가 지났으면 한 번에 전송
+    // 컨트롤러가 혼잡하면 스택이 알림을 버리므로 보내지 않고, 밀린 프레임은 링 버퍼가 덮어쓰며 유실로 셈
+    unsigned long now = millis();
+    uint16_t maxFrames = (streamMtu - 3 - BLE_STREAM_BATCH_HEADER_SIZE) / BLE_STREAM_FRAME_SIZE;
+    if (maxFrames > BLE_STREAM_RING_SIZE) {
+        maxFrames = BLE_STREAM_RING_SIZE;
+    }
+    uint16_t pending = pendingFrames();
+    if (!isBleLinkCongested() &&
+        (pending >= maxFrames || (pending > 0 && now - lastFlushMs >= BLE_STREAM_FLUSH_MS))) {
+        lastFlushMs = now;
+        sendBatch(maxFrames);
+    }
+
+    // 처리량 통계 갱신 및 로그
+    unsigned long elapsed = now - windowStartMs;
+    if (elapsed >= BLE_STREAM_STATS_INTERVAL_MS) {
+        stats.notificationsPerSec = (uint16_t)(windowNotifications * 1000UL / elapsed);
+        stats.framesPerSec = (uint16_t)(windowFrames * 1000UL / elapsed);
+        stats.droppedFrames = droppedFrames(); // 혼잡으로 배치를 못 보낸 동안의 유실도 반영
+        LOG_I(ble, "BLE 스트림: 알림 %u/s, 프레임 %u/s, 누적 유실 %lu (MTU %u)",
+                   stats.notificationsPerSec, stats.framesPerSec,
+                   (unsigned long)stats.droppedFrames, streamMtu);
+        windowNotifications = 0;
+        windowFrames = 0;
+        windowStartMs = now;
+    }
+}
+
+BleStreamStats getBleStreamStats() {
+    return stats;
+}
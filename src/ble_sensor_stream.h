@@ -0,0 +1,69 @@
+#ifndef BLE_SENSOR_STREAM_H
+#define BLE_SENSOR_STREAM_H
+
+#include <Arduino.h>
+#include <BLEServer.h>
+
+// --- 스트림 알림 형식 (SENSOR_STREAM_CHARACTERISTIC_UUID, Notify 전용) ---
+// 배치 헤더 4바이트 뒤에 프레임이 이어짐 (모두 little-endian)
+// [0] 타입 0xC1
+// [1] 프레임 수
+// [2..3] 이전 배치 이후 유실된 프레임 수 (65535에서 포화)
+//
+// 프레임 22바이트
+// [0..1]   시퀀스 번호 (uint16, 순환)
+// [2..5]   샘플 시각 millis() (uint32)
+// [6..7]   근접 (uint16)
+// [8..9]   조도 x10 lux (uint16, 포화)
+// [10..15] 가속도 x/y/z mg (int16)
+// [16..21] 자이로 x/y/z 0.1 dps (int16)
+#define BLE_STREAM_BATCH_TYPE 0xC1
+#define BLE_STREAM_BATCH_HEADER_SIZE 4
+#define BLE_STREAM_FRAME_SIZE 22
+// 알림 하나에 헤더와 프레임 하나가 들어가는 최소 ATT MTU (ATT notify 오버헤드 3바이트 포함)
+// 기본 MTU 23에서는 잘린 프레임이 가므로 이보다 작으면 스트림을 시작하지 않음
+#define BLE_STREAM_MIN_MTU (3 + BLE_STREAM_BATCH_HEADER_SIZE + BLE_STREAM_FRAME_SIZE)
+
+// 스트림 처리량 통계 (BLE_STREAM_STATS_INTERVAL_MS마다 갱신)
+struct BleStreamStats {
+    uint16_t notificationsPerSec;   // 초당 전송한 알림 수
+    uint16_t framesPerSec;          // 초당 전송한 프레임 수
+    uint32_t droppedFrames;         // 스트림 시작 이후 버퍼 초과로 버린 프레임 수 (오래된 것부터, 혼잡으로 밀린 것 포함)
+};
+
+/**
+ * @brief 센서 스트림 특성을 생성합니다. initBLE()에서 서비스 시작 전에 호출합니다.
+ * @param server 연결 파라미터 갱신에 사용할 BLE 서버
+ * @param service 특성을 추가할 서비스
+ */
+void initBleSensorStream(BLEServer* server, BLEService* service);
+
+/**
+ * @brief 연결된 클라이언트의 주소를 기록합니다. (연결 간격 협상용)
+ * @param address 6바이트 BD 주소
+ */
+void setBleSensorStreamPeer(const uint8_t* address);
+
+/**
+ * @brief 협상된 ATT MTU를 기록합니다. 배치당 프레임 수를 결정합니다.
+ * BLE_STREAM_MIN_MTU 미만이면 알림을 켜도 스트림을 시작하지 않습니다.
+ */
+void setBleSensorStreamMtu(uint16_t mtu);
+
+/**
+ * @brief 스트림을 중지하고 버퍼를 비웁니다. 연결 해제/BLE 정지 시 호출합니다.
+ */
+void resetBleSensorStream();
+
+/**
+ * @brief 구독 상태를 확인하고 쌓인 프레임을 배치로 묶어 알림을 전송합니다.
+ * handleBLE()에서 계속 호출되어야 하며, 샘플링은 별도 태스크에서 진행됩니다.
+ */
+void handleBleSensorStream();
+
+/**
+ * @brief 마지막 통계 구간의 스트림 처리량과 누적 유실 수를 반환합니다.
+ */
+BleStreamStats getBleStreamStats();
+
+#endif // BLE_SENSOR_STREAM_H
@@ -0,0 +1,294 @@
+#include "ble_transport.h"
+#include "globals.h"
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "logger.h"
+
+// 스택이 notify 요청을 거부했을 때(GATT 오류 등) 프레임당 최대 재시도 횟수
+static const uint8_t NOTIFY_MAX_RETRIES = 5;
+
+// 모듈 내부에서만 사용할 변수
+static BLECharacteristic* transportCharacteristic = nullptr;
+static volatile uint16_t negotiatedMtu = 23; // BLE 기본 ATT MTU
+static volatile bool framingEnabled = false;
+static volatile bool lastNotifyAccepted = true;
+static volatile bool linkCongested = false;
+static uint8_t notifyCredits = BLE_NOTIFY_CREDITS;
+static unsigned long creditUpdatedMs = 0;
+
+// 수신 재조립 상태
+static char rxBuffer[BLE_MAX_MESSAGE_SIZE + 1];
+static uint8_t rxMessageId = 0;
+static uint16_t rxExpectedSeq = 0;
+static uint16_t rxTotalLength = 0;
+static size_t rxReceived = 0;
+static bool rxActive = false;
+
+// 송신 보관 버퍼 (NACK 시 재전송용)
+static char txBuffer[BLE_MAX_MESSAGE_SIZE];
+static size_t txLength = 0;
+static uint8_t txMessageId = 0;
+
+// 프레임 처리 중 예약하고 handleBleTransport()에서 전송하는 응답
+static volatile bool ackPending = false;
+static volatile bool nackPending = false;
+static volatile uint8_t pendingResponseId = 0;
+static volatile uint16_t pendingNackSeq = 0;
+static volatile bool retransmitPending = false;
+static volatile uint16_t retransmitFromSeq = 0;
+
+// 내부 함수 프로토타입
+static size_t framePayloadSize();
+static bool waitForLinkCapacity();
+static bool notifyValue(uint8_t* data, size_t length);
+static bool sendDataFrames(uint16_t fromSeq);
+static void sendControlFrame(uint8_t type, uint8_t messageId, uint16_t value);
+static void writeHeader(uint8_t* frame, uint8_t type, uint8_t messageId, uint16_t seq, uint16_t value);
+
+// 함수 구현
+
+void initBleTransport(BLECharacteristic* characteristic) {
+    transportCharacteristic = characteristic;
+    resetBleTransport();
+}
+
+void resetBleTransport() {
+    negotiatedMtu = 23;
+    framingEnabled = false;
+    rxActive = false;
+    rxReceived = 0;
+    txLength = 0;
+    ackPending = false;
+    nackPending = false;
+    retransmitPending = false;
+    linkCongested = false;
+    notifyCredits = BLE_NOTIFY_CREDITS;
+}
+
+void onBleNotifyStatus(bool accepted) {
+    lastNotifyAccepted = accepted;
+}
+
+void onBleCongestion(bool congested) {
+    linkCongested = congested;
+}
+
+bool isBleLinkCongested() {
+    return linkCongested;
+}
+
+void setBleTransportMtu(uint16_t mtu) {
+    negotiatedMtu = mtu > BLE_MAX_MTU ? BLE_MAX_MTU : mtu;
+}
+
+bool isBleFrame(const uint8_t* data, size_t length) {
+    return length >= BLE_FRAME_HEADER_SIZE &&
+           (data[0] == BLE_FRAME_TYPE_DATA || data[0] == BLE_FRAME_TYPE_ACK || data[0] == BLE_FRAME_TYPE_NACK);
+}
+
+bool handleBleFrame(const uint8_t* data, size_t length, const char** message, size_t* messageLength) {
+    if (!isBleFrame(data, length)) {
+        return false;
+    }
+    // 클라이언트가 프레임을 사용하면 이 연결의 송신도 프레임 모드로 전환
+    framingEnabled = true;
+
+    uint8_t type = data[0];
+    uint8_t messageId = data[1];
+    uint16_t seq = data[2] | (data[3] << 8);
+    uint16_t value = data[4] | (data[5] << 8);
+
+    if (type == BLE_FRAME_TYPE_ACK) {
+        if (messageId == txMessageId) {
+            txLength = 0; // 전달 확인됨, 보관 버퍼 해제
+        }
+        return false;
+    }
+    if (type == BLE_FRAME_TYPE_NACK) {
+        if (messageId == txMessageId && txLength > 0) {
+            retransmitFromSeq = value;
+            retransmitPending = true;
+        }
+        return false;
+    }
+
+    // 데이터 프레임: 첫 프레임에서 새 메시지 시작
+    if (seq == 0) {
+        if (value == 0 || value > BLE_MAX_MESSAGE_SIZE) {
+            LOG_W(ble, "BLE 프레임 길이 오류: %u", (unsigned)value);
+            rxActive = false;
+            return false;
+        }
+        rxActive = true;
+        rxMessageId = messageId;
+        rxTotalLength = value;
+        rxExpectedSeq = 0;
+        rxReceived = 0;
+    }
+
+    if (!rxActive || messageId != rxMessageId || seq != rxExpectedSeq) {
+        // 누락/순서 오류: 기대하는 시퀀스부터 재전송 요청
+        if (rxActive) {
+            pendingResponseId = rxMessageId;
+            pendingNackSeq = rxExpectedSeq;
+            nackPending = true;
+        }
+        return false;
+    }
+
+    size_t payloadLength = length - BLE_FRAME_HEADER_SIZE;
+    if (rxReceived + payloadLength > rxTotalLength) {
+        payloadLength = rxTotalLength - rxReceived;
+    }
+    memcpy(rxBuffer + rxReceived, data + BLE_FRAME_HEADER_SIZE, payloadLength);
+    rxReceived += payloadLength;
+    rxExpectedSeq++;
+
+    if (rxReceived < rxTotalLength) {
+        return false;
+    }
+
+    // 메시지 완성: ACK 예약 후 호출자에게 전달
+    rxActive = false;
+    rxBuffer[rxReceived] = '\0';
+    pendingResponseId = rxMessageId;
+    ackPending = true;
+    *message = rxBuffer;
+    *messageLength = rxReceived;
+    return true;
+}
+
+bool sendBleMessage(const char* data, size_t length) {
+    if (transportCharacteristic == nullptr || !isBleClientConnected) {
+        return false;
+    }
+
+    unsigned long startUs = micros();
+    bool success;
+
+    if (framingEnabled) {
+        if (length > BLE_MAX_MESSAGE_SIZE) {
+            LOG_W(ble, "BLE 메시지가 너무 큼: %u bytes", (unsigned)length);
+            return false;
+        }
+        memcpy(txBuffer, data, length);
+        txLength = length;
+        txMessageId++;
+        success = sendDataFrames(0);
+    } else {
+        // 기존 앱 호환: 헤더 없이 청크 단위 전송
+        size_t chunkSize = min<size_t>(BLE_LEGACY_CHUNK_SIZE, negotiatedMtu - 3);
+        success = true;
+        for (size_t offset = 0; offset < length && success; offset += chunkSize) {
+            if (offset > 0) {
+                delay(BLE_LEGACY_CHUNK_INTERVAL_MS);
+            }
+            size_t size = min(chunkSize, length - offset);
+            success = notifyValue((uint8_t*)(data + offset), size);
+        }
+    }
+
+    unsigned long elapsedUs = micros() - startUs;
+    LOG_I(ble, "BLE 전송 %s: %u bytes, MTU %u, %lu ms, %.1f KB/s (%s)",
+               success ? "완료" : "실패", (unsigned)length, (unsigned)negotiatedMtu,
+               elapsedUs / 1000, elapsedUs > 0 ? (length * 1000.0f) / (elapsedUs * 1.024f) : 0.0f,
+               framingEnabled ? "프레임" : "청크");
+    return success;
+}
+
+void handleBleTransport() {
+    if (ackPending) {
+        ackPending = false;
+        sendControlFrame(BLE_FRAME_TYPE_ACK, pendingResponseId, 0);
+    }
+    if (nackPending) {
+        nackPending = false;
+        sendControlFrame(BLE_FRAME_TYPE_NACK, pendingResponseId, pendingNackSeq);
+    }
+    if (retransmitPending) {
+        retransmitPending = false;
+        LOG_I(ble, "BLE NACK 수신, 시퀀스 %u부터 재전송", (unsigned)retransmitFromSeq);
+        sendDataFrames(retransmitFromSeq);
+    }
+}
+
+
+// 내부(static) 함수 구현
+
+static size_t framePayloadSize() {
+    // ATT notify 오버헤드 3바이트와 프레임 헤더를 제외한 크기
+    return negotiatedMtu - 3 - BLE_FRAME_HEADER_SIZE;
+}
+
+// 혼잡이 풀리고 크레딧이 남을 때까지 한 틱씩 양보 (연결 해제/시간 초과 시 false)
+static bool waitForLinkCapacity() {
+    unsigned long startMs = millis();
+    while (isBleClientConnected) {
+        unsigned long nowMs = millis();
+        uint32_t recovered = (nowMs - creditUpdatedMs) / BLE_NOTIFY_CREDIT_INTERVAL_MS;
+        if (recovered > 0) {
+            notifyCredits = min<uint32_t>(BLE_NOTIFY_CREDITS, notifyCredits + recovered);
+            creditUpdatedMs = nowMs;
+        }
+        if (!linkCongested && notifyCredits > 0) {
+            return true;
+        }
+        if (nowMs - startMs > BLE_NOTIFY_CONGEST_TIMEOUT_MS) {
+            LOG_W(ble, "BLE 전송 혼잡이 %d ms 이상 지속되어 중단", BLE_NOTIFY_CONGEST_TIMEOUT_MS);
+            return false;
+        }
+        vTaskDelay(1);
+    }
+    return false;
+}
+
+// 링크에 여유가 있을 때 보내고, 스택이 요청을 거부한 경우에만 재시도
+static bool notifyValue(uint8_t* data, size_t length) {
+    for (uint8_t attempt = 0; attempt <= NOTIFY_MAX_RETRIES; attempt++) {
+        if (!waitForLinkCapacity()) {
+            return false;
+        }
+        if (notifyCredits == BLE_NOTIFY_CREDITS) {
+            creditUpdatedMs = millis(); // 가득 찬 동안 흐른 시간은 회복에 넣지 않음
+        }
+        transportCharacteristic->setValue(data, length);
+        transportCharacteristic->notify();
+        if (lastNotifyAccepted) {
+            notifyCredits--;
+            return true;
+        }
+        vTaskDelay(1);
+    }
+    return false;
+}
+
+static bool sendDataFrames(uint16_t fromSeq) {
+    static uint8_t frame[BLE_MAX_MTU];
+    size_t payloadSize = framePayloadSize();
+
+    for (size_t offset = (size_t)fromSeq * payloadSize; offset < txLength; offset += payloadSize) {
+        uint16_t seq = offset / payloadSize;
+        size_t size = min(payloadSize, txLength - offset);
+        writeHeader(frame, BLE_FRAME_TYPE_DATA, txMessageId, seq, (uint16_t)txLength);
+        memcpy(frame + BLE_FRAME_HEADER_SIZE, txBuffer + offset, size);
+        if (!notifyValue(frame, BLE_FRAME_HEADER_SIZE + size)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void sendControlFrame(uint8_t type, uint8_t messageId, uint16_t value) {
+    uint8_t frame[BLE_FRAME_HEADER_SIZE];
+    writeHeader(frame, type, messageId, 0, value);
+    notifyValue(frame, sizeof(frame));
+}
+
+static void writeHeader(uint8_t* frame, uint8_t type, uint8_t messageId, uint16_t seq, uint16_t value) {
+    frame[0] = type;
+    frame[1] = messageId;
+    frame[2] = seq & 0xFF;
+    frame[3] = seq >> 8;
+    frame[4] = value & 0xFF;
+    frame[5] = value >> 8;
+}
@@ -0,0 +1,97 @@
+#ifndef BLE_TRANSPORT_H
+#define BLE_TRANSPORT_H
+
+#include <Arduino.h>
+#include <BLECharacteristic.h>
+
+// --- 프레임 형식 (기존 특성(Characteristic) 위에서 동작) ---
+// [0] 타입   : 0xB1 데이터, 0xB2 ACK, 0xB3 NACK
+// [1] 메시지 ID (송신 측이 메시지마다 1씩 증가)
+// [2..3] 시퀀스 번호 (uint16, little-endian, 0부터 시작)
+// [4..5] 데이터: 메시지 전체 길이 / ACK: 0 / NACK: 재전송을 원하는 시퀀스 번호
+// [6..] 데이터 프레임의 페이로드 (MTU - 3 - 헤더 크기까지)
+//
+// 클라이언트가 프레임을 한 번이라도 보내면 해당 연결은 프레임 모드로 전환되며,
+// 그 전까지는 기존 앱과의 호환을 위해 헤더 없는 청크 방식으로 전송합니다.
+#define BLE_FRAME_HEADER_SIZE 6
+#define BLE_FRAME_TYPE_DATA 0xB1
+#define BLE_FRAME_TYPE_ACK 0xB2
+#define BLE_FRAME_TYPE_NACK 0xB3
+
+// 재조립/재전송 버퍼 크기 (한 메시지의 최대 길이)
+#define BLE_MAX_MESSAGE_SIZE 2048
+// 요청할 최대 ATT MTU
+#define BLE_MAX_MTU 517
+// 프레임 모드가 아닐 때의 청크 크기 (기존 앱 호환)
+#define BLE_LEGACY_CHUNK_SIZE 500
+// 기존 앱은 NACK으로 재전송을 요청할 수 없으므로 청크 사이에 고정 간격을 유지
+#define BLE_LEGACY_CHUNK_INTERVAL_MS 50
+
+// --- notify 페이싱 ---
+// notify()의 성공은 스택 큐에 들어갔다는 뜻일 뿐이므로, 컨트롤러 혼잡 이벤트(ESP_GATTS_CONGEST_EVT)가
+// 풀릴 때까지 기다리고 이벤트가 늦더라도 버퍼가 넘치지 않도록 연속 전송을 크레딧으로 제한
+#define BLE_NOTIFY_CREDITS 6             // 연속으로 보낼 수 있는 최대 notify 수
+#define BLE_NOTIFY_CREDIT_INTERVAL_MS 5  // 크레딧 1개가 회복되는 시간
+#define BLE_NOTIFY_CONGEST_TIMEOUT_MS 2000 // 혼잡이 이 시간 이상 지속되면 전송 실패
+
+/**
+ * @brief 전송 계층을 초기화합니다. initBLE()에서 특성 생성 후 호출합니다.
+ */
+void initBleTransport(BLECharacteristic* characteristic);
+
+/**
+ * @brief 연결/해제 시 재조립 상태와 프레임 모드를 초기화합니다.
+ */
+void resetBleTransport();
+
+/**
+ * @brief 협상된 ATT MTU를 기록합니다. (BLE 스택 콜백에서 호출 가능)
+ */
+void setBleTransportMtu(uint16_t mtu);
+
+/**
+ * @brief notify() 요청을 스택이 받아들였는지 기록합니다. 특성 콜백의 onStatus()에서 호출합니다.
+ * 성공은 큐에 들어갔다는 뜻일 뿐 전달을 보장하지 않으므로, 거부된 경우의 재시도에만 사용합니다.
+ */
+void onBleNotifyStatus(bool accepted);
+
+/**
+ * @brief 컨트롤러 혼잡 상태를 기록합니다. GATTS 이벤트 핸들러의 ESP_GATTS_CONGEST_EVT에서 호출합니다.
+ * 혼잡 중에는 다음 notify를 보내지 않고 해제될 때까지 기다립니다.
+ */
+void onBleCongestion(bool congested);
+
+/**
+ * @brief 컨트롤러가 혼잡 상태인지 반환합니다. 센서 스트림은 혼잡 중에 알림을 보내지 않습니다.
+ */
+bool isBleLinkCongested();
+
+/**
+ * @brief 수신 데이터가 전송 계층 프레임인지 확인합니다.
+ */
+bool isBleFrame(const uint8_t* data, size_t length);
+
+/**
+ * @brief 수신 프레임을 처리합니다.
+ * 데이터 프레임은 재조립하고, 순서가 어긋나면 NACK을 예약합니다.
+ * 클라이언트의 ACK/NACK은 송신 버퍼 해제/재전송 예약에 사용됩니다.
+ * @param message 메시지가 완성되면 재조립 버퍼를 가리킴 (NUL 종료)
+ * @param messageLength 완성된 메시지 길이
+ * @return 메시지가 완성되었으면 true
+ */
+bool handleBleFrame(const uint8_t* data, size_t length, const char** message, size_t* messageLength);
+
+/**
+ * @brief 메시지를 전송합니다. 프레임 모드면 MTU 크기 프레임으로 나누어 보내고
+ * 재전송을 위해 보관하며, 아니면 기존 방식의 청크로 보냅니다.
+ * 프레임은 혼잡 이벤트와 크레딧에 맞춰 보내고, 청크는 BLE_LEGACY_CHUNK_INTERVAL_MS 간격을 둡니다.
+ * @return 모든 프레임 전송에 성공하면 true
+ */
+bool sendBleMessage(const char* data, size_t length);
+
+/**
+ * @brief 예약된 ACK/NACK 응답과 재전송을 처리합니다. handleBLE()에서 호출합니다.
+ */
+void handleBleTransport();
+
+#endif // BLE_TRANSPORT_H
@@ -0,0 +1,134 @@
+#include "boot_manager.h"
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/event_groups.h>
+#include <freertos/task.h>
+#include "logger.h"
+
+static const uint8_t PHASE_COUNT = static_cast<uint8_t>(BootPhase::count);
+
+static const char* const PHASE_NAMES[PHASE_COUNT] = {
+    "storage", "pins", "sensors", "camera", "wifi_scan",
+    "ble", "wifi_connect", "mqtt_connect", "first_telemetry"
+};
+
+// 모듈 내부에서만 사용할 변수
+// 시각은 esp_timer 기준(전원 인가 직후부터 증가)이며 마이크로초 단위
+static int64_t phaseStartUs[PHASE_COUNT] = {0};
+static int64_t phaseEndUs[PHASE_COUNT] = {0};
+static bool phaseOk[PHASE_COUNT] = {false};
+static bool (*phaseTaskFunctions[PHASE_COUNT])() = {nullptr};
+
+// 단계 완료 비트 (태스크 간 완료 통지 및 대기용)
+static EventGroupHandle_t phaseDoneBits = nullptr;
+
+static EventGroupHandle_t getPhaseDoneBits() {
+    if (phaseDoneBits == nullptr) {
+        phaseDoneBits = xEventGroupCreate();
+    }
+    return phaseDoneBits;
+}
+
+static void bootPhaseTask(void* parameter) {
+    BootPhase phase = static_cast<BootPhase>(reinterpret_cast<uintptr_t>(parameter));
+    bool ok = phaseTaskFunctions[static_cast<uint8_t>(phase)]();
+    bootPhaseEnd(phase, ok);
+    vTaskDelete(nullptr);
+}
+
+// 함수 구현
+
+void bootPhaseBegin(BootPhase phase) {
+    uint8_t index = static_cast<uint8_t>(phase);
+    if (index >= PHASE_COUNT) {
+        return;
+    }
+    getPhaseDoneBits();
+    phaseStartUs[index] = esp_timer_get_time();
+}
+
+void bootPhaseEnd(BootPhase phase, bool ok) {
+    uint8_t index = static_cast<uint8_t>(phase);
+    if (index >= PHASE_COUNT || isBootPhaseDone(phase)) {
+        return;
+    }
+    phaseEndUs[index] = esp_timer_get_time();
+    phaseOk[index] = ok;
+    xEventGroupSetBits(getPhaseDoneBits(), 1UL << index);
+
+    LOG_I(system, "부팅 단계 %s %s: %lu ms (시작 후 %lu ms)",
+                  PHASE_NAMES[index], ok ? "완료" : "실패",
+                  (unsigned long)(phaseEndUs[index] / 1000),
+                  (unsigned long)((phaseEndUs[index] - phaseStartUs[index]) / 1000));
+}
+
+void startBootPhaseTask(BootPhase phase, bool (*initFunction)(), uint32_t stackSize) {
+    uint8_t index = static_cast<uint8_t>(phase);
+    if (index >= PHASE_COUNT) {
+        return;
+    }
+    phaseTaskFunctions[index] = initFunction;
+    bootPhaseBegin(phase);
+
+    BaseType_t created = xTaskCreate(bootPhaseTask, PHASE_NAMES[index], stackSize,
+                                     reinterpret_cast<void*>(static_cast<uintptr_t>(index)),
+                                     1, nullptr);
+    if (created != pdPASS) {
+        // 태스크를 만들 수 없으면 현재 태스크에서 순차 실행
+        LOG_W(system, "부팅 태스크 생성 실패 (%s), 순차 실행", PHASE_NAMES[index]);
+        bootPhaseEnd(phase, initFunction());
+    }
+}
+
+bool isBootPhaseDone(BootPhase phase) {
+    uint8_t index = static_cast<uint8_t>(phase);
+    return (xEventGroupGetBits(getPhaseDoneBits()) & (1UL << index)) != 0;
+}
+
+bool waitForBootPhase(BootPhase phase, uint32_t timeoutMs) {
+    uint8_t index = static_cast<uint8_t>(phase);
+    EventBits_t bits = xEventGroupWaitBits(getPhaseDoneBits(), 1UL << index,
+                                           pdFALSE, pdTRUE, pdMS_TO_TICKS(timeoutMs));
+    return (bits & (1UL << index)) != 0 && phaseOk[index];
+}
+
+size_t formatBootReportJson(char* buffer, size_t bufferSize) {
+    size_t used = 0;
+    int64_t lastEndUs = 0;
+    for (uint8_t i = 0; i < PHASE_COUNT; i++) {
+        if (phaseEndUs[i] > lastEndUs) {
+            lastEndUs = phaseEndUs[i];
+        }
+    }
+
+    int written = snprintf(buffer, bufferSize, "{\"total_ms\":%lu,\"phases\":{",
+                           (unsigned long)(lastEndUs / 1000));
+    if (written < 0 || (size_t)written >= bufferSize) {
+        return 0;
+    }
+    used = written;
+
+    bool first = true;
+    for (uint8_t i = 0; i < PHASE_COUNT; i++) {
+        // 실행되지 않은 단계(예: 자격 증명이 있어 생략된 스캔)는 제외
+        if (phaseStartUs[i] == 0 && phaseEndUs[i] == 0) {
+            continue;
+        }
+        written = snprintf(buffer + used, bufferSize - used, "%s\"%s\":[%lu,%lu,%d]",
+                           first ? "" : ",", PHASE_NAMES[i],
+                           (unsigned long)(phaseStartUs[i] / 1000),
+                           (unsigned long)(phaseEndUs[i] / 1000),
+                           phaseOk[i] ? 1 : 0);
+        if (written < 0 || (size_t)written >= bufferSize - used) {
+            return 0;
+        }
+        used += written;
+        first = false;
+    }
+
+    written = snprintf(buffer + used, bufferSize - used, "}}");
+    if (written < 0 || (size_t)written >= bufferSize - used) {
+        return 0;
+    }
+    return used + written;
+}
@@ -0,0 +1,62 @@
+#ifndef BOOT_MANAGER_H
+#define BOOT_MANAGER_H
+
+#include <Arduino.h>
+
+// 부팅 단계 (부팅 리포트에 이 순서대로 기록됨)
+enum class BootPhase : uint8_t {
+    storage,        // EEPROM/자격 증명 로드
+    pins,           // GPIO 초기화
+    sensors,        // VCNL4040/BMI270 초기화 (백그라운드 태스크)
+    camera,         // 카메라 초기화 (백그라운드 태스크)
+    wifiScan,       // 프로비저닝용 WiFi 스캔 (자격 증명이 없을 때만)
+    ble,            // BLE 초기화
+    wifiConnect,    // WiFi 연결 시작 → IP 획득
+    mqttConnect,    // MQTT 초기화 → 브로커 연결
+    firstTelemetry, // 첫 센서 데이터 발행
+    count
+};
+
+// formatBootReportJson()에 필요한 최대 버퍼 크기
+#define BOOT_REPORT_BUFFER_SIZE 512
+
+/**
+ * @brief 부팅 단계의 시작 시각을 기록합니다.
+ */
+void bootPhaseBegin(BootPhase phase);
+
+/**
+ * @brief 부팅 단계의 종료 시각과 결과를 기록합니다.
+ * 이미 종료된 단계는 다시 기록하지 않습니다.
+ * @param ok 단계 성공 여부
+ */
+void bootPhaseEnd(BootPhase phase, bool ok = true);
+
+/**
+ * @brief 초기화 함수를 별도 FreeRTOS 태스크에서 실행하여 다른 단계와 병렬로 진행합니다.
+ * 태스크가 끝나면 bootPhaseEnd()가 함수의 반환값으로 호출됩니다.
+ * @param phase 실행할 부팅 단계
+ * @param initFunction 실행할 초기화 함수 (성공 시 true 반환)
+ * @param stackSize 태스크 스택 크기 (bytes)
+ */
+void startBootPhaseTask(BootPhase phase, bool (*initFunction)(), uint32_t stackSize = 4096);
+
+/**
+ * @brief 부팅 단계가 종료되었는지 확인합니다 (성공/실패 무관).
+ */
+bool isBootPhaseDone(BootPhase phase);
+
+/**
+ * @brief 부팅 단계가 종료될 때까지 최대 timeoutMs 동안 기다립니다.
+ * @return 단계가 성공적으로 종료되었으면 true
+ */
+bool waitForBootPhase(BootPhase phase, uint32_t timeoutMs);
+
+/**
+ * @brief 단계별 시작/종료 시각(전원 인가 기준 ms)을 JSON으로 기록합니다.
+ * 예: {"total_ms":2410,"phases":{"storage":[312,318,1],...}}
+ * @return 기록된 문자열 길이. 버퍼가 부족하면 0.
+ */
+size_t formatBootReportJson(char* buffer, size_t bufferSize);
+
+#endif // BOOT_MANAGER_H
@@ -3,39 +3,69 @@
 #include "esp_camera.h"
 #include "WiFiClientSecure.h" // S3 업로드를 위해 필요
 #include <Wire.h> // I2C 통신을 위해 필요
+#include <esp_timer.h>
 
 // 이 모듈이 상호작용해야 하는 다른 핸들러 포함
 #include "wifi_handler.h" 
 #include "sensor_handler.h" // 조도 센서 값을 얻기 위해 필요
 #include "mqtt_handler.h"   // 업로드 완료 후 MQTT 메시지를 보내기 위해 필요
+#include "boot_manager.h"   // 백그라운드 카메라 초기화 완료를 기다리기 위해 필요
+#include "config_store.h"   // 해상도/JPEG 품질 설정
+#include "metrics.h"
+#include "trace.h"
+#include "upload_pacer.h"
+#include "url_pool.h"
+#include "mqtt_image_transfer.h"
+#include "uplink_shaper.h"
+#include "camera_power.h"
+#include "logger.h"
 
 // 모듈 내부에서만 사용할 함수 (업로드 로직)
 static bool uploadImageToS3(camera_fb_t* fb, const String& url);
+static bool uploadImageViaMqtt(camera_fb_t* fb);
+static void publishCaptureDone(bool success, const char* error, const char* rateJson = nullptr);
+
+// 촬영 명령 시 카메라 초기화 완료를 기다리는 최대 시간 (밀리초)
+static const uint32_t CAMERA_READY_TIMEOUT_MS = 5000;
+
+// 초기화 시 프레임 버퍼를 할당한 해상도 (런타임 해상도 변경의 상한)
+static framesize_t maxFrameSize = FRAMESIZE_INVALID;
+
+// 이번 촬영의 업로드 URL 출처("command"/"pool", MQTT 전송이면 nullptr)와 트리거 → 업로드 시작 시간
+// (cdone에 포함, 업로드 전이면 -1)
+static const char* captureUrlSource = "command";
+static int32_t triggerToUploadMs = -1;
+
+// 이번 촬영 요청 시점의 센서 전원 상태와 노출 수렴을 기다린 시간 (cdone의 "cam", 센서를 쓰기 전이면 nullptr)
+static const char* captureCameraState = nullptr;
+static uint32_t cameraWarmWaitMs = 0;
+
+// 대기 중인 로컬 촬영 요청 (메인 루프 태스크 전용)
+static bool localCapturePending = false;
+static int64_t localTriggerUs = 0;
 
 bool initCamera() {
-    Serial.println("=== 카메라 초기화 시작 ===");
-    Serial.flush(); // 즉시 출력
+    LOG_I(camera, "=== 카메라 초기화 시작 ===");
     delay(10);
     
     // 카메라 모델 확인
     #ifdef CAMERA_MODEL_ESP32S3_EYE
-    Serial.println("카메라 모델: ESP32S3_EYE");
+    LOG_I(camera, "카메라 모델: ESP32S3_EYE");
     #else
-    Serial.println("카메라 모델: 알 수 없음");
+    LOG_I(camera, "카메라 모델: 알 수 없음");
     #endif
-    Serial.flush();
     
     // 핀 설정 확인
-    Serial.printf("카메라 핀 설정:\n");
-    Serial.printf("  XCLK: %d, SIOD: %d, SIOC: %d\n", XCLK_GPIO_NUM, SIOD_GPIO_NUM, SIOC_GPIO_NUM);
-    Serial.printf("  VSYNC: %d, HREF: %d, PCLK: %d\n", VSYNC_GPIO_NUM, HREF_GPIO_NUM, PCLK_GPIO_NUM);
-    Serial.printf("  PWDN: %d, RESET: %d\n", PWDN_GPIO_NUM, RESET_GPIO_NUM);
+    LOG_I(camera, "카메라 핀 설정:");
+    LOG_I(camera, "  XCLK: %d, SIOD: %d, SIOC: %d", XCLK_GPIO_NUM, SIOD_GPIO_NUM, SIOC_GPIO_NUM);
+    LOG_I(camera, "  VSYNC: %d, HREF: %d, PCLK: %d", VSYNC_GPIO_NUM, HREF_GPIO_NUM, PCLK_GPIO_NUM);
+    LOG_I(camera, "  PWDN: %d, RESET: %d", PWDN_GPIO_NUM, RESET_GPIO_NUM);
     
     camera_config_t config;
-    Serial.println("camera_config_t 구조체 생성 완료");
+    LOG_I(camera, "camera_config_t 구조체 생성 완료");
     
     // 카메라 설정
-    Serial.println("카메라 기본 설정 시작...");
+    LOG_I(camera, "카메라 기본 설정 시작...");
     config.ledc_channel = LEDC_CHANNEL_0;
     config.ledc_timer = LEDC_TIMER_0;
     config.pin_d0 = Y2_GPIO_NUM;
@@ -58,66 +88,67 @@ bool initCamera() {
     config.pixel_format = PIXFORMAT_JPEG;
     config.grab_mode = CAMERA_GRAB_WHEN_EMPTY;
 
-    Serial.println("핀 설정 완료, PSRAM 확인 중...");
+    LOG_I(camera, "핀 설정 완료, PSRAM 확인 중...");
     
     // PSRAM에 따른 설정 분기
     if(psramFound()){
-        Serial.println("PSRAM 감지됨 - 카메라 촬영 실패 방지 모드로 설정");
+        LOG_W(camera, "PSRAM 감지됨 - 카메라 촬영 실패 방지 모드로 설정");
         
         // ========= 카메라 촬영 실패 방지 설정 =========
-        config.frame_size = FRAMESIZE_UXGA;          // 1600x1200, PSRAM 환경에서 고품질
-        config.jpeg_quality = 10;   // 32(보라색 필터 효과)
+        // 기본 UXGA(1600x1200) / 품질 10, 설정 저장소에서 변경 가능
+        config.frame_size = (framesize_t)getConfigU32(ConfigKey::cameraFrameSize);
+        config.jpeg_quality = getConfigU32(ConfigKey::cameraJpegQuality);   // 32(보라색 필터 효과)
         config.fb_count = 2;
         config.grab_mode = CAMERA_GRAB_LATEST; // CAMERA_GRAB_WHEN_EMPTY
         config.fb_location = CAMERA_FB_IN_PSRAM;
         // ============================================
     } else {
-        Serial.println("PSRAM 없음 - 낮은 품질 설정 사용");
+        LOG_I(camera, "PSRAM 없음 - 낮은 품질 설정 사용");
         config.frame_size = FRAMESIZE_SVGA;           // 800x600
         config.jpeg_quality = 24;                     // 메모리 제약 내에서 품질 상향
         config.fb_count = 1;
         config.fb_location = CAMERA_FB_IN_DRAM;
     }
-    Serial.println("카메라 설정 분기 완료");
+    LOG_I(camera, "카메라 설정 분기 완료");
     
-    Serial.printf("카메라 설정:\n");
-    Serial.printf("  해상도: %d\n", config.frame_size);
-    Serial.printf("  JPEG 품질: %d\n", config.jpeg_quality);
-    Serial.printf("  프레임 버퍼 개수: %d\n", config.fb_count);
-    Serial.printf("  버퍼 위치: %s\n", 
+    LOG_I(camera, "카메라 설정:");
+    LOG_I(camera, "  해상도: %d", config.frame_size);
+    LOG_I(camera, "  JPEG 품질: %d", config.jpeg_quality);
+    LOG_I(camera, "  프레임 버퍼 개수: %d", config.fb_count);
+    LOG_I(camera, "  버퍼 위치: %s", 
                   config.fb_location == CAMERA_FB_IN_PSRAM ? "PSRAM" : "DRAM");
     
     // 카메라 초기화 시도
-    Serial.println("esp_camera_init() 호출 시작...");
+    LOG_I(camera, "esp_camera_init() 호출 시작...");
     esp_err_t err = esp_camera_init(&config);
-    Serial.printf("esp_camera_init() 완료, 결과: 0x%x\n", err);
+    LOG_I(camera, "esp_camera_init() 완료, 결과: 0x%x", err);
     
     if (err != ESP_OK) {
-        Serial.printf("❌ 카메라 초기화 실패, 오류 코드: 0x%x\n", err);
+        LOG_E(camera, "❌ 카메라 초기화 실패, 오류 코드: 0x%x", err);
         
         // 오류 코드별 상세 설명
         switch(err) {
             case ESP_ERR_NO_MEM:
-                Serial.println("  원인: 메모리 부족");
+                LOG_I(camera, "  원인: 메모리 부족");
                 break;
             case ESP_ERR_INVALID_ARG:
-                Serial.println("  원인: 잘못된 인수 (핀 설정 문제 가능성)");
+                LOG_I(camera, "  원인: 잘못된 인수 (핀 설정 문제 가능성)");
                 break;
             case ESP_ERR_INVALID_STATE:
-                Serial.println("  원인: 잘못된 상태 (이미 초기화된 상태)");
+                LOG_I(camera, "  원인: 잘못된 상태 (이미 초기화된 상태)");
                 break;
             case ESP_FAIL:
-                Serial.println("  원인: 일반적인 실패 (하드웨어 연결 문제 가능성)");
+                LOG_W(camera, "  원인: 일반적인 실패 (하드웨어 연결 문제 가능성)");
                 break;
             case 0x263:  // ESP_ERR_NOT_FOUND
-                Serial.println("  원인: 카메라 하드웨어를 찾을 수 없음");
+                LOG_I(camera, "  원인: 카메라 하드웨어를 찾을 수 없음");
                 break;
             default:
-                Serial.printf("  원인: 알 수 없는 오류 (0x%x)\n", err);
+                LOG_W(camera, "  원인: 알 수 없는 오류 (0x%x)", err);
         }
         
         // 복구 시도: 카메라 해제 후 재시도
-        Serial.println("카메라 해제 후 재시도...");
+        LOG_I(camera, "카메라 해제 후 재시도...");
         esp_camera_deinit();
         delay(1000);
         
@@ -127,19 +158,21 @@ bool initCamera() {
         config.fb_count = 1;
         config.fb_location = CAMERA_FB_IN_DRAM;
         
-        Serial.println("낮은 설정으로 재시도 중...");
+        LOG_I(camera, "낮은 설정으로 재시도 중...");
         err = esp_camera_init(&config);
         
         if (err != ESP_OK) {
-            Serial.printf("재시도도 실패: 0x%x\n", err);
+            LOG_W(camera, "재시도도 실패: 0x%x", err);
             return false;
         } else {
-            Serial.println("낮은 설정으로 초기화 성공!");
+            LOG_I(camera, "낮은 설정으로 초기화 성공!");
         }
     } else {
-        Serial.println("✅ 카메라 초기화 성공!");
+        LOG_I(camera, "✅ 카메라 초기화 성공!");
     }
 
+    maxFrameSize = config.frame_size;
+
     // 센서 추가 설정
     sensor_t * s = esp_camera_sensor_get();
     if (s) {
@@ -156,42 +189,117 @@ bool initCamera() {
         s->set_gainceiling(s, GAINCEILING_8X);
         s->set_lenc(s, 1);
 
-        Serial.println("센서 설정 완료 (화질 향상 모드)");
+        LOG_I(camera, "센서 설정 완료 (화질 향상 모드)");
     } else {
-        Serial.println("센서 설정 실패");
+        LOG_W(camera, "센서 설정 실패");
     }
 
     // 카메라 안정화를 위한 대기 시간
-    Serial.println("카메라 안정화 대기 중...");
+    LOG_I(camera, "카메라 안정화 대기 중...");
     delay(1000);
     
-    Serial.println("카메라 초기화 성공");
+    LOG_I(camera, "카메라 초기화 성공");
     
     // 초기화 후 메모리 상태
-    Serial.printf("초기화 후 메모리 상태:\n");
-    Serial.printf("  힙 메모리: %d bytes\n", ESP.getFreeHeap());
-    Serial.printf("  PSRAM: %d bytes\n", ESP.getFreePsram());
+    LOG_I(camera, "초기화 후 메모리 상태:");
+    LOG_I(camera, "  힙 메모리: %d bytes", ESP.getFreeHeap());
+    LOG_I(camera, "  PSRAM: %d bytes", ESP.getFreePsram());
     
     return true;
 }
 
-void triggerCameraCapture(const String& uploadUrl) {
-    Serial.println("이미지 촬영 및 업로드 시작 (강화된 버퍼 플러시 방식)");
+// 저장된 해상도/품질과 목표 크기로 이번 촬영의 센서 설정을 정해 반영
+static void applyRatePlan(sensor_t* s, uint32_t targetBytes, JpegRatePlan& plan) {
+    framesize_t baseFrameSize = (framesize_t)getConfigU32(ConfigKey::cameraFrameSize);
+    if (maxFrameSize != FRAMESIZE_INVALID && baseFrameSize > maxFrameSize) {
+        baseFrameSize = maxFrameSize;
+    }
+    if (targetBytes == JPEG_TARGET_FROM_CONFIG) {
+        targetBytes = getConfigU32(ConfigKey::cameraJpegTargetBytes);
+    }
+    // 목표가 없어도 이전 촬영에서 낮춘 품질/해상도를 기본값으로 되돌림
+    if (jpegRatePlan(targetBytes, baseFrameSize, (int)getConfigU32(ConfigKey::cameraJpegQuality), plan)) {
+        LOG_D(camera, "JPEG 목표 %lu bytes: 품질 %d, 해상도 %d (예상 %lu, 기본 설정 예상 %lu)",
+              (unsigned long)plan.targetBytes, plan.quality, plan.frameSize, (unsigned long)plan.predictedBytes,
+              (unsigned long)plan.baselineBytes);
+    }
+    if (s == nullptr) {
+        return;
+    }
+    if (s->status.framesize != plan.frameSize) {
+        s->set_framesize(s, plan.frameSize);
+    }
+    if (s->status.quality != plan.quality) {
+        s->set_quality(s, plan.quality);
+    }
+}
+
+void triggerCameraCapture(const String& uploadUrl, uint32_t targetBytes) {
+    LOG_I(camera, "이미지 촬영 및 업로드 시작 (강화된 버퍼 플러시 방식)");
+    unsigned long commandMs = millis();
+    // 트리거 시각: 추적 기준 시각(명령 수신/버튼), 추적 중이 아니면 지금
+    int64_t triggerUs = isTraceActive() ? getTraceStartUs() : esp_timer_get_time();
+    triggerToUploadMs = -1;
+    captureCameraState = nullptr;
+    cameraWarmWaitMs = 0;
+
+    // MQTT 전송이면 URL이 필요 없고, URL이 없으면(로컬 촬영, url 없는 촬영 명령) 풀에서 꺼냄
+    // (클라우드 왕복 없이 업로드 시작). 준비/촬영 실패로 URL을 버리지 않도록 촬영 성공 뒤에 꺼내고,
+    // 재고가 아예 없으면 센서를 켜기 전에 실패 처리
+    bool viaMqtt = getConfigU32(ConfigKey::cameraUploadTransport) == UPLOAD_TRANSPORT_MQTT;
+    String url = uploadUrl;
+    bool urlFromPool = !viaMqtt && url.length() == 0;
+    captureUrlSource = viaMqtt ? nullptr : (urlFromPool ? "pool" : "command");
+    if (urlFromPool && getUploadUrlStock() == 0) {
+        incrementMetric(MetricCounter::capturesFailed);
+        publishCaptureDone(false, "no_upload_url");
+        return;
+    }
+
+    // 추적 구간: 각 단계를 열고 닫음 (mqttCallback에서 추적을 시작하지 않았으면 기록하지 않음)
+    TraceSpanId captureSpan = traceSpanBegin("capture");
+
+    // 부팅 직후 명령이 오면 백그라운드 카메라 초기화가 끝날 때까지 대기
+    TraceSpanId span = traceSpanBegin("wait_ready");
+    bool ready = waitForBootPhase(BootPhase::camera, CAMERA_READY_TIMEOUT_MS);
+    traceSpanEnd(span);
+    if (!ready) {
+        LOG_W(camera, "카메라가 준비되지 않음, 촬영 취소");
+        incrementMetric(MetricCounter::capturesFailed);
+        traceSpanEnd(captureSpan);
+        publishCaptureDone(false, "camera_not_ready");
+        return;
+    }
+
+    // 센서가 대기 모드면 켬 (노출 수렴은 아래 플러시/안정화 대기와 겹쳐 진행되고, 남은 시간만 촬영 직전에 기다림)
+    CameraPowerState powerState = beginCameraUse();
+    captureCameraState = cameraPowerStateName(powerState);
 
     // 1단계: 강화된 버퍼 플러시 - 모든 이전 버퍼 완전 제거
-    Serial.println("카메라 버퍼 완전 플러시 중...");
+    LOG_D(camera, "카메라 버퍼 완전 플러시 중...");
+    span = traceSpanBegin("flush");
     for (int i = 0; i < 3; i++) {
         camera_fb_t * dummy_fb = esp_camera_fb_get();
         if (dummy_fb) {
-            Serial.printf("이전 버퍼 %d 제거 완료\n", i + 1);
+            LOG_D(camera, "이전 버퍼 %d 제거 완료", i + 1);
+            // 버리는 프레임도 현재 장면의 크기 표본으로 사용 (노출 수렴 전 프레임 제외)
+            sensor_t* flushSensor = esp_camera_sensor_get();
+            if (flushSensor != nullptr && dummy_fb->format == PIXFORMAT_JPEG && isCameraConverged()) {
+                jpegRateObserve(dummy_fb->len, (uint32_t)dummy_fb->width * dummy_fb->height,
+                                flushSensor->status.quality);
+            }
             esp_camera_fb_return(dummy_fb);
             delay(50); // 버퍼 간 대기
         }
     }
+    traceSpanEnd(span);
     
-    // 2단계: 카메라 센서 강제 리프레시
-    Serial.println("카메라 센서 설정 리프레시...");
+    // 2단계: 카메라 센서 강제 리프레시 (목표 크기에 맞춘 품질/해상도도 여기서 반영, 안정화 대기 후 적용됨)
+    LOG_D(camera, "카메라 센서 설정 리프레시...");
+    span = traceSpanBegin("refresh");
     sensor_t * s = esp_camera_sensor_get();
+    JpegRatePlan ratePlan;
+    applyRatePlan(s, targetBytes, ratePlan);
     if (s) {
         // 센서 설정을 약간 변경했다가 다시 원래대로 (캐시 무효화)
         s->set_brightness(s, 2);
@@ -199,72 +307,173 @@ void triggerCameraCapture(const String& uploadUrl) {
         s->set_brightness(s, 1);
         delay(100);
     }
+    traceSpanEnd(span);
     
     // 3단계: 카메라 센서 충분한 안정화 대기
-    Serial.println("카메라 센서 안정화 대기...");
+    LOG_D(camera, "카메라 센서 안정화 대기...");
+    span = traceSpanBegin("settle");
     delay(500); // 더 긴 대기 시간으로 새로운 이미지 보장
+    traceSpanEnd(span);
+
+    // 센서를 방금 켰으면 자동 노출이 수렴할 때까지 남은 시간 대기
+    span = traceSpanBegin("warm_up");
+    cameraWarmWaitMs = waitCameraConverged();
+    traceSpanEnd(span);
     
     // 4단계: 실제 촬영 수행
-    Serial.println("실제 카메라 촬영 시작...");
+    LOG_D(camera, "실제 카메라 촬영 시작...");
+    span = traceSpanBegin("fb_get");
     camera_fb_t * fb = esp_camera_fb_get();
+    traceSpanEnd(span);
+    unsigned long captureMs = millis();
+    endCameraUse(); // 업로드 중에는 센서가 필요 없음 (유휴 시간은 여기서부터)
     
     if (fb) {
-        Serial.println("✅ 새로운 이미지 촬영 성공!");
-        Serial.printf("촬영 시각: %lu ms\n", millis());
+        LOG_D(camera, "✅ 새로운 이미지 촬영 성공! 촬영 시각: %lu ms", captureMs);
     }
     
     if (!fb) {
-        Serial.println("카메라 촬영 실패!");
-        String pubTopic = getMacAddress() + "/cdone";
-        String payload = "{\"upload\":0,\"error\":\"capture_failed\"}";
-        publishMqttMessage(pubTopic, payload);
+        LOG_W(camera, "카메라 촬영 실패!");
+        incrementMetric(MetricCounter::capturesFailed);
+        traceSpanEnd(captureSpan);
+        publishCaptureDone(false, "capture_failed");
+        return;
+    }
+    if (urlFromPool && !takeUploadUrl(url)) {
+        // 촬영하는 동안 남은 URL이 사용 기준(URL_POOL_MIN_VALIDITY_MS) 아래로 만료됨
+        esp_camera_fb_return(fb);
+        incrementMetric(MetricCounter::capturesFailed);
+        traceSpanEnd(captureSpan);
+        publishCaptureDone(false, "no_upload_url");
         return;
     }
     
-    Serial.printf("이미지 촬영 완료. 크기: %zu bytes\n", fb->len);
+    LOG_I(camera, "이미지 촬영 완료. 크기: %zu bytes", fb->len);
+    observeMetric(MetricHistogram::captureLatencyMs, captureMs - commandMs);
+    observeMetric(powerState == CameraPowerState::warm ? MetricHistogram::captureWarmLatencyMs
+                                                        : MetricHistogram::captureColdLatencyMs,
+                  captureMs - commandMs);
+    LOG_I(camera, "센서 상태 %s, 노출 수렴 대기 %lu ms", captureCameraState, (unsigned long)cameraWarmWaitMs);
+    size_t imageBytes = fb->len;
+    if (s && fb->format == PIXFORMAT_JPEG) {
+        jpegRateObserve(imageBytes, (uint32_t)fb->width * fb->height, s->status.quality);
+    }
 
     // 업로드 (Wi-Fi가 켜져 있으므로 바로 진행)
-    bool success = uploadImageToS3(fb, uploadUrl);
+    // 업로드 중 오류로 조기 반환해도 하위 구간은 upload 구간과 함께 닫힘
+    span = traceSpanBegin("upload");
+    unsigned long uploadStartMs = millis();
+    triggerToUploadMs = (int32_t)((esp_timer_get_time() - triggerUs) / 1000);
+    LOG_I(camera, "트리거 → 업로드 시작 %ld ms (%s)", (long)triggerToUploadMs,
+          viaMqtt ? "MQTT" : captureUrlSource);
+    bool success = viaMqtt ? uploadImageViaMqtt(fb) : uploadImageToS3(fb, url);
+    uint32_t uploadMs = success ? (uint32_t)(millis() - uploadStartMs) : 0;
+    traceSpanEnd(span);
     
     // 프레임 버퍼 메모리 해제
     esp_camera_fb_return(fb);
+    incrementMetric(success ? MetricCounter::capturesOk : MetricCounter::capturesFailed);
+    traceSpanEnd(captureSpan);
+
+    // 목표 크기 대비 결과 (크기 제어를 쓴 촬영만)
+    char rateJson[JPEG_RATE_JSON_BUFFER_SIZE];
+    bool rateControlled = ratePlan.targetBytes > 0 && ratePlan.baselineBytes > 0 &&
+                          formatJpegRateJson(ratePlan, imageBytes, uploadMs, rateJson, sizeof(rateJson)) > 0;
+    if (rateControlled) {
+        LOG_I(camera, "JPEG 크기 %zu / 목표 %lu bytes (품질 %d, 해상도 %d), 업로드 절약 약 %lu ms", imageBytes,
+              (unsigned long)ratePlan.targetBytes, ratePlan.quality, ratePlan.frameSize,
+              (unsigned long)jpegRateSavedMs(ratePlan, imageBytes, uploadMs));
+    }
     
-    // 업로드 완료 후 MQTT로 결과 알림
-    String pubTopic = getMacAddress() + "/cdone";
-    String payload = "{\"upload\":" + String(success ? "1" : "0") + "}";
-    publishMqttMessage(pubTopic, payload);
+    // 업로드 완료 후 MQTT로 결과 알림 (단계별 소요 시간 포함)
+    publishCaptureDone(success, nullptr, rateControlled ? rateJson : nullptr);
 
-    Serial.println("촬영 및 업로드 완료.");
+    // 촬영 → 업로드 완료 시간 (로그 출력 비용 변화 확인용)
+    LOG_I(camera, "촬영 및 업로드 완료. 촬영 → 완료 %lu ms", millis() - captureMs);
+}
+
+void requestLocalCapture(const char* reason) {
+    if (localCapturePending) {
+        LOG_D(camera, "로컬 촬영 요청 무시 (이미 대기 중): %s", reason);
+        return;
+    }
+    localCapturePending = true;
+    localTriggerUs = esp_timer_get_time();
+    LOG_I(camera, "로컬 촬영 요청: %s (URL 재고 %u)", reason, (unsigned)getUploadUrlStock());
+}
+
+void handleLocalCapture() {
+    if (!localCapturePending) {
+        return;
+    }
+    localCapturePending = false;
+    // 요청 시각을 기준으로 추적을 시작해 대기 시간도 업로드 시작 지연에 포함
+    traceBegin("", localTriggerUs);
+    triggerCameraCapture(String());
+    traceEnd();
+}
+
+bool isCameraFrameSizeSupported(uint32_t frameSize) {
+    if (maxFrameSize == FRAMESIZE_INVALID) {
+        return true; // 초기화 전: 초기화 시 이 해상도로 버퍼를 할당
+    }
+    return frameSize <= (uint32_t)maxFrameSize;
+}
+
+bool applyCameraConfig() {
+    if (!isBootPhaseDone(BootPhase::camera) || maxFrameSize == FRAMESIZE_INVALID) {
+        return true;
+    }
+    sensor_t* s = esp_camera_sensor_get();
+    if (s == nullptr) {
+        return false;
+    }
+    framesize_t frameSize = (framesize_t)getConfigU32(ConfigKey::cameraFrameSize);
+    int quality = (int)getConfigU32(ConfigKey::cameraJpegQuality);
+    // 이전 설정으로 채워진 프레임 버퍼는 촬영 시 버퍼 플러시 단계에서 버려짐
+    if (s->set_framesize(s, frameSize) != 0 || s->set_quality(s, quality) != 0) {
+        LOG_W(camera, "카메라 설정 반영 실패");
+        return false;
+    }
+    LOG_I(camera, "카메라 설정 반영: 해상도 %d, JPEG 품질 %d", frameSize, quality);
+    return true;
 }
 
 void testCameraCapture() {
-    Serial.println("=== 카메라 테스트 시작 ===");
+    LOG_I(camera, "=== 카메라 테스트 시작 ===");
+
+    if (!waitForBootPhase(BootPhase::camera, CAMERA_READY_TIMEOUT_MS)) {
+        LOG_I(camera, "카메라가 준비되지 않음");
+        return;
+    }
     
     // 카메라 센서 상태 확인
     sensor_t * s = esp_camera_sensor_get();
     if (!s) {
-        Serial.println("카메라 센서를 가져올 수 없음");
+        LOG_I(camera, "카메라 센서를 가져올 수 없음");
         return;
     }
-    Serial.println("카메라 센서 접근 가능");
+    LOG_I(camera, "카메라 센서 접근 가능");
+    CameraPowerState state = beginCameraUse();
+    LOG_I(camera, "센서 전원 상태: %s", cameraPowerStateName(state));
     
     // 메모리 상태 확인
-    Serial.printf("메모리 상태:\n");
-    Serial.printf("  힙 메모리: %d bytes\n", ESP.getFreeHeap());
-    Serial.printf("  PSRAM: %d bytes\n", ESP.getFreePsram());
+    LOG_I(camera, "메모리 상태:");
+    LOG_I(camera, "  힙 메모리: %d bytes", ESP.getFreeHeap());
+    LOG_I(camera, "  PSRAM: %d bytes", ESP.getFreePsram());
     
     // 테스트 촬영 시도 (강화된 버퍼 플러시 방식)
-    Serial.println("이전 버퍼 완전 플러시 중...");
+    LOG_I(camera, "이전 버퍼 완전 플러시 중...");
     for (int i = 0; i < 3; i++) {
         camera_fb_t * dummy_fb = esp_camera_fb_get();
         if (dummy_fb) {
-            Serial.printf("이전 버퍼 %d 제거 완료\n", i + 1);
+            LOG_I(camera, "이전 버퍼 %d 제거 완료", i + 1);
             esp_camera_fb_return(dummy_fb);
             delay(50);
         }
     }
     
-    Serial.println("센서 설정 리프레시...");
+    LOG_I(camera, "센서 설정 리프레시...");
     if (s) {
         s->set_brightness(s, 2);
         delay(100);
@@ -272,31 +481,32 @@ void testCameraCapture() {
         delay(100);
     }
     
-    Serial.println("센서 안정화 대기...");
+    LOG_I(camera, "센서 안정화 대기...");
     delay(500);
+    waitCameraConverged();
     
-    Serial.println("테스트 촬영 시도 중...");
+    LOG_I(camera, "테스트 촬영 시도 중...");
     camera_fb_t * fb = esp_camera_fb_get();
     
     if (!fb) {
-        Serial.println("테스트 촬영 실패");
+        LOG_W(camera, "테스트 촬영 실패");
         
         // 추가 진단
-        Serial.println("카메라 상태 재확인:");
-        Serial.printf("  PSRAM 사용 가능: %s\n", psramFound() ? "예" : "아니오");
-        Serial.printf("  최소 힙 메모리: %d bytes\n", ESP.getMinFreeHeap());
+        LOG_I(camera, "카메라 상태 재확인:");
+        LOG_I(camera, "  PSRAM 사용 가능: %s", psramFound() ? "예" : "아니오");
+        LOG_I(camera, "  최소 힙 메모리: %d bytes", ESP.getMinFreeHeap());
         
         // 카메라 재설정 시도
-        Serial.println("카메라 센서 재설정 시도...");
+        LOG_I(camera, "카메라 센서 재설정 시도...");
         s->set_framesize(s, FRAMESIZE_VGA); // 더 작은 크기로 시도
         delay(100);
         
         // 재시도 (강화된 버퍼 플러시 포함)
-        Serial.println("재시도 전 버퍼 완전 플러시...");
+        LOG_I(camera, "재시도 전 버퍼 완전 플러시...");
         for (int i = 0; i < 3; i++) {
             camera_fb_t * retry_dummy_fb = esp_camera_fb_get();
             if (retry_dummy_fb) {
-                Serial.printf("재시도 버퍼 %d 제거\n", i + 1);
+                LOG_I(camera, "재시도 버퍼 %d 제거", i + 1);
                 esp_camera_fb_return(retry_dummy_fb);
                 delay(50);
             }
@@ -310,21 +520,23 @@ void testCameraCapture() {
         
         fb = esp_camera_fb_get();
         if (!fb) {
-            Serial.println("재시도 촬영도 실패");
+            LOG_W(camera, "재시도 촬영도 실패");
+            endCameraUse();
             return;
         }
     }
+    endCameraUse();
     
-    Serial.println("테스트 촬영 성공!");
-    Serial.printf("이미지 정보:\n");
-    Serial.printf("  크기: %zu bytes\n", fb->len);
-    Serial.printf("  해상도: %dx%d\n", fb->width, fb->height);
-    Serial.printf("  형식: %d\n", fb->format);
+    LOG_I(camera, "테스트 촬영 성공!");
+    LOG_I(camera, "이미지 정보:");
+    LOG_I(camera, "  크기: %zu bytes", fb->len);
+    LOG_I(camera, "  해상도: %zux%zu", fb->width, fb->height);
+    LOG_I(camera, "  형식: %d", fb->format);
     
     // 메모리 해제
     esp_camera_fb_return(fb);
     
-    Serial.println("=== 카메라 테스트 완료 ===");
+    LOG_I(camera, "=== 카메라 테스트 완료 ===");
 }
 
 
@@ -337,30 +549,30 @@ static bool uploadImageToS3(camera_fb_t* fb, const String& url) {
     String host, path;
     int hostStart = url.indexOf("://") + 3;
     if (hostStart < 3) {
-        Serial.println("❌ URL 형식 오류.");
+        LOG_E(camera, "❌ URL 형식 오류.");
         return false;
     }
     int pathStart = url.indexOf('/', hostStart);
     host = url.substring(hostStart, pathStart);
     path = url.substring(pathStart);
 
-    Serial.printf("S3 업로드 시작:\n");
-    Serial.printf("  호스트: %s\n", host.c_str());
-    Serial.printf("  경로: %s\n", path.c_str());
-    Serial.printf("  이미지 크기: %zu bytes\n", fb->len);
+    LOG_I(camera, "S3 업로드 시작: 호스트 %s, 이미지 크기 %zu bytes", host.c_str(), fb->len);
+    LOG_D(camera, "  경로: %s", path.c_str());
 
     // 2. 보안 클라이언트 설정 및 서버 연결
     WiFiClientSecure uploadClient;
     uploadClient.setCACert(ROOT_CA_CERT); // config.h의 Root CA 사용
     uploadClient.setTimeout(30000); // 30초 타임아웃 설정
     
-    Serial.printf("S3 서버 연결 중: %s\n", host.c_str());
+    LOG_D(camera, "S3 서버 연결 중: %s", host.c_str());
 
+    TraceSpanId span = traceSpanBegin("tls_connect");
     if (!uploadClient.connect(host.c_str(), 443)) {
-        Serial.println("❌ S3 서버 연결 실패!");
+        LOG_E(camera, "❌ S3 서버 연결 실패!");
         return false;
     }
-    Serial.println("✅ S3 서버 연결 성공");
+    traceSpanEnd(span);
+    LOG_D(camera, "✅ S3 서버 연결 성공");
 
     // 3. HTTP PUT 요청 헤더 생성
     String requestHeader = "PUT " + path + " HTTP/1.1\r\n" +
@@ -369,56 +581,73 @@ static bool uploadImageToS3(camera_fb_t* fb, const String& url) {
                          "Content-Length: " + String(fb->len) + "\r\n" +
                          "Connection: close\r\n\r\n";
     
-    Serial.println("HTTP 헤더 전송 중...");
-    Serial.println(requestHeader);
+    LOG_V(camera, "HTTP 헤더 전송 중...\n%s", requestHeader.c_str());
     
     // 4. 헤더와 이미지 데이터 전송
+    span = traceSpanBegin("header");
     uploadClient.print(requestHeader);
+    traceSpanEnd(span);
     
-    Serial.println("이미지 데이터 청크 전송 시작...");
+    LOG_D(camera, "이미지 데이터 청크 전송 시작...");
+    span = traceSpanBegin("body");
     
-    // 큰 이미지를 청크 단위로 나누어 전송 (WiFi 버퍼 제한 해결)
-    const size_t CHUNK_SIZE = 8192; // 8KB 청크 크기
+    // 추정 대역폭으로 정한 청크 단위로 전송하고, 청크 사이에는 추정 송신 버퍼 점유가 줄 때까지만 대기
+    // (write 1회가 TLS 레코드 1개가 되도록 레코드 크기 이하로 나눔)
+    unsigned long bodyStartMs = millis();
+    uploadPacerBegin(WiFi.RSSI());
+    // 본문 전송 ~ 응답 대기 동안 제어/텔레메트리 메시지는 청크 사이에서 먼저 보냄 (serviceUplink)
+    uplinkBulkBegin();
     size_t totalSent = 0;
     size_t remaining = fb->len;
     uint8_t* dataPtr = fb->buf;
     
     while (remaining > 0) {
-        size_t chunkSize = (remaining > CHUNK_SIZE) ? CHUNK_SIZE : remaining;
-        
-        Serial.printf("청크 전송: %zu bytes (진행률: %.1f%%)\n", 
-                      chunkSize, (float)totalSent / fb->len * 100.0);
-        
-        size_t sent = uploadClient.write(dataPtr, chunkSize);
-        
-        if (sent != chunkSize) {
-            Serial.printf("❌ 청크 전송 실패: %zu / %zu bytes\n", sent, chunkSize);
-            uploadClient.stop();
-            return false;
+        serviceUplink(); // 청크(추정 대역폭 × UPLOAD_CHUNK_MS) 사이마다 우선 메시지 처리, 보낸 만큼 아래 대기가 늘어남
+        uint32_t waitMs = uploadPacerWaitMs();
+        if (waitMs > 0) {
+            delay(waitMs);
         }
+        size_t chunkRemaining = min(remaining, uploadPacerChunkBytes());
         
-        totalSent += sent;
-        remaining -= sent;
-        dataPtr += sent;
+        LOG_V(camera, "청크 전송: %zu bytes (진행률: %u%%)",
+                      chunkRemaining, (unsigned)(totalSent * 100 / fb->len));
         
-        // 청크 간 짧은 대기 (버퍼 안정화)
-        if (remaining > 0) {
-            delay(10);
+        while (chunkRemaining > 0) {
+            size_t writeSize = min(chunkRemaining, uploadPacerRecordBytes());
+            uint32_t writeStartUs = micros();
+            size_t sent = uploadClient.write(dataPtr, writeSize);
+            uploadPacerOnWrite(sent, micros() - writeStartUs);
+            
+            if (sent != writeSize) {
+                LOG_E(camera, "❌ 청크 전송 실패: %zu / %zu bytes", sent, writeSize);
+                uploadClient.stop();
+                uplinkBulkEnd();
+                return false;
+            }
+            
+            totalSent += sent;
+            remaining -= sent;
+            chunkRemaining -= sent;
+            dataPtr += sent;
         }
     }
     
-    Serial.printf("✅ 전체 이미지 전송 완료: %zu / %zu bytes\n", totalSent, fb->len);
+    traceSpanEnd(span);
+    LOG_D(camera, "✅ 전체 이미지 전송 완료: %zu / %zu bytes", totalSent, fb->len);
     
     // 5. 서버 응답 확인 (중요!)
-    Serial.println("서버 응답 대기 중...");
+    LOG_D(camera, "서버 응답 대기 중...");
+    span = traceSpanBegin("response");
     unsigned long responseTimeout = millis() + 10000; // 10초 대기
     
     while (uploadClient.connected() && !uploadClient.available()) {
         if (millis() > responseTimeout) {
-            Serial.println("❌ 서버 응답 타임아웃!");
+            LOG_E(camera, "❌ 서버 응답 타임아웃!");
             uploadClient.stop();
+            uplinkBulkEnd();
             return false;
         }
+        serviceUplink();
         delay(10);
     }
     
@@ -432,7 +661,7 @@ static bool uploadImageToS3(camera_fb_t* fb, const String& url) {
         if (isFirstLine) {
             statusLine = line;
             isFirstLine = false;
-            Serial.printf("HTTP 상태: %s\n", statusLine.c_str());
+            LOG_D(camera, "HTTP 상태: %s", statusLine.c_str());
         }
         response += line + "\n";
         
@@ -440,31 +669,92 @@ static bool uploadImageToS3(camera_fb_t* fb, const String& url) {
         if (response.length() > 2048) break;
     }
     
-    Serial.printf("서버 응답:\n%s\n", response.c_str());
+    traceSpanEnd(span);
+    uplinkBulkEnd();
+    uint32_t bodyMs = (uint32_t)(millis() - bodyStartMs);
+    LOG_V(camera, "서버 응답:\n%s", response.c_str());
     
     // HTTP 상태 코드 확인
     bool uploadSuccess = false;
     if (statusLine.indexOf("200") > 0 || statusLine.indexOf("201") > 0) {
         uploadSuccess = true;
-        Serial.println("✅ S3 업로드 성공!");
+        LOG_I(camera, "✅ S3 업로드 성공!");
+        uploadPacerEnd(fb->len, bodyMs);
     } else {
-        Serial.println("❌ S3 업로드 실패!");
-        Serial.printf("상태 코드: %s\n", statusLine.c_str());
+        LOG_E(camera, "❌ S3 업로드 실패! 상태 코드: %s", statusLine.c_str());
         
         // 일반적인 오류 코드 설명
         if (statusLine.indexOf("403") > 0) {
-            Serial.println("원인: 권한 없음 (Presigned URL 만료 또는 잘못된 서명)");
+            LOG_W(camera, "원인: 권한 없음 (Presigned URL 만료 또는 잘못된 서명)");
         } else if (statusLine.indexOf("404") > 0) {
-            Serial.println("원인: 버킷 또는 경로를 찾을 수 없음");
+            LOG_W(camera, "원인: 버킷 또는 경로를 찾을 수 없음");
         } else if (statusLine.indexOf("400") > 0) {
-            Serial.println("원인: 잘못된 요청 (헤더 또는 데이터 문제)");
+            LOG_W(camera, "원인: 잘못된 요청 (헤더 또는 데이터 문제)");
         }
     }
     
     long duration = millis() - startTime;
-    Serial.printf("업로드 처리 완료, 소요 시간: %ld ms, 성공: %s\n", 
-                  duration, uploadSuccess ? "예" : "아니오");
+    LOG_I(camera, "업로드 처리 완료, 소요 시간: %ld ms, 성공: %s",
+          duration, uploadSuccess ? "예" : "아니오");
+    if (uploadSuccess) {
+        // bytes/ms는 약 KB/s (1000/1024 차이는 버킷 폭에 비해 무시)
+        incrementMetric(MetricCounter::uploadBytes, fb->len);
+        observeMetric(MetricHistogram::uploadKBps, (uint32_t)(duration > 0 ? fb->len / (size_t)duration : fb->len));
+    }
     
     uploadClient.stop();
     return uploadSuccess;
-}
\ No newline at end of file
+}
+
+// HTTPS 업로드가 막힌 현장용: MQTT 연결로 청크 전송 (업로드 지표는 HTTPS 경로와 같이 기록)
+static bool uploadImageViaMqtt(camera_fb_t* fb) {
+    unsigned long startMs = millis();
+    bool success = uploadImageOverMqtt(fb->buf, fb->len);
+    if (success) {
+        unsigned long duration = millis() - startMs;
+        incrementMetric(MetricCounter::uploadBytes, fb->len);
+        observeMetric(MetricHistogram::uploadKBps, (uint32_t)(duration > 0 ? fb->len / duration : fb->len));
+    }
+    return success;
+}
+
+// 촬영 결과를 cdone 토픽으로 발행
+// 예: {"upload":1,"url_src":"pool","upload_start_ms":912,"goodput_kbps":812,"cam":{"state":"warm","wait_ms":0},"jpeg":{"target":150000,"bytes":143210,...},"trace":{"id":"a1","us":{"parse":180,...}}}
+static void publishCaptureDone(bool success, const char* error, const char* rateJson) {
+    static char payload[160 + JPEG_RATE_JSON_BUFFER_SIZE + TRACE_STAGES_BUFFER_SIZE];
+    // MQTT 전송이면 url_src 대신 "via":"mqtt"
+    int written = snprintf(payload, sizeof(payload), "{\"upload\":%d,\"%s\":\"%s\"", success ? 1 : 0,
+                           captureUrlSource != nullptr ? "url_src" : "via",
+                           captureUrlSource != nullptr ? captureUrlSource : "mqtt");
+    if (triggerToUploadMs >= 0) {
+        written += snprintf(payload + written, sizeof(payload) - written, ",\"upload_start_ms\":%ld",
+                            (long)triggerToUploadMs);
+    }
+    if (success) {
+        // HTTPS: 본문 전송 시작 → 서버 응답까지의 처리량 (TLS 연결 시간 제외), MQTT: 첫 청크 → 마지막 ACK
+        written += snprintf(payload + written, sizeof(payload) - written, ",\"goodput_kbps\":%lu",
+                            (unsigned long)getUploadGoodputKBps());
+    }
+    if (error != nullptr) {
+        written += snprintf(payload + written, sizeof(payload) - written, ",\"error\":\"%s\"", error);
+    }
+    if (captureCameraState != nullptr) {
+        written += snprintf(payload + written, sizeof(payload) - written, ",\"cam\":{\"state\":\"%s\",\"wait_ms\":%lu}",
+                            captureCameraState, (unsigned long)cameraWarmWaitMs);
+    }
+    if (rateJson != nullptr) {
+        written += snprintf(payload + written, sizeof(payload) - written, ",\"jpeg\":%s", rateJson);
+    }
+    if (isTraceActive()) {
+        memcpy(payload + written, ",\"trace\":", 9);
+        size_t stagesLength = formatTraceStagesJson(payload + written + 9, sizeof(payload) - written - 10);
+        if (stagesLength > 0) {
+            written += 9 + stagesLength; // 버퍼가 부족하면 추적 정보 없이 발행
+        }
+    }
+    payload[written++] = '}';
+
+    TraceSpanId span = traceSpanBegin("cdone");
+    publishMqttMessage(getCaptureDoneTopic(), payload, written);
+    traceSpanEnd(span);
+}
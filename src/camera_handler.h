@@ -2,10 +2,41 @@
 #define CAMERA_HANDLER_H
 
 #include <Arduino.h>
+#include "jpeg_rate_control.h"
 
 bool initCamera();
 
-void triggerCameraCapture(const String& uploadUrl);
+/**
+ * @brief 촬영 후 presigned URL로 업로드하고 결과를 cdone 토픽으로 발행합니다.
+ * @param uploadUrl 비어 있으면 URL 풀에서 꺼내 씀 (없으면 "no_upload_url" 오류로 cdone 발행)
+ * @param targetBytes JPEG 목표 크기 (0이면 저장된 품질 고정, 기본은 설정 저장소의 jpeg_target_bytes)
+ */
+void triggerCameraCapture(const String& uploadUrl, uint32_t targetBytes = JPEG_TARGET_FROM_CONFIG);
 void testCameraCapture(); // 테스트용 함수
 
+/**
+ * @brief 장치에서 발생한 이벤트(버튼 등)로 촬영을 요청합니다. 업로드 URL은 URL 풀에서 꺼냅니다.
+ * 촬영은 다음 handleLocalCapture() 실행에서 하고, 요청 시각부터 업로드 시작까지를 cdone의 upload_start_ms로 보고합니다.
+ * 이미 대기 중인 요청이 있으면 무시합니다.
+ */
+void requestLocalCapture(const char* reason);
+
+/**
+ * @brief 대기 중인 로컬 촬영 요청을 처리합니다. (스케줄러 작업)
+ */
+void handleLocalCapture();
+
+/**
+ * @brief 해당 해상도로 전환할 수 있는지 확인합니다.
+ * 프레임 버퍼는 초기화 시 해상도 기준으로 할당되므로 그보다 큰 해상도는 재초기화 없이 쓸 수 없습니다.
+ */
+bool isCameraFrameSizeSupported(uint32_t frameSize);
+
+/**
+ * @brief 설정 저장소의 해상도/JPEG 품질을 sensor_t 설정 함수로 반영합니다. (esp_camera_deinit 없음)
+ * 카메라 초기화 전이면 초기화 시 저장된 값이 사용되므로 아무것도 하지 않습니다.
+ * @return 센서 설정에 실패하면 false
+ */
+bool applyCameraConfig();
+
 #endif // CAMERA_HANDLER_H
\ No newline at end of file
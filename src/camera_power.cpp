@@ -0,0 +1,242 @@
+#include "camera_power.h"
+#include <math.h>
+#include "config.h" // CAMERA_POWER_*, CAMERA_WAKE_*, 카메라 핀 설정을 위해 포함
+#include "esp_camera.h"
+#include "sensor_handler.h"
+#include "boot_manager.h"
+#include "metrics.h"
+#include "logger.h"
+
+// 근접 값 평소 수준의 지수 평균 가중치 (CAMERA_POWER_CHECK_MS 100ms 기준 시정수 약 1.6초)
+static const float PROXIMITY_BASELINE_WEIGHT = 1.0f / 16.0f;
+
+// 모듈 내부에서만 사용할 변수 (메인 루프 태스크 전용: 스케줄러 작업과 촬영 함수가 같은 태스크에서 실행)
+static bool initialized = false;
+static bool gatingEnabled = false;   // 대기 모드를 쓸 수 있는 센서인지 (아니면 항상 켬)
+static bool sensorsReady = false;
+static CameraPowerState state = CameraPowerState::warm;
+static unsigned long poweredAtMs = 0;      // 마지막으로 켠 시각 (수렴 판단 기준)
+static unsigned long keepWarmUntilMs = 0;  // 이 시각까지는 끄지 않음 (감지/촬영 때마다 연장)
+static unsigned long lastAccountMs = 0;
+static bool inUse = false;
+static bool predictiveWake = false;        // 미리 켠 뒤 아직 촬영에 쓰이지 않음
+static float proximityBaseline = -1.0f;
+static CameraPowerStats stats;
+
+// 센서를 대기 모드로 두거나 깨움 (레지스터 값은 유지되므로 해상도/품질/노출 설정을 다시 쓰지 않음)
+// PWDN 핀이 있는 보드는 핀으로, 없으면(ESP32-S3-EYE) SCCB로 센서별 대기 레지스터를 설정
+static bool setSensorStandby(bool standby) {
+#if PWDN_GPIO_NUM >= 0
+    digitalWrite(PWDN_GPIO_NUM, standby ? HIGH : LOW); // 드라이버가 초기화 시 출력으로 설정
+    return true;
+#else
+    sensor_t* s = esp_camera_sensor_get();
+    if (s == nullptr) {
+        return false;
+    }
+    switch (s->id.PID) {
+        case OV3660_PID:
+        case OV5640_PID:
+            // SYSTEM CTROL0(0x3008) bit6: 소프트웨어 전원 차단
+            return s->set_reg(s, 0x3008, 0x40, standby ? 0x40 : 0x00) == 0;
+        case OV2640_PID:
+            // 센서 뱅크(bit8) COM2(0x09) bit4: 대기 모드
+            return s->set_reg(s, 0x109, 0x10, standby ? 0x10 : 0x00) == 0;
+        default:
+            return false;
+    }
+#endif
+}
+
+// 지난 확인 이후 시간을 켜진/전체 시간에 더함
+static void accountTime(unsigned long now) {
+    unsigned long elapsed = now - lastAccountMs;
+    lastAccountMs = now;
+    stats.trackedMs += elapsed;
+    if (state != CameraPowerState::off) {
+        stats.poweredMs += elapsed;
+    }
+}
+
+static void powerUp(unsigned long now) {
+    if (state != CameraPowerState::off) {
+        return;
+    }
+    accountTime(now);
+    if (!setSensorStandby(false)) {
+        LOG_W(camera, "카메라 센서 깨우기 실패");
+    }
+    state = CameraPowerState::warming;
+    poweredAtMs = now;
+}
+
+static void powerDown(unsigned long now) {
+    accountTime(now);
+    if (!setSensorStandby(true)) {
+        // 대기 모드를 쓸 수 없는 센서: 이후로는 항상 켜 둠
+        LOG_W(camera, "카메라 센서 대기 모드 설정 실패, 전원 관리 중지");
+        gatingEnabled = false;
+        return;
+    }
+    if (predictiveWake) {
+        stats.wastedWakeUps++;
+        incrementMetric(MetricCounter::cameraWastedWakeUps);
+        predictiveWake = false;
+    }
+    state = CameraPowerState::off;
+    LOG_D(camera, "카메라 센서 대기 모드 (켜진 시간 %lu ms)", now - poweredAtMs);
+}
+
+static void updateConvergence(unsigned long now) {
+    if (state == CameraPowerState::warming && now - poweredAtMs >= CAMERA_WARMUP_MS) {
+        state = CameraPowerState::warm;
+    }
+}
+
+static void initCameraPower(unsigned long now) {
+    initialized = true;
+    lastAccountMs = now;
+    // initCamera()가 안정화 대기까지 마쳤으므로 수렴한 상태로 시작
+    state = CameraPowerState::warm;
+    poweredAtMs = now - CAMERA_WARMUP_MS;
+    keepWarmUntilMs = now + CAMERA_POWER_IDLE_MS;
+    gatingEnabled = CAMERA_POWER_IDLE_MS > 0 && waitForBootPhase(BootPhase::camera, 0);
+    LOG_I(camera, "카메라 전원 관리 %s (대기 전환 %lu ms, 수렴 %lu ms)", gatingEnabled ? "사용" : "안 함",
+          (unsigned long)CAMERA_POWER_IDLE_MS, (unsigned long)CAMERA_WARMUP_MS);
+}
+
+// 근접 값이 평소보다 크게 오르거나 장치가 움직이면 곧 촬영할 것으로 봄
+// @return 감지 이유 ("근접"/"움직임"), 없으면 nullptr
+static const char* detectActivity() {
+    if (!sensorsReady) {
+        if (!isBootPhaseDone(BootPhase::sensors) || !waitForBootPhase(BootPhase::sensors, 0)) {
+            return nullptr;
+        }
+        sensorsReady = true;
+    }
+    SensorData sample = readSensorSample();
+    float proximity = (float)sample.proximity;
+    bool approaching = proximityBaseline >= 0.0f && proximity - proximityBaseline >= CAMERA_WAKE_PROXIMITY_RISE;
+    // 물체가 다가온 동안에는 평소 수준을 올리지 않아 머무는 동안 계속 켜 둠
+    if (proximityBaseline < 0.0f) {
+        proximityBaseline = proximity;
+    } else if (!approaching) {
+        proximityBaseline += (proximity - proximityBaseline) * PROXIMITY_BASELINE_WEIGHT;
+    }
+
+    float accel = sqrtf(sample.accelX * sample.accelX + sample.accelY * sample.accelY + sample.accelZ * sample.accelZ);
+    float gyro = sqrtf(sample.gyroX * sample.gyroX + sample.gyroY * sample.gyroY + sample.gyroZ * sample.gyroZ);
+    bool moving = fabsf(accel - 1.0f) >= CAMERA_WAKE_ACCEL_G || gyro >= CAMERA_WAKE_GYRO_DPS;
+    return approaching ? "근접" : moving ? "움직임" : nullptr;
+}
+
+static void wakeUp(unsigned long now, const char* reason) {
+    keepWarmUntilMs = now + CAMERA_POWER_IDLE_MS;
+    if (state != CameraPowerState::off) {
+        return;
+    }
+    powerUp(now);
+    predictiveWake = true;
+    stats.wakeUps++;
+    incrementMetric(MetricCounter::cameraWakeUps);
+    LOG_I(camera, "카메라 센서 미리 켬: %s", reason);
+}
+
+void handleCameraPower() {
+    unsigned long now = millis();
+    if (!initialized) {
+        if (!isBootPhaseDone(BootPhase::camera)) {
+            return;
+        }
+        initCameraPower(now);
+    }
+    accountTime(now);
+    updateConvergence(now);
+    if (!gatingEnabled) {
+        return;
+    }
+    const char* activity = detectActivity();
+    if (activity != nullptr) {
+        wakeUp(now, activity);
+    }
+    if (state != CameraPowerState::off && !inUse && (long)(now - keepWarmUntilMs) >= 0) {
+        powerDown(now);
+    }
+}
+
+void requestCameraWarmUp(const char* reason) {
+    if (!initialized || !gatingEnabled) {
+        return;
+    }
+    wakeUp(millis(), reason);
+}
+
+CameraPowerState beginCameraUse() {
+    unsigned long now = millis();
+    if (!initialized) {
+        initCameraPower(now); // 첫 전원 관리 작업보다 촬영이 먼저 온 경우
+    }
+    updateConvergence(now);
+    CameraPowerState requested = state;
+    switch (requested) {
+        case CameraPowerState::warm:
+            stats.warmHits++;
+            incrementMetric(MetricCounter::cameraWarmHits);
+            break;
+        case CameraPowerState::warming:
+            stats.partialHits++;
+            incrementMetric(MetricCounter::cameraPartialHits);
+            break;
+        case CameraPowerState::off:
+            stats.coldStarts++;
+            incrementMetric(MetricCounter::cameraColdStarts);
+            powerUp(now);
+            break;
+    }
+    predictiveWake = false;
+    inUse = true;
+    return requested;
+}
+
+uint32_t waitCameraConverged() {
+    unsigned long startMs = millis();
+    updateConvergence(startMs);
+    if (state != CameraPowerState::warming) {
+        return 0;
+    }
+    unsigned long elapsed = startMs - poweredAtMs;
+    if (elapsed < CAMERA_WARMUP_MS) {
+        delay(CAMERA_WARMUP_MS - elapsed);
+    }
+    state = CameraPowerState::warm;
+    return (uint32_t)(millis() - startMs);
+}
+
+void endCameraUse() {
+    inUse = false;
+    keepWarmUntilMs = millis() + CAMERA_POWER_IDLE_MS;
+}
+
+bool isCameraConverged() {
+    updateConvergence(millis());
+    return state == CameraPowerState::warm;
+}
+
+const char* cameraPowerStateName(CameraPowerState powerState) {
+    switch (powerState) {
+        case CameraPowerState::off:
+            return "off";
+        case CameraPowerState::warming:
+            return "warming";
+        default:
+            return "warm";
+    }
+}
+
+CameraPowerStats getCameraPowerStats() {
+    if (initialized) {
+        accountTime(millis());
+    }
+    stats.state = state;
+    return stats;
+}
@@ -0,0 +1,69 @@
+#ifndef CAMERA_POWER_H
+#define CAMERA_POWER_H
+
+#include <Arduino.h>
+
+// 카메라 센서 전원 상태
+enum class CameraPowerState : uint8_t {
+    off,      // 대기 모드 (PWDN 핀 또는 SCCB 대기 레지스터, 프레임 출력 없음)
+    warming,  // 켜진 뒤 자동 노출 수렴 대기 (CAMERA_WARMUP_MS)
+    warm      // 수렴 완료, 바로 촬영 가능
+};
+
+/**
+ * @brief 근접/IMU 값으로 센서를 미리 켜고, 쉬는 시간이 CAMERA_POWER_IDLE_MS를 넘으면 대기 모드로 둡니다.
+ * (스케줄러 작업, CAMERA_POWER_CHECK_MS 주기, 카메라 초기화 전에는 아무것도 하지 않음)
+ */
+void handleCameraPower();
+
+/**
+ * @brief 곧 촬영할 것으로 보이는 이벤트(버튼 누름 등)에서 센서를 미리 켭니다.
+ */
+void requestCameraWarmUp(const char* reason);
+
+/**
+ * @brief 촬영을 시작합니다. 센서가 꺼져 있으면 켜고, endCameraUse()까지는 끄지 않습니다.
+ * 요청 시점의 상태별로 촬영 횟수를 집계합니다. (warm: 미리 켜 둔 적중, warming: 부분 적중, off: 냉간 시작)
+ * @return 요청 시점의 전원 상태
+ */
+CameraPowerState beginCameraUse();
+
+/**
+ * @brief 자동 노출이 수렴할 때까지 기다립니다. (beginCameraUse() 이후 실제 프레임을 얻기 직전에 호출)
+ * @return 기다린 시간 (ms, 이미 수렴했으면 0)
+ */
+uint32_t waitCameraConverged();
+
+/**
+ * @brief 촬영이 끝났음을 알립니다. 이후 CAMERA_POWER_IDLE_MS 동안 켜 두어 이어지는 촬영에 대비합니다.
+ */
+void endCameraUse();
+
+/**
+ * @brief 자동 노출이 수렴했는지 확인합니다. (수렴 전 프레임은 장면 크기 표본으로 쓰지 않음)
+ */
+bool isCameraConverged();
+
+/**
+ * @brief 상태 이름을 반환합니다. (cdone의 "cam" 필드: "off", "warming", "warm")
+ */
+const char* cameraPowerStateName(CameraPowerState powerState);
+
+// 누적 통계 (카메라 초기화 이후)
+struct CameraPowerStats {
+    CameraPowerState state;
+    uint32_t warmHits;      // 수렴이 끝난 상태에서 받은 촬영
+    uint32_t partialHits;   // 켜는 중에 받은 촬영 (남은 수렴 시간만 기다림)
+    uint32_t coldStarts;    // 꺼진 상태에서 받은 촬영 (수렴 시간 전체를 기다림)
+    uint32_t wakeUps;       // 근접/움직임/버튼으로 미리 켠 횟수
+    uint32_t wastedWakeUps; // 미리 켰지만 촬영 없이 다시 끈 횟수
+    uint64_t poweredMs;     // 센서가 켜져 있던 시간 (대기 전류 추정용)
+    uint64_t trackedMs;     // 집계한 전체 시간
+};
+
+/**
+ * @brief 누적 통계를 반환합니다. (켜진 시간은 호출 시점까지 반영)
+ */
+CameraPowerStats getCameraPowerStats();
+
+#endif // CAMERA_POWER_H
@@ -23,8 +23,24 @@
 #define BLE_DEVICE_NAME "MONOPLEX AI SENSOR"
 #define SERVER_SERVICE_UUID "4fafc201-1fb5-459e-8fcc-31914cc5c9c3"
 #define SERVER_CHARACTERISTIC_UUID "9f549a79-f038-47df-b252-3a330ec61ebf"
+#define SENSOR_STREAM_CHARACTERISTIC_UUID "9f549a79-f038-47df-b252-3a330ec61ec0"
 #define MAX_BLE_RETRY 5
 
+// BLE 센서 스트림 (설치 시 현장 확인용)
+#define BLE_STREAM_RATE_HZ 100            // 구독 중 샘플링 주기
+#define BLE_STREAM_RING_SIZE 64           // 전송 대기 프레임 수 (가득 차면 오래된 프레임부터 버림)
+#define BLE_STREAM_FLUSH_MS 20            // MTU를 채우지 못해도 이 시간이 지나면 전송
+#define BLE_STREAM_STATS_INTERVAL_MS 5000 // 처리량 로그 주기
+
+// BLE 수명 주기 (프로비저닝 이후 BLE를 정지하여 내부 DRAM과 WiFi 공존 시간을 확보)
+#define BLE_TRIGGER_BUTTON_PIN 0          // ESP32-S3-EYE BOOT 버튼, 길게 누르면 BLE 창을 엶
+#define BLE_TRIGGER_HOLD_MS 3000          // 버튼을 이 시간 이상 눌러야 트리거
+#define BLE_WINDOW_MS 300000              // 트리거 후 BLE를 유지하는 시간
+#define BLE_SHUTDOWN_GRACE_MS 30000       // 프로비저닝 완료 후 BLE 종료까지 대기 시간
+#define BLE_OFFLINE_TRIGGER_MS 180000     // 이 시간 이상 WiFi 미연결 시 재프로비저닝용 BLE 창을 엶
+// 컨트롤러 메모리까지 힙으로 반환 (추가 확보, 다시 켤 때 재부팅 필요)
+// #define BLE_RELEASE_CONTROLLER_MEMORY
+
 // 카메라 설정
 // CAMERA_MODEL_ESP32S3_EYE는 PlatformIO에서 자동 정의됨 - 중복 정의 방지
 #ifndef CAMERA_MODEL_ESP32S3_EYE
@@ -45,7 +61,126 @@ extern const char* ROOT_CA_CERT;
 extern const char* CERTIFICATE_PEM;
 extern const char* PRIVATE_KEY;
 
-// EEPROM 설정
+// 재연결 정책 (decorrelated jitter 지수 백오프 + 서킷 브레이커)
+// WiFi는 연결 시도 한 번에 수 초가 걸리므로 MQTT보다 기본 간격을 길게 둠
+// 서킷 open 시간은 *_MAX_MS를 넘지 않음 (장애 해제 후 최악 복구 시간 = *_MAX_MS)
+#define WIFI_RECONNECT_BASE_MS 5000
+#define WIFI_RECONNECT_MAX_MS 120000
+#define WIFI_RECONNECT_FAILURE_THRESHOLD 10
+#define WIFI_RECONNECT_OPEN_MS 120000
+#define WIFI_CONNECT_ATTEMPT_TIMEOUT_MS 15000 // 이 시간 내 연결되지 않으면 이번 시도를 실패로 기록
+#define MQTT_RECONNECT_BASE_MS 2000
+#define MQTT_RECONNECT_MAX_MS 300000
+#define MQTT_RECONNECT_FAILURE_THRESHOLD 8
+#define MQTT_RECONNECT_OPEN_MS 300000
+
+// WiFi 빠른 재연결 (NVS에 캐시된 BSSID/채널로 스캔 없이 연결)
+#define WIFI_FAST_CONNECT_TIMEOUT_MS 4000   // 이 시간 내 연결되지 않으면 전체 스캔으로 전환
+#define WIFI_FAST_CONNECT_MAX_FAILURES 2    // 연속 실패 시 캐시 무효화
+#define WIFI_FAST_CONNECT_MIN_RSSI -80      // 이보다 약한 AP는 캐시하지 않음 (dBm)
+// 이전 DHCP 임대 주소를 고정 IP로 재사용 (IP 충돌 위험이 있어 기본 비활성화)
+// #define WIFI_REUSE_DHCP_LEASE
+
+// WiFi 비동기 스캔 (BLE 프로비저닝 목록)
+#define WIFI_SCAN_TOP_K 10                // BLE로 전송할 최대 AP 수 (RSSI 상위)
+#define WIFI_SCAN_RESULTS_PER_POLL 8      // handleWifiScan() 1회당 처리할 결과 수
+#define WIFI_SCAN_CACHE_TTL_MS 60000      // 스캔 결과 캐시 유효 시간
+
+// 시각 동기화 (시계열 저장소 타임스탬프)
+#define NTP_SERVER_PRIMARY "pool.ntp.org"
+#define NTP_SERVER_SECONDARY "time.google.com"
+
+// 시계열 저장소 (spiffs 파티션을 원시 플래시 링으로 사용)
+#define TS_PARTITION_LABEL "spiffs"
+#define TS_LOG_INTERVAL_MS 1000           // 센서 샘플 기록 주기 (업링크 상태와 무관)
+#define TS_ROLLUP_SEGMENTS 64             // 1분 평균 링 크기 (4KB 섹터 수, 약 5.6일)
+#define TS_APPEND_QUEUE_DEPTH 32          // 기록 태스크 대기 레코드 수
+
+// 메인 루프 스케줄러 (타이머 휠, 작업별 주기/마감/실행 예산)
+#define SCHEDULER_MAX_JOBS 16              // 등록 가능한 최대 작업 수
+#define SCHEDULER_WHEEL_SLOTS 64           // 휠 슬롯 수 (1 슬롯 = 1 ms, 한 번에 최대 64 ms 대기)
+#define SCHEDULER_REPORT_INTERVAL_MS 60000 // 유휴율/지터/예산 초과 리포트 주기
+
+// 로그 (링 버퍼에 쌓고 낮은 우선순위 태스크가 시리얼로 배출)
+#define LOG_COMPILE_LEVEL 3                // 1=error 2=warn 3=info 4=debug 5=verbose, 이보다 상세한 로그는 컴파일 시 제거
+#define LOG_RING_SIZE 32                   // 배출 대기 로그 수 (2의 거듭제곱, 가득 차면 새 로그를 버림)
+#define LOG_DRAIN_INTERVAL_MS 10           // 배출 태스크 주기
+// 포맷 문자열 대신 주소와 인자만 전송 (호스트에서 tools/log_decode.py로 복원)
+// #define LOG_TOKENIZED
+
+// 런타임 지표 ("{deviceUid}/status"로 발행, 히스토그램은 발행할 때마다 초기화)
+#define METRICS_PUBLISH_INTERVAL_MS 60000
+#define METRICS_FORMAT_VERSION 3           // 스냅샷 JSON의 "v" 값 (필드 구성이 바뀌면 증가)
+#define METRICS_JSON_BUFFER_SIZE 1920      // 스냅샷 JSON 최대 길이 (모든 값이 최대 자릿수일 때 약 1790, MQTT 버퍼 2048보다 작아야 함)
+
+// 촬영 추적 (명령 수신 → 업로드 완료 구간별 소요 시간, cdone에 포함)
+#define TRACE_MAX_SPANS 16                 // 추적 1건에 기록할 최대 구간 수
+#define TRACE_EXPORT_MQTT 1                // 1이면 구간 전체를 "{deviceUid}/trace"로 내보냄 (tools/trace_to_chrome.py)
+#define TRACE_EXPORT_BUFFER_SIZE 1024
+
+// JPEG 크기 제어 (촬영마다 품질/해상도를 조정해 장면과 관계없이 목표 크기 근처로 유지)
+#define JPEG_RC_DEFAULT_TARGET_BYTES 150000  // jpeg_target_bytes 기본값 (0이면 저장된 품질 고정)
+#define JPEG_RC_MAX_QUALITY 40               // 품질 값 상한 (이보다 높으면 블록 노이즈가 두드러짐)
+#define JPEG_RC_MIN_FRAMESIZE FRAMESIZE_XGA  // 품질 상한으로도 목표를 넘을 때 낮출 수 있는 최소 해상도
+#define JPEG_RC_QUALITY_OFFSET 2             // 크기 모델 bytes ≈ k * pixels / (quality + offset)
+#define JPEG_RC_EWMA_WEIGHT 0.5f             // 장면 복잡도 k의 지수 평균에서 새 프레임 가중치
+
+// 이미지 업로드 전송 조절 (고정 청크/대기 대신 추정 대역폭과 송신 버퍼 점유로 결정)
+#define UPLOAD_TLS_RECORD_MAX 4096         // write 1회 최대 크기 (mbedTLS 송신 레코드 버퍼 CONFIG_MBEDTLS_SSL_OUT_CONTENT_LEN)
+#define UPLOAD_TLS_RECORD_MIN 1360         // 약한 링크/정체 시 write 크기 (TCP MSS 1436 - TLS 레코드 오버헤드)
+#define UPLOAD_SNDBUF_BYTES 5744           // lwIP TCP 송신 버퍼 (CONFIG_LWIP_TCP_SND_BUF_DEFAULT)
+#define UPLOAD_CHUNK_MS 20                 // 페이싱 확인 간격에 해당하는 전송량 (추정 대역폭 기준)
+#define UPLOAD_CHUNK_MAX 32768             // 청크 최대 크기
+#define UPLOAD_WRITE_BLOCKED_US 2000       // write가 이보다 오래 걸리면 송신 버퍼가 가득 찼던 것으로 판단
+#define UPLOAD_STALL_MS 200                // write가 이보다 오래 막히면 재전송 정체로 보고 레코드를 줄임
+#define UPLOAD_RSSI_WEAK -75               // 이보다 약한 신호에서는 작은 레코드로 시작 (dBm)
+
+// MQTT 이미지 전송 (HTTPS 업로드가 막힌 현장용, 청크 + 누적 ACK 슬라이딩 윈도우)
+#define UPLOAD_TRANSPORT_HTTPS 0              // presigned URL로 HTTPS PUT (uploadImageToS3)
+#define UPLOAD_TRANSPORT_MQTT 1               // MQTT 연결로 청크 전송 (uploadImageOverMqtt)
+#define UPLOAD_TRANSPORT_DEFAULT UPLOAD_TRANSPORT_HTTPS // upload_transport 기본값
+#define IMG_MQTT_CHUNK_BYTES 8192             // 청크 1개의 이미지 데이터 크기 (AWS IoT 메시지 상한 128KB 이하)
+#define IMG_MQTT_WINDOW 8                     // ACK 없이 보낼 수 있는 청크 수 (대역폭 × 수신 측 ACK 왕복 시간 이상)
+#define IMG_MQTT_ACK_TIMEOUT_MS 2000          // 누적 ACK가 이 시간 동안 늘지 않으면 마지막 ACK 위치부터 재전송
+#define IMG_MQTT_MAX_RETRIES 4                // 진행 없이 재전송을 반복할 수 있는 횟수
+#define IMG_MQTT_RESUME_TIMEOUT_MS 15000      // 전송 중 MQTT가 끊기면 재연결을 기다리는 시간 (재연결 후 ACK 위치부터 이어서 전송)
+
+// 업링크 트래픽 조절 (이미지 전송 중에도 제어/상태 → 텔레메트리 → 이미지 순으로 링크를 나눠 씀)
+// 토큰 버킷은 이미지 전송 중에만 적용 (전송이 없으면 바로 발행)
+#define UPLINK_CONTROL_RATE_BPS 4096          // 제어/상태 메시지 토큰 충전 속도 (bytes/s)
+#define UPLINK_CONTROL_BURST_BYTES 4096       // 제어/상태 메시지 버킷 크기 (지표 스냅샷 + cdone이 한 번에 나갈 수 있는 크기)
+#define UPLINK_TELEMETRY_RATE_BPS 1024        // 텔레메트리 토큰 충전 속도 (bytes/s)
+#define UPLINK_TELEMETRY_BURST_BYTES 2048     // 텔레메트리 버킷 크기
+#define UPLINK_QUEUE_SLOTS 8                  // 보내지 못한 메시지 대기 슬롯 수
+#define UPLINK_QUEUE_BYTES 4096               // 대기 메시지 페이로드 합계 상한
+#define UPLINK_SERVICE_INTERVAL_MS 10         // 이미지 전송 중 MQTT 수신/keepalive와 텔레메트리를 처리하는 간격 (mqttLoop 작업 주기와 같음)
+
+// 업로드 URL 풀 (presigned PUT URL을 미리 받아 두고 로컬/원격 촬영에서 바로 사용)
+#define URL_POOL_SIZE 4                       // 보관할 URL 수
+#define URL_POOL_URL_MAX 1024                 // URL 최대 길이 (보안 토큰 포함 presigned URL 기준)
+#define URL_POOL_LOW_WATER 2                  // 여유 재고가 이보다 적으면 보충 요청
+#define URL_POOL_REQUEST_BATCH 1              // 요청 1회에 받을 URL 수 (응답이 MQTT 수신 버퍼에 들어가야 함, 가득 찰 때까지 반복)
+#define URL_POOL_REFRESH_MARGIN_MS 300000     // 만료까지 이보다 적게 남으면 여유 재고에서 빼고 교체 요청
+#define URL_POOL_MIN_VALIDITY_MS 60000        // 남은 유효 시간이 이보다 짧으면 사용하지 않음 (업로드 중 만료 방지)
+#define URL_POOL_REQUEST_TIMEOUT_MS 10000     // 보충 응답이 없으면 다시 요청
+#define URL_POOL_CHECK_INTERVAL_MS 1000       // 풀 점검 주기
+#define LOCAL_CAPTURE_PRESS_MIN_MS 50         // 트리거 버튼을 이보다 길게, BLE_TRIGGER_HOLD_MS보다 짧게 누르면 로컬 촬영
+
+// 카메라 전원 관리 (쉬는 동안 센서를 대기 모드로 두고, 근접/움직임이 감지되면 촬영 전에 미리 켬)
+#define CAMERA_POWER_IDLE_MS 5000             // 마지막 촬영/감지 후 이 시간이 지나면 센서 대기 모드 (0이면 항상 켬)
+#define CAMERA_WARMUP_MS 1000                 // 센서를 켠 뒤 자동 노출/화이트밸런스가 수렴하는 시간
+#define CAMERA_POWER_CHECK_MS 100             // 근접/IMU 확인 주기 (스케줄러 작업)
+#define CAMERA_WAKE_PROXIMITY_RISE 25         // 근접 값이 평소 수준(지수 평균)보다 이만큼 오르면 미리 켬
+#define CAMERA_WAKE_ACCEL_G 0.1f              // 가속도 크기가 1g에서 이만큼 벗어나면 움직임으로 판단
+#define CAMERA_WAKE_GYRO_DPS 8.0f             // 각속도 크기가 이보다 크면 움직임으로 판단
+
+// 시스템 시각(SNTP)이 이보다 이르면 아직 동기화되지 않은 것으로 판단
+#define TIME_MIN_VALID_EPOCH 1700000000UL
+
+// 힙 단편화 모니터링: 요약 로그 출력 주기 (밀리초)
+#define HEAP_STATS_LOG_INTERVAL_MS 60000
+
+// 레거시 EEPROM 레이아웃 (설정은 config_store의 NVS에 저장, 기존 장치 마이그레이션에만 사용)
 #define EEPROM_SIZE 96              // 128에서 96으로 축소 (UID 저장 공간 제거)
 #define EEPROM_INIT_FLAG_ADDR 0
 #define EEPROM_AP_INFO_FLAG_ADDR 1
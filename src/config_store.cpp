@@ -0,0 +1,226 @@
+#include "config_store.h"
+#include "config.h"
+#include <Preferences.h>
+#include <EEPROM.h>         // 레거시 EEPROM 레이아웃 마이그레이션
+#include <esp_camera.h>     // framesize_t 범위
+#include "logger.h"
+
+enum class ConfigType : uint8_t { u32, str };
+
+// 설정 항목 정의 (ConfigKey 순서와 같아야 함)
+// NVS 키 이름은 15자 이하
+struct ConfigEntry {
+    const char* name;
+    ConfigType type;
+    uint32_t defaultValue;
+    uint32_t minValue;
+    uint32_t maxValue;
+};
+
+static const uint8_t CONFIG_COUNT = static_cast<uint8_t>(ConfigKey::count);
+
+static const ConfigEntry CONFIG_ENTRIES[CONFIG_COUNT] = {
+    {"wifi_ssid",      ConfigType::str, 0,             0,               32},
+    {"wifi_pass",      ConfigType::str, 0,             0,               63},
+    {"sensor_int_ms",  ConfigType::u32, 1000,          100,             3600000},
+    {"mqtt_keepalive", ConfigType::u32, 30,            10,              1200},
+    {"cam_frame_size", ConfigType::u32, FRAMESIZE_UXGA, FRAMESIZE_QQVGA, FRAMESIZE_UXGA},
+    {"cam_jpeg_q",     ConfigType::u32, 10,            4,               63},
+    {"mqtt_rc_base",   ConfigType::u32, MQTT_RECONNECT_BASE_MS, 500,    600000},
+    {"mqtt_rc_max",    ConfigType::u32, MQTT_RECONNECT_MAX_MS,  1000,   3600000},
+    {"wifi_rc_base",   ConfigType::u32, WIFI_RECONNECT_BASE_MS, 1000,   600000},
+    {"wifi_rc_max",    ConfigType::u32, WIFI_RECONNECT_MAX_MS,  1000,   3600000},
+    {"cfg_version",    ConfigType::u32, 0,             0,               0xFFFFFFFF},
+    {"cam_target_b",   ConfigType::u32, JPEG_RC_DEFAULT_TARGET_BYTES, 0, 4000000},
+    {"cam_upload_via", ConfigType::u32, UPLOAD_TRANSPORT_DEFAULT, 0, 1},
+};
+
+static Preferences configPrefs;
+static bool storeOpen = false;
+static uint32_t numberCache[CONFIG_COUNT];
+static char stringCache[CONFIG_COUNT][CONFIG_STRING_MAX_LENGTH + 1];
+static uint32_t writeCount = 0;
+
+static const ConfigEntry& entryOf(ConfigKey key) {
+    return CONFIG_ENTRIES[static_cast<uint8_t>(key)];
+}
+
+static void loadDefault(uint8_t index) {
+    numberCache[index] = CONFIG_ENTRIES[index].defaultValue;
+    stringCache[index][0] = '\0';
+}
+
+// --- 마이그레이션: MIGRATIONS[v]는 버전 v를 v+1로 변환 ---
+
+// v0 → v1: EEPROM 고정 오프셋(32/64)에 저장된 WiFi 자격 증명을 NVS로 가져옴
+static bool migrateLegacyEeprom() {
+    if (!EEPROM.begin(EEPROM_SIZE)) {
+        return true; // 가져올 데이터 없음
+    }
+    if (EEPROM.read(EEPROM_INIT_FLAG_ADDR) == EEPROM_INIT_CHECK_VALUE &&
+        EEPROM.read(EEPROM_AP_INFO_FLAG_ADDR) == 1) {
+        String legacySsid = EEPROM.readString(EEPROM_SSID_ADDR);
+        String legacyPassword = EEPROM.readString(EEPROM_PASSWD_ADDR);
+        if (!setConfigString(ConfigKey::wifiSsid, legacySsid.c_str()) ||
+            !setConfigString(ConfigKey::wifiPassword, legacyPassword.c_str())) {
+            EEPROM.end();
+            return false;
+        }
+        LOG_I(storage, "레거시 EEPROM의 Wi-Fi 정보를 NVS로 이전");
+
+        // 이전이 끝난 평문 비밀번호는 한 번의 커밋으로 지움
+        for (int i = EEPROM_AP_INFO_FLAG_ADDR; i < EEPROM_SIZE; i++) {
+            EEPROM.write(i, 0);
+        }
+        EEPROM.commit();
+    }
+    EEPROM.end();
+    return true;
+}
+
+static bool (*const MIGRATIONS[CONFIG_SCHEMA_VERSION])() = {
+    migrateLegacyEeprom,
+};
+
+static void runMigrations() {
+    uint16_t version = configPrefs.getUShort("schema", 0);
+    if (version > CONFIG_SCHEMA_VERSION) {
+        // 펌웨어 다운그레이드: 아는 키만 읽고 스키마 표시는 그대로 둠
+        LOG_I(storage, "설정 스키마 v%u가 펌웨어(v%u)보다 높음, 알려진 키만 사용",
+                       version, CONFIG_SCHEMA_VERSION);
+        return;
+    }
+    while (version < CONFIG_SCHEMA_VERSION) {
+        if (!MIGRATIONS[version]()) {
+            LOG_W(storage, "설정 마이그레이션 v%u → v%u 실패, 다음 부팅에 재시도", version, version + 1);
+            return;
+        }
+        version++;
+        configPrefs.putUShort("schema", version);
+        writeCount++;
+        LOG_I(storage, "설정 스키마 v%u로 마이그레이션 완료", version);
+    }
+}
+
+bool initConfigStore() {
+    for (uint8_t i = 0; i < CONFIG_COUNT; i++) {
+        loadDefault(i);
+    }
+
+    configPrefs.end(); // 다시 호출되면 저장소를 새로 열고 캐시를 다시 읽음
+    storeOpen = configPrefs.begin("config", false);
+    if (!storeOpen) {
+        LOG_W(storage, "설정 저장소(NVS) 열기 실패, 기본값 사용");
+        return false;
+    }
+
+    // 저장된 값을 캐시로 읽음 (이후 읽기는 NVS 접근 없음)
+    for (uint8_t i = 0; i < CONFIG_COUNT; i++) {
+        const ConfigEntry& entry = CONFIG_ENTRIES[i];
+        if (!configPrefs.isKey(entry.name)) {
+            continue;
+        }
+        if (entry.type == ConfigType::u32) {
+            uint32_t value = configPrefs.getUInt(entry.name, entry.defaultValue);
+            if (value >= entry.minValue && value <= entry.maxValue) {
+                numberCache[i] = value;
+            }
+        } else {
+            configPrefs.getString(entry.name, stringCache[i], sizeof(stringCache[i]));
+        }
+    }
+
+    runMigrations();
+
+    LOG_I(storage, "설정 저장소 준비 완료 (스키마 v%u, Wi-Fi 정보 %s)",
+                   CONFIG_SCHEMA_VERSION,
+                   stringCache[static_cast<uint8_t>(ConfigKey::wifiSsid)][0] != '\0' ? "있음" : "없음");
+    return true;
+}
+
+uint32_t getConfigU32(ConfigKey key) {
+    return numberCache[static_cast<uint8_t>(key)];
+}
+
+const char* getConfigString(ConfigKey key) {
+    return stringCache[static_cast<uint8_t>(key)];
+}
+
+bool isConfigU32Valid(ConfigKey key, uint32_t value) {
+    const ConfigEntry& entry = entryOf(key);
+    return entry.type == ConfigType::u32 && value >= entry.minValue && value <= entry.maxValue;
+}
+
+bool setConfigU32(ConfigKey key, uint32_t value) {
+    uint8_t index = static_cast<uint8_t>(key);
+    if (!isConfigU32Valid(key, value)) {
+        return false;
+    }
+    if (numberCache[index] == value) {
+        return true; // 변경 없음, 쓰기 생략
+    }
+    if (storeOpen) {
+        if (configPrefs.putUInt(entryOf(key).name, value) == 0) {
+            LOG_W(storage, "설정 저장 실패: %s", entryOf(key).name);
+            return false;
+        }
+        writeCount++;
+    }
+    numberCache[index] = value;
+    return true;
+}
+
+bool setConfigString(ConfigKey key, const char* value) {
+    uint8_t index = static_cast<uint8_t>(key);
+    const ConfigEntry& entry = entryOf(key);
+    if (entry.type != ConfigType::str || value == nullptr || strlen(value) > entry.maxValue) {
+        return false;
+    }
+    if (strcmp(stringCache[index], value) == 0) {
+        return true; // 변경 없음, 쓰기 생략
+    }
+    if (storeOpen) {
+        // 빈 문자열은 키 삭제로 저장 (putString은 길이 0을 실패로 반환)
+        bool ok = value[0] == '\0' ? configPrefs.remove(entry.name)
+                                   : configPrefs.putString(entry.name, value) > 0;
+        if (!ok) {
+            LOG_W(storage, "설정 저장 실패: %s", entry.name);
+            return false;
+        }
+        writeCount++;
+    }
+    strlcpy(stringCache[index], value, sizeof(stringCache[index]));
+    return true;
+}
+
+void resetConfig(ConfigKey key) {
+    uint8_t index = static_cast<uint8_t>(key);
+    if (storeOpen && configPrefs.isKey(CONFIG_ENTRIES[index].name)) {
+        configPrefs.remove(CONFIG_ENTRIES[index].name);
+        writeCount++;
+    }
+    loadDefault(index);
+}
+
+const char* getConfigName(ConfigKey key) {
+    return entryOf(key).name;
+}
+
+uint32_t getConfigWriteCount() {
+    return writeCount;
+}
+
+void saveWiFiCredentials(const String& newSsid, const String& newPassword) {
+    LOG_I(storage, "새로운 Wi-Fi 정보 저장 중...");
+    if (setConfigString(ConfigKey::wifiSsid, newSsid.c_str()) &&
+        setConfigString(ConfigKey::wifiPassword, newPassword.c_str())) {
+        LOG_I(storage, "Wi-Fi 정보 저장 완료.");
+    } else {
+        LOG_E(storage, "ERROR! Wi-Fi 정보 저장 실패.");
+    }
+}
+
+void loadWiFiCredentials(String& targetSsid, String& targetPassword) {
+    targetSsid = getConfigString(ConfigKey::wifiSsid);
+    targetPassword = getConfigString(ConfigKey::wifiPassword);
+}
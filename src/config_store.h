@@ -0,0 +1,93 @@
+#ifndef CONFIG_STORE_H
+#define CONFIG_STORE_H
+
+#include <Arduino.h>
+
+// 저장 스키마 버전 (키 이름/형식이 바뀌면 올리고 config_store.cpp에 마이그레이션 추가)
+#define CONFIG_SCHEMA_VERSION 1
+// 문자열 설정 값의 최대 길이 (WPA2 비밀번호 최대 63자 + 여유)
+#define CONFIG_STRING_MAX_LENGTH 64
+
+/**
+ * @brief 런타임에 변경 가능한 설정 키
+ * 새 키는 count 앞에 추가하고 config_store.cpp의 CONFIG_ENTRIES에 같은 순서로 정의
+ */
+enum class ConfigKey : uint8_t {
+    wifiSsid,
+    wifiPassword,
+    sensorPublishIntervalMs,
+    mqttKeepAliveSec,
+    cameraFrameSize,
+    cameraJpegQuality,
+    mqttReconnectBaseMs,
+    mqttReconnectMaxMs,
+    wifiReconnectBaseMs,
+    wifiReconnectMaxMs,
+    configVersion,
+    cameraJpegTargetBytes,
+    cameraUploadTransport,
+    count
+};
+
+/**
+ * @brief NVS 설정 저장소를 열고 모든 값을 RAM 캐시로 읽어옴
+ * 저장된 스키마 버전이 낮으면 마이그레이션(레거시 EEPROM 가져오기 포함)을 먼저 수행
+ * setup()에서 다른 모듈보다 먼저 한 번 호출 (다시 호출하면 NVS에서 캐시를 새로 읽음)
+ * @return NVS를 열었으면 true (실패 시 기본값으로 동작)
+ */
+bool initConfigStore();
+
+/**
+ * @brief 숫자 설정 값을 반환 (RAM 캐시, NVS 접근 없음)
+ */
+uint32_t getConfigU32(ConfigKey key);
+
+/**
+ * @brief 문자열 설정 값을 반환 (RAM 캐시, NVS 접근 없음)
+ * @return NUL 종료 문자열, 다음 변경 전까지 유효
+ */
+const char* getConfigString(ConfigKey key);
+
+/**
+ * @brief 숫자 설정 값을 변경 (값이 같으면 NVS에 쓰지 않음)
+ * @return 허용 범위를 벗어나거나 형식이 맞지 않거나 저장에 실패하면 false
+ */
+bool setConfigU32(ConfigKey key, uint32_t value);
+
+/**
+ * @brief 문자열 설정 값을 변경 (값이 같으면 NVS에 쓰지 않음)
+ * @return CONFIG_STRING_MAX_LENGTH를 넘거나 형식이 맞지 않거나 저장에 실패하면 false
+ */
+bool setConfigString(ConfigKey key, const char* value);
+
+/**
+ * @brief 설정을 기본값으로 되돌리고 NVS에서 키를 삭제
+ */
+void resetConfig(ConfigKey key);
+
+/**
+ * @brief 값이 허용 범위 안에 있는지만 확인 (저장하지 않음)
+ */
+bool isConfigU32Valid(ConfigKey key, uint32_t value);
+
+/**
+ * @brief NVS 키 이름을 반환 (로그/원격 설정 매핑용)
+ */
+const char* getConfigName(ConfigKey key);
+
+/**
+ * @brief 부팅 이후 NVS에 실제로 기록한 횟수 (플래시 마모 추적용)
+ */
+uint32_t getConfigWriteCount();
+
+/**
+ * @brief 새로운 Wi-Fi 접속 정보를 저장
+ */
+void saveWiFiCredentials(const String& newSsid, const String& newPassword);
+
+/**
+ * @brief 저장된 Wi-Fi 정보를 불러옴 (없으면 빈 문자열)
+ */
+void loadWiFiCredentials(String& targetSsid, String& targetPassword);
+
+#endif // CONFIG_STORE_H
@@ -0,0 +1,39 @@
+#include "heap_monitor.h"
+#include "config.h" // HEAP_STATS_LOG_INTERVAL_MS 설정을 위해 포함
+#include <esp_heap_caps.h>
+#include "logger.h"
+
+// TLS 버퍼와 카메라 DMA가 사용하는 내부 DRAM만 추적 (PSRAM은 별도 표시)
+static const uint32_t HEAP_CAPS = MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+
+// 모듈 내부에서만 사용할 변수
+static HeapStats heapStats = {0, 0, 0, UINT32_MAX, 0};
+static unsigned long lastHeapLogMs = 0;
+
+// 함수 구현
+
+void updateHeapStats() {
+    heapStats.freeHeap = heap_caps_get_free_size(HEAP_CAPS);
+    heapStats.minFreeHeap = heap_caps_get_minimum_free_size(HEAP_CAPS);
+    heapStats.largestFreeBlock = heap_caps_get_largest_free_block(HEAP_CAPS);
+    heapStats.freePsram = heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
+
+    if (heapStats.largestFreeBlock < heapStats.minLargestFreeBlock) {
+        heapStats.minLargestFreeBlock = heapStats.largestFreeBlock;
+    }
+
+    unsigned long now = millis();
+    if (lastHeapLogMs == 0 || now - lastHeapLogMs >= HEAP_STATS_LOG_INTERVAL_MS) {
+        lastHeapLogMs = now;
+        LOG_I(system, "힙 상태: 여유 %u (최소 %u), 최대 블록 %u (최소 %u), PSRAM %u bytes",
+                      (unsigned)heapStats.freeHeap,
+                      (unsigned)heapStats.minFreeHeap,
+                      (unsigned)heapStats.largestFreeBlock,
+                      (unsigned)heapStats.minLargestFreeBlock,
+                      (unsigned)heapStats.freePsram);
+    }
+}
+
+HeapStats getHeapStats() {
+    return heapStats;
+}
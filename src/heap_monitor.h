@@ -0,0 +1,28 @@
+#ifndef HEAP_MONITOR_H
+#define HEAP_MONITOR_H
+
+#include <Arduino.h>
+
+// 내부 DRAM 힙 상태 스냅샷 (단편화 추적용)
+struct HeapStats {
+    uint32_t freeHeap;            // 현재 여유 힙 (bytes)
+    uint32_t minFreeHeap;         // 부팅 이후 최소 여유 힙 (bytes)
+    uint32_t largestFreeBlock;    // 현재 할당 가능한 최대 연속 블록 (bytes)
+    uint32_t minLargestFreeBlock; // 관측된 최대 연속 블록의 최솟값 (bytes)
+    uint32_t freePsram;           // 현재 여유 PSRAM (bytes)
+};
+
+/**
+ * @brief 힙 상태를 샘플링하여 최소값 카운터를 갱신합니다.
+ * 주기적인 발행 직후처럼 할당이 끝난 시점에 호출하면 단편화 추세를 볼 수 있습니다.
+ * HEAP_STATS_LOG_INTERVAL_MS 주기로 시리얼에 요약을 출력합니다.
+ */
+void updateHeapStats();
+
+/**
+ * @brief 마지막으로 샘플링된 힙 상태를 반환합니다.
+ * @return HeapStats 구조체.
+ */
+HeapStats getHeapStats();
+
+#endif // HEAP_MONITOR_H
@@ -0,0 +1,93 @@
+#include "jpeg_rate_control.h"
+#include <math.h>
+#include "config.h" // JPEG_RC_* 설정을 위해 포함
+
+// 크기 모델: bytes ≈ complexity * pixels / (quality + JPEG_RC_QUALITY_OFFSET)
+// complexity는 장면(밝기/노이즈/디테일)에 따라 달라지므로 최근 프레임으로 지수 평균
+static float sceneComplexity = 0.0f;
+static bool modelReady = false;
+
+static uint32_t pixelsOf(framesize_t frameSize) {
+    return (uint32_t)resolution[frameSize].width * resolution[frameSize].height;
+}
+
+static uint32_t predictBytes(framesize_t frameSize, int quality) {
+    return (uint32_t)(sceneComplexity * pixelsOf(frameSize) / (float)(quality + JPEG_RC_QUALITY_OFFSET));
+}
+
+// 목표 크기를 넘지 않는 가장 좋은 품질 (값이 작을수록 좋은 품질)
+static int qualityFor(uint32_t targetBytes, framesize_t frameSize) {
+    float quality = sceneComplexity * pixelsOf(frameSize) / (float)targetBytes - JPEG_RC_QUALITY_OFFSET;
+    return quality > 63.0f ? 64 : (int)ceilf(quality);
+}
+
+// 같은 화면비의 한 단계 작은 해상도 (없으면 FRAMESIZE_INVALID)
+static framesize_t smallerFrameSize(framesize_t frameSize) {
+    for (int candidate = (int)frameSize - 1; candidate >= (int)JPEG_RC_MIN_FRAMESIZE; candidate--) {
+        if (resolution[candidate].aspect_ratio == resolution[frameSize].aspect_ratio) {
+            return (framesize_t)candidate;
+        }
+    }
+    return FRAMESIZE_INVALID;
+}
+
+void jpegRateObserve(size_t bytes, uint32_t pixels, int quality) {
+    if (bytes == 0 || pixels == 0) {
+        return;
+    }
+    float sample = (float)bytes * (float)(quality + JPEG_RC_QUALITY_OFFSET) / (float)pixels;
+    sceneComplexity = modelReady ? sceneComplexity + JPEG_RC_EWMA_WEIGHT * (sample - sceneComplexity) : sample;
+    modelReady = true;
+}
+
+bool jpegRatePlan(uint32_t targetBytes, framesize_t baseFrameSize, int baseQuality, JpegRatePlan& plan) {
+    plan.targetBytes = targetBytes;
+    plan.frameSize = baseFrameSize;
+    plan.quality = baseQuality;
+    plan.predictedBytes = modelReady ? predictBytes(baseFrameSize, baseQuality) : 0;
+    plan.baselineBytes = plan.predictedBytes;
+    if (targetBytes == 0 || !modelReady) {
+        return false;
+    }
+
+    framesize_t frameSize = baseFrameSize;
+    int quality = max(qualityFor(targetBytes, frameSize), baseQuality);
+    while (quality > JPEG_RC_MAX_QUALITY) {
+        framesize_t smaller = smallerFrameSize(frameSize);
+        if (smaller == FRAMESIZE_INVALID) {
+            quality = JPEG_RC_MAX_QUALITY; // 해상도를 더 낮출 수 없으면 목표를 넘더라도 품질 한계에서 촬영
+            break;
+        }
+        frameSize = smaller;
+        quality = max(qualityFor(targetBytes, frameSize), baseQuality);
+    }
+
+    plan.frameSize = frameSize;
+    plan.quality = quality;
+    plan.predictedBytes = predictBytes(frameSize, quality);
+    return true;
+}
+
+uint32_t jpegRateSavedMs(const JpegRatePlan& plan, size_t actualBytes, uint32_t uploadMs) {
+    if (uploadMs == 0 || actualBytes == 0 || plan.baselineBytes <= actualBytes) {
+        return 0;
+    }
+    return (uint32_t)((uint64_t)(plan.baselineBytes - actualBytes) * uploadMs / actualBytes);
+}
+
+size_t formatJpegRateJson(const JpegRatePlan& plan, size_t actualBytes, uint32_t uploadMs, char* buffer,
+                          size_t bufferSize) {
+    int written = snprintf(buffer, bufferSize, "{\"target\":%lu,\"bytes\":%lu,\"q\":%d,\"fs\":%d",
+                           (unsigned long)plan.targetBytes, (unsigned long)actualBytes, plan.quality,
+                           (int)plan.frameSize);
+    if (written > 0 && (size_t)written < bufferSize && uploadMs > 0) {
+        written += snprintf(buffer + written, bufferSize - written, ",\"saved_ms\":%lu",
+                            (unsigned long)jpegRateSavedMs(plan, actualBytes, uploadMs));
+    }
+    if (written <= 0 || (size_t)written + 1 >= bufferSize) {
+        return 0;
+    }
+    buffer[written++] = '}';
+    buffer[written] = '\0';
+    return (size_t)written;
+}
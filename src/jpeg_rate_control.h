@@ -0,0 +1,59 @@
+#ifndef JPEG_RATE_CONTROL_H
+#define JPEG_RATE_CONTROL_H
+
+#include <Arduino.h>
+#include <esp_camera.h>
+
+// triggerCameraCapture()의 목표 크기 인자: 설정 저장소의 jpeg_target_bytes를 사용
+#define JPEG_TARGET_FROM_CONFIG UINT32_MAX
+
+// formatJpegRateJson()에 필요한 최대 버퍼 크기
+#define JPEG_RATE_JSON_BUFFER_SIZE 112
+
+// 한 번의 촬영에 쓸 센서 설정과 예측 값
+struct JpegRatePlan {
+    uint32_t targetBytes;     // 목표 크기 (0이면 제어하지 않음)
+    framesize_t frameSize;    // 촬영에 쓸 해상도
+    int quality;              // 촬영에 쓸 JPEG 품질 (클수록 작은 파일)
+    uint32_t predictedBytes;  // 위 설정에서 예상되는 크기 (모델이 없으면 0)
+    uint32_t baselineBytes;   // 기본 설정(저장된 해상도/품질)에서 예상되는 크기 (모델이 없으면 0)
+};
+
+/**
+ * @brief 프레임 1장의 크기를 장면 복잡도 모델에 반영합니다.
+ * 버퍼 플러시로 버리는 프레임도 현재 장면의 표본이므로 함께 반영합니다.
+ * @param bytes JPEG 크기
+ * @param pixels 프레임 픽셀 수 (fb->width * fb->height)
+ * @param quality 프레임을 인코딩한 JPEG 품질
+ */
+void jpegRateObserve(size_t bytes, uint32_t pixels, int quality);
+
+/**
+ * @brief 목표 크기에 맞는 다음 촬영의 품질(필요하면 해상도)을 계산합니다.
+ * 품질은 기본 품질보다 좋아지지 않으며, JPEG_RC_MAX_QUALITY로도 목표를 넘으면
+ * 같은 화면비에서 JPEG_RC_MIN_FRAMESIZE까지 해상도를 낮춥니다.
+ * 목표가 0이거나 아직 표본이 없으면 기본 설정을 그대로 반환합니다.
+ * @param targetBytes 목표 크기 (bytes)
+ * @param baseFrameSize 저장된 해상도 (프레임 버퍼 상한 이하)
+ * @param baseQuality 저장된 JPEG 품질
+ * @param plan 결과
+ * @return 목표 크기에 맞춰 설정을 계산했으면 true
+ */
+bool jpegRatePlan(uint32_t targetBytes, framesize_t baseFrameSize, int baseQuality, JpegRatePlan& plan);
+
+/**
+ * @brief 목표 대비 실제 크기와 절약한 업로드 시간을 cdone 페이로드에 넣을 JSON 객체로 기록합니다.
+ * 예: {"target":150000,"bytes":143210,"q":15,"fs":13,"saved_ms":420}
+ * 절약 시간은 기본 설정의 예상 크기와 실제 크기의 차이를 이번 업로드 처리량으로 환산한 값입니다.
+ * @param uploadMs 이번 업로드 소요 시간 (실패했으면 0, saved_ms 생략)
+ * @return 기록한 길이 (NUL 제외), 버퍼가 부족하면 0
+ */
+size_t formatJpegRateJson(const JpegRatePlan& plan, size_t actualBytes, uint32_t uploadMs, char* buffer,
+                          size_t bufferSize);
+
+/**
+ * @brief 기본 설정 대비 절약한 업로드 시간(ms)을 추정합니다. 절약이 없으면 0
+ */
+uint32_t jpegRateSavedMs(const JpegRatePlan& plan, size_t actualBytes, uint32_t uploadMs);
+
+#endif // JPEG_RATE_CONTROL_H
@@ -0,0 +1,256 @@
+#include "logger.h"
+#include <atomic>
+#include <stdarg.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+
+// 링 버퍼 한 칸. 생산자가 채우는 동안 소비자는 sequence로 완료 여부를 판단
+struct LogRecord {
+    uint32_t timestampMs;
+    const char* format;       // 토큰화: 포맷 문자열 주소 (텍스트 모드에서는 미사용)
+    LogLevel level;
+    LogModule module;
+    bool tokenized;
+    uint8_t length;
+    uint8_t payload[LOG_RECORD_PAYLOAD];
+};
+
+struct LogCell {
+    std::atomic<uint32_t> sequence;
+    LogRecord record;
+};
+
+static_assert((LOG_RING_SIZE & (LOG_RING_SIZE - 1)) == 0, "LOG_RING_SIZE는 2의 거듭제곱이어야 합니다");
+static_assert(LOG_RECORD_PAYLOAD + 9 <= UINT8_MAX, "토큰화 프레임 본문 길이는 1바이트로 표현되어야 합니다");
+
+static const uint32_t RING_MASK = LOG_RING_SIZE - 1;
+static const char* const MODULE_NAMES[] = {"sys", "wifi", "ble", "mqtt", "cam", "sensor", "store"};
+static const char LEVEL_CHARS[] = {'-', 'E', 'W', 'I', 'D', 'V'};
+
+static_assert(sizeof(MODULE_NAMES) / sizeof(MODULE_NAMES[0]) == (size_t)LogModule::count,
+              "모듈 이름 표와 LogModule이 일치해야 합니다");
+
+// 모듈 내부에서만 사용할 변수
+// 여러 태스크가 동시에 로그를 남기므로 ble_event_queue와 같은 Vyukov MPSC 방식 사용
+static LogCell cells[LOG_RING_SIZE];
+static std::atomic<uint32_t> enqueuePosition(0);
+static uint32_t dequeuePosition = 0;   // 소비자만 접근 (drainMutex로 보호)
+static std::atomic<uint32_t> droppedLogs(0);
+static uint32_t reportedDrops = 0;
+static std::atomic<uint8_t> moduleLevels[(size_t)LogModule::count];
+static SemaphoreHandle_t drainMutex = nullptr;
+
+// 정적 초기화 시점에 슬롯 순번과 기본 레벨을 설정 (setup() 이전 로그도 받을 수 있게)
+static struct LoggerInitializer {
+    LoggerInitializer() {
+        for (uint32_t i = 0; i < LOG_RING_SIZE; i++) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        for (size_t i = 0; i < (size_t)LogModule::count; i++) {
+            moduleLevels[i].store(LOG_COMPILE_LEVEL, std::memory_order_relaxed);
+        }
+    }
+} loggerInitializer;
+
+// 빈 칸을 선점 (가득 차면 블로킹하지 않고 nullptr)
+static LogCell* reserveCell(uint32_t& position) {
+    position = enqueuePosition.load(std::memory_order_relaxed);
+    while (true) {
+        LogCell* cell = &cells[position & RING_MASK];
+        uint32_t sequence = cell->sequence.load(std::memory_order_acquire);
+        int32_t difference = (int32_t)sequence - (int32_t)position;
+        if (difference == 0) {
+            if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                return cell;
+            }
+        } else if (difference < 0) {
+            droppedLogs.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        } else {
+            position = enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+static void commitCell(LogCell* cell, uint32_t position) {
+    cell->sequence.store(position + 1, std::memory_order_release);
+}
+
+// 토큰화 프레임: [00 1E][본문 길이][본문][본문 바이트 합]
+// 본문: 시각 u32 | 레벨<<4 | 모듈 | 포맷 주소 u32 | 인코딩된 인자 (모두 little-endian)
+static void writeTokenFrame(const LogRecord& record) {
+    uint8_t frame[3 + 9 + LOG_RECORD_PAYLOAD + 1];
+    size_t bodyLength = 9 + record.length;
+    frame[0] = LOG_FRAME_MARKER_0;
+    frame[1] = LOG_FRAME_MARKER_1;
+    frame[2] = (uint8_t)bodyLength;
+    uint8_t* body = frame + 3;
+    uint32_t formatAddress = (uint32_t)(uintptr_t)record.format;
+    memcpy(body, &record.timestampMs, 4);
+    body[4] = (uint8_t)(((uint8_t)record.level << 4) | (uint8_t)record.module);
+    memcpy(body + 5, &formatAddress, 4);
+    memcpy(body + 9, record.payload, record.length);
+
+    uint8_t checksum = 0;
+    for (size_t i = 0; i < bodyLength; i++) {
+        checksum += body[i];
+    }
+    body[bodyLength] = checksum;
+    Serial.write(frame, 3 + bodyLength + 1);
+}
+
+static void writeRecord(const LogRecord& record) {
+    if (record.tokenized) {
+        writeTokenFrame(record);
+        return;
+    }
+    Serial.printf("[%lu][%c][%s] %.*s\n", (unsigned long)record.timestampMs,
+                  LEVEL_CHARS[(uint8_t)record.level], MODULE_NAMES[(uint8_t)record.module],
+                  (int)record.length, (const char*)record.payload);
+}
+
+// 소비자: 완료된 칸을 순서대로 출력 (생산자가 아직 채우는 칸에서 멈춤)
+static void drainRecords() {
+    while (true) {
+        LogCell* cell = &cells[dequeuePosition & RING_MASK];
+        uint32_t sequence = cell->sequence.load(std::memory_order_acquire);
+        if ((int32_t)(sequence - (dequeuePosition + 1)) < 0) {
+            break;
+        }
+        writeRecord(cell->record);
+        cell->sequence.store(dequeuePosition + LOG_RING_SIZE, std::memory_order_release);
+        dequeuePosition++;
+    }
+
+    uint32_t drops = droppedLogs.load(std::memory_order_relaxed);
+    if (drops != reportedDrops) {
+        Serial.printf("[%lu][W][sys] 로그 버퍼 가득 참: %lu건 유실\n",
+                      millis(), (unsigned long)(drops - reportedDrops));
+        reportedDrops = drops;
+    }
+}
+
+static void logDrainTask(void* parameter) {
+    while (true) {
+        xSemaphoreTake(drainMutex, portMAX_DELAY);
+        drainRecords();
+        xSemaphoreGive(drainMutex);
+        vTaskDelay(pdMS_TO_TICKS(LOG_DRAIN_INTERVAL_MS));
+    }
+}
+
+// 함수 구현
+
+void initLogger() {
+    drainMutex = xSemaphoreCreateMutex();
+    // loopTask와 같은 낮은 우선순위: 시리얼 전송 대기는 이 태스크만 겪음
+    xTaskCreate(logDrainTask, "logDrain", 3072, nullptr, 1, nullptr);
+}
+
+bool isLogEnabled(LogModule module, LogLevel level) {
+    return (uint8_t)level <= moduleLevels[(size_t)module].load(std::memory_order_relaxed);
+}
+
+void setLogLevel(LogModule module, LogLevel level) {
+    uint8_t value = (uint8_t)level > LOG_COMPILE_LEVEL ? LOG_COMPILE_LEVEL : (uint8_t)level;
+    moduleLevels[(size_t)module].store(value, std::memory_order_relaxed);
+}
+
+LogLevel getLogLevel(LogModule module) {
+    return (LogLevel)moduleLevels[(size_t)module].load(std::memory_order_relaxed);
+}
+
+void flushLogs() {
+    if (drainMutex == nullptr) {
+        drainRecords(); // 배출 태스크 시작 전: 호출한 태스크가 유일한 소비자
+        Serial.flush();
+        return;
+    }
+    xSemaphoreTake(drainMutex, portMAX_DELAY);
+    drainRecords();
+    xSemaphoreGive(drainMutex);
+    Serial.flush();
+}
+
+uint32_t getLogDropCount() {
+    return droppedLogs.load(std::memory_order_relaxed);
+}
+
+uint32_t getLogQueueDepth() {
+    // 배출 태스크가 동시에 진행 중일 수 있으므로 근사값
+    return enqueuePosition.load(std::memory_order_relaxed) - dequeuePosition;
+}
+
+void logText(LogLevel level, LogModule module, const char* format, ...) {
+    uint32_t position;
+    LogCell* cell = reserveCell(position);
+    if (cell == nullptr) {
+        return;
+    }
+
+    LogRecord& record = cell->record;
+    record.timestampMs = millis();
+    record.level = level;
+    record.module = module;
+    record.tokenized = false;
+    record.format = format;
+
+    va_list args;
+    va_start(args, format);
+    int written = vsnprintf((char*)record.payload, sizeof(record.payload), format, args);
+    va_end(args);
+
+    if (written < 0) {
+        written = 0;
+    } else if (written >= (int)sizeof(record.payload)) {
+        written = sizeof(record.payload) - 1; // 잘림
+    }
+    record.length = (uint8_t)written;
+    commitCell(cell, position);
+}
+
+void logSubmitTokenized(LogLevel level, LogModule module, const char* format, const uint8_t* args, size_t length) {
+    uint32_t position;
+    LogCell* cell = reserveCell(position);
+    if (cell == nullptr) {
+        return;
+    }
+
+    LogRecord& record = cell->record;
+    record.timestampMs = millis();
+    record.level = level;
+    record.module = module;
+    record.tokenized = true;
+    record.format = format;
+    record.length = (uint8_t)length;
+    memcpy(record.payload, args, length);
+    commitCell(cell, position);
+}
+
+void LogTokenWriter::putWord(uint8_t tag, uint32_t value) {
+    if (length + 5 > sizeof(buffer)) {
+        return; // 인자가 너무 많으면 뒤쪽 인자는 버림 (호스트에서 '?'로 표시)
+    }
+    buffer[length++] = tag;
+    memcpy(buffer + length, &value, 4);
+    length += 4;
+}
+
+void LogTokenWriter::putString(const char* text) {
+    if (text == nullptr) {
+        text = "(null)";
+    }
+    size_t textLength = strlen(text);
+    size_t room = sizeof(buffer) - length;
+    if (room < 2) {
+        return;
+    }
+    if (textLength > room - 2) {
+        textLength = room - 2;
+    }
+    buffer[length++] = 's';
+    buffer[length++] = (uint8_t)textLength;
+    memcpy(buffer + length, text, textLength);
+    length += textLength;
+}
@@ -0,0 +1,146 @@
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <Arduino.h>
+#include <type_traits>
+#include "config.h" // LOG_COMPILE_LEVEL, LOG_TOKENIZED 설정을 위해 포함
+
+// 로그 레벨 (숫자가 클수록 상세)
+enum class LogLevel : uint8_t { none = 0, error = 1, warn = 2, info = 3, debug = 4, verbose = 5 };
+
+// 로그를 남기는 모듈 (모듈별로 런타임 레벨을 따로 둠)
+enum class LogModule : uint8_t { system, wifi, ble, mqtt, camera, sensor, storage, count };
+
+// 링 버퍼 한 칸에 담기는 최대 페이로드 (텍스트는 이 길이에서 잘림)
+#define LOG_RECORD_PAYLOAD 160
+
+// 토큰화 프레임 시작 표식 (NUL은 텍스트 로그에 나오지 않으므로 호스트에서 구분 가능)
+#define LOG_FRAME_MARKER_0 0x00
+#define LOG_FRAME_MARKER_1 0x1E
+
+// 사용법: LOG_I(camera, "이미지 크기: %zu bytes", len);
+// LOG_COMPILE_LEVEL보다 상세한 호출은 포맷 문자열/인자 평가까지 컴파일 시 제거됨
+#define LOG_E(module, ...) LOG_AT(1, module, __VA_ARGS__)
+#define LOG_W(module, ...) LOG_AT(2, module, __VA_ARGS__)
+#define LOG_I(module, ...) LOG_AT(3, module, __VA_ARGS__)
+#define LOG_D(module, ...) LOG_AT(4, module, __VA_ARGS__)
+#define LOG_V(module, ...) LOG_AT(5, module, __VA_ARGS__)
+
+#define LOG_AT(level, module, ...)                                                        \
+    do {                                                                                  \
+        if ((level) <= LOG_COMPILE_LEVEL && isLogEnabled(LogModule::module, (LogLevel)(level))) { \
+            LOG_EMIT((LogLevel)(level), LogModule::module, __VA_ARGS__);                  \
+        }                                                                                 \
+    } while (0)
+
+#ifdef LOG_TOKENIZED
+#define LOG_EMIT logTokenized
+#else
+#define LOG_EMIT logText
+#endif
+
+/**
+ * @brief 로그 배출 태스크를 시작합니다.
+ * 그 전에 남긴 로그는 링 버퍼에 쌓였다가 태스크가 시작되면 출력됩니다.
+ * setup()에서 Serial.begin() 직후 한 번 호출합니다.
+ */
+void initLogger();
+
+/**
+ * @brief 모듈/레벨 로그가 현재 런타임 레벨에서 출력 대상인지 확인합니다.
+ */
+bool isLogEnabled(LogModule module, LogLevel level);
+
+/**
+ * @brief 모듈의 런타임 로그 레벨을 변경합니다. (LOG_COMPILE_LEVEL보다 상세하게는 불가)
+ */
+void setLogLevel(LogModule module, LogLevel level);
+
+/**
+ * @brief 모듈의 현재 런타임 로그 레벨을 반환합니다.
+ */
+LogLevel getLogLevel(LogModule module);
+
+/**
+ * @brief 호출한 태스크에서 링 버퍼의 로그를 모두 출력합니다.
+ * ESP.restart() 직전처럼 배출 태스크를 기다릴 수 없을 때 사용합니다.
+ */
+void flushLogs();
+
+/**
+ * @brief 링 버퍼가 가득 차서 버려진 로그 수를 반환합니다.
+ */
+uint32_t getLogDropCount();
+
+/**
+ * @brief 배출을 기다리는 로그 수를 반환합니다. (근사값)
+ */
+uint32_t getLogQueueDepth();
+
+/**
+ * @brief 포맷한 텍스트를 링 버퍼에 넣습니다. (블로킹 없음, LOG_* 매크로에서 호출)
+ */
+void logText(LogLevel level, LogModule module, const char* format, ...) __attribute__((format(printf, 3, 4)));
+
+/**
+ * @brief 포맷 문자열 주소와 인코딩된 인자를 링 버퍼에 넣습니다. (LOG_TOKENIZED 전용)
+ * 문자열 포맷팅은 호스트의 tools/log_decode.py가 펌웨어 ELF를 참조하여 수행합니다.
+ */
+void logSubmitTokenized(LogLevel level, LogModule module, const char* format, const uint8_t* args, size_t length);
+
+// 토큰화 인자 인코더: [타입 1바이트][값] 형식으로 이어 붙임
+// 'i' 32비트 정수, 'l' 64비트 정수, 'f' float, 's' 길이 1바이트 + 문자열
+struct LogTokenWriter {
+    uint8_t buffer[LOG_RECORD_PAYLOAD];
+    size_t length = 0;
+
+    void putWord(uint8_t tag, uint32_t value);
+    void putString(const char* text);
+};
+
+inline void logEncodeArg(LogTokenWriter& writer, const char* text) { writer.putString(text); }
+inline void logEncodeArg(LogTokenWriter& writer, char* text) { writer.putString(text); }
+
+inline void logEncodeArg(LogTokenWriter& writer, double value) {
+    float narrowed = (float)value;
+    uint32_t bits;
+    memcpy(&bits, &narrowed, sizeof(bits));
+    writer.putWord('f', bits);
+}
+
+inline void logEncodeArg(LogTokenWriter& writer, float value) { logEncodeArg(writer, (double)value); }
+
+template <typename T>
+inline void logEncodeArg(LogTokenWriter& writer, T* pointer) {
+    writer.putWord('i', (uint32_t)(uintptr_t)pointer);
+}
+
+template <typename T>
+inline void logEncodeArg(LogTokenWriter& writer, T value) {
+    static_assert(std::is_integral<T>::value || std::is_enum<T>::value,
+                  "토큰화 로그 인자는 정수/실수/문자열/포인터만 지원합니다 (String은 c_str() 사용)");
+    uint64_t wide = (uint64_t)(int64_t)value;
+    if (sizeof(T) > 4) {
+        writer.putWord('l', (uint32_t)wide);
+        writer.putWord('l', (uint32_t)(wide >> 32));
+    } else {
+        writer.putWord('i', (uint32_t)wide);
+    }
+}
+
+inline void logEncodeArgs(LogTokenWriter&) {}
+
+template <typename T, typename... Rest>
+inline void logEncodeArgs(LogTokenWriter& writer, T first, Rest... rest) {
+    logEncodeArg(writer, first);
+    logEncodeArgs(writer, rest...);
+}
+
+template <typename... Args>
+void logTokenized(LogLevel level, LogModule module, const char* format, Args... args) {
+    LogTokenWriter writer;
+    logEncodeArgs(writer, args...);
+    logSubmitTokenized(level, module, format, writer.buffer, writer.length);
+}
+
+#endif // LOGGER_H
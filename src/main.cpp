@@ -2,16 +2,62 @@
 #include "globals.h"
 #include "wifi_handler.h"
 #include "ble_handler.h"
+#include "ble_lifecycle.h"
 #include "mqtt_handler.h"
 #include "camera_handler.h"
+#include "camera_power.h"
 #include "sensor_handler.h"
-#include "eeprom_handler.h"
+#include "config_store.h"
+#include "heap_monitor.h"
+#include "boot_manager.h"
+#include "wifi_scanner.h"
+#include "timeseries_store.h"
+#include "url_pool.h"
+#include "uplink_shaper.h"
+#include "scheduler.h"
+#include "metrics.h"
+#include "logger.h"
+#include <esp_timer.h>
 
 // 함수 선언
 // setup()과 loop()보다 앞에 이 함수들이 존재한다고 미리 알려줌
 void initPins();
 void updateStatusLEDs();
 void handleSensorDataPublishing();
+void updateBootProgress();
+void handleTimeSeriesLogging();
+static bool initCameraPhase();
+static void handleMqttJob();
+static void mqttLoopJob();
+static void handleBleJob();
+
+// 메인 루프 작업 표 (주기 ms, 허용 시작 지연 ms, 1회 실행 예산 us, 첫 실행 지연 ms)
+// 같은 주기의 폴링 작업은 첫 실행 지연을 달리해 한 tick에 몰리지 않게 함
+struct LoopJob {
+    const char* name;
+    SchedulerJobFn fn;
+    uint32_t periodMs;
+    uint32_t deadlineMs;
+    uint32_t budgetUs;
+    uint32_t offsetMs;
+};
+
+static const LoopJob LOOP_JOBS[] = {
+    {"mqttLoop", mqttLoopJob,                10,                 10,  5000,  0},
+    {"ble",      handleBleJob,               10,                 10,  5000,  5},
+    {"led",      updateStatusLEDs,           10,                 20,   200,  2},
+    {"capture",  handleLocalCapture,         20,                 50,  5000,  3},
+    {"bleLife",  handleBleLifecycle,         50,                 50,  1000,  7},
+    {"wifi",     handleWiFiConnection,       100,               100, 20000,  0},
+    {"mqtt",     handleMqttJob,              100,               100, 20000, 20},
+    {"wifiScan", handleWifiScan,             100,               100,  5000, 40},
+    {"camPower", handleCameraPower,          CAMERA_POWER_CHECK_MS, 100, 5000, 50},
+    {"publish",  handleSensorDataPublishing, 100,               100, 50000, 60},
+    {"boot",     updateBootProgress,         100,               100,   500, 80},
+    {"urlPool",  handleUrlPool,              URL_POOL_CHECK_INTERVAL_MS, 1000, 2000, 85},
+    {"tsLog",    handleTimeSeriesLogging,    TS_LOG_INTERVAL_MS, 100,  2000, 90},
+    {"metrics",  publishMetrics,             METRICS_PUBLISH_INTERVAL_MS, 1000, 20000, 95},
+};
 
 // === 전역 변수 정의 ===
 // globals.h에서 extern으로 선언된 변수들의 실제 정의 (메모리 할당)
@@ -40,61 +86,127 @@ static void setStatusLed(bool on) {
 
 void setup() {
     Serial.begin(SERIAL_BAUD_RATE);
+    initLogger(); // 이후 로그는 링 버퍼를 거쳐 배출 태스크가 출력
 
     // // 3초간 대기하여 모니터를 켤 시간을 줍니다.
     // delay(3000);
-    // Serial.println("\nMONOPLEX AI SENSOR 시작");
+    // LOG_I(system, "MONOPLEX AI SENSOR 시작");
 
-    // EEPROM 초기화 및 저장된 설정 로드
-    initEEPROM();
+    // 설정 저장소(NVS) 초기화 및 저장된 설정 로드
+    bootPhaseBegin(BootPhase::storage);
+    initConfigStore();
     deviceUid = getMacAddress(); // MAC 주소를 고유 식별자로 사용
     loadWiFiCredentials(ssid, password);
+    initTimeSeriesStore();
+    bootPhaseEnd(BootPhase::storage);
 
-    // 하드웨어 초기화
+    bootPhaseBegin(BootPhase::pins);
     initPins();
-    initSensors();
-    
-    Serial.println("카메라 초기화 호출 시작...");
-    bool cameraInitResult = initCamera();
-    Serial.printf("카메라 초기화 결과: %s\n", cameraInitResult ? "성공" : "실패");
-
-    // WiFi 스캔을 먼저 수행 (BLE에서 사용할 목록 준비)
-    Serial.println("주변 WiFi 네트워크 스캔 중...");
-    WiFi.mode(WIFI_STA);
-    delay(100);
-    String wifiListJson = scanWifiNetworks(deviceUid);
-    Serial.println("WiFi 스캔 완료, BLE 초기화 진행");
-    
-    // BLE 초기화 (스캔된 WiFi 목록을 사용)
-    initBLE(deviceUid, wifiListJson);
-    
-    // 연결 초기화
-    if (areWiFiCredentialsAvailable()) {
+    bootPhaseEnd(BootPhase::pins);
+
+    // 자격 증명이 있으면 가장 오래 걸리는 WiFi 연결을 먼저 시작
+    // (연결은 WiFi 드라이버 태스크에서 진행되므로 아래 초기화와 병렬로 진행됨)
+    bool provisioned = areWiFiCredentialsAvailable();
+    if (provisioned) {
+        bootPhaseBegin(BootPhase::wifiConnect);
         initWiFi();
     }
+
+    // 센서와 카메라는 서로 다른 I2C 포트를 사용하므로 백그라운드 태스크에서 동시에 초기화
+    startBootPhaseTask(BootPhase::sensors, initSensors);
+    startBootPhaseTask(BootPhase::camera, initCameraPhase, 6144);
+
+    // 프로비저닝이 필요할 때만 BLE에 보낼 WiFi 목록을 백그라운드로 미리 스캔
+    if (!provisioned) {
+        bootPhaseBegin(BootPhase::wifiScan);
+        LOG_I(system, "주변 WiFi 네트워크 비동기 스캔 시작...");
+        WiFi.mode(WIFI_STA);
+        startWifiScan();
+    }
+    
+    // BLE는 미프로비저닝 상태에서만 시작 (이후에는 버튼/MQTT 명령으로 창을 엶)
+    // WiFi 목록은 스캔 캐시에서 요청 시 전송
+    bootPhaseBegin(BootPhase::ble);
+    initBleLifecycle(provisioned);
+    bootPhaseEnd(BootPhase::ble);
     
     // MQTT 초기화 (WiFi 초기화 후)
+    bootPhaseBegin(BootPhase::mqttConnect);
     initMQTT();
+    // 이미지 전송 중에는 스케줄러가 멈추므로 센서 발행은 업링크 조절이 대신 호출 (자체 주기 확인)
+    setUplinkTelemetryProducer(handleSensorDataPublishing);
+    bootPhaseBegin(BootPhase::firstTelemetry);
+
+    // 메인 루프 작업 등록 (각 핸들러가 millis()를 폴링하며 회전하던 루프를 대체)
+    initScheduler();
+    for (const LoopJob& job : LOOP_JOBS) {
+        addSchedulerJob(job.name, job.fn, job.periodMs, job.deadlineMs, job.budgetUs, job.offsetMs);
+    }
     
-    Serial.println("설정 완료. 메인 루프 진입");
+    LOG_I(system, "설정 완료. 메인 루프 진입");
 }
 
 void loop() {
-    // WiFi 및 MQTT 연결 로직 처리
-    handleWiFiConnection();
+    // loop() 호출 간격 = 작업 실행 시간 + 다음 작업까지의 대기
+    static int64_t lastLoopUs = 0;
+    int64_t nowUs = esp_timer_get_time();
+    if (lastLoopUs != 0) {
+        observeMetric(MetricHistogram::loopPeriodUs, (uint32_t)(nowUs - lastLoopUs));
+    }
+    lastLoopUs = nowUs;
+
+    // 예정 시각이 된 작업을 실행하고 다음 작업까지 대기 (busy-spin 없음)
+    runScheduler();
+}
+
+// WiFi 및 MQTT 연결 로직 처리
+static void handleMqttJob() {
     if (isWifiConnected) {
         handleMqttConnection();
-        mqttLoop(); // MQTT 메시지 수신/처리
     }
+}
 
-    // 수신된 BLE 통신 처리
-    handleBLE();
+// MQTT 메시지 수신/처리
+static void mqttLoopJob() {
+    if (isWifiConnected) {
+        mqttLoop();
+    }
+    serviceUplink(); // 업링크 대기열에 남은 메시지 발행
+}
+
+// 수신된 BLE 통신 처리 (시작/종료 정책은 bleLife 작업이 담당)
+static void handleBleJob() {
+    if (isBleActive()) {
+        handleBLE();
+    }
+}
 
-    // LED 상태 업데이트
-    updateStatusLEDs();
+static bool initCameraPhase() {
+    LOG_I(system, "카메라 초기화 호출 시작...");
+    bool cameraInitResult = initCamera();
+    LOG_I(system, "카메라 초기화 결과: %s", cameraInitResult ? "성공" : "실패");
+    return cameraInitResult;
+}
+
+void updateBootProgress() {
+    // 부팅 시 시작한 연결 단계만 기록 (프로비저닝 이후의 연결은 부팅 리포트 대상 아님)
+    if (isWifiConnected && !isBootPhaseDone(BootPhase::wifiConnect) && areWiFiCredentialsAvailable()) {
+        bootPhaseEnd(BootPhase::wifiConnect);
+    }
+    if (isMqttConnected && !isBootPhaseDone(BootPhase::mqttConnect)) {
+        bootPhaseEnd(BootPhase::mqttConnect);
+    }
+    if (!areWiFiCredentialsAvailable() && hasWifiScanResults() && !isBootPhaseDone(BootPhase::wifiScan)) {
+        bootPhaseEnd(BootPhase::wifiScan);
+    }
+}
 
-    // 주기적인 센서 읽기 및 MQTT 발행
-    handleSensorDataPublishing();
+// 업링크와 무관하게 센서 샘플을 플래시에 기록 (주기는 스케줄러가 TS_LOG_INTERVAL_MS로 보장)
+void handleTimeSeriesLogging() {
+    if (!isBootPhaseDone(BootPhase::sensors)) {
+        return;
+    }
+    appendTimeSeriesSample(readSensorSample());
 }
 
 void initPins() {
@@ -183,7 +295,7 @@ void updateStatusLEDs() {
 void handleSensorDataPublishing() {
     static unsigned long lastSensorPublish = 0;
     static bool firstPublishDone = false;
-    const unsigned long sensorPublishInterval = 1000; // 1초마다 센서 데이터 발행
+    const unsigned long sensorPublishInterval = getConfigU32(ConfigKey::sensorPublishIntervalMs);
     
     unsigned long currentTime = millis();
     
@@ -194,13 +306,13 @@ void handleSensorDataPublishing() {
     //     // 센서 값 갱신 후 근접센서 값 출력
     //     readAllSensors();
     //     SensorData latest = getSensorDataStruct();
-    //     Serial.printf("Proximity: %u\n", latest.proximity);
+    //     LOG_I(system, "Proximity: %u", latest.proximity);
     // }
     
-    // MQTT 연결 후 첫 발행은 5초 후, 이후 1초마다 발행
+    // 센서 초기화(백그라운드)가 끝나고 MQTT가 연결되면 즉시 첫 발행, 이후 설정된 주기마다 발행
     bool shouldPublish = false;
-    if (isMqttConnected) {
-        if (!firstPublishDone && currentTime > 5000) {
+    if (isMqttConnected && isBootPhaseDone(BootPhase::sensors)) {
+        if (!firstPublishDone) {
             shouldPublish = true;
             firstPublishDone = true;
         } else if (firstPublishDone && (currentTime - lastSensorPublish >= sensorPublishInterval)) {
@@ -214,11 +326,32 @@ void handleSensorDataPublishing() {
         // 센서 데이터 읽기
         readAllSensors();
         
-        // JSON 형태로 센서 데이터 생성
-        String sensorJson = getSensorDataJson();
+        // JSON 형태로 센서 데이터 생성 (정적 버퍼 재사용, 힙 할당 없음)
+        static char sensorJson[SENSOR_JSON_BUFFER_SIZE];
+        size_t sensorJsonLength = formatSensorDataJson(sensorJson, sizeof(sensorJson));
         
-        // MQTT로 센서 데이터 발행
-        String sensorTopic = deviceUid + "/sensor";
-        publishMqttMessage(sensorTopic, sensorJson);
+        // MQTT로 센서 데이터 발행 (토픽은 initMQTT()에서 미리 계산됨)
+        if (sensorJsonLength > 0) {
+            publishMqttMessage(getSensorTopic(), sensorJson, sensorJsonLength);
+        }
+
+        // 발행 직후 힙 단편화 상태 샘플링
+        updateHeapStats();
+
+        // 부팅 → 첫 발행 지연 기록 (빠른 연결/전체 스캔 경로 비교용) 및 부팅 리포트 1회 발행
+        if (!isBootPhaseDone(BootPhase::firstTelemetry)) {
+            bootPhaseEnd(BootPhase::firstTelemetry);
+            WiFiConnectMetrics wifiMetrics = getWiFiConnectMetrics();
+            LOG_I(system, "부팅 → 첫 발행: %lu ms (WiFi %s, 연결 완료 %lu ms)",
+                          currentTime,
+                          wifiMetrics.lastConnectFast ? "빠른 연결" : "전체 스캔",
+                          (unsigned long)wifiMetrics.bootToConnectMs);
+
+            static char bootReport[BOOT_REPORT_BUFFER_SIZE];
+            size_t bootReportLength = formatBootReportJson(bootReport, sizeof(bootReport));
+            if (bootReportLength > 0) {
+                publishMqttMessage(getBootReportTopic(), bootReport, bootReportLength);
+            }
+        }
     }
 }
@@ -0,0 +1,244 @@
+#include "metrics.h"
+#include "config.h" // METRICS_* 설정을 위해 포함
+#include <atomic>
+#include <stdarg.h>
+#include <WiFi.h>
+#include <esp_heap_caps.h>
+#include "globals.h"
+#include "mqtt_handler.h"
+#include "heap_monitor.h"
+#include "scheduler.h"
+#include "timeseries_store.h"
+#include "ble_event_queue.h"
+#include "camera_power.h"
+#include "logger.h"
+
+// 히스토그램 한 개. 모든 필드를 개별 원자 변수로 두어 어느 코어에서든 락 없이 갱신
+// (스냅샷은 필드 단위로 원자적이며, 동시 갱신 중이면 count와 버킷 합이 1~2 어긋날 수 있음)
+struct Histogram {
+    std::atomic<uint32_t> count;
+    std::atomic<uint32_t> sum;
+    std::atomic<uint32_t> max;
+    std::atomic<uint32_t> buckets[METRIC_BUCKET_COUNT];
+};
+
+// 버킷 상한 (대략 1-2-5 간격, 마지막 버킷은 상한 초과분)
+static const uint32_t BUCKET_BOUNDS[(size_t)MetricHistogram::count][METRIC_BUCKET_BOUNDS] = {
+    {1000, 2000, 5000, 10000, 20000, 50000, 100000, 1000000},  // loopPeriodUs
+    {500, 1000, 2000, 5000, 10000, 20000, 50000, 200000},      // publishLatencyUs
+    {100, 200, 500, 1000, 1500, 2000, 3000, 5000},             // captureLatencyMs
+    {10, 25, 50, 100, 200, 400, 800, 1600},                    // uploadKBps
+    {5, 10, 20, 50, 100, 250, 500, 1000},                      // uplinkControlDelayMs
+    {5, 10, 20, 50, 100, 250, 500, 1000},                      // uplinkTelemetryDelayMs
+    {5, 10, 20, 50, 100, 250, 500, 1000},                      // uplinkBulkDelayMs
+    {100, 200, 500, 1000, 1500, 2000, 3000, 5000},             // captureWarmLatencyMs
+    {100, 200, 500, 1000, 1500, 2000, 3000, 5000},             // captureColdLatencyMs
+};
+
+// JSON 키 (enum 순서와 일치해야 함)
+static const char* const COUNTER_NAMES[] = {"mqtt_rc", "pub_fail", "cap_ok", "cap_fail", "upl_bytes",
+                                            "cam_hit", "cam_part", "cam_cold", "cam_wake", "cam_waste"};
+static const char* const GAUGE_NAMES[] = {"heap_min", "heap_blk_min", "psram_min", "rssi", "idle_pct",
+                                          "ts_q", "log_q", "ble_q", "log_drop", "cam_on_pct"};
+static const char* const HISTOGRAM_NAMES[] = {"loop_us", "pub_us", "cap_ms", "upl_kbps", "q_ctl_ms", "q_tel_ms",
+                                              "q_blk_ms", "cap_warm_ms", "cap_cold_ms"};
+
+static_assert(sizeof(COUNTER_NAMES) / sizeof(COUNTER_NAMES[0]) == (size_t)MetricCounter::count,
+              "카운터 이름 표와 MetricCounter가 일치해야 합니다");
+static_assert(sizeof(GAUGE_NAMES) / sizeof(GAUGE_NAMES[0]) == (size_t)MetricGauge::count,
+              "게이지 이름 표와 MetricGauge가 일치해야 합니다");
+static_assert(sizeof(HISTOGRAM_NAMES) / sizeof(HISTOGRAM_NAMES[0]) == (size_t)MetricHistogram::count,
+              "히스토그램 이름 표와 MetricHistogram이 일치해야 합니다");
+
+// 모듈 내부에서만 사용할 변수 (전역 0 초기화, 힙 할당 없음)
+static std::atomic<uint32_t> counters[(size_t)MetricCounter::count];
+static std::atomic<int32_t> gauges[(size_t)MetricGauge::count];
+static Histogram histograms[(size_t)MetricHistogram::count];
+static HistogramSnapshot formattedHistograms[(size_t)MetricHistogram::count]; // 마지막 formatMetricsJson()이 쓴 값
+
+// 스냅샷 시점에만 의미가 있는 값들을 게이지로 옮김
+static void sampleGauges() {
+    updateHeapStats();
+    HeapStats heap = getHeapStats();
+    setMetric(MetricGauge::heapMinFree, (int32_t)heap.minFreeHeap);
+    setMetric(MetricGauge::heapMinLargestBlock, (int32_t)heap.minLargestFreeBlock);
+    setMetric(MetricGauge::psramMinFree, (int32_t)heap_caps_get_minimum_free_size(MALLOC_CAP_SPIRAM));
+    setMetric(MetricGauge::wifiRssi, isWifiConnected ? (int32_t)WiFi.RSSI() : 0);
+    setMetric(MetricGauge::cpuIdlePercent, (int32_t)getSchedulerIdlePercent());
+    setMetric(MetricGauge::tsQueueDepth, (int32_t)getTimeSeriesStats().queueDepth);
+    setMetric(MetricGauge::logQueueDepth, (int32_t)getLogQueueDepth());
+    setMetric(MetricGauge::bleEventQueueDepth, (int32_t)getBleEventQueueDepth());
+    setMetric(MetricGauge::logDrops, (int32_t)getLogDropCount());
+
+    // 카메라 켜짐 비율은 직전 스냅샷 이후 구간으로 계산 (집계 시간이 없으면 이전 값 유지)
+    static uint64_t lastPoweredMs = 0;
+    static uint64_t lastTrackedMs = 0;
+    CameraPowerStats camera = getCameraPowerStats();
+    if (camera.trackedMs > lastTrackedMs) {
+        setMetric(MetricGauge::cameraOnPercent,
+                  (int32_t)((camera.poweredMs - lastPoweredMs) * 100 / (camera.trackedMs - lastTrackedMs)));
+        lastPoweredMs = camera.poweredMs;
+        lastTrackedMs = camera.trackedMs;
+    }
+}
+
+// snprintf 결과를 누적하며 버퍼 부족을 검사 (formatBootReportJson과 같은 방식)
+static bool appendFormat(char* buffer, size_t bufferSize, size_t& used, const char* format, ...)
+    __attribute__((format(printf, 4, 5)));
+
+static bool appendFormat(char* buffer, size_t bufferSize, size_t& used, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    int written = vsnprintf(buffer + used, bufferSize - used, format, args);
+    va_end(args);
+    if (written < 0 || (size_t)written >= bufferSize - used) {
+        return false;
+    }
+    used += written;
+    return true;
+}
+
+// 함수 구현
+
+void incrementMetric(MetricCounter counter, uint32_t delta) {
+    counters[(size_t)counter].fetch_add(delta, std::memory_order_relaxed);
+}
+
+void setMetric(MetricGauge gauge, int32_t value) {
+    gauges[(size_t)gauge].store(value, std::memory_order_relaxed);
+}
+
+void observeMetric(MetricHistogram histogram, uint32_t value) {
+    Histogram& h = histograms[(size_t)histogram];
+    const uint32_t* bounds = BUCKET_BOUNDS[(size_t)histogram];
+
+    size_t bucket = 0;
+    while (bucket < METRIC_BUCKET_BOUNDS && value > bounds[bucket]) {
+        bucket++;
+    }
+    h.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    h.count.fetch_add(1, std::memory_order_relaxed);
+    h.sum.fetch_add(value, std::memory_order_relaxed);
+
+    uint32_t currentMax = h.max.load(std::memory_order_relaxed);
+    while (value > currentMax &&
+           !h.max.compare_exchange_weak(currentMax, value, std::memory_order_relaxed)) {
+    }
+}
+
+uint32_t getMetric(MetricCounter counter) {
+    return counters[(size_t)counter].load(std::memory_order_relaxed);
+}
+
+int32_t getMetric(MetricGauge gauge) {
+    return gauges[(size_t)gauge].load(std::memory_order_relaxed);
+}
+
+HistogramSnapshot getMetric(MetricHistogram histogram, bool reset) {
+    Histogram& h = histograms[(size_t)histogram];
+    HistogramSnapshot snapshot;
+    if (reset) {
+        // 필드마다 exchange로 읽고 비워서 초기화 중 들어온 관측값이 사라지지 않게 함
+        snapshot.count = h.count.exchange(0, std::memory_order_relaxed);
+        snapshot.sum = h.sum.exchange(0, std::memory_order_relaxed);
+        snapshot.max = h.max.exchange(0, std::memory_order_relaxed);
+        for (size_t i = 0; i < METRIC_BUCKET_COUNT; i++) {
+            snapshot.buckets[i] = h.buckets[i].exchange(0, std::memory_order_relaxed);
+        }
+    } else {
+        snapshot.count = h.count.load(std::memory_order_relaxed);
+        snapshot.sum = h.sum.load(std::memory_order_relaxed);
+        snapshot.max = h.max.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < METRIC_BUCKET_COUNT; i++) {
+            snapshot.buckets[i] = h.buckets[i].load(std::memory_order_relaxed);
+        }
+    }
+    return snapshot;
+}
+
+const uint32_t* getMetricBucketBounds(MetricHistogram histogram) {
+    return BUCKET_BOUNDS[(size_t)histogram];
+}
+
+// 형식: {"v":1,"up":초,"c":{이름:값},"g":{이름:값},"h":{이름:[count,sum,max,b0..b8]}}
+size_t formatMetricsJson(char* buffer, size_t bufferSize) {
+    sampleGauges();
+
+    size_t used = 0;
+    if (!appendFormat(buffer, bufferSize, used, "{\"v\":%d,\"up\":%lu,\"c\":{",
+                      METRICS_FORMAT_VERSION, millis() / 1000)) {
+        return 0;
+    }
+    for (size_t i = 0; i < (size_t)MetricCounter::count; i++) {
+        if (!appendFormat(buffer, bufferSize, used, "%s\"%s\":%lu", i ? "," : "", COUNTER_NAMES[i],
+                          (unsigned long)getMetric((MetricCounter)i))) {
+            return 0;
+        }
+    }
+    if (!appendFormat(buffer, bufferSize, used, "},\"g\":{")) {
+        return 0;
+    }
+    for (size_t i = 0; i < (size_t)MetricGauge::count; i++) {
+        if (!appendFormat(buffer, bufferSize, used, "%s\"%s\":%ld", i ? "," : "", GAUGE_NAMES[i],
+                          (long)getMetric((MetricGauge)i))) {
+            return 0;
+        }
+    }
+    if (!appendFormat(buffer, bufferSize, used, "},\"h\":{")) {
+        return 0;
+    }
+    for (size_t i = 0; i < (size_t)MetricHistogram::count; i++) {
+        HistogramSnapshot& h = formattedHistograms[i];
+        h = getMetric((MetricHistogram)i);
+        if (!appendFormat(buffer, bufferSize, used, "%s\"%s\":[%lu,%lu,%lu", i ? "," : "", HISTOGRAM_NAMES[i],
+                          (unsigned long)h.count, (unsigned long)h.sum, (unsigned long)h.max)) {
+            return 0;
+        }
+        for (size_t b = 0; b < METRIC_BUCKET_COUNT; b++) {
+            if (!appendFormat(buffer, bufferSize, used, ",%lu", (unsigned long)h.buckets[b])) {
+                return 0;
+            }
+        }
+        if (!appendFormat(buffer, bufferSize, used, "]")) {
+            return 0;
+        }
+    }
+    if (!appendFormat(buffer, bufferSize, used, "}}")) {
+        return 0;
+    }
+    return used;
+}
+
+void commitMetricsSnapshot() {
+    // 전체를 비우지 않고 발행한 만큼만 빼서, 직렬화 이후 들어온 관측값은 다음 스냅샷에 남김
+    for (size_t i = 0; i < (size_t)MetricHistogram::count; i++) {
+        Histogram& h = histograms[i];
+        HistogramSnapshot& published = formattedHistograms[i];
+        uint32_t remaining = h.count.fetch_sub(published.count, std::memory_order_relaxed) - published.count;
+        h.sum.fetch_sub(published.sum, std::memory_order_relaxed);
+        for (size_t b = 0; b < METRIC_BUCKET_COUNT; b++) {
+            h.buckets[b].fetch_sub(published.buckets[b], std::memory_order_relaxed);
+        }
+        // 최댓값은 뺄 수 없으므로 남은 관측값이 없을 때만 비움 (남아 있으면 다음 창에 크게 보고될 수 있음)
+        uint32_t publishedMax = published.max;
+        if (remaining == 0) {
+            h.max.compare_exchange_strong(publishedMax, 0, std::memory_order_relaxed);
+        }
+        published = HistogramSnapshot();
+    }
+}
+
+void publishMetrics() {
+    if (!isMqttConnected) {
+        return; // 히스토그램은 초기화하지 않고 다음 주기에 누적분을 발행
+    }
+    static char metricsJson[METRICS_JSON_BUFFER_SIZE];
+    size_t length = formatMetricsJson(metricsJson, sizeof(metricsJson));
+    if (length == 0) {
+        LOG_W(system, "지표 스냅샷 버퍼 부족 (METRICS_JSON_BUFFER_SIZE)");
+        return;
+    }
+    if (publishMqttMessage(getStatusTopic(), metricsJson, length)) {
+        commitMetricsSnapshot(); // 실패하면 히스토그램을 그대로 두고 다음 주기에 누적분을 발행
+    }
+}
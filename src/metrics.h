@@ -0,0 +1,116 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <Arduino.h>
+
+// 누적 카운터 (부팅 이후 단조 증가)
+enum class MetricCounter : uint8_t {
+    mqttReconnects,       // MQTT 재연결 성공 횟수 (첫 연결 제외)
+    mqttPublishFailures,  // 발행 실패 횟수
+    capturesOk,           // 촬영 및 업로드 성공
+    capturesFailed,       // 촬영 또는 업로드 실패
+    uploadBytes,          // 업로드한 이미지 바이트
+    cameraWarmHits,       // 센서가 미리 켜져 노출이 수렴한 상태에서 받은 촬영
+    cameraPartialHits,    // 센서를 켜는 중에 받은 촬영
+    cameraColdStarts,     // 센서가 대기 모드일 때 받은 촬영
+    cameraWakeUps,        // 근접/움직임/버튼으로 센서를 미리 켠 횟수
+    cameraWastedWakeUps,  // 미리 켰지만 촬영 없이 다시 대기 모드로 둔 횟수
+    count
+};
+
+// 현재 값 게이지 (스냅샷 시점에 갱신되는 값 포함)
+enum class MetricGauge : uint8_t {
+    heapMinFree,          // 부팅 이후 최소 여유 내부 힙 (bytes)
+    heapMinLargestBlock,  // 관측된 최대 연속 블록의 최솟값 (bytes)
+    psramMinFree,         // 관측된 최소 여유 PSRAM (bytes)
+    wifiRssi,             // WiFi 신호 강도 (dBm)
+    cpuIdlePercent,       // 직전 스케줄러 리포트 구간의 유휴율 (%)
+    tsQueueDepth,         // 시계열 기록 대기 레코드 수
+    logQueueDepth,        // 배출 대기 로그 수
+    bleEventQueueDepth,   // 처리 대기 BLE 이벤트 수
+    logDrops,             // 누적 유실 로그 수
+    cameraOnPercent,      // 직전 스냅샷 이후 카메라 센서가 켜져 있던 시간 비율 (%, 대기 전류 대용)
+    count
+};
+
+// 고정 버킷 히스토그램 (스냅샷 발행 시 초기화)
+enum class MetricHistogram : uint8_t {
+    loopPeriodUs,         // loop() 호출 간격 (us)
+    publishLatencyUs,     // MQTT 발행 1회 소요 시간 (us)
+    captureLatencyMs,     // 촬영 명령 → 프레임 획득 (ms)
+    uploadKBps,           // 업로드 처리량 (KB/s)
+    uplinkControlDelayMs, // 제어/상태 메시지 발행 대기 (ms, 업링크 조절 대기열)
+    uplinkTelemetryDelayMs, // 텔레메트리 발행 대기 (ms)
+    uplinkBulkDelayMs,    // 우선 메시지 때문에 이미지 쓰기가 밀린 시간 (ms)
+    captureWarmLatencyMs, // 센서가 켜져 수렴한 상태에서의 촬영 명령 → 프레임 획득 (ms)
+    captureColdLatencyMs, // 센서를 켜거나 수렴을 기다린 촬영의 명령 → 프레임 획득 (ms)
+    count
+};
+
+// 히스토그램 버킷 수 (상한 METRIC_BUCKET_BOUNDS개 + 초과 버킷 1개)
+#define METRIC_BUCKET_BOUNDS 8
+#define METRIC_BUCKET_COUNT (METRIC_BUCKET_BOUNDS + 1)
+
+// 히스토그램 스냅샷
+struct HistogramSnapshot {
+    uint32_t count;
+    uint32_t sum;
+    uint32_t max;
+    uint32_t buckets[METRIC_BUCKET_COUNT];  // buckets[i]: 상한 bounds[i] 이하 (마지막은 초과분)
+};
+
+/**
+ * @brief 카운터를 증가시킵니다. (할당 없음, 코어 간 안전)
+ */
+void incrementMetric(MetricCounter counter, uint32_t delta = 1);
+
+/**
+ * @brief 게이지 값을 설정합니다. (할당 없음, 코어 간 안전)
+ */
+void setMetric(MetricGauge gauge, int32_t value);
+
+/**
+ * @brief 히스토그램에 관측값을 기록합니다. (할당 없음, 코어 간 안전)
+ */
+void observeMetric(MetricHistogram histogram, uint32_t value);
+
+/**
+ * @brief 카운터의 현재 값을 반환합니다.
+ */
+uint32_t getMetric(MetricCounter counter);
+
+/**
+ * @brief 게이지의 현재 값을 반환합니다.
+ */
+int32_t getMetric(MetricGauge gauge);
+
+/**
+ * @brief 히스토그램의 현재 값을 복사합니다. (reset이 true면 복사 후 초기화)
+ */
+HistogramSnapshot getMetric(MetricHistogram histogram, bool reset = false);
+
+/**
+ * @brief 히스토그램의 버킷 상한 배열(METRIC_BUCKET_BOUNDS개)을 반환합니다.
+ */
+const uint32_t* getMetricBucketBounds(MetricHistogram histogram);
+
+/**
+ * @brief 스냅샷 시점에만 의미가 있는 게이지(RSSI, 큐 깊이 등)를 샘플링한 뒤
+ * 전체 지표를 압축 JSON으로 직렬화합니다. 히스토그램은 초기화하지 않습니다.
+ * @return 기록한 길이, 버퍼가 부족하면 0
+ */
+size_t formatMetricsJson(char* buffer, size_t bufferSize);
+
+/**
+ * @brief 마지막 formatMetricsJson()에 담긴 히스토그램 값을 현재 값에서 뺍니다.
+ * 스냅샷을 발행한 뒤에만 호출하며, 직렬화 이후 들어온 관측값은 다음 스냅샷에 남습니다.
+ */
+void commitMetricsSnapshot();
+
+/**
+ * @brief 지표 스냅샷을 "{deviceUid}/status"로 발행합니다.
+ * METRICS_PUBLISH_INTERVAL_MS 주기 작업과 "{deviceUid}/statreq" 요청에서 호출합니다.
+ */
+void publishMetrics();
+
+#endif // METRICS_H
@@ -3,42 +3,88 @@
 #include <WiFiClientSecure.h>
 #include <PubSubClient.h>
 #include <ArduinoJson.h>
+#include <esp_timer.h>
 
 // 이 모듈에 필요한 다른 핸들러 포함
 #include "wifi_handler.h"
 #include "camera_handler.h" // MQTT 메시지로 카메라 촬영을 제어하기 위해 필요
 #include "ble_handler.h"
+#include "ble_lifecycle.h"  // 원격 BLE 창 요청
+#include "timeseries_store.h" // 시계열 질의 처리
+#include "remote_config.h"  // 원격 설정 적용
+#include "reconnect_policy.h"
+#include "config_store.h"
+#include "metrics.h"
+#include "trace.h"
+#include "url_pool.h"
+#include "mqtt_image_transfer.h"
+#include "uplink_shaper.h"
+#include "logger.h"
 
 // 모듈 내부에서만 사용할 객체 및 변수
 static WiFiClientSecure wifiNet;
 static PubSubClient mqttClient(wifiNet);
-static String clientId;
-static String subTopic;
-static String pubCaptureTopic;
-static String pubSensorTopic;
-static long lastReconnectAttempt = 0;
+// 토픽은 initMQTT()에서 한 번만 만들어 고정 버퍼에 보관 (발행 시 String 생성 방지)
+static char clientId[MQTT_TOPIC_BUFFER_SIZE];
+static char subTopic[MQTT_TOPIC_BUFFER_SIZE];
+static char pubCaptureTopic[MQTT_TOPIC_BUFFER_SIZE];
+static char pubSensorTopic[MQTT_TOPIC_BUFFER_SIZE];
+static char pubBootTopic[MQTT_TOPIC_BUFFER_SIZE];
+static char bleTopic[MQTT_TOPIC_BUFFER_SIZE];
+static char tsQueryTopic[MQTT_TOPIC_BUFFER_SIZE];
+static char tsResponseTopic[MQTT_TOPIC_BUFFER_SIZE];
+static char configTopic[MQTT_TOPIC_BUFFER_SIZE];
+static char configAckTopic[MQTT_TOPIC_BUFFER_SIZE];
+static char statusTopic[MQTT_TOPIC_BUFFER_SIZE];
+static char statusRequestTopic[MQTT_TOPIC_BUFFER_SIZE];
+static char traceTopic[MQTT_TOPIC_BUFFER_SIZE];
+static char urlRequestTopic[MQTT_TOPIC_BUFFER_SIZE];
+static char urlTopic[MQTT_TOPIC_BUFFER_SIZE];
+static char imageTopic[MQTT_TOPIC_BUFFER_SIZE];
+static char imageAckTopic[MQTT_TOPIC_BUFFER_SIZE];
+static bool hasConnectedOnce = false; // 첫 연결은 재연결 횟수에서 제외
+static uint16_t sessionKeepAliveSec = 0; // 현재 세션의 CONNECT에 실린 keepalive
+// 이미지 전송 중 받은 촬영 명령 (전송이 끝나면 mqttLoop()에서 다시 처리, 최근 1건만 보관)
+static byte deferredCapture[URL_POOL_URL_MAX + 256];
+static unsigned int deferredCaptureLength = 0;
+static ReconnectPolicy reconnectPolicy(MQTT_RECONNECT_BASE_MS, MQTT_RECONNECT_MAX_MS,
+                                       MQTT_RECONNECT_FAILURE_THRESHOLD, MQTT_RECONNECT_OPEN_MS);
 
 // isMqttConnected는 main.cpp에서 이미 정의됨 - 중복 정의 제거
 
 // 내부 함수 프로토타입
 static void mqttCallback(char* topic, byte* payload, unsigned int length);
 static void subscribeToTopics();
+static bool publishNow(const char* topic, const uint8_t* payload, size_t length);
 
 // 함수 구현
 
 void initMQTT() {
     // 1. MQTT에서 사용할 토픽과 클라이언트 ID 설정
-    String macId = getMacAddress(); // WiFi 핸들러의 함수 사용
+    const char* macId = getMacAddressCStr(); // WiFi 핸들러의 함수 사용
     
-    if (macId.length() == 0) {
-        Serial.println("MAC 주소를 가져올 수 없음, 기본값 사용");
+    if (macId[0] == '\0') {
+        LOG_I(mqtt, "MAC 주소를 가져올 수 없음, 기본값 사용");
         macId = "DEFAULT_DEVICE";
     }
     
-    clientId = "mlx-" + macId;
-    subTopic = macId + "/capture";
-    pubCaptureTopic = macId + "/cdone";
-    pubSensorTopic = macId + "/sensor";
+    snprintf(clientId, sizeof(clientId), "mlx-%s", macId);
+    snprintf(subTopic, sizeof(subTopic), "%s/capture", macId);
+    snprintf(pubCaptureTopic, sizeof(pubCaptureTopic), "%s/cdone", macId);
+    snprintf(pubSensorTopic, sizeof(pubSensorTopic), "%s/sensor", macId);
+    snprintf(pubBootTopic, sizeof(pubBootTopic), "%s/boot", macId);
+    snprintf(bleTopic, sizeof(bleTopic), "%s/ble", macId);
+    snprintf(tsQueryTopic, sizeof(tsQueryTopic), "%s/tsq", macId);
+    snprintf(tsResponseTopic, sizeof(tsResponseTopic), "%s/tsr", macId);
+    snprintf(configTopic, sizeof(configTopic), "%s/config", macId);
+    snprintf(configAckTopic, sizeof(configAckTopic), "%s/cfgack", macId);
+    snprintf(statusTopic, sizeof(statusTopic), "%s/status", macId);
+    snprintf(statusRequestTopic, sizeof(statusRequestTopic), "%s/statreq", macId);
+    snprintf(traceTopic, sizeof(traceTopic), "%s/trace", macId);
+    snprintf(urlRequestTopic, sizeof(urlRequestTopic), "%s/urlreq", macId);
+    snprintf(urlTopic, sizeof(urlTopic), "%s/urls", macId);
+    snprintf(imageTopic, sizeof(imageTopic), "%s/img", macId);
+    snprintf(imageAckTopic, sizeof(imageAckTopic), "%s/imgack", macId);
 
     // 2. 보안 연결(TLS)을 위한 인증서 설정
     wifiNet.setCACert(ROOT_CA_CERT);
@@ -49,11 +95,12 @@ void initMQTT() {
     // 3. MQTT 서버 정보 및 콜백 함수 설정
     mqttClient.setServer(IOT_ENDPOINT, MQTTS_PORT);
     mqttClient.setCallback(mqttCallback);
-    mqttClient.setKeepAlive(30);
+    applyMqttConfig();
     mqttClient.setSocketTimeout(10);
-    mqttClient.setBufferSize(2048);
+    mqttClient.setBufferSize(MQTT_BUFFER_SIZE);
+    initUplinkShaper(publishNow);
     
-    Serial.println("MQTT 핸들러 초기화 완료");
+    LOG_I(mqtt, "MQTT 핸들러 초기화 완료");
 }
 
 void handleMqttConnection() {
@@ -61,8 +108,8 @@ void handleMqttConnection() {
     // 개발 모드: MQTT 연결 비활성화
     static bool showedMessage = false;
     if (!showedMessage) {
-        Serial.println("⚠️  개발 모드: MQTT 연결이 비활성화되었습니다.");
-        Serial.println("   config.h에서 DISABLE_MQTT_FOR_DEVELOPMENT를 주석처리하면 활성화됩니다.");
+        LOG_W(mqtt, "⚠️  개발 모드: MQTT 연결이 비활성화되었습니다.");
+        LOG_W(mqtt, "   config.h에서 DISABLE_MQTT_FOR_DEVELOPMENT를 주석처리하면 활성화됩니다.");
         showedMessage = true;
     }
     return;
@@ -72,35 +119,46 @@ void handleMqttConnection() {
     if (mqttClient.connected()) {
         // 연결 상태 변화 감지
         if (!isMqttConnected) {
-            Serial.println("MQTT 연결 복구됨");
+            LOG_I(mqtt, "MQTT 연결 복구됨");
             isMqttConnected = true;
+            reconnectPolicy.onConnected();
             subscribeToTopics();
             sendMqttStatusUpdate(true);
         }
         return;
     }
 
-    // 이전에 연결이 끊어졌다면
+    unsigned long now = millis();
+
+    // 이전에 연결이 끊어졌다면 지터가 적용된 시각에 첫 재시도 예약
     if (isMqttConnected) {
         isMqttConnected = false;
-        Serial.println("MQTT 연결 끊김.");
+        reconnectPolicy.onDisconnected(now);
+        LOG_W(mqtt, "MQTT 연결 끊김.");
     }
     
-    // 5초에 한 번씩만 재연결 시도
-    long now = millis();
-    if (now - lastReconnectAttempt > 5000) {
-        lastReconnectAttempt = now;
-        Serial.println("MQTT 연결 시도 중...");
+    // 재연결 정책이 허용할 때만 시도 (지수 백오프 + 서킷 브레이커)
+    if (reconnectPolicy.ready(now)) {
+        reconnectPolicy.onAttempt();
+        LOG_I(mqtt, "MQTT 연결 시도 중...");
+        sessionKeepAliveSec = getConfigU32(ConfigKey::mqttKeepAliveSec);
+        mqttClient.setKeepAlive(sessionKeepAliveSec);
         
-        if (mqttClient.connect(clientId.c_str())) {
-            Serial.println("MQTT 연결 성공");
+        if (mqttClient.connect(clientId)) {
+            LOG_I(mqtt, "MQTT 연결 성공");
+            if (hasConnectedOnce) {
+                incrementMetric(MetricCounter::mqttReconnects);
+            }
+            hasConnectedOnce = true;
             isMqttConnected = true;
+            reconnectPolicy.onConnected();
             subscribeToTopics();
             sendMqttStatusUpdate(true);
         } else {
+            reconnectPolicy.onFailed(millis());
             int errorCode = mqttClient.state();
-            Serial.print("MQTT 연결 실패, 에러 코드: ");
-            Serial.println(errorCode);
+            LOG_W(mqtt, "MQTT 연결 실패, 에러 코드: %d (다음 시도까지 %lu ms)",
+                        errorCode, (unsigned long)reconnectPolicy.currentDelayMs());
             sendMqttStatusUpdate(false, "mqtt_error_" + String(errorCode));
         }
     }
@@ -110,19 +168,139 @@ void mqttLoop() {
     if (isWifiConnected) {
         mqttClient.loop();
     }
+    // 이미지 전송 중 미뤄 둔 촬영 명령은 전송이 끝난 뒤 mqttClient.loop() 밖에서 처리
+    // (추적의 명령 수신 시각은 다시 처리한 시각)
+    if (deferredCaptureLength > 0 && !isUplinkBulkActive()) {
+        unsigned int length = deferredCaptureLength;
+        deferredCaptureLength = 0;
+        mqttCallback(subTopic, deferredCapture, length);
+    }
 }
 
 void publishMqttMessage(const String& topic, const String& payload) {
-    if (mqttClient.connected()) {
-        mqttClient.publish(topic.c_str(), payload.c_str());
-    } else {
-        Serial.println("MQTT 연결 안됨, 메시지 전송 불가");
+    publishMqttMessage(topic.c_str(), payload.c_str(), payload.length());
+}
+
+// 토픽으로 업링크 우선순위를 정함 (텔레메트리 외에는 제어/상태)
+static UplinkClass classifyTopic(const char* topic) {
+    if (topic == pubSensorTopic || topic == tsResponseTopic || topic == traceTopic) {
+        return UplinkClass::telemetry;
+    }
+    return UplinkClass::control;
+}
+
+bool publishMqttMessage(const char* topic, const char* payload, size_t length) {
+    if (!mqttClient.connected()) {
+        LOG_W(mqtt, "MQTT 연결 안됨, 메시지 전송 불가");
+        incrementMetric(MetricCounter::mqttPublishFailures);
+        return false;
+    }
+    // 이미지 전송 중이면 우선순위/토큰 버킷에 따라 바로 보내거나 대기열에 넣음
+    return submitUplink(classifyTopic(topic), topic, payload, length);
+}
+
+// 업링크 조절을 통과한 메시지를 실제로 발행
+static bool publishNow(const char* topic, const uint8_t* payload, size_t length) {
+    if (!mqttClient.connected()) {
+        LOG_W(mqtt, "MQTT 연결 안됨, 대기 메시지 전송 불가");
+        incrementMetric(MetricCounter::mqttPublishFailures);
+        return false;
+    }
+    // 바이트 배열 오버로드는 PubSubClient 내부 버퍼로 바로 직렬화하므로 추가 할당이 없음
+    int64_t startUs = esp_timer_get_time();
+    bool published = mqttClient.publish(topic, payload, length);
+    observeMetric(MetricHistogram::publishLatencyUs, (uint32_t)(esp_timer_get_time() - startUs));
+    if (!published) {
+        incrementMetric(MetricCounter::mqttPublishFailures);
     }
+    return published;
+}
+
+// 스트리밍 발행 상태 (begin ~ end 사이, 메인 루프 태스크 전용)
+static size_t streamRemaining = 0;
+static int64_t streamStartUs = 0;
+
+bool beginMqttPublish(const char* topic, size_t length) {
+    if (!mqttClient.connected()) {
+        LOG_W(mqtt, "MQTT 연결 안됨, 메시지 전송 불가");
+        incrementMetric(MetricCounter::mqttPublishFailures);
+        return false;
+    }
+    streamStartUs = esp_timer_get_time();
+    if (!mqttClient.beginPublish(topic, (unsigned int)length, false)) {
+        incrementMetric(MetricCounter::mqttPublishFailures);
+        return false;
+    }
+    streamRemaining = length;
+    uplinkStreamBegin(); // 발행이 끝날 때까지 다른 메시지는 대기열로
+    return true;
+}
+
+size_t writeMqttPublish(const uint8_t* data, size_t length) {
+    // PubSubClient::write()는 내부 버퍼를 거치지 않고 네트워크 클라이언트로 바로 씀
+    size_t written = mqttClient.write(data, min(length, streamRemaining));
+    streamRemaining -= written;
+    return written;
+}
+
+bool endMqttPublish() {
+    bool published = mqttClient.endPublish() == 1 && streamRemaining == 0;
+    observeMetric(MetricHistogram::publishLatencyUs, (uint32_t)(esp_timer_get_time() - streamStartUs));
+    if (!published) {
+        incrementMetric(MetricCounter::mqttPublishFailures);
+    }
+    streamRemaining = 0;
+    uplinkStreamEnd();
+    return published;
+}
+
+const char* getSensorTopic() {
+    return pubSensorTopic;
+}
+
+const char* getCaptureDoneTopic() {
+    return pubCaptureTopic;
+}
+
+const char* getBootReportTopic() {
+    return pubBootTopic;
+}
+
+const char* getTimeSeriesResponseTopic() {
+    return tsResponseTopic;
+}
+
+const char* getConfigAckTopic() {
+    return configAckTopic;
+}
+
+const char* getStatusTopic() {
+    return statusTopic;
+}
+
+const char* getTraceTopic() {
+    return traceTopic;
+}
+
+const char* getUrlRequestTopic() {
+    return urlRequestTopic;
+}
+
+const char* getImageTopic() {
+    return imageTopic;
+}
+
+bool applyMqttConfig() {
+    reconnectPolicy.setDelays(getConfigU32(ConfigKey::mqttReconnectBaseMs),
+                              getConfigU32(ConfigKey::mqttReconnectMaxMs));
+    // keepalive는 CONNECT 때 브로커와 합의한 값이라 세션 중에 바꾸면 PINGREQ 주기가 어긋남
+    // (늘리면 브로커가 1.5배 시간 초과로 끊음) → 다음 연결 시 connectMQTT()에서 반영
+    return !mqttClient.connected() || sessionKeepAliveSec == getConfigU32(ConfigKey::mqttKeepAliveSec);
 }
 
 void disconnectMQTT() {
     if (mqttClient.connected()) {
-        Serial.println("명령에 따라 MQTT 연결을 종료합니다.");
+        LOG_I(mqtt, "명령에 따라 MQTT 연결을 종료합니다.");
         mqttClient.disconnect();
         isMqttConnected = false;
         sendMqttStatusUpdate(false, "mqtt_disconnected");
@@ -135,31 +313,77 @@ void disconnectMQTT() {
 
 // 토픽 구독을 처리하는 함수
 static void subscribeToTopics() {
-    bool subscribed = mqttClient.subscribe(subTopic.c_str(), 0);
+    bool subscribed = mqttClient.subscribe(subTopic, 0) && mqttClient.subscribe(bleTopic, 0) &&
+                      mqttClient.subscribe(tsQueryTopic, 0) && mqttClient.subscribe(configTopic, 1) &&
+                      mqttClient.subscribe(statusRequestTopic, 0) && mqttClient.subscribe(urlTopic, 1) &&
+                      mqttClient.subscribe(imageAckTopic, 0);
     if (subscribed) {
-        Serial.println("토픽 구독 성공");
+        LOG_I(mqtt, "토픽 구독 성공");
     } else {
-        Serial.println("토픽 구독 실패");
+        LOG_W(mqtt, "토픽 구독 실패");
     }
 }
 
 // MQTT 메시지 수신 시 자동으로 호출되는 콜백 함수
 static void mqttCallback(char* topic, byte* payload, unsigned int length) {
     // 수신된 토픽이 "capture" 명령 토픽이라면
-    if (String(topic) == subTopic) {
+    if (strcmp(topic, subTopic) == 0) {
+        // 이미지 전송 중(ACK 대기, serviceUplink()의 mqttLoop)에 들어온 명령은 전송이 끝난 뒤 처리
+        if (isUplinkBulkActive()) {
+            if (length > sizeof(deferredCapture)) {
+                LOG_W(mqtt, "이미지 전송 중 촬영 명령 무시 (길이 %u)", length);
+                return;
+            }
+            if (deferredCaptureLength > 0) {
+                LOG_W(mqtt, "대기 중인 촬영 명령을 새 명령으로 교체");
+            }
+            memcpy(deferredCapture, payload, length);
+            deferredCaptureLength = length;
+            LOG_I(mqtt, "이미지 전송 중 촬영 명령 수신, 전송 후 처리");
+            return;
+        }
+        int64_t receivedUs = esp_timer_get_time();
         JsonDocument doc;
         DeserializationError error = deserializeJson(doc, payload, length);
 
         if (error) {
-            Serial.print("JSON 파싱 실패: ");
-            Serial.println(error.c_str());
+            LOG_W(mqtt, "JSON 파싱 실패: %s", error.c_str());
             return;
         }
 
-        if (doc["url"].is<JsonVariant>()) {
-            const char* url = doc["url"];
-            Serial.println("카메라 촬영 명령 수신");
-            triggerCameraCapture(String(url)); 
-        }
+        // "url"이 없으면 URL 풀에서 꺼내 씀 (클라우드가 촬영마다 URL을 만들지 않아도 됨)
+        const char* url = doc["url"] | "";
+        // 명령의 "id"를 추적 ID로 사용하고 "ts"(발행 시각, epoch ms)가 있으면 전달 시간도 기록
+        traceBegin(doc["id"] | "", receivedUs);
+        traceRecordDelivery(doc["ts"] | (uint64_t)0, receivedUs);
+        traceSpanRecord("parse", receivedUs, esp_timer_get_time());
+        LOG_I(mqtt, "카메라 촬영 명령 수신 (추적 %s)", getTraceId());
+        // "target"(bytes)가 있으면 이번 촬영만 JPEG 목표 크기를 바꿈 (0이면 저장된 품질 고정)
+        triggerCameraCapture(String(url), doc["target"] | (uint32_t)JPEG_TARGET_FROM_CONFIG);
+        traceEnd();
+    }
+    // BLE 창 요청 명령 (원격에서 재프로비저닝을 허용할 때 사용, 페이로드는 무시)
+    else if (strcmp(topic, bleTopic) == 0) {
+        requestBleWindow("MQTT 명령");
+    }
+    // 시계열 저장소 기간 질의 (응답은 tsr 토픽)
+    else if (strcmp(topic, tsQueryTopic) == 0) {
+        handleTimeSeriesQuery(payload, length);
+    }
+    // 원격 설정 델타 (검증 후 적용, 결과는 cfgack 토픽)
+    else if (strcmp(topic, configTopic) == 0) {
+        handleRemoteConfig(payload, length);
+    }
+    // 지표 스냅샷 즉시 요청 (페이로드는 무시, 응답은 status 토픽)
+    else if (strcmp(topic, statusRequestTopic) == 0) {
+        publishMetrics();
+    }
+    // MQTT 이미지 전송 청크 ACK (전송 중 mqttLoop()에서 수신)
+    else if (strcmp(topic, imageAckTopic) == 0) {
+        handleImageTransferAck(payload, length);
+    }
+    // 업로드 URL 보충 응답 (URL 풀에 추가)
+    else if (strcmp(topic, urlTopic) == 0) {
+        handleUrlPoolResponse(payload, length);
     }
 }
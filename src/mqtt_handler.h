@@ -6,6 +6,12 @@
 
 // isMqttConnected는 globals.h에서 선언됨
 
+// 토픽/클라이언트 ID 버퍼 크기 ("{12자리 MAC}/{suffix}" 형식)
+#define MQTT_TOPIC_BUFFER_SIZE 48
+
+// PubSubClient 송수신 버퍼 크기 (수신 메시지는 고정 헤더/토픽 포함 전체가 이 안에 들어가야 하며, 넘치면 버려짐)
+#define MQTT_BUFFER_SIZE 2048
+
 /**
  * @brief MQTT 클라이언트를 초기 설정
  * 보안 인증서, 서버 주소, 메시지 수신 콜백 함수를 설정
@@ -31,9 +37,103 @@ void mqttLoop();
  */
 void publishMqttMessage(const String& topic, const String& payload);
 
+/**
+ * @brief 힙 할당 없이 지정된 토픽으로 메시지를 발행
+ * 주기적인 텔레메트리처럼 자주 호출되는 경로에서 사용
+ * 이미지 전송 중에는 uplink_shaper가 토픽별 우선순위(sensor/tsr/trace는 텔레메트리, 나머지는 제어/상태)로 보낼 시점을 정함
+ * @param topic 발행할 토픽 (getSensorTopic() 등 미리 계산된 버퍼 권장, 토픽 분류는 버퍼 주소로 함)
+ * @param payload 페이로드 버퍼 (대기열에 넣을 때 복사되므로 반환 후 재사용 가능)
+ * @param length 페이로드 길이 (바이트)
+ * @return 발행했거나 업링크 대기열에 넣었으면 true
+ */
+bool publishMqttMessage(const char* topic, const char* payload, size_t length);
+
+/**
+ * @brief 센서 데이터 발행 토픽("{deviceUid}/sensor")을 반환
+ * initMQTT()에서 한 번 계산된 정적 버퍼를 가리킴
+ */
+const char* getSensorTopic();
+
+/**
+ * @brief PubSubClient 버퍼(2048 bytes)에 담기지 않는 큰 페이로드를 스트리밍 발행하기 시작합니다. (QoS 0)
+ * 고정 헤더와 토픽만 먼저 보내고, 페이로드는 writeMqttPublish()로 호출자의 버퍼에서 소켓으로 바로 씁니다.
+ * beginMqttPublish → writeMqttPublish(합계 length) → endMqttPublish 순서로 메인 루프 태스크에서만 호출합니다.
+ * 그 사이에 발행한 메시지는 업링크 대기열에 넣었다가 endMqttPublish() 뒤 serviceUplink()에서 보냅니다.
+ * @param length 페이로드 전체 크기 (이후 쓰는 양과 정확히 같아야 함)
+ * @return 연결되어 있지 않거나 헤더 전송에 실패하면 false
+ */
+bool beginMqttPublish(const char* topic, size_t length);
+
+/**
+ * @brief 스트리밍 발행 중인 메시지의 페이로드 일부를 씁니다. (복사 없음)
+ * @return 실제로 쓴 바이트 수 (length보다 작으면 연결이 끊긴 것)
+ */
+size_t writeMqttPublish(const uint8_t* data, size_t length);
+
+/**
+ * @brief 스트리밍 발행을 마칩니다.
+ * @return 쓴 양이 beginMqttPublish()의 length와 같고 연결이 유지되었으면 true
+ */
+bool endMqttPublish();
+
+/**
+ * @brief 촬영 완료 알림 토픽("{deviceUid}/cdone")을 반환
+ * initMQTT()에서 한 번 계산된 정적 버퍼를 가리킴
+ */
+const char* getCaptureDoneTopic();
+
+/**
+ * @brief 부팅 리포트 토픽("{deviceUid}/boot")을 반환
+ * 부팅 단계별 소요 시간을 부팅 후 한 번 발행할 때 사용
+ */
+const char* getBootReportTopic();
+
+/**
+ * @brief 시계열 질의 응답 토픽("{deviceUid}/tsr")을 반환
+ * "{deviceUid}/tsq"로 받은 기간 질의의 결과를 발행할 때 사용
+ */
+const char* getTimeSeriesResponseTopic();
+
+/**
+ * @brief 원격 설정 결과 토픽("{deviceUid}/cfgack")을 반환
+ * "{deviceUid}/config"로 받은 설정 델타의 적용 결과를 발행할 때 사용
+ */
+const char* getConfigAckTopic();
+
+/**
+ * @brief 지표 스냅샷 토픽("{deviceUid}/status")을 반환
+ * 주기 발행과 "{deviceUid}/statreq" 요청에 대한 응답에 사용
+ */
+const char* getStatusTopic();
+
+/**
+ * @brief 촬영 추적 내보내기 토픽("{deviceUid}/trace")을 반환
+ * 명령 수신부터 업로드 완료까지의 구간 목록을 발행할 때 사용
+ */
+const char* getTraceTopic();
+
+/**
+ * @brief 업로드 URL 보충 요청 토픽("{deviceUid}/urlreq")을 반환
+ * 응답은 "{deviceUid}/urls"로 받아 URL 풀에 넣음
+ */
+const char* getUrlRequestTopic();
+
+/**
+ * @brief MQTT 이미지 전송 청크 토픽("{deviceUid}/img")을 반환
+ * 청크 ACK는 "{deviceUid}/imgack"로 받아 mqtt_image_transfer에 전달
+ */
+const char* getImageTopic();
+
 /**
  * @brief MQTT 클라이언트 연결을 명시적으로 종료합니다.
  */
 void disconnectMQTT();
 
+/**
+ * @brief 설정 저장소의 keepalive와 재연결 백오프 범위를 반영합니다.
+ * 백오프는 다음 예약부터, keepalive는 다음 연결(CONNECT 패킷)부터 적용됩니다.
+ * @return 모두 즉시 반영되었으면 true, 연결 중이라 keepalive 변경이 다음 연결로 미뤄졌으면 false
+ */
+bool applyMqttConfig();
+
 #endif // MQTT_HANDLER_H
\ No newline at end of file
@@ -0,0 +1,220 @@
+#include "mqtt_image_transfer.h"
+#include "config.h" // IMG_MQTT_* 설정을 위해 포함
+#include <esp_system.h>
+#include <WiFi.h>
+#include "globals.h"
+#include "mqtt_handler.h"
+#include "upload_pacer.h"
+#include "uplink_shaper.h"
+#include "logger.h"
+
+static const uint8_t IMG_MQTT_VERSION = 1;
+static const uint8_t FLAG_LAST_CHUNK = 0x01;
+static const uint8_t ACK_STATUS_ABORT = 1;
+// 같은 누적 ACK를 이만큼 더 받으면 시간 초과를 기다리지 않고 그 위치부터 재전송 (수신 측은 순서가 어긋난 청크를 버림)
+static const uint8_t DUPLICATE_ACK_THRESHOLD = 2;
+
+// 진행 중인 전송 (메인 루프 태스크 전용, ACK도 같은 태스크의 mqttCallback에서 갱신)
+static bool active = false;
+static uint32_t transferId = 0;
+static uint16_t ackedChunks = 0;    // 수신 측이 다음에 받을 순번 (누적 ACK)
+static uint8_t duplicateAcks = 0;   // ackedChunks와 같은 ACK를 연속으로 받은 횟수
+static bool aborted = false;
+
+static void putLe16(uint8_t* out, uint16_t value) {
+    out[0] = (uint8_t)value;
+    out[1] = (uint8_t)(value >> 8);
+}
+
+static void putLe32(uint8_t* out, uint32_t value) {
+    putLe16(out, (uint16_t)value);
+    putLe16(out + 2, (uint16_t)(value >> 16));
+}
+
+static uint32_t getLe32(const uint8_t* in) {
+    return (uint32_t)in[0] | ((uint32_t)in[1] << 8) | ((uint32_t)in[2] << 16) | ((uint32_t)in[3] << 24);
+}
+
+// 이미지 데이터를 HTTPS 업로드와 같은 페이서로 나눠 씀 (write 1회 = TLS 레코드 1개, 송신 버퍼가 찬 동안만 대기)
+static bool writePaced(const uint8_t* data, size_t length) {
+    while (length > 0) {
+        uint32_t waitMs = uploadPacerWaitMs();
+        if (waitMs > 0) {
+            delay(waitMs);
+        }
+        size_t recordBytes = min(length, uploadPacerRecordBytes());
+        uint32_t writeStartUs = micros();
+        size_t written = writeMqttPublish(data, recordBytes);
+        uploadPacerOnWrite(written, micros() - writeStartUs);
+        if (written != recordBytes) {
+            return false;
+        }
+        data += written;
+        length -= written;
+    }
+    return true;
+}
+
+// 청크 1개를 헤더 + 원본 버퍼 조각으로 스트리밍 발행 (이미지 데이터는 복사하지 않음)
+static bool sendChunk(const uint8_t* data, size_t length, uint16_t seq, uint16_t chunkCount) {
+    size_t offset = (size_t)seq * IMG_MQTT_CHUNK_BYTES;
+    size_t chunkBytes = min((size_t)IMG_MQTT_CHUNK_BYTES, length - offset);
+
+    uint8_t header[IMG_MQTT_HEADER_BYTES];
+    header[0] = IMG_MQTT_VERSION;
+    header[1] = seq + 1 == chunkCount ? FLAG_LAST_CHUNK : 0;
+    putLe16(header + 2, seq);
+    putLe32(header + 4, transferId);
+    putLe32(header + 8, (uint32_t)offset);
+    putLe32(header + 12, (uint32_t)length);
+
+    if (!beginMqttPublish(getImageTopic(), sizeof(header) + chunkBytes)) {
+        return false;
+    }
+    bool written = writeMqttPublish(header, sizeof(header)) == sizeof(header) &&
+                   writePaced(data + offset, chunkBytes);
+    // 일부만 쓰였으면 연결이 끊긴 것이므로 endMqttPublish 결과와 관계없이 실패
+    return endMqttPublish() && written;
+}
+
+// 연결 상태를 갱신하고, 끊겼으면 재연결 정책에 따라 다시 연결될 때까지 대기 (재연결 시 imgack도 다시 구독됨)
+static bool waitForReconnect() {
+    unsigned long startMs = millis();
+    bool logged = false;
+    while (true) {
+        if (isWifiConnected) {
+            handleMqttConnection();
+        }
+        if (isMqttConnected) {
+            return true;
+        }
+        if (!logged) {
+            LOG_W(mqtt, "이미지 전송 중 MQTT 끊김, 재연결 대기 (최대 %lu ms)", (unsigned long)IMG_MQTT_RESUME_TIMEOUT_MS);
+            logged = true;
+        }
+        if (millis() - startMs >= IMG_MQTT_RESUME_TIMEOUT_MS) {
+            return false;
+        }
+        delay(50);
+    }
+}
+
+bool uploadImageOverMqtt(const uint8_t* data, size_t length) {
+    if (length == 0 || (length + IMG_MQTT_CHUNK_BYTES - 1) / IMG_MQTT_CHUNK_BYTES > UINT16_MAX) {
+        LOG_E(mqtt, "MQTT 이미지 전송 불가 크기: %zu bytes", length);
+        return false;
+    }
+    uint16_t chunkCount = (uint16_t)((length + IMG_MQTT_CHUNK_BYTES - 1) / IMG_MQTT_CHUNK_BYTES);
+    transferId = esp_random();
+    ackedChunks = 0;
+    duplicateAcks = 0;
+    aborted = false;
+    active = true;
+
+    LOG_I(mqtt, "MQTT 이미지 전송 시작: ID %08lx, %zu bytes, 청크 %u개", (unsigned long)transferId, length,
+          (unsigned)chunkCount);
+    unsigned long startMs = millis();
+    unsigned long progressMs = startMs;
+    uploadPacerBegin(WiFi.RSSI());
+    uplinkBulkBegin();
+    uint16_t nextChunk = 0;
+    uint16_t lastAcked = 0;
+    uint8_t retries = 0;
+    uint16_t resent = 0;
+    uint8_t resumes = 0;
+    bool fastRetransmitted = false; // ACK가 늘 때까지 중복 ACK로 다시 되돌아가지 않음
+    bool linkLost = false;
+    bool success = false;
+
+    while (true) {
+        if (linkLost || !isMqttConnected) {
+            if (resumes >= IMG_MQTT_MAX_RETRIES || !waitForReconnect()) {
+                LOG_E(mqtt, "MQTT 재연결 실패, 이미지 전송 중단 (%u/%u 청크 확인)", (unsigned)ackedChunks,
+                      (unsigned)chunkCount);
+                break;
+            }
+            // 끊기기 전에 보낸 청크의 도착 여부는 알 수 없으므로 마지막 누적 ACK 위치부터 이어서 전송
+            resent += nextChunk - ackedChunks;
+            nextChunk = ackedChunks;
+            progressMs = millis();
+            resumes++;
+            linkLost = false;
+        }
+
+        // 창이 허용하는 만큼 전송
+        while (nextChunk < chunkCount && nextChunk - ackedChunks < IMG_MQTT_WINDOW) {
+            if (!sendChunk(data, length, nextChunk, chunkCount)) {
+                linkLost = true; // 다음 반복에서 연결 상태 확인 후 재개
+                break;
+            }
+            nextChunk++;
+            serviceUplink(); // 청크 사이에 대기 중인 우선 메시지를 보냄
+        }
+
+        // ACK 수신 (mqttCallback → handleImageTransferAck)
+        mqttLoop();
+        if (aborted) {
+            LOG_E(mqtt, "수신 측이 이미지 전송을 중단함");
+            break;
+        }
+        if (ackedChunks >= chunkCount) {
+            success = true;
+            break;
+        }
+        if (nextChunk < ackedChunks) {
+            nextChunk = ackedChunks; // 재개 후 수신 측이 이미 받은 청크는 건너뜀
+        }
+        if (ackedChunks != lastAcked) {
+            lastAcked = ackedChunks;
+            progressMs = millis();
+            retries = 0;
+            fastRetransmitted = false;
+        } else if (duplicateAcks >= DUPLICATE_ACK_THRESHOLD && !fastRetransmitted && nextChunk > ackedChunks) {
+            LOG_D(mqtt, "이미지 청크 %u 유실 (중복 ACK), 재전송", (unsigned)ackedChunks);
+            resent += nextChunk - ackedChunks;
+            nextChunk = ackedChunks;
+            fastRetransmitted = true;
+        } else if (millis() - progressMs >= IMG_MQTT_ACK_TIMEOUT_MS) {
+            if (++retries > IMG_MQTT_MAX_RETRIES) {
+                LOG_E(mqtt, "이미지 전송 ACK 시간 초과, 중단 (%u/%u 청크 확인)", (unsigned)ackedChunks,
+                      (unsigned)chunkCount);
+                break;
+            }
+            // 누적 ACK 이후 청크가 유실된 것으로 보고 그 위치부터 다시 전송 (go-back-N)
+            LOG_W(mqtt, "이미지 청크 ACK 시간 초과, %u번부터 재전송 (%u회)", (unsigned)ackedChunks, (unsigned)retries);
+            resent += nextChunk - ackedChunks;
+            nextChunk = ackedChunks;
+            progressMs = millis();
+        } else if (nextChunk - ackedChunks >= IMG_MQTT_WINDOW || nextChunk >= chunkCount) {
+            serviceUplink();
+            delay(1); // 창이 가득 참: ACK 대기
+        }
+    }
+
+    active = false;
+    uplinkBulkEnd();
+    uint32_t elapsedMs = (uint32_t)(millis() - startMs);
+    // 성공한 전송만 goodput으로 기록 (cdone의 goodput_kbps, 첫 청크 → 마지막 ACK)
+    uint32_t goodputKBps = success ? uploadPacerEnd(length, elapsedMs) : 0;
+    LOG_I(mqtt, "MQTT 이미지 전송 %s: %lu ms, %lu KB/s (재전송 청크 %u, 재연결 후 재개 %u회)",
+          success ? "완료" : "실패", (unsigned long)elapsedMs, (unsigned long)goodputKBps, (unsigned)resent,
+          (unsigned)resumes);
+    return success;
+}
+
+void handleImageTransferAck(const byte* payload, unsigned int length) {
+    if (length < IMG_MQTT_ACK_BYTES || !active || getLe32(payload) != transferId) {
+        return; // 이전 전송에 대한 늦은 ACK 등은 무시
+    }
+    if (payload[6] == ACK_STATUS_ABORT) {
+        aborted = true;
+        return;
+    }
+    uint16_t next = (uint16_t)(payload[4] | (payload[5] << 8));
+    if (next > ackedChunks) {
+        ackedChunks = next;
+        duplicateAcks = 0;
+    } else if (next == ackedChunks && duplicateAcks < UINT8_MAX) {
+        duplicateAcks++;
+    }
+}
@@ -0,0 +1,31 @@
+#ifndef MQTT_IMAGE_TRANSFER_H
+#define MQTT_IMAGE_TRANSFER_H
+
+#include <Arduino.h>
+
+// 청크 헤더 크기 (모든 필드 little-endian)
+// [0] 버전  [1] 플래그(bit0: 마지막 청크)  [2..3] 순번  [4..7] 전송 ID  [8..11] 오프셋  [12..15] 전체 크기
+#define IMG_MQTT_HEADER_BYTES 16
+
+// ACK 크기: [0..3] 전송 ID  [4..5] 다음에 받을 순번(누적)  [6] 상태(0: 정상, 1: 중단)  [7] 예약
+#define IMG_MQTT_ACK_BYTES 8
+
+/**
+ * @brief 이미지를 "{deviceUid}/img"로 청크 단위 전송합니다. (uploadImageToS3 대체 경로, 완료까지 블로킹)
+ * 각 청크는 헤더 뒤에 data를 복사 없이 이어 쓰는 스트리밍 발행이며 (쓰기 크기/간격은 upload_pacer),
+ * 수신 측이 "{deviceUid}/imgack"로 보내는 누적 ACK로 IMG_MQTT_WINDOW개 창을 밀어 나갑니다.
+ * ACK가 IMG_MQTT_ACK_TIMEOUT_MS 동안 늘지 않으면 마지막 ACK 위치부터 다시 보내고,
+ * MQTT 연결이 끊기면 IMG_MQTT_RESUME_TIMEOUT_MS까지 재연결을 기다렸다가 같은 위치부터 이어서 보냅니다.
+ * 메인 루프 태스크에서만 호출합니다. (ACK 수신을 위해 내부에서 mqttLoop()를 호출)
+ * 청크 사이와 ACK 대기 중에는 serviceUplink()로 대기 중인 제어/텔레메트리 메시지를 먼저 보냅니다.
+ * 성공하면 goodput을 getUploadGoodputKBps()로 조회할 수 있습니다.
+ * @return 모든 청크의 ACK를 받으면 true
+ */
+bool uploadImageOverMqtt(const uint8_t* data, size_t length);
+
+/**
+ * @brief "{deviceUid}/imgack"로 받은 ACK를 반영합니다. (mqttCallback에서 호출)
+ */
+void handleImageTransferAck(const byte* payload, unsigned int length);
+
+#endif // MQTT_IMAGE_TRANSFER_H
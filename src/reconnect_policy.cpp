@@ -0,0 +1,100 @@
+#include "reconnect_policy.h"
+#include <esp_system.h>
+#include "logger.h"
+
+ReconnectPolicy::ReconnectPolicy(uint32_t baseDelayMs, uint32_t maxDelayMs,
+                                 uint8_t failureThreshold, uint32_t openDurationMs)
+    : baseDelayMs(baseDelayMs),
+      maxDelayMs(maxDelayMs),
+      failureThreshold(failureThreshold),
+      openDurationMs(openDurationMs),
+      currentState(ReconnectState::closed),
+      failureCount(0),
+      lastDelayMs(baseDelayMs),
+      nextAttemptMs(0),
+      inFlight(false) {}
+
+bool ReconnectPolicy::ready(unsigned long nowMs) {
+    // 진행 중인 시도의 결과가 나오기 전에는 다시 시작하지 않음
+    // millis() 오버플로에 안전하도록 차이값의 부호로 비교
+    if (inFlight || (long)(nowMs - nextAttemptMs) < 0) {
+        return false;
+    }
+    if (currentState == ReconnectState::open) {
+        currentState = ReconnectState::halfOpen;
+        LOG_I(system, "재연결 서킷 half-open: 시험 연결 1회 허용");
+    }
+    return true;
+}
+
+void ReconnectPolicy::onAttempt() {
+    inFlight = true;
+}
+
+void ReconnectPolicy::onFailed(unsigned long nowMs) {
+    inFlight = false;
+    if (failureCount < UINT8_MAX) {
+        failureCount++;
+    }
+
+    // half-open 시험이 실패했거나 연속 실패가 임계값에 도달하면 서킷을 연다
+    if (currentState == ReconnectState::halfOpen ||
+        (failureThreshold > 0 && failureCount >= failureThreshold)) {
+        currentState = ReconnectState::open;
+        lastDelayMs = maxDelayMs;
+        // 열린 시간도 백오프 상한 이하로 제한하여 장애가 풀리면 maxDelayMs 안에 다시 시도하게 함
+        uint32_t openCapMs = openDurationMs < maxDelayMs ? openDurationMs : maxDelayMs;
+        uint32_t openMs = randomBetween(openCapMs / 2, openCapMs);
+        nextAttemptMs = nowMs + openMs;
+        LOG_W(system, "재연결 서킷 open: 연속 실패 %u회, %lu ms 후 재시도",
+                      (unsigned)failureCount, (unsigned long)openMs);
+        return;
+    }
+
+    nextAttemptMs = nowMs + nextBackoffMs();
+}
+
+void ReconnectPolicy::onConnected() {
+    inFlight = false;
+    currentState = ReconnectState::closed;
+    failureCount = 0;
+    lastDelayMs = baseDelayMs;
+}
+
+void ReconnectPolicy::onDisconnected(unsigned long nowMs) {
+    onConnected();
+    nextAttemptMs = nowMs + nextBackoffMs();
+}
+
+void ReconnectPolicy::reset(unsigned long nowMs) {
+    onConnected();
+    nextAttemptMs = nowMs;
+}
+
+void ReconnectPolicy::setDelays(uint32_t newBaseDelayMs, uint32_t newMaxDelayMs) {
+    baseDelayMs = newBaseDelayMs;
+    maxDelayMs = newMaxDelayMs;
+    if (lastDelayMs < baseDelayMs) {
+        lastDelayMs = baseDelayMs;
+    } else if (lastDelayMs > maxDelayMs) {
+        lastDelayMs = maxDelayMs;
+    }
+}
+
+// Decorrelated jitter: sleep = min(cap, random(base, prev * 3))
+uint32_t ReconnectPolicy::nextBackoffMs() {
+    uint32_t upper = lastDelayMs > maxDelayMs / 3 ? maxDelayMs : lastDelayMs * 3;
+    lastDelayMs = randomBetween(baseDelayMs, upper);
+    if (lastDelayMs > maxDelayMs) {
+        lastDelayMs = maxDelayMs;
+    }
+    return lastDelayMs;
+}
+
+uint32_t ReconnectPolicy::randomBetween(uint32_t low, uint32_t high) {
+    if (high <= low) {
+        return low;
+    }
+    // esp_random()은 하드웨어 RNG 기반이라 장치마다 독립적인 지터를 보장
+    return low + esp_random() % (high - low + 1);
+}
@@ -0,0 +1,90 @@
+#ifndef RECONNECT_POLICY_H
+#define RECONNECT_POLICY_H
+
+#include <Arduino.h>
+
+// 서킷 브레이커 상태
+enum class ReconnectState { closed, open, halfOpen };
+
+/**
+ * @brief WiFi/MQTT가 공유하는 재연결 정책
+ * 고정 주기 재시도 대신 decorrelated jitter 지수 백오프를 사용하여,
+ * 장애 복구 시 전체 장치가 같은 순간에 재접속하지 않도록 분산시킵니다.
+ * 연속 실패가 임계값에 도달하면 서킷을 열어 일정 시간 시도를 멈추고,
+ * 이후 한 번의 시험 시도(half-open) 결과에 따라 닫거나 다시 엽니다.
+ */
+class ReconnectPolicy {
+public:
+    /**
+     * @param baseDelayMs 최소 재시도 간격 (밀리초)
+     * @param maxDelayMs 백오프 상한 (밀리초)
+     * @param failureThreshold 서킷을 열기까지 허용하는 연속 실패 횟수
+     * @param openDurationMs 서킷이 열려 있는 최대 시간 (밀리초, maxDelayMs로 제한되며 지터로 1/2 ~ 1배)
+     */
+    ReconnectPolicy(uint32_t baseDelayMs, uint32_t maxDelayMs,
+                    uint8_t failureThreshold, uint32_t openDurationMs);
+
+    /**
+     * @brief 지금 재연결을 시도해도 되는지 확인합니다.
+     * 진행 중인 시도가 있으면 결과가 나올 때까지 false를 반환하고,
+     * 열린 서킷의 대기 시간이 끝났다면 half-open으로 전환합니다.
+     */
+    bool ready(unsigned long nowMs);
+
+    /**
+     * @brief 재연결 시도 시작을 기록합니다.
+     * 결과는 onConnected() 또는 onFailed()로 알려야 하며, 그 전까지는 ready()가 false입니다.
+     * 결과가 비동기로 나오는 경우(WiFi)에도 진행 중인 시도를 다시 시작하지 않도록 합니다.
+     */
+    void onAttempt();
+
+    /**
+     * @brief 진행 중인 시도가 실패했을 때 호출합니다.
+     * 연속 실패를 세고 다음 시도 시각을 예약하며, 임계값에 도달하거나 half-open 시험이
+     * 실패하면 서킷을 엽니다.
+     */
+    void onFailed(unsigned long nowMs);
+
+    /**
+     * @brief 연결 성공 시 호출합니다. 백오프와 서킷을 초기화합니다.
+     */
+    void onConnected();
+
+    /**
+     * @brief 연결이 끊어졌을 때 호출합니다.
+     * 첫 재시도도 지터를 적용해 예약하여 동시 재접속을 피합니다.
+     */
+    void onDisconnected(unsigned long nowMs);
+
+    /**
+     * @brief 사용자 요청 등으로 즉시 재시도가 필요할 때 상태를 초기화합니다.
+     */
+    void reset(unsigned long nowMs);
+
+    /**
+     * @brief 백오프 범위를 변경합니다. (원격 설정 반영, 다음 예약부터 적용)
+     */
+    void setDelays(uint32_t baseDelayMs, uint32_t maxDelayMs);
+
+    ReconnectState state() const { return currentState; }
+    bool attemptInFlight() const { return inFlight; }
+    uint8_t consecutiveFailures() const { return failureCount; }
+    uint32_t currentDelayMs() const { return lastDelayMs; }
+
+private:
+    uint32_t nextBackoffMs();
+    uint32_t randomBetween(uint32_t low, uint32_t high);
+
+    uint32_t baseDelayMs;
+    uint32_t maxDelayMs;
+    uint8_t failureThreshold;
+    uint32_t openDurationMs;
+
+    ReconnectState currentState;
+    uint8_t failureCount;
+    uint32_t lastDelayMs;
+    unsigned long nextAttemptMs;
+    bool inFlight;
+};
+
+#endif // RECONNECT_POLICY_H
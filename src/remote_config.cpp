@@ -0,0 +1,178 @@
+#include "remote_config.h"
+#include <ArduinoJson.h>
+#include <esp_timer.h>
+#include "config_store.h"
+#include "mqtt_handler.h"
+#include "wifi_handler.h"
+#include "camera_handler.h"
+#include "logger.h"
+
+// 설정이 바뀌었을 때 다시 반영해야 하는 서브시스템 (비트 마스크)
+enum : uint8_t {
+    APPLY_NONE = 0,
+    APPLY_CAMERA = 1 << 0,
+    APPLY_MQTT = 1 << 1,
+    APPLY_WIFI = 1 << 2,
+};
+
+// 원격 설정 JSON 필드 ↔ 설정 키 매핑
+// 센서 발행 주기처럼 매번 저장소에서 읽는 값은 별도 반영 없이 다음 주기부터 적용됨
+struct RemoteConfigField {
+    const char* jsonName;
+    ConfigKey key;
+    uint8_t apply;
+};
+
+static const RemoteConfigField REMOTE_FIELDS[] = {
+    {"sensor_interval_ms",     ConfigKey::sensorPublishIntervalMs, APPLY_NONE},
+    {"jpeg_quality",           ConfigKey::cameraJpegQuality,       APPLY_CAMERA},
+    {"frame_size",             ConfigKey::cameraFrameSize,         APPLY_CAMERA},
+    {"jpeg_target_bytes",      ConfigKey::cameraJpegTargetBytes,   APPLY_NONE},
+    {"upload_transport",       ConfigKey::cameraUploadTransport,   APPLY_NONE},
+    {"mqtt_keepalive_s",       ConfigKey::mqttKeepAliveSec,        APPLY_MQTT},
+    {"mqtt_reconnect_base_ms", ConfigKey::mqttReconnectBaseMs,     APPLY_MQTT},
+    {"mqtt_reconnect_max_ms",  ConfigKey::mqttReconnectMaxMs,      APPLY_MQTT},
+    {"wifi_reconnect_base_ms", ConfigKey::wifiReconnectBaseMs,     APPLY_WIFI},
+    {"wifi_reconnect_max_ms",  ConfigKey::wifiReconnectMaxMs,      APPLY_WIFI},
+};
+static const size_t REMOTE_FIELD_COUNT = sizeof(REMOTE_FIELDS) / sizeof(REMOTE_FIELDS[0]);
+
+static const RemoteConfigField* findField(const char* name) {
+    for (size_t i = 0; i < REMOTE_FIELD_COUNT; i++) {
+        if (strcmp(REMOTE_FIELDS[i].jsonName, name) == 0) {
+            return &REMOTE_FIELDS[i];
+        }
+    }
+    return nullptr;
+}
+
+static void publishAck(const char* status, uint32_t version, const char* detail, JsonArrayConst applied, uint32_t latencyUs) {
+    JsonDocument ack;
+    ack["status"] = status;
+    ack["version"] = version;
+    if (detail != nullptr) {
+        ack["detail"] = detail;
+    }
+    if (!applied.isNull()) {
+        ack["applied"] = applied;
+    }
+    ack["latency_us"] = latencyUs;
+
+    static char ackBuffer[REMOTE_CONFIG_ACK_BUFFER_SIZE];
+    size_t ackLength = serializeJson(ack, ackBuffer, sizeof(ackBuffer));
+    if (ackLength > 0 && ackLength < sizeof(ackBuffer)) {
+        publishMqttMessage(getConfigAckTopic(), ackBuffer, ackLength);
+    }
+}
+
+static void reject(uint32_t version, const char* detail, int64_t startUs) {
+    LOG_I(mqtt, "원격 설정 거부: %s", detail);
+    publishAck("rejected", version, detail, JsonArrayConst(), (uint32_t)(esp_timer_get_time() - startUs));
+}
+
+void handleRemoteConfig(const uint8_t* payload, size_t length) {
+    int64_t startUs = esp_timer_get_time();
+    uint32_t currentVersion = getConfigU32(ConfigKey::configVersion);
+
+    JsonDocument request;
+    if (deserializeJson(request, payload, length)) {
+        reject(currentVersion, "invalid_json", startUs);
+        return;
+    }
+    JsonObjectConst delta = request.as<JsonObjectConst>();
+    if (delta.isNull()) {
+        reject(currentVersion, "invalid_json", startUs);
+        return;
+    }
+
+    // 버전이 주어지면 현재보다 새로운 경우에만 적용 (재전송된 명령은 무시)
+    uint32_t newVersion = currentVersion + 1;
+    if (delta["version"].is<uint32_t>()) {
+        newVersion = delta["version"].as<uint32_t>();
+        if (newVersion <= currentVersion) {
+            publishAck("stale", currentVersion, nullptr, JsonArrayConst(),
+                       (uint32_t)(esp_timer_get_time() - startUs));
+            return;
+        }
+    }
+
+    // 1단계: 전체 검증 (알 수 없는 키, 형식, 범위, 항목 간 제약)
+    const RemoteConfigField* fields[REMOTE_FIELD_COUNT];
+    uint32_t values[REMOTE_FIELD_COUNT];
+    size_t fieldCount = 0;
+    uint32_t proposed[static_cast<uint8_t>(ConfigKey::count)];
+    for (uint8_t i = 0; i < static_cast<uint8_t>(ConfigKey::count); i++) {
+        proposed[i] = getConfigU32(static_cast<ConfigKey>(i));
+    }
+
+    for (JsonPairConst pair : delta) {
+        const char* name = pair.key().c_str();
+        if (strcmp(name, "version") == 0) {
+            continue;
+        }
+        const RemoteConfigField* field = findField(name);
+        if (field == nullptr) {
+            reject(currentVersion, name, startUs); // 알 수 없는 키
+            return;
+        }
+        if (!pair.value().is<uint32_t>() || !isConfigU32Valid(field->key, pair.value().as<uint32_t>())) {
+            reject(currentVersion, name, startUs); // 형식 또는 범위 오류
+            return;
+        }
+        uint32_t value = pair.value().as<uint32_t>();
+        if (field->key == ConfigKey::cameraFrameSize && !isCameraFrameSizeSupported(value)) {
+            reject(currentVersion, name, startUs);
+            return;
+        }
+        fields[fieldCount] = field;
+        values[fieldCount] = value;
+        fieldCount++;
+        proposed[static_cast<uint8_t>(field->key)] = value;
+    }
+    if (proposed[static_cast<uint8_t>(ConfigKey::mqttReconnectBaseMs)] > proposed[static_cast<uint8_t>(ConfigKey::mqttReconnectMaxMs)]) {
+        reject(currentVersion, "mqtt_reconnect_base_ms>max", startUs);
+        return;
+    }
+    if (proposed[static_cast<uint8_t>(ConfigKey::wifiReconnectBaseMs)] > proposed[static_cast<uint8_t>(ConfigKey::wifiReconnectMaxMs)]) {
+        reject(currentVersion, "wifi_reconnect_base_ms>max", startUs);
+        return;
+    }
+
+    // 2단계: 저장 (도중에 저장이 실패하면 이미 바꾼 값을 되돌림)
+    uint32_t previous[REMOTE_FIELD_COUNT];
+    for (size_t i = 0; i < fieldCount; i++) {
+        previous[i] = getConfigU32(fields[i]->key);
+        if (!setConfigU32(fields[i]->key, values[i])) {
+            for (size_t j = 0; j < i; j++) {
+                setConfigU32(fields[j]->key, previous[j]);
+            }
+            reject(currentVersion, "storage_error", startUs);
+            return;
+        }
+    }
+    setConfigU32(ConfigKey::configVersion, newVersion);
+
+    // 3단계: 바뀐 서브시스템에만 반영 (재부팅/태스크 재시작 없음)
+    uint8_t applyMask = APPLY_NONE;
+    JsonDocument appliedDoc;
+    JsonArray applied = appliedDoc.to<JsonArray>();
+    for (size_t i = 0; i < fieldCount; i++) {
+        applyMask |= fields[i]->apply;
+        applied.add(fields[i]->jsonName);
+    }
+    const char* detail = nullptr;
+    if ((applyMask & APPLY_CAMERA) && !applyCameraConfig()) {
+        detail = "camera_apply_failed"; // 저장은 되었으므로 다음 초기화 시 반영
+    }
+    if ((applyMask & APPLY_MQTT) && !applyMqttConfig() && detail == nullptr) {
+        detail = "mqtt_keepalive_next_connect"; // 현재 세션은 기존 keepalive 유지
+    }
+    if (applyMask & APPLY_WIFI) {
+        applyWiFiConfig();
+    }
+
+    uint32_t latencyUs = (uint32_t)(esp_timer_get_time() - startUs);
+    LOG_I(mqtt, "원격 설정 v%lu 적용: %u개 항목, %lu us",
+                (unsigned long)newVersion, (unsigned)fieldCount, (unsigned long)latencyUs);
+    publishAck("applied", newVersion, detail, applied, latencyUs);
+}
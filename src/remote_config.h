@@ -0,0 +1,19 @@
+#ifndef REMOTE_CONFIG_H
+#define REMOTE_CONFIG_H
+
+#include <Arduino.h>
+
+// 설정 적용 결과(ack) JSON 버퍼 크기
+#define REMOTE_CONFIG_ACK_BUFFER_SIZE 384
+
+/**
+ * @brief MQTT 설정 토픽으로 받은 JSON 델타를 검증한 뒤 한꺼번에 적용하고 ack를 발행
+ * 하나라도 잘못된 항목이 있으면 아무것도 바꾸지 않음
+ * 적용된 값은 설정 저장소에 저장되고 해당 서브시스템에 재부팅 없이 반영됨
+ * 예: {"version": 12, "sensor_interval_ms": 5000, "jpeg_quality": 14}
+ * @param payload JSON 페이로드
+ * @param length 페이로드 길이
+ */
+void handleRemoteConfig(const uint8_t* payload, size_t length);
+
+#endif // REMOTE_CONFIG_H
@@ -0,0 +1,277 @@
+#include "scheduler.h"
+#include "config.h" // SCHEDULER_* 설정을 위해 포함
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "logger.h"
+
+static_assert(SCHEDULER_MAX_JOBS < INT8_MAX, "SchedulerJobId 범위를 넘습니다");
+
+// 작업 한 개. 같은 휠 슬롯의 작업들은 next로 연결됨
+struct SchedulerJob {
+    const char* name;
+    SchedulerJobFn fn;
+    uint32_t periodUs;
+    uint32_t deadlineUs;
+    uint32_t budgetUs;
+    uint64_t dueUs;           // 다음 예정 시각
+    SchedulerJobId next;      // 같은 슬롯의 다음 작업 (-1이면 끝)
+    SchedulerJobStats stats;
+};
+
+static const SchedulerJobId NO_JOB = -1;
+
+// 모듈 내부에서만 사용할 변수
+static SchedulerJob jobs[SCHEDULER_MAX_JOBS];
+static uint8_t jobCount = 0;
+
+// 타이머 휠: 1 tick = 1 ms, 예정 시각(ms) % 슬롯 수 위치에 작업을 매달아 둠
+// 한 바퀴(SCHEDULER_WHEEL_SLOTS ms)보다 먼 작업은 해당 tick이 될 때까지 슬롯에 남아 있음
+static SchedulerJobId wheel[SCHEDULER_WHEEL_SLOTS];
+static uint64_t wheelTickMs = 0; // 아직 처리하지 않은 가장 이른 tick
+
+static SchedulerStats stats = {};
+static uint64_t windowStartUs = 0;
+static float lastIdlePercent = 0.0f;
+
+static uint64_t defaultNowUs() {
+    return (uint64_t)esp_timer_get_time();
+}
+
+// 1 tick 미만이 남아도 최소 1 tick은 대기 (0 tick이면 바로 돌아와 busy-spin이 됨)
+// 작업 시작이 최대 1 tick 늦어질 수 있지만 휠 해상도(1 ms)와 같아 지터에는 영향 없음
+static bool defaultSleepUs(uint32_t us) {
+    TickType_t ticks = pdMS_TO_TICKS(us / 1000);
+    vTaskDelay(ticks > 0 ? ticks : 1);
+    return true;
+}
+
+static const SchedulerClock DEFAULT_CLOCK = {defaultNowUs, defaultSleepUs};
+static const SchedulerClock* activeClock = &DEFAULT_CLOCK;
+
+static void reportSchedulerStats();
+
+static void wheelInsert(SchedulerJobId id) {
+    // 이미 훑고 지나간 tick이면 다음 tick 슬롯에 넣어 한 바퀴 늦어지지 않게 함
+    uint64_t tickMs = jobs[id].dueUs / 1000;
+    if (tickMs < wheelTickMs) {
+        tickMs = wheelTickMs;
+    }
+    uint32_t slot = (uint32_t)(tickMs % SCHEDULER_WHEEL_SLOTS);
+    jobs[id].next = wheel[slot];
+    wheel[slot] = id;
+}
+
+// 지금까지 지난 tick의 슬롯을 훑어 예정 시각이 된 작업을 꺼냄
+static uint8_t collectDueJobs(uint64_t nowUs, SchedulerJobId* ready) {
+    uint64_t nowMs = nowUs / 1000;
+    if (nowMs < wheelTickMs) {
+        return 0;
+    }
+
+    // 오래 블로킹되어 한 바퀴 이상 밀렸으면 모든 슬롯을 한 번씩만 확인하면 충분
+    uint64_t elapsedTicks = nowMs - wheelTickMs + 1;
+    uint32_t slotsToScan = elapsedTicks > SCHEDULER_WHEEL_SLOTS ? SCHEDULER_WHEEL_SLOTS : (uint32_t)elapsedTicks;
+
+    uint8_t readyCount = 0;
+    for (uint32_t i = 0; i < slotsToScan; i++) {
+        uint32_t slot = (uint32_t)((wheelTickMs + i) % SCHEDULER_WHEEL_SLOTS);
+        SchedulerJobId* link = &wheel[slot];
+        while (*link != NO_JOB) {
+            SchedulerJobId id = *link;
+            if (jobs[id].dueUs / 1000 <= nowMs) {
+                *link = jobs[id].next;
+                ready[readyCount++] = id;
+            } else {
+                link = &jobs[id].next;
+            }
+        }
+    }
+    wheelTickMs = nowMs + 1;
+    return readyCount;
+}
+
+// 마감 시각(예정 시각 + deadline)이 이른 작업부터 실행 (작업 수가 적어 삽입 정렬)
+static void sortByDeadline(SchedulerJobId* ready, uint8_t count) {
+    for (uint8_t i = 1; i < count; i++) {
+        SchedulerJobId id = ready[i];
+        uint64_t deadline = jobs[id].dueUs + jobs[id].deadlineUs;
+        int j = i - 1;
+        while (j >= 0 && jobs[ready[j]].dueUs + jobs[ready[j]].deadlineUs > deadline) {
+            ready[j + 1] = ready[j];
+            j--;
+        }
+        ready[j + 1] = id;
+    }
+}
+
+static void runJob(SchedulerJobId id) {
+    SchedulerJob& job = jobs[id];
+    uint64_t startUs = activeClock->nowUs();
+    uint32_t latenessUs = startUs > job.dueUs ? (uint32_t)(startUs - job.dueUs) : 0;
+
+    job.fn();
+
+    uint64_t endUs = activeClock->nowUs();
+    uint32_t runUs = (uint32_t)(endUs - startUs);
+
+    SchedulerJobStats& s = job.stats;
+    s.runs++;
+    s.totalRunUs += runUs;
+    s.totalLatenessUs += latenessUs;
+    if (runUs > s.maxRunUs) {
+        s.maxRunUs = runUs;
+    }
+    if (latenessUs > s.maxLatenessUs) {
+        s.maxLatenessUs = latenessUs;
+    }
+    if (runUs > job.budgetUs) {
+        s.overruns++;
+    }
+    if (latenessUs > job.deadlineUs) {
+        s.deadlineMisses++;
+    }
+
+    // 위상을 유지하며 다음 주기 예약, 이미 지난 주기는 몰아서 실행하지 않고 건너뜀
+    job.dueUs += job.periodUs;
+    if (job.dueUs <= endUs) {
+        uint64_t behindUs = endUs - job.dueUs;
+        uint32_t skipped = (uint32_t)(behindUs / job.periodUs) + 1;
+        s.skippedPeriods += skipped;
+        job.dueUs += (uint64_t)skipped * job.periodUs;
+    }
+    wheelInsert(id);
+}
+
+// 현재 tick부터 한 바퀴 안에서 가장 이른 예정 시각을 찾음 (없으면 한 바퀴 뒤)
+static uint64_t nextDueUs(uint64_t nowUs) {
+    uint64_t limitUs = (wheelTickMs + SCHEDULER_WHEEL_SLOTS) * 1000;
+    uint64_t earliestUs = limitUs;
+    for (uint32_t i = 0; i < SCHEDULER_WHEEL_SLOTS; i++) {
+        uint64_t tickMs = wheelTickMs + i;
+        if (tickMs * 1000 >= earliestUs) {
+            break;
+        }
+        for (SchedulerJobId id = wheel[tickMs % SCHEDULER_WHEEL_SLOTS]; id != NO_JOB; id = jobs[id].next) {
+            if (jobs[id].dueUs / 1000 <= tickMs && jobs[id].dueUs < earliestUs) {
+                earliestUs = jobs[id].dueUs;
+            }
+        }
+    }
+    return earliestUs > nowUs ? earliestUs : nowUs;
+}
+
+// 함수 구현
+
+void initScheduler() {
+    jobCount = 0;
+    for (uint32_t i = 0; i < SCHEDULER_WHEEL_SLOTS; i++) {
+        wheel[i] = NO_JOB;
+    }
+    uint64_t nowUs = activeClock->nowUs();
+    wheelTickMs = nowUs / 1000;
+    windowStartUs = nowUs;
+    stats = {};
+
+    addSchedulerJob("sched", reportSchedulerStats, SCHEDULER_REPORT_INTERVAL_MS,
+                    SCHEDULER_REPORT_INTERVAL_MS, 5000, SCHEDULER_REPORT_INTERVAL_MS);
+}
+
+SchedulerJobId addSchedulerJob(const char* name, SchedulerJobFn fn, uint32_t periodMs,
+                               uint32_t deadlineMs, uint32_t budgetUs, uint32_t offsetMs) {
+    if (jobCount >= SCHEDULER_MAX_JOBS || fn == nullptr || periodMs == 0) {
+        LOG_W(system, "스케줄러 작업 등록 실패: %s", name);
+        return NO_JOB;
+    }
+
+    SchedulerJobId id = (SchedulerJobId)jobCount++;
+    SchedulerJob& job = jobs[id];
+    job.name = name;
+    job.fn = fn;
+    job.periodUs = periodMs * 1000;
+    job.deadlineUs = deadlineMs * 1000;
+    job.budgetUs = budgetUs;
+    job.dueUs = activeClock->nowUs() + (uint64_t)offsetMs * 1000;
+    job.stats = {};
+    wheelInsert(id);
+    return id;
+}
+
+void runScheduler() {
+    SchedulerJobId ready[SCHEDULER_MAX_JOBS];
+    uint8_t readyCount = collectDueJobs(activeClock->nowUs(), ready);
+    sortByDeadline(ready, readyCount);
+    for (uint8_t i = 0; i < readyCount; i++) {
+        runJob(ready[i]);
+    }
+
+    // 다음 예정 작업까지 대기 (busy-spin 없이 유휴 태스크에 CPU를 넘김)
+    // CPU를 넘기지 못하고 돌아온 시간은 유휴가 아니라 실행 시간으로 셈
+    uint64_t nowUs = activeClock->nowUs();
+    uint64_t dueUs = nextDueUs(nowUs);
+    if (dueUs > nowUs) {
+        if (activeClock->sleepUs((uint32_t)(dueUs - nowUs))) {
+            stats.idleUs += activeClock->nowUs() - nowUs;
+            stats.wakeups++;
+        } else {
+            stats.busyWaits++;
+        }
+    }
+}
+
+void setSchedulerClock(const SchedulerClock* newClock) {
+    activeClock = newClock != nullptr ? newClock : &DEFAULT_CLOCK;
+}
+
+uint8_t getSchedulerJobCount() {
+    return jobCount;
+}
+
+const char* getSchedulerJobName(SchedulerJobId id) {
+    if (id < 0 || id >= jobCount) {
+        return nullptr;
+    }
+    return jobs[id].name;
+}
+
+SchedulerJobStats getSchedulerJobStats(SchedulerJobId id) {
+    if (id < 0 || id >= jobCount) {
+        return {};
+    }
+    return jobs[id].stats;
+}
+
+SchedulerStats getSchedulerStats() {
+    SchedulerStats current = stats;
+    current.windowUs = activeClock->nowUs() - windowStartUs;
+    return current;
+}
+
+float getSchedulerIdlePercent() {
+    return lastIdlePercent;
+}
+
+// 리포트 주기마다 유휴율과 작업별 지터/예산 초과를 출력하고 통계를 초기화
+static void reportSchedulerStats() {
+    uint64_t nowUs = activeClock->nowUs();
+    uint64_t windowUs = nowUs - windowStartUs;
+    lastIdlePercent = windowUs > 0 ? (float)(stats.idleUs * 100.0 / (double)windowUs) : 0.0f;
+
+    LOG_I(system, "스케줄러: 유휴 %.1f%%, 대기 %u회, 양보 실패 %u회",
+                  lastIdlePercent, (unsigned)stats.wakeups, (unsigned)stats.busyWaits);
+    for (uint8_t i = 0; i < jobCount; i++) {
+        SchedulerJobStats& s = jobs[i].stats;
+        if (s.runs == 0) {
+            continue;
+        }
+        LOG_I(system, "  %-8s %5u회, 실행 평균 %lu/최대 %lu us, 지터 평균 %lu/최대 %lu us, 예산 초과 %u, 마감 초과 %u, 건너뜀 %u",
+                      jobs[i].name, (unsigned)s.runs,
+                      (unsigned long)(s.totalRunUs / s.runs), (unsigned long)s.maxRunUs,
+                      (unsigned long)(s.totalLatenessUs / s.runs), (unsigned long)s.maxLatenessUs,
+                      (unsigned)s.overruns, (unsigned)s.deadlineMisses, (unsigned)s.skippedPeriods);
+        s = {};
+    }
+
+    stats = {};
+    windowStartUs = nowUs;
+}
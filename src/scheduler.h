@@ -0,0 +1,94 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <Arduino.h>
+
+// 작업 식별자 (addSchedulerJob()의 반환값, 등록 실패 시 -1)
+typedef int8_t SchedulerJobId;
+
+// 주기적으로 실행할 작업 함수 (블로킹하지 않고 빨리 반환해야 함)
+typedef void (*SchedulerJobFn)();
+
+// 작업별 실행 통계 (리포트 주기마다 초기화)
+struct SchedulerJobStats {
+    uint32_t runs;            // 실행 횟수
+    uint32_t overruns;        // 실행 시간이 예산을 넘은 횟수
+    uint32_t deadlineMisses;  // 예정 시각보다 deadline 이상 늦게 시작한 횟수
+    uint32_t skippedPeriods;  // 한 주기 이상 밀려 건너뛴 주기 수
+    uint32_t maxRunUs;        // 최대 실행 시간 (us)
+    uint64_t totalRunUs;      // 누적 실행 시간 (us)
+    uint32_t maxLatenessUs;   // 최대 시작 지연 = 지터 (us)
+    uint64_t totalLatenessUs; // 누적 시작 지연 (us)
+};
+
+// 스케줄러 전체 통계 (리포트 주기 기준)
+struct SchedulerStats {
+    uint64_t windowUs;        // 측정 구간 길이 (us)
+    uint64_t idleUs;          // 대기(슬립)한 시간 (us)
+    uint32_t wakeups;         // 대기 횟수
+    uint32_t busyWaits;       // CPU를 넘기지 못하고 돌아온 대기 횟수 (유휴에서 제외)
+};
+
+// 시간 소스 (호스트에서는 가상 시계로 교체하여 지터/유휴율을 재현)
+struct SchedulerClock {
+    uint64_t (*nowUs)();              // 단조 증가 시각 (us)
+    bool (*sleepUs)(uint32_t us);     // us 동안 대기, CPU를 다른 태스크/유휴 상태로 넘겼으면 true
+};
+
+/**
+ * @brief 타이머 휠과 통계를 초기화하고 통계 리포트 작업을 등록합니다.
+ * setup()에서 작업을 등록하기 전에 한 번 호출합니다.
+ */
+void initScheduler();
+
+/**
+ * @brief 주기 작업을 등록합니다.
+ * @param name 통계 출력용 이름 (정적 문자열)
+ * @param fn 실행할 함수
+ * @param periodMs 실행 주기 (ms, 1 이상)
+ * @param deadlineMs 예정 시각 대비 허용 시작 지연 (ms, 넘으면 deadline miss)
+ * @param budgetUs 1회 실행 시간 예산 (us, 넘으면 overrun)
+ * @param offsetMs 첫 실행까지 지연 (같은 주기 작업의 위상 분산용)
+ * @return 작업 ID, 슬롯이 없으면 -1
+ */
+SchedulerJobId addSchedulerJob(const char* name, SchedulerJobFn fn, uint32_t periodMs,
+                               uint32_t deadlineMs, uint32_t budgetUs, uint32_t offsetMs = 0);
+
+/**
+ * @brief 예정 시각이 된 작업을 마감 시각 순으로 실행한 뒤 다음 작업까지 대기합니다.
+ * 메인 loop()에서 이 함수만 호출합니다. 대기 중에는 CPU가 다른 태스크/유휴 상태로 넘어갑니다.
+ */
+void runScheduler();
+
+/**
+ * @brief 시간 소스를 교체합니다. (nullptr이면 esp_timer/vTaskDelay 기본값)
+ * 가상 시계로 교체하면 호스트에서 지터와 유휴율을 결정적으로 측정할 수 있습니다.
+ */
+void setSchedulerClock(const SchedulerClock* clock);
+
+/**
+ * @brief 등록된 작업 수를 반환합니다.
+ */
+uint8_t getSchedulerJobCount();
+
+/**
+ * @brief 작업 이름을 반환합니다. (범위를 벗어나면 nullptr)
+ */
+const char* getSchedulerJobName(SchedulerJobId id);
+
+/**
+ * @brief 현재 리포트 구간의 작업별 통계를 반환합니다.
+ */
+SchedulerJobStats getSchedulerJobStats(SchedulerJobId id);
+
+/**
+ * @brief 현재 리포트 구간의 스케줄러 전체 통계를 반환합니다.
+ */
+SchedulerStats getSchedulerStats();
+
+/**
+ * @brief 직전 리포트 구간의 CPU 유휴율(%)을 반환합니다.
+ */
+float getSchedulerIdlePercent();
+
+#endif // SCHEDULER_H
@@ -5,24 +5,42 @@
 #include <Wire.h>
 #include <Adafruit_VCNL4040.h>
 #include <SparkFun_BMI270_Arduino_Library.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include "logger.h"
 
 // 모듈 내부에서만 사용할 객체 및 변수
 static Adafruit_VCNL4040 vcnl;
 static BMI270 imu;
 static SensorData currentSensorData; // 현재 센서 값을 저장할 내부 변수
+// 메인 루프(1Hz 발행)와 BLE 스트림 샘플러 태스크가 I2C 버스와 센서 값을 공유하므로 뮤텍스로 보호
+static SemaphoreHandle_t sensorMutex = nullptr;
+
+static SensorData copySensorData() {
+    if (sensorMutex == nullptr) {
+        return currentSensorData; // initSensors() 이전
+    }
+    SensorData snapshot;
+    xSemaphoreTake(sensorMutex, portMAX_DELAY);
+    snapshot = currentSensorData;
+    xSemaphoreGive(sensorMutex);
+    return snapshot;
+}
 
 // 함수 구현
 
 bool initSensors() {
+    sensorMutex = xSemaphoreCreateMutex();
+
     // 1. I2C 버스 시작
     Wire.begin(I2C_SDA_PIN, I2C_SCL_PIN);
 
     // 2. VCNL4040 (조도/근접) 센서 초기화
     if (!vcnl.begin()) {
-        Serial.println("VCNL4040 센서 미발견. 회로 연결 확인!");
+        LOG_I(sensor, "VCNL4040 센서 미발견. 회로 연결 확인!");
         return false;
     }
-    Serial.println("VCNL4040 센서 발견.");
+    LOG_I(sensor, "VCNL4040 센서 발견.");
     // VCNL4040 설정
     vcnl.setProximityLEDCurrent(VCNL4040_LED_CURRENT_200MA);
     vcnl.setProximityIntegrationTime(VCNL4040_PROXIMITY_INTEGRATION_TIME_8T);
@@ -33,20 +51,21 @@ bool initSensors() {
     // 연결될 때까지 몇 번 시도
     int retry = 0;
     while(imu.beginI2C(0x68) != BMI2_OK && retry < 3) {
-        Serial.println("BMI270 연결 안됨, 재시도...");
+        LOG_I(sensor, "BMI270 연결 안됨, 재시도...");
         delay(1000);
         retry++;
     }
     if (retry >= 3) {
-        Serial.println("BMI270 초기화 실패!");
+        LOG_W(sensor, "BMI270 초기화 실패!");
         return false;
     }
-    Serial.println("BMI270 센서 연결 성공!");
+    LOG_I(sensor, "BMI270 센서 연결 성공!");
 
     return true;
 }
 
-void readAllSensors() {
+// 호출자가 sensorMutex를 잡은 상태에서 모든 센서 값을 갱신
+static void readAllSensorsLocked() {
     // VCNL4040 센서 값 읽기
     currentSensorData.proximity = vcnl.getProximity();
     currentSensorData.ambientLight = vcnl.getLux();
@@ -60,29 +79,55 @@ void readAllSensors() {
         currentSensorData.gyroY = imu.data.gyroY;
         currentSensorData.gyroZ = imu.data.gyroZ;
     } else {
-        Serial.println("IMU 데이터 읽기 실패.");
+        LOG_W(sensor, "IMU 데이터 읽기 실패.");
     }
 }
 
+void readAllSensors() {
+    xSemaphoreTake(sensorMutex, portMAX_DELAY);
+    readAllSensorsLocked();
+    xSemaphoreGive(sensorMutex);
+}
+
+SensorData readSensorSample() {
+    xSemaphoreTake(sensorMutex, portMAX_DELAY);
+    readAllSensorsLocked();
+    SensorData snapshot = currentSensorData;
+    xSemaphoreGive(sensorMutex);
+    return snapshot;
+}
+
 float getAmbientLight() {
-    return currentSensorData.ambientLight;
+    return copySensorData().ambientLight;
 }
 
 SensorData getSensorDataStruct() {
-    return currentSensorData;
+    return copySensorData();
 }
 
-String getSensorDataJson() {
-    char jsonBuffer[256];
-    snprintf(jsonBuffer, sizeof(jsonBuffer),
+size_t formatSensorDataJson(char* buffer, size_t bufferSize) {
+    return formatSensorJson(copySensorData(), buffer, bufferSize);
+}
+
+size_t formatSensorJson(const SensorData& data, char* buffer, size_t bufferSize) {
+    int written = snprintf(buffer, bufferSize,
              "{\"proximity\":%d,\"lux\":%d,\"ax\":%.2f,\"ay\":%.2f,\"az\":%.2f,\"gx\":%.2f,\"gy\":%.2f,\"gz\":%.2f}",
-             currentSensorData.proximity,
-             (int)currentSensorData.ambientLight,
-             currentSensorData.accelX,
-             currentSensorData.accelY,
-             currentSensorData.accelZ,
-             currentSensorData.gyroX,
-             currentSensorData.gyroY,
-             currentSensorData.gyroZ);
+             data.proximity,
+             (int)data.ambientLight,
+             data.accelX,
+             data.accelY,
+             data.accelZ,
+             data.gyroX,
+             data.gyroY,
+             data.gyroZ);
+    if (written < 0 || (size_t)written >= bufferSize) {
+        return 0; // 버퍼 부족 시 잘린 JSON을 발행하지 않도록 실패 처리
+    }
+    return (size_t)written;
+}
+
+String getSensorDataJson() {
+    char jsonBuffer[SENSOR_JSON_BUFFER_SIZE];
+    formatSensorDataJson(jsonBuffer, sizeof(jsonBuffer));
     return String(jsonBuffer);
 }
\ No newline at end of file
@@ -3,6 +3,9 @@
 
 #include <Arduino.h>
 
+// formatSensorDataJson()에 필요한 최대 버퍼 크기
+#define SENSOR_JSON_BUFFER_SIZE 256
+
 // 모든 센서 데이터를 담을 구조체
 struct SensorData {
     uint16_t proximity;
@@ -24,6 +27,14 @@ bool initSensors();
  */
 void readAllSensors();
 
+/**
+ * @brief 센서를 한 번 읽고 그 결과를 반환합니다.
+ * 읽기와 복사를 같은 잠금 구간에서 수행하므로 다른 태스크에서 호출해도 안전합니다.
+ * BLE 스트림 샘플러 태스크에서 사용합니다.
+ * @return 방금 읽은 센서 데이터.
+ */
+SensorData readSensorSample();
+
 /**
  * @brief 현재 조도(lux) 값을 반환합니다.
  * 카메라 핸들러에서 야간 촬영 여부를 판단할 때 사용합니다.
@@ -31,6 +42,25 @@ void readAllSensors();
  */
 float getAmbientLight();
 
+/**
+ * @brief 현재 센서 데이터를 호출자가 제공한 버퍼에 JSON 형식으로 기록합니다.
+ * 힙 할당 없이 동작하므로 주기적인 MQTT 발행 경로에서 사용합니다.
+ * @param buffer JSON을 기록할 버퍼 (SENSOR_JSON_BUFFER_SIZE 이상 권장).
+ * @param bufferSize 버퍼 크기 (바이트).
+ * @return 기록된 문자열 길이. 버퍼가 부족하면 0.
+ */
+size_t formatSensorDataJson(char* buffer, size_t bufferSize);
+
+/**
+ * @brief 주어진 센서 데이터를 버퍼에 JSON 형식으로 기록합니다.
+ * 센서 상태를 읽지 않으므로 호스트 부하 시험기처럼 장치 여러 대의 값을 만들 때도 사용합니다.
+ * @param data 기록할 센서 데이터.
+ * @param buffer JSON을 기록할 버퍼 (SENSOR_JSON_BUFFER_SIZE 이상 권장).
+ * @param bufferSize 버퍼 크기 (바이트).
+ * @return 기록된 문자열 길이. 버퍼가 부족하면 0.
+ */
+size_t formatSensorJson(const SensorData& data, char* buffer, size_t bufferSize);
+
 /**
  * @brief 현재 센서 데이터 전체를 JSON 문자열 형식으로 반환합니다.
  * MQTT로 센서 데이터를 게시할 때 사용됩니다.
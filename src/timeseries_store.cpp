@@ -0,0 +1,523 @@
+#include "timeseries_store.h"
+#include <esp_partition.h>
+#include <esp_rom_crc.h>
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include <ArduinoJson.h>
+#include <time.h>
+#include "config.h"
+#include "mqtt_handler.h"
+#include "logger.h"
+
+#define TS_SEGMENT_SIZE SPI_FLASH_SEC_SIZE
+#define TS_RECORDS_PER_SEGMENT (TS_SEGMENT_SIZE / TS_RECORD_SIZE - 1)   // 첫 슬롯은 헤더
+#define TS_SEGMENT_MAGIC 0x31535354UL   // "TSS1"
+#define TS_UNWRITTEN 0xFFFFFFFFUL       // 지워진 플래시 값 (아직 기록하지 않은 필드)
+#define TS_READ_CHUNK_RECORDS 16
+
+// 세그먼트 헤더 (세그먼트의 첫 32바이트)
+// 지워진 필드(0xFF)는 나중에 한 번만 기록할 수 있으므로 min/max/개수는 필요한 시점에 각각 기록
+struct TsSegmentHeader {
+    uint32_t magic;
+    uint32_t sequence;      // 링 내에서 단조 증가 (최신 세그먼트가 가장 큼)
+    uint32_t headerCrc;     // magic + sequence의 CRC32
+    uint32_t minTimestamp;  // 첫 레코드 기록 시 기록
+    uint32_t maxTimestamp;  // 봉인 시 기록
+    uint32_t recordCount;   // 봉인 시 기록 (손상 레코드 포함 사용 슬롯 수)
+    uint32_t reserved[2];
+};
+
+static_assert(sizeof(TsRecord) == TS_RECORD_SIZE, "TsRecord는 32바이트여야 함");
+static_assert(sizeof(TsSegmentHeader) == TS_RECORD_SIZE, "세그먼트 헤더는 레코드 슬롯 1개 크기여야 함");
+
+// 세그먼트별 RAM 인덱스 (레코드 위치는 두지 않는 희소 인덱스, 세그먼트당 16바이트)
+struct TsSegmentIndex {
+    uint32_t sequence;
+    uint32_t minTimestamp;
+    uint32_t maxTimestamp;
+    uint16_t records;       // 사용된 레코드 슬롯 수
+    uint16_t valid;         // 헤더가 유효하면 1
+};
+
+// 세그먼트 링 하나 (원본 / 1분 평균)
+// 유효 세그먼트는 oldest부터 used개가 링 순서대로 이어지며, 마지막이 기록 중인 세그먼트
+struct TsRing {
+    const char* name;
+    uint16_t firstSegment;  // 파티션 내 시작 섹터
+    uint16_t segmentCount;
+    TsSegmentIndex* index;
+    uint16_t oldest;
+    uint16_t used;
+    uint32_t nextSequence;
+};
+
+static const esp_partition_t* partition = nullptr;
+static TsRing rawRing = {"raw", 0, 0, nullptr, 0, 0, 1};
+static TsRing rollupRing = {"1m", 0, 0, nullptr, 0, 0, 1};
+static SemaphoreHandle_t storeMutex = nullptr;
+static QueueHandle_t appendQueue = nullptr;
+static TimeSeriesStats stats = {};
+
+// 플래시 읽기 버퍼 (storeMutex를 잡은 상태에서만 사용)
+static TsRecord readChunk[TS_READ_CHUNK_RECORDS];
+
+static uint32_t recordCrc(const TsRecord& record) {
+    return esp_rom_crc32_le(0, reinterpret_cast<const uint8_t*>(&record), offsetof(TsRecord, crc));
+}
+
+static bool isErased(const TsRecord& record) {
+    const uint32_t* words = reinterpret_cast<const uint32_t*>(&record);
+    for (size_t i = 0; i < TS_RECORD_SIZE / sizeof(uint32_t); i++) {
+        if (words[i] != TS_UNWRITTEN) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static uint16_t physicalSegment(const TsRing& ring, uint16_t logical) {
+    return (ring.oldest + logical) % ring.segmentCount;
+}
+
+static size_t segmentOffset(const TsRing& ring, uint16_t segment) {
+    return (size_t)(ring.firstSegment + segment) * TS_SEGMENT_SIZE;
+}
+
+static size_t recordOffset(const TsRing& ring, uint16_t segment, uint16_t slot) {
+    return segmentOffset(ring, segment) + (size_t)(slot + 1) * TS_RECORD_SIZE;
+}
+
+// 세그먼트 레코드를 처음부터 읽어 사용 슬롯 수와 최대 시각을 복구 (봉인되지 않은 세그먼트용)
+static void scanSegment(const TsRing& ring, uint16_t segment, TsSegmentIndex& entry) {
+    entry.records = 0;
+    for (uint16_t slot = 0; slot < TS_RECORDS_PER_SEGMENT; slot += TS_READ_CHUNK_RECORDS) {
+        uint16_t chunk = min(TS_READ_CHUNK_RECORDS, TS_RECORDS_PER_SEGMENT - slot);
+        esp_partition_read(partition, recordOffset(ring, segment, slot), readChunk, chunk * TS_RECORD_SIZE);
+        for (uint16_t i = 0; i < chunk; i++) {
+            if (isErased(readChunk[i])) {
+                return; // 첫 빈 슬롯 = 다음 기록 위치
+            }
+            entry.records = slot + i + 1;
+            if (readChunk[i].crc != recordCrc(readChunk[i])) {
+                stats.corruptRecords++; // 기록 중 전원 차단 등, 슬롯은 사용된 것으로 둠
+                continue;
+            }
+            if (entry.minTimestamp == TS_UNWRITTEN) {
+                entry.minTimestamp = readChunk[i].timestamp;
+            }
+            if (readChunk[i].timestamp > entry.maxTimestamp) {
+                entry.maxTimestamp = readChunk[i].timestamp;
+            }
+        }
+    }
+}
+
+// 부팅 시 모든 세그먼트 헤더를 읽어 링 상태를 복구
+static void recoverRing(TsRing& ring) {
+    uint32_t newestSequence = 0;
+    int32_t newest = -1;
+
+    for (uint16_t segment = 0; segment < ring.segmentCount; segment++) {
+        TsSegmentHeader header;
+        TsSegmentIndex& entry = ring.index[segment];
+        esp_partition_read(partition, segmentOffset(ring, segment), &header, sizeof(header));
+
+        entry = {0, TS_UNWRITTEN, 0, 0, 0};
+        uint32_t crc = esp_rom_crc32_le(0, reinterpret_cast<const uint8_t*>(&header), 2 * sizeof(uint32_t));
+        if (header.magic != TS_SEGMENT_MAGIC || header.headerCrc != crc) {
+            continue;
+        }
+        entry.valid = 1;
+        entry.sequence = header.sequence;
+        if (header.recordCount != TS_UNWRITTEN) {
+            // 봉인된 세그먼트는 헤더만으로 인덱스 구성
+            entry.minTimestamp = header.minTimestamp;
+            entry.maxTimestamp = header.maxTimestamp;
+            entry.records = header.recordCount;
+        } else {
+            scanSegment(ring, segment, entry);
+        }
+        if (newest < 0 || entry.sequence > newestSequence) {
+            newest = segment;
+            newestSequence = entry.sequence;
+        }
+    }
+
+    if (newest < 0) {
+        ring.oldest = 0;
+        ring.used = 0;
+        ring.nextSequence = 1;
+        return;
+    }
+
+    // 최신 세그먼트에서 거꾸로 시퀀스가 1씩 줄어드는 구간까지가 유효 링
+    ring.used = 1;
+    uint16_t current = newest;
+    while (ring.used < ring.segmentCount) {
+        uint16_t previous = (current + ring.segmentCount - 1) % ring.segmentCount;
+        const TsSegmentIndex& entry = ring.index[previous];
+        if (!entry.valid || entry.sequence + 1 != ring.index[current].sequence) {
+            break;
+        }
+        current = previous;
+        ring.used++;
+    }
+    ring.oldest = current;
+    ring.nextSequence = newestSequence + 1;
+}
+
+static bool appendRecord(TsRing& ring, const TsRecord& record);
+
+// 원본 세그먼트 하나를 1분 평균 레코드로 요약하여 rollup 링에 기록
+static void rollupSegment(uint16_t segment) {
+    const TsSegmentIndex& entry = rawRing.index[segment];
+    int32_t sums[8] = {0};
+    uint16_t count = 0;
+    uint32_t minute = 0;
+
+    auto emit = [&]() {
+        if (count == 0) {
+            return;
+        }
+        TsRecord rollup;
+        memset(&rollup, 0, sizeof(rollup));
+        rollup.type = TS_RECORD_ROLLUP;
+        rollup.sampleCount = count;
+        rollup.timestamp = minute;
+        rollup.proximity = (uint16_t)(sums[0] / count);
+        rollup.luxX10 = (uint16_t)(sums[1] / count);
+        for (int axis = 0; axis < 3; axis++) {
+            rollup.accel[axis] = (int16_t)(sums[2 + axis] / count);
+            rollup.gyro[axis] = (int16_t)(sums[5 + axis] / count);
+        }
+        rollup.crc = recordCrc(rollup);
+        appendRecord(rollupRing, rollup);
+        stats.rollupRecords++;
+        memset(sums, 0, sizeof(sums));
+        count = 0;
+    };
+
+    for (uint16_t slot = 0; slot < entry.records; slot += TS_READ_CHUNK_RECORDS) {
+        uint16_t chunk = min((uint16_t)TS_READ_CHUNK_RECORDS, (uint16_t)(entry.records - slot));
+        esp_partition_read(partition, recordOffset(rawRing, segment, slot), readChunk, chunk * TS_RECORD_SIZE);
+        for (uint16_t i = 0; i < chunk; i++) {
+            const TsRecord& record = readChunk[i];
+            if (record.crc != recordCrc(record)) {
+                continue;
+            }
+            uint32_t recordMinute = record.timestamp - record.timestamp % 60;
+            if (count > 0 && recordMinute != minute) {
+                emit();
+            }
+            minute = recordMinute;
+            sums[0] += record.proximity;
+            sums[1] += record.luxX10;
+            for (int axis = 0; axis < 3; axis++) {
+                sums[2 + axis] += record.accel[axis];
+                sums[5 + axis] += record.gyro[axis];
+            }
+            count++;
+        }
+    }
+    emit();
+}
+
+// 가장 오래된 세그먼트를 비움 (원본 링은 먼저 1분 평균으로 요약)
+static void reclaimOldest(TsRing& ring) {
+    if (&ring == &rawRing) {
+        rollupSegment(ring.oldest);
+    }
+    ring.index[ring.oldest].valid = 0;
+    ring.index[ring.oldest].records = 0;
+    ring.oldest = (ring.oldest + 1) % ring.segmentCount;
+    ring.used--;
+}
+
+static void sealSegment(TsRing& ring, uint16_t segment) {
+    const TsSegmentIndex& entry = ring.index[segment];
+    uint32_t seal[2] = {entry.maxTimestamp, entry.records};
+    esp_partition_write(partition, segmentOffset(ring, segment) + offsetof(TsSegmentHeader, maxTimestamp),
+                        seal, sizeof(seal));
+}
+
+static bool openSegment(TsRing& ring) {
+    if (ring.used == ring.segmentCount) {
+        reclaimOldest(ring);
+    }
+    uint16_t segment = physicalSegment(ring, ring.used);
+    if (esp_partition_erase_range(partition, segmentOffset(ring, segment), TS_SEGMENT_SIZE) != ESP_OK) {
+        LOG_W(storage, "시계열 세그먼트 지우기 실패 (%s #%u)", ring.name, segment);
+        return false;
+    }
+    stats.erasedSegments++;
+
+    TsSegmentHeader header;
+    memset(&header, 0xFF, sizeof(header));
+    header.magic = TS_SEGMENT_MAGIC;
+    header.sequence = ring.nextSequence++;
+    header.headerCrc = esp_rom_crc32_le(0, reinterpret_cast<const uint8_t*>(&header), 2 * sizeof(uint32_t));
+    if (esp_partition_write(partition, segmentOffset(ring, segment), &header, sizeof(header)) != ESP_OK) {
+        return false;
+    }
+    ring.index[segment] = {header.sequence, TS_UNWRITTEN, 0, 0, 1};
+    ring.used++;
+    return true;
+}
+
+static bool appendRecord(TsRing& ring, const TsRecord& record) {
+    if (ring.used == 0 || ring.index[physicalSegment(ring, ring.used - 1)].records >= TS_RECORDS_PER_SEGMENT) {
+        if (ring.used > 0) {
+            sealSegment(ring, physicalSegment(ring, ring.used - 1));
+        }
+        if (!openSegment(ring)) {
+            return false;
+        }
+    }
+
+    uint16_t segment = physicalSegment(ring, ring.used - 1);
+    TsSegmentIndex& entry = ring.index[segment];
+    if (esp_partition_write(partition, recordOffset(ring, segment, entry.records), &record, sizeof(record)) != ESP_OK) {
+        return false;
+    }
+    if (entry.minTimestamp == TS_UNWRITTEN) {
+        entry.minTimestamp = record.timestamp;
+        esp_partition_write(partition, segmentOffset(ring, segment) + offsetof(TsSegmentHeader, minTimestamp),
+                            &entry.minTimestamp, sizeof(entry.minTimestamp));
+    }
+    // 시각이 뒤로 보정되어도 인덱스의 최대 시각은 단조 증가를 유지 (이분 탐색 전제)
+    if (record.timestamp > entry.maxTimestamp) {
+        entry.maxTimestamp = record.timestamp;
+    }
+    entry.records++;
+    return true;
+}
+
+static void writerTask(void* parameter) {
+    TsRecord record;
+    while (true) {
+        if (xQueueReceive(appendQueue, &record, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+        xSemaphoreTake(storeMutex, portMAX_DELAY);
+        if (appendRecord(rawRing, record)) {
+            stats.appended++;
+        }
+        xSemaphoreGive(storeMutex);
+    }
+}
+
+static bool initRing(TsRing& ring, uint16_t firstSegment, uint16_t segmentCount) {
+    ring.firstSegment = firstSegment;
+    ring.segmentCount = segmentCount;
+    size_t indexSize = sizeof(TsSegmentIndex) * segmentCount;
+    ring.index = static_cast<TsSegmentIndex*>(psramFound() ? ps_malloc(indexSize) : malloc(indexSize));
+    if (ring.index == nullptr) {
+        return false;
+    }
+    recoverRing(ring);
+    return true;
+}
+
+bool initTimeSeriesStore() {
+    partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_SPIFFS, TS_PARTITION_LABEL);
+    if (partition == nullptr) {
+        LOG_I(storage, "시계열 저장소: spiffs 파티션 없음");
+        return false;
+    }
+
+    uint16_t totalSegments = partition->size / TS_SEGMENT_SIZE;
+    if (totalSegments <= TS_ROLLUP_SEGMENTS + 1) {
+        LOG_I(storage, "시계열 저장소: 파티션이 너무 작음");
+        return false;
+    }
+
+    int64_t startUs = esp_timer_get_time();
+    if (!initRing(rollupRing, 0, TS_ROLLUP_SEGMENTS) ||
+        !initRing(rawRing, TS_ROLLUP_SEGMENTS, totalSegments - TS_ROLLUP_SEGMENTS)) {
+        LOG_W(storage, "시계열 저장소: 인덱스 메모리 할당 실패");
+        return false;
+    }
+
+    storeMutex = xSemaphoreCreateMutex();
+    appendQueue = xQueueCreate(TS_APPEND_QUEUE_DEPTH, sizeof(TsRecord));
+    xTaskCreate(writerTask, "tsWriter", 4096, nullptr, 1, nullptr);
+
+    LOG_I(storage, "시계열 저장소 복구 완료 (%lld ms): 원본 %u/%u, 1분 평균 %u/%u 세그먼트, 손상 레코드 %lu",
+                   (esp_timer_get_time() - startUs) / 1000,
+                   rawRing.used, rawRing.segmentCount, rollupRing.used, rollupRing.segmentCount,
+                   (unsigned long)stats.corruptRecords);
+    return true;
+}
+
+bool appendTimeSeriesSample(const SensorData& data) {
+    if (appendQueue == nullptr) {
+        return false;
+    }
+    time_t now = time(nullptr);
+    if (now < (time_t)TIME_MIN_VALID_EPOCH) {
+        stats.skippedNoTime++;
+        return false;
+    }
+
+    TsRecord record;
+    memset(&record, 0, sizeof(record));
+    record.type = TS_RECORD_RAW;
+    record.sampleCount = 1;
+    record.timestamp = (uint32_t)now;
+    record.proximity = data.proximity;
+    float lux10 = data.ambientLight * 10.0f;
+    record.luxX10 = lux10 >= 65535.0f ? 65535 : (lux10 <= 0.0f ? 0 : (uint16_t)lux10);
+    float accel[3] = {data.accelX, data.accelY, data.accelZ};
+    float gyro[3] = {data.gyroX, data.gyroY, data.gyroZ};
+    for (int axis = 0; axis < 3; axis++) {
+        record.accel[axis] = (int16_t)constrain(accel[axis] * 1000.0f, -32768.0f, 32767.0f);
+        record.gyro[axis] = (int16_t)constrain(gyro[axis] * 10.0f, -32768.0f, 32767.0f);
+    }
+    record.crc = recordCrc(record);
+
+    if (xQueueSend(appendQueue, &record, 0) != pdTRUE) {
+        stats.droppedQueueFull++;
+        return false;
+    }
+    return true;
+}
+
+size_t queryTimeSeries(uint32_t from, uint32_t to, bool rollup, TsRecord* out, size_t maxRecords, uint32_t* nextTimestamp) {
+    *nextTimestamp = 0;
+    if (storeMutex == nullptr || maxRecords == 0) {
+        return 0;
+    }
+    const TsRing& ring = rollup ? rollupRing : rawRing;
+    size_t found = 0;
+
+    xSemaphoreTake(storeMutex, portMAX_DELAY);
+
+    // maxTimestamp >= from 인 첫 세그먼트를 이분 탐색
+    uint16_t low = 0;
+    uint16_t high = ring.used;
+    while (low < high) {
+        uint16_t mid = (low + high) / 2;
+        const TsSegmentIndex& entry = ring.index[physicalSegment(ring, mid)];
+        if (entry.records == 0 || entry.maxTimestamp < from) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    for (uint16_t logical = low; logical < ring.used; logical++) {
+        uint16_t segment = physicalSegment(ring, logical);
+        const TsSegmentIndex& entry = ring.index[segment];
+        if (entry.records == 0) {
+            continue;
+        }
+        if (entry.minTimestamp != TS_UNWRITTEN && entry.minTimestamp > to) {
+            break;
+        }
+        for (uint16_t slot = 0; slot < entry.records; slot += TS_READ_CHUNK_RECORDS) {
+            uint16_t chunk = min((uint16_t)TS_READ_CHUNK_RECORDS, (uint16_t)(entry.records - slot));
+            esp_partition_read(partition, recordOffset(ring, segment, slot), readChunk, chunk * TS_RECORD_SIZE);
+            for (uint16_t i = 0; i < chunk; i++) {
+                const TsRecord& record = readChunk[i];
+                if (record.crc != recordCrc(record)) {
+                    continue; // 손상 레코드는 복구 시 이미 집계됨
+                }
+                if (record.timestamp < from || record.timestamp > to) {
+                    continue;
+                }
+                if (found == maxRecords) {
+                    // 결과가 잘림: 다음 질의는 여기서부터 (같은 시각 레코드는 중복될 수 있음)
+                    *nextTimestamp = record.timestamp;
+                    xSemaphoreGive(storeMutex);
+                    return found;
+                }
+                out[found++] = record;
+            }
+        }
+    }
+
+    xSemaphoreGive(storeMutex);
+    return found;
+}
+
+void handleTimeSeriesQuery(const uint8_t* payload, size_t length) {
+    JsonDocument request;
+    DeserializationError error = deserializeJson(request, payload, length);
+    if (error) {
+        LOG_W(storage, "시계열 질의 JSON 파싱 실패: %s", error.c_str());
+        return;
+    }
+
+    uint32_t from = request["from"] | 0UL;
+    uint32_t to = request["to"] | 0xFFFFFFFFUL;
+    bool rollup = strcmp(request["res"] | "raw", "1m") == 0;
+    size_t limit = request["limit"] | TS_QUERY_MAX_RECORDS;
+    if (limit == 0 || limit > TS_QUERY_MAX_RECORDS) {
+        limit = TS_QUERY_MAX_RECORDS;
+    }
+
+    static TsRecord results[TS_QUERY_MAX_RECORDS];
+    uint32_t nextTimestamp = 0;
+    int64_t startUs = esp_timer_get_time();
+    size_t count = queryTimeSeries(from, to, rollup, results, limit, &nextTimestamp);
+    uint32_t elapsedUs = (uint32_t)(esp_timer_get_time() - startUs);
+
+    // 행 형식: [ts, n, prox, lux x10, ax, ay, az, gx, gy, gz]
+    JsonDocument response;
+    response["id"] = request["id"];
+    response["res"] = rollup ? "1m" : "raw";
+    response["count"] = count;
+    response["us"] = elapsedUs;
+    if (nextTimestamp != 0) {
+        response["next"] = nextTimestamp;
+    }
+    JsonArray rows = response["rows"].to<JsonArray>();
+    for (size_t i = 0; i < count; i++) {
+        JsonArray row = rows.add<JsonArray>();
+        row.add(results[i].timestamp);
+        row.add(results[i].sampleCount);
+        row.add(results[i].proximity);
+        row.add(results[i].luxX10);
+        for (int axis = 0; axis < 3; axis++) {
+            row.add(results[i].accel[axis]);
+        }
+        for (int axis = 0; axis < 3; axis++) {
+            row.add(results[i].gyro[axis]);
+        }
+    }
+
+    // serializeJson은 버퍼가 부족하면 잘린 JSON을 쓰므로 먼저 길이를 재고,
+    // 넘치면 뒤쪽 행을 빼서 그 행의 시각을 next로 돌려줌 (값이 큰 행이 많으면 30건이 1800 bytes를 넘음)
+    static char responseBuffer[TS_RESPONSE_BUFFER_SIZE];
+    size_t responseLength = measureJson(response);
+    while (responseLength >= sizeof(responseBuffer) && count > 0) {
+        count--;
+        rows.remove(count);
+        response["count"] = count;
+        response["next"] = results[count].timestamp;
+        responseLength = measureJson(response);
+    }
+    if (responseLength >= sizeof(responseBuffer)) {
+        // 행이 없어도 넘치는 건 id가 매우 긴 경우뿐이므로 id 없이 오류만 응답
+        LOG_W(storage, "시계열 응답이 버퍼보다 큼 (%u bytes)", (unsigned)responseLength);
+        JsonDocument failure;
+        failure["error"] = "response_too_large";
+        responseLength = serializeJson(failure, responseBuffer, sizeof(responseBuffer));
+    } else {
+        responseLength = serializeJson(response, responseBuffer, sizeof(responseBuffer));
+    }
+    publishMqttMessage(getTimeSeriesResponseTopic(), responseBuffer, responseLength);
+    LOG_I(storage, "시계열 질의: %u건 (%s), %lu us", (unsigned)count, rollup ? "1m" : "raw", (unsigned long)elapsedUs);
+}
+
+TimeSeriesStats getTimeSeriesStats() {
+    TimeSeriesStats snapshot = stats;
+    snapshot.rawSegments = rawRing.used;
+    snapshot.rollupSegments = rollupRing.used;
+    snapshot.queueDepth = appendQueue ? (uint16_t)uxQueueMessagesWaiting(appendQueue) : 0;
+    return snapshot;
+}
@@ -0,0 +1,85 @@
+#ifndef TIMESERIES_STORE_H
+#define TIMESERIES_STORE_H
+
+#include <Arduino.h>
+#include "sensor_handler.h"
+
+// --- 플래시 레이아웃 (spiffs 파티션을 원시 섹터 단위로 사용) ---
+// 세그먼트 = 플래시 섹터 1개(4KB) = 헤더 슬롯 1개 + 레코드 127개, 레코드는 32바이트 고정
+// 파티션 앞쪽 TS_ROLLUP_SEGMENTS개는 1분 평균(rollup) 링, 나머지는 원본(raw) 링
+// 원본 링이 가득 차면 가장 오래된 세그먼트를 1분 평균으로 요약해 rollup 링에 기록한 뒤 지움
+#define TS_RECORD_SIZE 32
+#define TS_RECORD_RAW 0x01
+#define TS_RECORD_ROLLUP 0x02
+
+// 한 번의 질의로 반환하는 최대 레코드 수 (MQTT 버퍼 2048바이트 기준)
+#define TS_QUERY_MAX_RECORDS 30
+// 질의 응답 JSON 버퍼 크기 (토픽/헤더를 위해 MQTT 버퍼보다 작게)
+#define TS_RESPONSE_BUFFER_SIZE 1800
+
+// 플래시에 기록되는 레코드 (little-endian, 마지막 4바이트는 앞 28바이트의 CRC32)
+struct TsRecord {
+    uint8_t type;           // TS_RECORD_RAW / TS_RECORD_ROLLUP
+    uint8_t reserved;
+    uint16_t sampleCount;   // rollup: 평균에 사용된 원본 레코드 수, raw: 1
+    uint32_t timestamp;     // UNIX 시각 (초), rollup은 해당 분의 시작
+    uint16_t proximity;
+    uint16_t luxX10;        // 조도 x10 (포화)
+    int16_t accel[3];       // mg
+    int16_t gyro[3];        // 0.1 dps
+    uint8_t spare[4];       // 확장용 (0)
+    uint32_t crc;
+};
+
+// 저장소 통계
+struct TimeSeriesStats {
+    uint32_t appended;          // 플래시에 기록한 원본 레코드 수
+    uint32_t droppedQueueFull;  // 기록 태스크가 밀려 버린 레코드 수
+    uint32_t skippedNoTime;     // 시각 동기화 전이라 기록하지 않은 샘플 수
+    uint32_t erasedSegments;    // 부팅 이후 지운 섹터 수 (플래시 마모 지표)
+    uint32_t rollupRecords;     // 생성한 1분 평균 레코드 수
+    uint32_t corruptRecords;    // 부팅 시 복구 중 CRC가 맞지 않아 건너뛴 레코드 수
+    uint16_t rawSegments;       // 현재 원본 링에 들어있는 세그먼트 수
+    uint16_t rollupSegments;    // 현재 rollup 링에 들어있는 세그먼트 수
+    uint16_t queueDepth;        // 기록 태스크 대기 레코드 수
+};
+
+/**
+ * @brief spiffs 파티션을 열고 세그먼트 헤더를 읽어 인덱스를 만든 뒤 기록 태스크를 시작
+ * 전원이 끊겼던 활성 세그먼트는 레코드를 다시 읽어 마지막 유효 위치부터 이어서 기록
+ * @return 파티션을 찾지 못하거나 인덱스 메모리를 할당하지 못하면 false
+ */
+bool initTimeSeriesStore();
+
+/**
+ * @brief 센서 샘플 하나를 기록 큐에 넣음 (플래시 쓰기는 백그라운드 태스크에서 수행)
+ * SNTP 시각 동기화 전에는 기록하지 않음
+ * @return 큐에 넣었으면 true
+ */
+bool appendTimeSeriesSample(const SensorData& data);
+
+/**
+ * @brief 기간 내 레코드를 오래된 순으로 읽음
+ * 세그먼트 인덱스에서 이분 탐색으로 시작 세그먼트를 찾은 뒤 순차로 읽음
+ * @param from 시작 시각 (포함)
+ * @param to 종료 시각 (포함)
+ * @param rollup true면 1분 평균 링, false면 원본 링
+ * @param out 결과를 받을 배열
+ * @param maxRecords out 크기
+ * @param nextTimestamp 결과가 잘렸으면 다음 질의 시작 시각, 아니면 0
+ * @return 읽은 레코드 수
+ */
+size_t queryTimeSeries(uint32_t from, uint32_t to, bool rollup, TsRecord* out, size_t maxRecords, uint32_t* nextTimestamp);
+
+/**
+ * @brief MQTT 질의 요청(JSON)을 처리하고 응답 토픽으로 결과를 발행
+ * 요청: {"id":..., "from":UNIX초, "to":UNIX초, "res":"raw"|"1m", "limit":N}
+ */
+void handleTimeSeriesQuery(const uint8_t* payload, size_t length);
+
+/**
+ * @brief 저장소 통계를 반환
+ */
+TimeSeriesStats getTimeSeriesStats();
+
+#endif // TIMESERIES_STORE_H
@@ -0,0 +1,209 @@
+#include "trace.h"
+#include "config.h" // TRACE_*, TIME_MIN_VALID_EPOCH 설정을 위해 포함
+#include <stdarg.h>
+#include <sys/time.h>
+#include <esp_timer.h>
+#include "globals.h"
+#include "mqtt_handler.h"
+#include "logger.h"
+
+// 구간 하나 (시각은 추적 기준 시각에 대한 오프셋, 71분 이상 걸리는 추적은 없음)
+struct TraceSpan {
+    const char* name;
+    int8_t parent;       // 상위 구간 (-1이면 최상위)
+    int32_t startUs;
+    int32_t endUs;       // 열린 구간은 TRACE_OPEN
+};
+
+static const int32_t TRACE_OPEN = INT32_MIN;
+
+// 모듈 내부에서만 사용할 변수 (메인 루프 태스크 전용이라 락 없음)
+static TraceSpan spans[TRACE_MAX_SPANS];
+static uint8_t spanCount = 0;
+static int8_t openSpan = -1;   // 가장 안쪽의 열린 구간
+static int64_t traceStartUs = 0;
+static bool active = false;
+static char traceId[TRACE_ID_MAX_LENGTH + 1] = "";
+
+static int32_t toOffset(int64_t timestampUs) {
+    return (int32_t)(timestampUs - traceStartUs);
+}
+
+static TraceSpanId addSpan(const char* name, int8_t parent, int32_t startUs, int32_t endUs) {
+    if (!active || spanCount >= TRACE_MAX_SPANS) {
+        return -1;
+    }
+    TraceSpan& span = spans[spanCount];
+    span.name = name;
+    span.parent = parent;
+    span.startUs = startUs;
+    span.endUs = endUs;
+    return (TraceSpanId)spanCount++;
+}
+
+// JSON 문자열에 그대로 넣을 수 있게 따옴표/역슬래시/제어 문자는 '_'로 바꿔 복사
+static void copyTraceId(const char* source) {
+    size_t length = 0;
+    while (source[length] != '\0' && length < TRACE_ID_MAX_LENGTH) {
+        char c = source[length];
+        traceId[length] = (c == '"' || c == '\\' || (uint8_t)c < 0x20) ? '_' : c;
+        length++;
+    }
+    traceId[length] = '\0';
+}
+
+// snprintf 결과를 누적하며 버퍼 부족을 검사
+static bool appendFormat(char* buffer, size_t bufferSize, size_t& used, const char* format, ...)
+    __attribute__((format(printf, 4, 5)));
+
+static bool appendFormat(char* buffer, size_t bufferSize, size_t& used, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    int written = vsnprintf(buffer + used, bufferSize - used, format, args);
+    va_end(args);
+    if (written < 0 || (size_t)written >= bufferSize - used) {
+        return false;
+    }
+    used += written;
+    return true;
+}
+
+#if TRACE_EXPORT_MQTT
+static size_t formatTraceEventsJson(char* buffer, size_t bufferSize) {
+    size_t used = 0;
+    if (!appendFormat(buffer, bufferSize, used, "{\"id\":\"%s\",\"t0\":%lld,\"spans\":[",
+                      traceId, (long long)traceStartUs)) {
+        return 0;
+    }
+    for (uint8_t i = 0; i < spanCount; i++) {
+        const TraceSpan& span = spans[i];
+        if (!appendFormat(buffer, bufferSize, used, "%s[\"%s\",%d,%ld,%ld]", i ? "," : "", span.name,
+                          span.parent, (long)span.startUs, (long)(span.endUs - span.startUs))) {
+            return 0;
+        }
+    }
+    if (!appendFormat(buffer, bufferSize, used, "]}")) {
+        return 0;
+    }
+    return used;
+}
+#endif
+
+// 함수 구현
+
+void traceBegin(const char* id, int64_t startUs) {
+    spanCount = 0;
+    openSpan = -1;
+    traceStartUs = startUs;
+    active = true;
+    if (id != nullptr && id[0] != '\0') {
+        copyTraceId(id);
+    } else {
+        snprintf(traceId, sizeof(traceId), "%08lx", (unsigned long)esp_random());
+    }
+}
+
+bool isTraceActive() {
+    return active;
+}
+
+const char* getTraceId() {
+    return active ? traceId : "";
+}
+
+int64_t getTraceStartUs() {
+    return active ? traceStartUs : 0;
+}
+
+TraceSpanId traceSpanBegin(const char* name) {
+    TraceSpanId span = addSpan(name, openSpan, toOffset(esp_timer_get_time()), TRACE_OPEN);
+    if (span >= 0) {
+        openSpan = span;
+    }
+    return span;
+}
+
+void traceSpanEnd(TraceSpanId span) {
+    if (!active || span < 0 || span >= spanCount || spans[span].endUs != TRACE_OPEN) {
+        return;
+    }
+    int32_t nowUs = toOffset(esp_timer_get_time());
+    // 오류 경로에서 조기 반환하여 닫히지 않은 하위 구간도 함께 닫음
+    while (openSpan >= span) {
+        if (spans[openSpan].endUs == TRACE_OPEN) {
+            spans[openSpan].endUs = nowUs;
+        }
+        openSpan = spans[openSpan].parent;
+    }
+}
+
+void traceSpanRecord(const char* name, int64_t startUs, int64_t endUs) {
+    addSpan(name, openSpan, toOffset(startUs), toOffset(endUs));
+}
+
+void traceRecordDelivery(uint64_t sentEpochMs, int64_t receivedUs) {
+    struct timeval now;
+    gettimeofday(&now, nullptr);
+    if (now.tv_sec < (time_t)TIME_MIN_VALID_EPOCH || sentEpochMs == 0) {
+        return;
+    }
+    uint64_t nowEpochMs = (uint64_t)now.tv_sec * 1000 + now.tv_usec / 1000;
+    // SNTP 오차로 발행 시각이 미래이거나, 잘못된 값으로 분 단위를 넘으면 무시
+    if (sentEpochMs > nowEpochMs || nowEpochMs - sentEpochMs > 60000) {
+        return;
+    }
+    int64_t deliveryUs = (int64_t)(nowEpochMs - sentEpochMs) * 1000;
+    traceSpanRecord("mqtt", receivedUs - deliveryUs, receivedUs);
+}
+
+size_t formatTraceStagesJson(char* buffer, size_t bufferSize) {
+    if (!active) {
+        return 0;
+    }
+    size_t used = 0;
+    if (!appendFormat(buffer, bufferSize, used, "{\"id\":\"%s\",\"us\":{", traceId)) {
+        return 0;
+    }
+    bool first = true;
+    for (uint8_t i = 0; i < spanCount; i++) {
+        if (spans[i].endUs == TRACE_OPEN) {
+            continue;
+        }
+        if (!appendFormat(buffer, bufferSize, used, "%s\"%s\":%ld", first ? "" : ",", spans[i].name,
+                          (long)(spans[i].endUs - spans[i].startUs))) {
+            return 0;
+        }
+        first = false;
+    }
+    if (!appendFormat(buffer, bufferSize, used, "}}")) {
+        return 0;
+    }
+    return used;
+}
+
+void traceEnd() {
+    if (!active) {
+        return;
+    }
+    // 아직 열린 구간은 종료 시각으로 닫음
+    if (openSpan >= 0) {
+        TraceSpanId root = openSpan;
+        while (spans[root].parent >= 0) {
+            root = spans[root].parent;
+        }
+        traceSpanEnd(root);
+    }
+
+#if TRACE_EXPORT_MQTT
+    if (isMqttConnected) {
+        static char eventsJson[TRACE_EXPORT_BUFFER_SIZE];
+        size_t length = formatTraceEventsJson(eventsJson, sizeof(eventsJson));
+        if (length > 0) {
+            publishMqttMessage(getTraceTopic(), eventsJson, length);
+        } else {
+            LOG_W(system, "추적 내보내기 버퍼 부족 (TRACE_EXPORT_BUFFER_SIZE)");
+        }
+    }
+#endif
+    active = false;
+}
@@ -0,0 +1,78 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <Arduino.h>
+
+// 구간 식별자 (traceSpanBegin()의 반환값, 기록하지 않으면 -1)
+typedef int8_t TraceSpanId;
+
+// 촬영 명령 "id"로 받을 수 있는 추적 ID 최대 길이 (NUL 제외)
+#define TRACE_ID_MAX_LENGTH 32
+
+// formatTraceStagesJson()에 필요한 최대 버퍼 크기
+#define TRACE_STAGES_BUFFER_SIZE 512
+
+/**
+ * @brief 새 추적을 시작합니다. 진행 중인 추적은 내보내지 않고 버립니다.
+ * 한 번에 하나의 추적만 기록하며 메인 루프 태스크에서만 호출합니다.
+ * @param traceId 명령에 포함된 ID (nullptr 또는 빈 문자열이면 장치에서 생성)
+ * @param startUs 추적 기준 시각 (esp_timer_get_time(), 보통 명령 수신 시각)
+ */
+void traceBegin(const char* traceId, int64_t startUs);
+
+/**
+ * @brief 추적이 진행 중인지 확인합니다.
+ */
+bool isTraceActive();
+
+/**
+ * @brief 현재 추적 ID를 반환합니다. (진행 중이 아니면 빈 문자열)
+ */
+const char* getTraceId();
+
+/**
+ * @brief 현재 추적의 기준 시각(esp_timer_get_time())을 반환합니다. (진행 중이 아니면 0)
+ */
+int64_t getTraceStartUs();
+
+/**
+ * @brief 구간을 엽니다. 열린 구간 안에서 연 구간은 그 하위 구간이 됩니다.
+ * @param name 구간 이름 (문자열 리터럴, 한 추적 안에서 중복되지 않게)
+ * @return 구간 식별자. 추적 중이 아니거나 TRACE_MAX_SPANS를 넘으면 -1 (traceSpanEnd()는 무시)
+ */
+TraceSpanId traceSpanBegin(const char* name);
+
+/**
+ * @brief 구간을 닫습니다. 닫지 않은 하위 구간도 같은 시각에 함께 닫힙니다.
+ */
+void traceSpanEnd(TraceSpanId span);
+
+/**
+ * @brief 시작/종료 시각을 이미 알고 있는 구간을 기록합니다. (예: 브로커 → 장치 전달 시간)
+ * 시작 시각이 추적 기준 시각보다 이를 수 있습니다.
+ */
+void traceSpanRecord(const char* name, int64_t startUs, int64_t endUs);
+
+/**
+ * @brief 명령의 발행 시각(epoch ms)으로 MQTT 전달 구간 "mqtt"를 기록합니다.
+ * 시각이 동기화되지 않았거나 값이 음수/비정상이면 기록하지 않습니다.
+ * @param sentEpochMs 클라우드가 명령을 발행한 시각
+ * @param receivedUs 명령 수신 시각 (esp_timer_get_time())
+ */
+void traceRecordDelivery(uint64_t sentEpochMs, int64_t receivedUs);
+
+/**
+ * @brief 닫힌 구간의 소요 시간을 cdone 페이로드에 넣을 JSON 객체로 기록합니다.
+ * 예: {"id":"a1","us":{"parse":180,"flush":412300,"fb_get":61020,...}}
+ * @return 기록된 문자열 길이. 추적 중이 아니거나 버퍼가 부족하면 0.
+ */
+size_t formatTraceStagesJson(char* buffer, size_t bufferSize);
+
+/**
+ * @brief 추적을 끝내고 TRACE_EXPORT_MQTT가 켜져 있으면 "{deviceUid}/trace"로 내보냅니다.
+ * 형식: {"id":"a1","t0":기준 시각 us,"spans":[[이름,부모,시작 오프셋 us,길이 us],...]}
+ * tools/trace_to_chrome.py로 Chrome Trace Event 형식(Perfetto, speedscope)으로 변환합니다.
+ */
+void traceEnd();
+
+#endif // TRACE_H
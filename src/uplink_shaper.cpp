@@ -0,0 +1,262 @@
+#include "uplink_shaper.h"
+#include "config.h" // UPLINK_* 설정을 위해 포함
+#include "mqtt_handler.h"
+#include "upload_pacer.h"
+#include "metrics.h"
+#include "logger.h"
+
+// MQTT PUBLISH 고정 헤더(최대 5) + 토픽 길이 필드(2): 토큰/링크 사용량에 더함
+static const size_t PUBLISH_OVERHEAD_BYTES = 7;
+
+// 클래스별 토큰 버킷 (bulk는 버킷 없이 upload_pacer가 남은 대역폭으로 조절)
+struct TokenBucket {
+    float tokens;
+    float ratePerMs;
+    float burst;
+};
+
+static TokenBucket buckets[(size_t)UplinkClass::bulk] = {
+    {UPLINK_CONTROL_BURST_BYTES, UPLINK_CONTROL_RATE_BPS / 1000.0f, UPLINK_CONTROL_BURST_BYTES},
+    {UPLINK_TELEMETRY_BURST_BYTES, UPLINK_TELEMETRY_RATE_BPS / 1000.0f, UPLINK_TELEMETRY_BURST_BYTES},
+};
+static unsigned long lastRefillMs = 0;
+
+// 대기 메시지 (도착 순서로 저장, 페이로드는 arena에 같은 순서로 이어 붙임)
+struct QueuedMessage {
+    UplinkClass cls;
+    char topic[MQTT_TOPIC_BUFFER_SIZE];
+    uint16_t offset;
+    uint16_t length;
+    unsigned long enqueuedMs;
+};
+
+static QueuedMessage queue[UPLINK_QUEUE_SLOTS];
+static uint8_t queueCount = 0;
+static uint8_t arena[UPLINK_QUEUE_BYTES];
+static size_t arenaUsed = 0;
+
+static const MetricHistogram DELAY_HISTOGRAMS[(size_t)UplinkClass::count] = {
+    MetricHistogram::uplinkControlDelayMs, MetricHistogram::uplinkTelemetryDelayMs,
+    MetricHistogram::uplinkBulkDelayMs};
+
+static UplinkSendFn sendFn = nullptr;
+static void (*telemetryProducer)() = nullptr;
+static UplinkClassStats stats[(size_t)UplinkClass::count];
+static bool bulkActive = false;
+static bool streamOpen = false;
+static bool servicing = false;
+static unsigned long lastServiceMs = 0;
+static uint32_t pacedMs = 0; // 우선 메시지 때문에 upload_pacer가 본문 쓰기를 늦춘 시간 누계 (bulk 대기 시간 계산용)
+
+static void refillBuckets() {
+    unsigned long now = millis();
+    unsigned long elapsed = now - lastRefillMs;
+    lastRefillMs = now;
+    for (TokenBucket& bucket : buckets) {
+        bucket.tokens = min(bucket.burst, bucket.tokens + bucket.ratePerMs * elapsed);
+    }
+}
+
+// 이미지 전송 중에는 토큰이 있어야 보냄 (버킷보다 큰 메시지는 버킷이 가득 찼을 때 보내고 잔고는 음수가 됨)
+static bool canSendNow(UplinkClass cls, size_t wireBytes) {
+    if (streamOpen) {
+        return false;
+    }
+    if (!bulkActive || cls == UplinkClass::bulk) {
+        return true;
+    }
+    const TokenBucket& bucket = buckets[(size_t)cls];
+    return bucket.tokens >= min((float)wireBytes, bucket.burst);
+}
+
+static void recordDelay(UplinkClass cls, uint32_t delayMs) {
+    UplinkClassStats& s = stats[(size_t)cls];
+    s.sent++;
+    s.totalDelayMs += delayMs;
+    s.maxDelayMs = max(s.maxDelayMs, delayMs);
+    observeMetric(DELAY_HISTOGRAMS[(size_t)cls], delayMs);
+}
+
+// 실제 발행이 성공하면 대기 시간을 기록하고 토큰을 쓰며, 이미지 전송 중이면 같은 링크를 쓴 양만큼 본문 쓰기를 늦춤
+// (실패한 발행은 링크를 쓰지 않았으므로 실패 횟수만 셈)
+static bool sendMessage(UplinkClass cls, const char* topic, const uint8_t* payload, size_t length,
+                        unsigned long enqueuedMs) {
+    size_t wireBytes = length + strlen(topic) + PUBLISH_OVERHEAD_BYTES;
+    bool sent = sendFn(topic, payload, length);
+    if (!sent) {
+        stats[(size_t)cls].failed++;
+        return false;
+    }
+    recordDelay(cls, (uint32_t)(millis() - enqueuedMs));
+    if (bulkActive) {
+        if (cls != UplinkClass::bulk) {
+            buckets[(size_t)cls].tokens -= (float)wireBytes;
+        }
+        pacedMs += uploadPacerOnCrossTraffic(wireBytes);
+    }
+    return true;
+}
+
+static void removeQueued(uint8_t index) {
+    QueuedMessage& message = queue[index];
+    size_t end = message.offset + message.length;
+    memmove(arena + message.offset, arena + end, arenaUsed - end);
+    arenaUsed -= message.length;
+    for (uint8_t i = index + 1; i < queueCount; i++) {
+        queue[i].offset -= message.length;
+        queue[i - 1] = queue[i];
+    }
+    queueCount--;
+}
+
+static bool hasQueued(UplinkClass cls) {
+    for (uint8_t i = 0; i < queueCount; i++) {
+        if (queue[i].cls == cls) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// 공간이 부족하면 이 메시지보다 낮은 클래스의 가장 최근 메시지부터 밀어냄
+static bool makeRoom(UplinkClass cls, size_t length) {
+    while (queueCount == UPLINK_QUEUE_SLOTS || arenaUsed + length > UPLINK_QUEUE_BYTES) {
+        int8_t victim = -1;
+        for (int8_t i = queueCount - 1; i >= 0; i--) {
+            if (queue[i].cls > cls) {
+                victim = i;
+                break;
+            }
+        }
+        if (victim < 0) {
+            return false;
+        }
+        stats[(size_t)queue[victim].cls].dropped++;
+        LOG_W(mqtt, "업링크 대기열 가득 참, 낮은 순위 메시지 폐기: %s", queue[victim].topic);
+        removeQueued((uint8_t)victim);
+    }
+    return true;
+}
+
+static bool enqueue(UplinkClass cls, const char* topic, const char* payload, size_t length) {
+    size_t topicLength = strlen(topic);
+    if (length > UPLINK_QUEUE_BYTES || topicLength >= MQTT_TOPIC_BUFFER_SIZE || !makeRoom(cls, length)) {
+        stats[(size_t)cls].dropped++;
+        LOG_W(mqtt, "업링크 대기열 가득 참, 메시지 폐기: %s (%zu bytes)", topic, length);
+        return false;
+    }
+    QueuedMessage& message = queue[queueCount++];
+    message.cls = cls;
+    memcpy(message.topic, topic, topicLength + 1);
+    message.offset = (uint16_t)arenaUsed;
+    message.length = (uint16_t)length;
+    message.enqueuedMs = millis();
+    memcpy(arena + arenaUsed, payload, length);
+    arenaUsed += length;
+    stats[(size_t)cls].queued++;
+    return true;
+}
+
+// 클래스 순서대로, 각 클래스 안에서는 도착 순서대로 보낼 수 있는 만큼 보냄
+// 연결이 끊겼거나 발행이 실패하면 멈추고 남은 메시지는 재연결 후 같은 순서로 다시 보냄
+static void flushQueue() {
+    if (!isMqttConnected) {
+        return;
+    }
+    for (uint8_t c = 0; c < (uint8_t)UplinkClass::count; c++) {
+        uint8_t i = 0;
+        while (i < queueCount) {
+            QueuedMessage& message = queue[i];
+            if (message.cls != (UplinkClass)c) {
+                i++;
+                continue;
+            }
+            if (!canSendNow(message.cls, message.length + strlen(message.topic) + PUBLISH_OVERHEAD_BYTES)) {
+                break; // 같은 클래스의 뒤 메시지도 순서를 지켜 대기
+            }
+            if (!sendMessage(message.cls, message.topic, arena + message.offset, message.length, message.enqueuedMs)) {
+                LOG_W(mqtt, "대기 메시지 발행 실패, 대기열에 유지: %s", message.topic);
+                return;
+            }
+            removeQueued(i);
+        }
+    }
+}
+
+void initUplinkShaper(UplinkSendFn send) {
+    sendFn = send;
+    lastRefillMs = millis();
+}
+
+bool submitUplink(UplinkClass cls, const char* topic, const char* payload, size_t length) {
+    if (sendFn == nullptr) {
+        return false;
+    }
+    refillBuckets();
+    size_t wireBytes = length + strlen(topic) + PUBLISH_OVERHEAD_BYTES;
+    if (!hasQueued(cls) && canSendNow(cls, wireBytes)) {
+        return sendMessage(cls, topic, reinterpret_cast<const uint8_t*>(payload), length, millis());
+    }
+    return enqueue(cls, topic, payload, length);
+}
+
+void serviceUplink() {
+    if (servicing || streamOpen) {
+        return;
+    }
+    servicing = true;
+    unsigned long startMs = millis();
+    uint32_t sentBefore = stats[(size_t)UplinkClass::control].sent + stats[(size_t)UplinkClass::telemetry].sent;
+    uint32_t pacedBefore = pacedMs;
+
+    // 이미지 전송 중에는 메인 루프가 멈춰 있으므로 keepalive/수신 제어 메시지와 텔레메트리를 여기서 처리
+    if (bulkActive && startMs - lastServiceMs >= UPLINK_SERVICE_INTERVAL_MS) {
+        lastServiceMs = startMs;
+        mqttLoop();
+        if (telemetryProducer != nullptr) {
+            telemetryProducer();
+        }
+    }
+    refillBuckets();
+    if (queueCount > 0) {
+        flushQueue();
+    }
+
+    // bulk 대기 시간: 우선 메시지를 처리하느라 쓴 시간 + 같은 링크를 쓴 만큼 늦춰진 본문 쓰기
+    uint32_t sentAfter = stats[(size_t)UplinkClass::control].sent + stats[(size_t)UplinkClass::telemetry].sent;
+    if (bulkActive && sentAfter != sentBefore) {
+        recordDelay(UplinkClass::bulk, (uint32_t)(millis() - startMs) + (pacedMs - pacedBefore));
+    }
+    servicing = false;
+}
+
+void uplinkBulkBegin() {
+    refillBuckets();
+    bulkActive = true;
+    lastServiceMs = millis();
+}
+
+void uplinkBulkEnd() {
+    bulkActive = false;
+    serviceUplink(); // 버킷 제한으로 남은 메시지를 바로 보냄
+}
+
+bool isUplinkBulkActive() {
+    return bulkActive;
+}
+
+void uplinkStreamBegin() {
+    streamOpen = true;
+}
+
+void uplinkStreamEnd() {
+    streamOpen = false;
+}
+
+void setUplinkTelemetryProducer(void (*producer)()) {
+    telemetryProducer = producer;
+}
+
+UplinkClassStats getUplinkStats(UplinkClass cls) {
+    return stats[(size_t)cls];
+}
@@ -0,0 +1,77 @@
+#ifndef UPLINK_SHAPER_H
+#define UPLINK_SHAPER_H
+
+#include <Arduino.h>
+
+// 업링크 우선순위 (값이 작을수록 먼저 보냄)
+enum class UplinkClass : uint8_t {
+    control,    // 제어/상태: cdone, cfgack, status, boot, urlreq (MQTT keepalive도 이 순위로 처리)
+    telemetry,  // 텔레메트리: sensor, tsr, trace
+    bulk,       // 이미지 전송 (HTTPS 본문, MQTT 청크), 위 두 클래스가 쓰고 남은 대역폭 사용
+    count
+};
+
+// 실제 발행 함수 (mqtt_handler의 PubSubClient 발행)
+typedef bool (*UplinkSendFn)(const char* topic, const uint8_t* payload, size_t length);
+
+/**
+ * @brief 대기 메시지를 실제로 보낼 발행 함수를 등록합니다. (initMQTT()에서 한 번 호출)
+ */
+void initUplinkShaper(UplinkSendFn send);
+
+/**
+ * @brief 메시지를 우선순위 클래스에 따라 보내거나 대기열에 넣습니다. (메인 루프 태스크 전용)
+ * 이미지 전송이 없으면 바로 보냅니다. 이미지 전송 중에는 클래스별 토큰 버킷이 허용할 때 보내고,
+ * MQTT 청크를 스트리밍하는 도중이면 청크가 끝난 뒤 serviceUplink()에서 보냅니다.
+ * 대기열이 가득 차면 더 낮은 클래스의 가장 최근 메시지를 밀어내고, 없으면 이 메시지를 버립니다.
+ * 대기열의 메시지는 발행이 실패하면 버리지 않고 남겨 두었다가 연결이 돌아오면 다시 보냅니다.
+ * @return 보냈거나 대기열에 넣었으면 true (바로 보내다 실패하면 false)
+ */
+bool submitUplink(UplinkClass cls, const char* topic, const char* payload, size_t length);
+
+/**
+ * @brief 대기 메시지를 보내고, 이미지 전송 중이면 MQTT 수신/keepalive와 텔레메트리 생성도 처리합니다.
+ * 이미지 전송 함수가 쓰기 사이(HTTPS 레코드, MQTT 청크)와 ACK/응답 대기 중에 호출하고,
+ * 평소에는 mqttLoop 작업이 남은 대기 메시지를 보내려고 호출합니다. (재진입 시 무시)
+ */
+void serviceUplink();
+
+/**
+ * @brief 이미지 전송을 시작/종료합니다. 시작하면 토큰 버킷이 적용되고 우선 트래픽이 upload_pacer에 반영됩니다.
+ */
+void uplinkBulkBegin();
+void uplinkBulkEnd();
+
+/**
+ * @brief 이미지 전송 중인지 확인합니다. (전송 중 도착한 촬영 명령을 전송 뒤로 미루는 데 사용)
+ */
+bool isUplinkBulkActive();
+
+/**
+ * @brief MQTT 스트리밍 발행(beginMqttPublish ~ endMqttPublish) 중임을 알립니다. 그동안의 발행은 대기열에 넣습니다.
+ */
+void uplinkStreamBegin();
+void uplinkStreamEnd();
+
+/**
+ * @brief 이미지 전송 중 serviceUplink()가 호출할 텔레메트리 생성 함수를 등록합니다.
+ * 스케줄러가 멈춘 동안에도 주기 발행이 이어지도록 자체 주기를 확인하는 함수를 등록합니다. (예: 센서 발행)
+ */
+void setUplinkTelemetryProducer(void (*producer)());
+
+// 클래스별 누적 통계 (부팅 이후)
+struct UplinkClassStats {
+    uint32_t sent;          // 발행에 성공한 메시지 수 (bulk: 우선 트래픽 때문에 쓰기가 밀린 횟수)
+    uint32_t failed;        // 발행 실패 횟수 (대기 메시지는 대기열에 남아 재연결 후 다시 보냄)
+    uint32_t queued;        // 대기열을 거친 메시지 수
+    uint32_t dropped;       // 대기열이 가득 차 버린 메시지 수
+    uint32_t maxDelayMs;    // 최대 대기 시간 (성공한 발행 기준, bulk: 최대로 밀린 시간)
+    uint64_t totalDelayMs;  // 누적 대기 시간
+};
+
+/**
+ * @brief 클래스별 누적 통계를 반환합니다. (대기 시간 분포는 지표 스냅샷의 q_ctl_ms/q_tel_ms/q_blk_ms)
+ */
+UplinkClassStats getUplinkStats(UplinkClass cls);
+
+#endif // UPLINK_SHAPER_H
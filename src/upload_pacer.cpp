@@ -0,0 +1,113 @@
+#include "upload_pacer.h"
+#include "config.h" // UPLOAD_* 설정을 위해 포함
+#include "logger.h"
+
+// 대역폭 추정 범위 (bytes/ms ≈ KB/s)
+static const float BANDWIDTH_MIN = 1.0f;
+static const float BANDWIDTH_MAX = 4000.0f;
+// 막힌 write 표본의 지수 평균 가중치, 막히지 않은 write마다 올리는 비율
+static const float BANDWIDTH_SAMPLE_WEIGHT = 0.25f;
+static const float BANDWIDTH_PROBE_GAIN = 1.05f;
+
+// 업로드 사이에 유지하는 추정치 (0이면 아직 측정 전)
+static float bandwidth = 0.0f;
+static uint32_t lastGoodputKBps = 0;
+
+// 업로드 1회 동안의 상태
+static float queuedBytes = 0.0f;     // 추정 송신 버퍼 점유 (쓴 양 - 추정 대역폭으로 빠져나간 양)
+static uint32_t lastUpdateUs = 0;
+static size_t recordBytes = UPLOAD_TLS_RECORD_MAX;
+static uint16_t blockedWrites = 0;
+static uint16_t stalls = 0;
+
+// RSSI에 따른 초기 대역폭 (HT20 실측 처리량의 보수적인 근사)
+static float initialBandwidth(int8_t rssi) {
+    if (rssi >= -60) {
+        return 400.0f;
+    }
+    if (rssi >= UPLOAD_RSSI_WEAK) {
+        return 150.0f;
+    }
+    return 40.0f;
+}
+
+// 마지막 갱신 이후 추정 대역폭만큼 송신 버퍼가 비워진 것으로 반영
+static void drainQueue() {
+    uint32_t now = micros();
+    queuedBytes -= bandwidth * (float)(now - lastUpdateUs) / 1000.0f;
+    if (queuedBytes < 0.0f) {
+        queuedBytes = 0.0f;
+    }
+    lastUpdateUs = now;
+}
+
+void uploadPacerBegin(int8_t rssi) {
+    if (bandwidth <= 0.0f) {
+        bandwidth = initialBandwidth(rssi);
+    }
+    recordBytes = rssi < UPLOAD_RSSI_WEAK ? UPLOAD_TLS_RECORD_MIN : UPLOAD_TLS_RECORD_MAX;
+    queuedBytes = 0.0f;
+    lastUpdateUs = micros();
+    blockedWrites = 0;
+    stalls = 0;
+}
+
+size_t uploadPacerRecordBytes() {
+    return recordBytes;
+}
+
+size_t uploadPacerChunkBytes() {
+    size_t chunk = (size_t)(bandwidth * UPLOAD_CHUNK_MS);
+    return constrain(chunk, recordBytes, (size_t)UPLOAD_CHUNK_MAX);
+}
+
+uint32_t uploadPacerWaitMs() {
+    drainQueue();
+    // 송신 버퍼를 비우면 창이 작은 TCP(송신 버퍼 < 대역폭×RTT)의 처리량이 바로 떨어지므로
+    // 버퍼가 가득 찬 동안만 write 밖에서 기다림 (write 안에서 오래 막히지 않게)
+    float excess = queuedBytes - (float)UPLOAD_SNDBUF_BYTES;
+    return excess > 0.0f ? (uint32_t)(excess / bandwidth) + 1 : 0;
+}
+
+void uploadPacerOnWrite(size_t bytes, uint32_t elapsedUs) {
+    drainQueue();
+    if (elapsedUs >= UPLOAD_STALL_MS * 1000UL) {
+        // 재전송 대기: 링크 속도와 무관하므로 대역폭 표본으로 쓰지 않고,
+        // 작은 레코드로 바꿔 이후 write가 빨리 돌아오게 함
+        queuedBytes = (float)UPLOAD_SNDBUF_BYTES;
+        blockedWrites++;
+        stalls++;
+        recordBytes = UPLOAD_TLS_RECORD_MIN;
+    } else if (elapsedUs >= UPLOAD_WRITE_BLOCKED_US) {
+        // 버퍼가 가득 찬 동안 빠져나간 양 ≈ 이번에 쓴 양: 링크 처리량 표본
+        float sample = (float)bytes * 1000.0f / (float)elapsedUs;
+        bandwidth += BANDWIDTH_SAMPLE_WEIGHT * (sample - bandwidth);
+        queuedBytes = (float)UPLOAD_SNDBUF_BYTES;
+        blockedWrites++;
+    } else {
+        queuedBytes += (float)bytes;
+        bandwidth *= BANDWIDTH_PROBE_GAIN;
+    }
+    bandwidth = constrain(bandwidth, BANDWIDTH_MIN, BANDWIDTH_MAX);
+}
+
+uint32_t uploadPacerOnCrossTraffic(size_t bytes) {
+    if (bandwidth <= 0.0f) {
+        return 0;
+    }
+    drainQueue();
+    queuedBytes += (float)bytes;
+    return (uint32_t)((float)bytes / bandwidth);
+}
+
+uint32_t uploadPacerEnd(size_t bytes, uint32_t elapsedMs) {
+    lastGoodputKBps = (uint32_t)(elapsedMs > 0 ? bytes / elapsedMs : bytes);
+    LOG_I(camera, "업로드 goodput %lu KB/s (추정 대역폭 %lu KB/s, 레코드 %u bytes, 버퍼 대기 write %u회, 정체 %u회)",
+          (unsigned long)lastGoodputKBps, (unsigned long)bandwidth, (unsigned)recordBytes, (unsigned)blockedWrites,
+          (unsigned)stalls);
+    return lastGoodputKBps;
+}
+
+uint32_t getUploadGoodputKBps() {
+    return lastGoodputKBps;
+}
@@ -0,0 +1,59 @@
+#ifndef UPLOAD_PACER_H
+#define UPLOAD_PACER_H
+
+#include <Arduino.h>
+
+/**
+ * @brief 업로드 본문 전송을 시작합니다.
+ * 대역폭 추정치는 업로드 사이에 유지하고, 처음에는 RSSI로 초기값을 정합니다.
+ * 메인 루프 태스크에서만 호출합니다. (업로드는 한 번에 하나)
+ * @param rssi 현재 WiFi 신호 강도 (dBm, 약하면 작은 TLS 레코드로 시작)
+ */
+void uploadPacerBegin(int8_t rssi);
+
+/**
+ * @brief 다음 write() 한 번에 넘길 크기를 반환합니다. (write 1회가 TLS 레코드 1개가 되도록 UPLOAD_TLS_RECORD_MAX 이하)
+ */
+size_t uploadPacerRecordBytes();
+
+/**
+ * @brief 페이싱 확인 없이 이어서 쓸 청크 크기를 반환합니다. (추정 대역폭 × UPLOAD_CHUNK_MS)
+ */
+size_t uploadPacerChunkBytes();
+
+/**
+ * @brief 다음 청크 전에 기다릴 시간을 반환합니다.
+ * 추정 송신 버퍼 점유가 버퍼 크기 이하로 줄어드는 데 걸리는 시간 (자리가 있으면 0)
+ */
+uint32_t uploadPacerWaitMs();
+
+/**
+ * @brief write() 1회의 결과를 반영합니다.
+ * write가 오래 막혔으면 송신 버퍼가 가득 찼던 것이므로 그 시간 동안의 처리량을 대역폭 표본으로 쓰고,
+ * 막히지 않았으면 대역폭 추정치를 조금씩 올려 여유를 탐색합니다.
+ * @param bytes 실제로 쓴 바이트
+ * @param elapsedUs write() 소요 시간
+ */
+void uploadPacerOnWrite(size_t bytes, uint32_t elapsedUs);
+
+/**
+ * @brief 업로드 중 같은 링크로 나간 다른 트래픽(우선 순위가 높은 MQTT 메시지)을 반영합니다.
+ * 송신 버퍼 점유에 더해 다음 본문 쓰기가 그만큼 늦게 나가도록 합니다. (업링크 조절에서 호출)
+ * @return 이 트래픽 때문에 본문 쓰기가 늦춰질 시간 추정치 (ms)
+ */
+uint32_t uploadPacerOnCrossTraffic(size_t bytes);
+
+/**
+ * @brief 본문 전송을 마치고 이번 업로드의 goodput을 기록합니다.
+ * @param bytes 전송한 본문 바이트
+ * @param elapsedMs 본문 전송 시작 → 서버 응답 수신 소요 시간
+ * @return goodput (KB/s, bytes/ms 근사)
+ */
+uint32_t uploadPacerEnd(size_t bytes, uint32_t elapsedMs);
+
+/**
+ * @brief 직전 업로드의 goodput (KB/s)을 반환합니다. 성공한 업로드가 없으면 0
+ */
+uint32_t getUploadGoodputKBps();
+
+#endif // UPLOAD_PACER_H
@@ -0,0 +1,175 @@
+#include "url_pool.h"
+#include "config.h" // URL_POOL_*, TIME_MIN_VALID_EPOCH 설정을 위해 포함
+#include <ArduinoJson.h>
+#include <time.h>
+#include "globals.h"
+#include "mqtt_handler.h"
+#include "logger.h"
+
+// 응답 한 건({"urls":[{"url":"...","exp":N}, ...]})이 토픽/헤더와 함께 PubSubClient 버퍼에 들어가야 함
+// (넘치면 PubSubClient가 조용히 버려 보충이 타임아웃마다 반복됨)
+static const size_t URL_ENTRY_MAX_BYTES = URL_POOL_URL_MAX + 32;
+static_assert(URL_POOL_REQUEST_BATCH >= 1 &&
+              16 + MQTT_TOPIC_BUFFER_SIZE + URL_POOL_REQUEST_BATCH * URL_ENTRY_MAX_BYTES <= MQTT_BUFFER_SIZE,
+              "URL_POOL_REQUEST_BATCH개 응답이 MQTT_BUFFER_SIZE를 넘습니다");
+
+// 풀 항목 (url[0] == '\0'이면 빈 칸)
+struct UrlLease {
+    char url[URL_POOL_URL_MAX + 1];
+    unsigned long expiresAtMs; // millis() 기준 만료 시각
+};
+
+static UrlLease leases[URL_POOL_SIZE];
+static unsigned long requestSentMs = 0;
+static bool requestPending = false;
+static bool refilling = false;     // 여유 재고가 LOW_WATER 아래로 떨어진 뒤 풀이 찰 때까지 true
+static uint32_t takenCount = 0;
+static uint32_t missCount = 0;
+
+// 만료까지 남은 시간 (이미 지났으면 0)
+static unsigned long remainingMs(const UrlLease& lease, unsigned long now) {
+    long remaining = (long)(lease.expiresAtMs - now);
+    return remaining > 0 ? (unsigned long)remaining : 0;
+}
+
+// 남은 유효 시간이 업로드에 부족한 URL을 비움
+static void dropUnusable(unsigned long now) {
+    for (UrlLease& lease : leases) {
+        if (lease.url[0] != '\0' && remainingMs(lease, now) < URL_POOL_MIN_VALIDITY_MS) {
+            LOG_D(mqtt, "만료 임박 업로드 URL 폐기");
+            lease.url[0] = '\0';
+        }
+    }
+}
+
+// 만료까지 URL_POOL_REFRESH_MARGIN_MS 이상 남은 URL 수 (보충 판단 기준)
+static uint8_t freshCount(unsigned long now) {
+    uint8_t count = 0;
+    for (const UrlLease& lease : leases) {
+        if (lease.url[0] != '\0' && remainingMs(lease, now) >= URL_POOL_REFRESH_MARGIN_MS) {
+            count++;
+        }
+    }
+    return count;
+}
+
+// 보충 중이면 부족분을 URL_POOL_REQUEST_BATCH개씩 요청 (응답이 오면 바로 다음 묶음 요청)
+static void requestMoreUrls(unsigned long now) {
+    uint8_t fresh = freshCount(now);
+    if (fresh < URL_POOL_LOW_WATER) {
+        refilling = true;
+    } else if (fresh >= URL_POOL_SIZE) {
+        refilling = false;
+    }
+    if (!refilling || !isMqttConnected) {
+        return;
+    }
+    // 만료가 다가온 URL도 새 URL로 교체되도록 여유 재고 기준으로 부족분을 요청
+    uint8_t count = min<uint8_t>(URL_POOL_SIZE - fresh, URL_POOL_REQUEST_BATCH);
+    char request[24];
+    int length = snprintf(request, sizeof(request), "{\"n\":%u}", (unsigned)count);
+    if (publishMqttMessage(getUrlRequestTopic(), request, (size_t)length)) {
+        requestPending = true;
+        requestSentMs = now;
+        LOG_I(mqtt, "업로드 URL 보충 요청: %u개 (여유 재고 %u)", (unsigned)count, (unsigned)fresh);
+    }
+}
+
+void handleUrlPool() {
+    unsigned long now = millis();
+    dropUnusable(now);
+
+    if (requestPending && now - requestSentMs < URL_POOL_REQUEST_TIMEOUT_MS) {
+        return;
+    }
+    requestPending = false;
+    requestMoreUrls(now);
+}
+
+// 새 URL을 넣을 칸: 빈 칸, 없으면 만료가 가장 이른 칸
+static UrlLease& slotForNewLease() {
+    UrlLease* earliest = &leases[0];
+    for (UrlLease& lease : leases) {
+        if (lease.url[0] == '\0') {
+            return lease;
+        }
+        if ((long)(lease.expiresAtMs - earliest->expiresAtMs) < 0) {
+            earliest = &lease;
+        }
+    }
+    return *earliest;
+}
+
+void handleUrlPoolResponse(const byte* payload, unsigned int length) {
+    JsonDocument doc;
+    if (deserializeJson(doc, payload, length)) {
+        LOG_W(mqtt, "업로드 URL 응답 파싱 실패");
+        return;
+    }
+    requestPending = false;
+
+    unsigned long now = millis();
+    time_t epochNow = time(nullptr);
+    bool clockValid = epochNow >= (time_t)TIME_MIN_VALID_EPOCH;
+    uint8_t accepted = 0;
+    for (JsonObject entry : doc["urls"].as<JsonArray>()) {
+        const char* url = entry["url"] | "";
+        size_t urlLength = strlen(url);
+        if (urlLength == 0 || urlLength > URL_POOL_URL_MAX) {
+            LOG_W(mqtt, "업로드 URL 길이 오류: %u", (unsigned)urlLength);
+            continue;
+        }
+        uint32_t validSec;
+        if (clockValid && entry["exp"].is<uint32_t>()) {
+            uint32_t expiresAt = entry["exp"];
+            validSec = expiresAt > (uint32_t)epochNow ? expiresAt - (uint32_t)epochNow : 0;
+        } else {
+            validSec = entry["ttl"] | 0;
+        }
+        if ((uint64_t)validSec * 1000 < URL_POOL_MIN_VALIDITY_MS) {
+            continue;
+        }
+        UrlLease& lease = slotForNewLease();
+        memcpy(lease.url, url, urlLength + 1);
+        lease.expiresAtMs = now + (unsigned long)min<uint64_t>((uint64_t)validSec * 1000, 0x7FFFFFFF);
+        accepted++;
+    }
+    LOG_I(mqtt, "업로드 URL %u개 수신, 재고 %u", (unsigned)accepted, (unsigned)getUploadUrlStock());
+
+    // 쓸 수 있는 URL을 받았으면 점검 주기를 기다리지 않고 다음 묶음 요청 (못 받았으면 다음 점검에서 재시도)
+    if (accepted > 0) {
+        requestMoreUrls(now);
+    }
+}
+
+bool takeUploadUrl(String& url) {
+    unsigned long now = millis();
+    dropUnusable(now);
+    UrlLease* earliest = nullptr;
+    for (UrlLease& lease : leases) {
+        if (lease.url[0] != '\0' && (earliest == nullptr || (long)(lease.expiresAtMs - earliest->expiresAtMs) < 0)) {
+            earliest = &lease;
+        }
+    }
+    if (earliest == nullptr) {
+        missCount++;
+        LOG_W(mqtt, "사용 가능한 업로드 URL 없음 (누적 부족 %lu회)", (unsigned long)missCount);
+        return false;
+    }
+    url = earliest->url;
+    earliest->url[0] = '\0';
+    takenCount++;
+    LOG_D(mqtt, "풀에서 업로드 URL 사용 (남은 재고 %u, 누적 %lu)", (unsigned)getUploadUrlStock(),
+          (unsigned long)takenCount);
+    return true;
+}
+
+uint8_t getUploadUrlStock() {
+    uint8_t count = 0;
+    for (const UrlLease& lease : leases) {
+        if (lease.url[0] != '\0') {
+            count++;
+        }
+    }
+    return count;
+}
@@ -0,0 +1,35 @@
+#ifndef URL_POOL_H
+#define URL_POOL_H
+
+#include <Arduino.h>
+
+/**
+ * @brief 업로드 URL 풀을 점검합니다. (스케줄러 작업, URL_POOL_CHECK_INTERVAL_MS 주기)
+ * 만료가 URL_POOL_REFRESH_MARGIN_MS 안으로 다가온 URL은 여유 재고에서 빼고,
+ * 여유 재고가 URL_POOL_LOW_WATER 미만이 되면 풀이 찰 때까지 "{deviceUid}/urlreq"로
+ * URL_POOL_REQUEST_BATCH개씩 요청합니다. (응답이 MQTT_BUFFER_SIZE에 들어가는 크기)
+ * 응답이 URL_POOL_REQUEST_TIMEOUT_MS 안에 오지 않으면 다시 요청합니다.
+ */
+void handleUrlPool();
+
+/**
+ * @brief "{deviceUid}/urls"로 받은 presigned PUT URL 묶음을 풀에 넣습니다.
+ * 형식: {"urls":[{"url":"https://...","exp":1718003600},{"url":"https://...","ttl":3600}]}
+ * "exp"(만료 시각, epoch 초)는 시각이 동기화된 경우에만 쓰고, 아니면 "ttl"(남은 초)을 씁니다.
+ * 풀이 가득 차면 만료가 가장 이른 URL을 새 URL로 교체하고, 아직 보충 중이면 다음 묶음을 바로 요청합니다.
+ */
+void handleUrlPoolResponse(const byte* payload, unsigned int length);
+
+/**
+ * @brief 풀에서 업로드 URL 하나를 꺼냅니다. (만료가 가장 이른 것부터, 꺼낸 URL은 풀에서 제거)
+ * 남은 유효 시간이 URL_POOL_MIN_VALIDITY_MS보다 짧은 URL은 쓰지 않고 버립니다.
+ * @return 쓸 수 있는 URL이 없으면 false (다음 점검에서 보충 요청)
+ */
+bool takeUploadUrl(String& url);
+
+/**
+ * @brief 지금 쓸 수 있는 URL 수를 반환합니다.
+ */
+uint8_t getUploadUrlStock();
+
+#endif // URL_POOL_H
@@ -1,6 +1,11 @@
 #include "wifi_handler.h"
 #include "esp_system.h"
 #include "ble_handler.h"
+#include "config.h"
+#include "reconnect_policy.h"
+#include "config_store.h"
+#include <Preferences.h>
+#include "logger.h"
 
 // --- 전역 변수 정의 ---
 // 헤더에서 extern으로 선언된 변수들의 실체를 여기서 정의
@@ -14,23 +19,60 @@ static unsigned long provisioningStartMs = 0;
 static int wifiRetryCount = 0;
 static const int MAX_WIFI_RETRY = 3;
 
+// 재연결 주기는 고정 5초 대신 공유 재연결 정책이 결정 (장치 간 지터 분산)
+static ReconnectPolicy reconnectPolicy(WIFI_RECONNECT_BASE_MS, WIFI_RECONNECT_MAX_MS,
+                                       WIFI_RECONNECT_FAILURE_THRESHOLD, WIFI_RECONNECT_OPEN_MS);
+
 // WiFi 연결 결과를 기다리는 시간 제한 (밀리초)
 static const unsigned long WIFI_PROVISIONING_TIMEOUT_MS = 30000; // 30초로 증가
 
+// --- 빠른 재연결 캐시 (NVS) ---
+// 마지막으로 성공한 AP의 BSSID/채널과 DHCP 임대 정보를 저장해 두고,
+// 다음 연결 시 전 채널 스캔 없이 해당 AP로 직접 연결한다.
+struct FastConnectCache {
+    uint8_t bssid[6];
+    int32_t channel;
+    uint32_t ip;
+    uint32_t gateway;
+    uint32_t subnet;
+    uint32_t dns;
+    uint8_t failures; // 빠른 연결 연속 실패 횟수
+};
+
+static const char* FAST_CONNECT_NVS_NAMESPACE = "wifi_cache";
+static const char* FAST_CONNECT_NVS_KEY = "ap";
+
+static FastConnectCache fastConnectCache;
+static bool fastConnectCacheValid = false;
+static bool fastConnectInFlight = false;   // 현재 시도가 BSSID/채널 지정 연결인지
+static unsigned long connectAttemptStartMs = 0;
+static unsigned long disconnectedAtMs = 0;
+static WiFiConnectMetrics connectMetrics = {};
+
+static void loadFastConnectCache();
+static void saveFastConnectCache();
+static void invalidateFastConnectCache(const char* reason);
+static void startWiFiConnect(bool allowFastConnect = true);
+static void onWiFiConnected(unsigned long nowMs);
+
 void initWiFi() {
     // WiFi 모드 설정 및 초기화
     WiFi.mode(WIFI_STA);
     WiFi.persistent(true);
-    WiFi.setAutoReconnect(true);
+    // 드라이버 자동 재연결은 끊김 즉시 모든 장치가 동시에 재접속하므로 끄고,
+    // handleWiFiConnection()에서 재연결 정책에 따라 재시도한다
+    WiFi.setAutoReconnect(false);
+    applyWiFiConfig();
     delay(100); // 초기화 시간 확보
     
     if (!areWiFiCredentialsAvailable()) {
-        Serial.println("WiFi 자격 증명이 없습니다. 연결을 건너뜁니다.");
+        LOG_I(wifi, "WiFi 자격 증명이 없습니다. 연결을 건너뜁니다.");
         return;
     }
-    Serial.print("WiFi에 연결 시도: ");
-    Serial.println(ssid);
-    WiFi.begin(ssid.c_str(), password.c_str());
+    loadFastConnectCache();
+    LOG_I(wifi, "WiFi에 연결 시도: %s", ssid.c_str());
+    startWiFiConnect();
+    reconnectPolicy.onAttempt();
 }
 
 void handleWiFiConnection() {
@@ -43,9 +85,9 @@ void handleWiFiConnection() {
         // 이전에 연결되지 않은 상태였다면 (즉, 방금 연결되었다면)
         if (!isWifiConnected) {
             isWifiConnected = true;
-            Serial.println("\nWiFi 연결 성공!");
-            Serial.print("IP 주소: ");
-            Serial.println(WiFi.localIP());
+            reconnectPolicy.onConnected();
+            LOG_I(wifi, "WiFi 연결 성공! IP 주소: %s", WiFi.localIP().toString().c_str());
+            onWiFiConnected(millis());
             if (awaitingWifiProvisioning) {
                 sendWifiStatusUpdate(true);
                 awaitingWifiProvisioning = false;
@@ -54,28 +96,53 @@ void handleWiFiConnection() {
         }
     } else {
         // 이전에 연결된 상태였다면 (즉, 방금 연결이 끊어졌다면)
+        unsigned long nowMs = millis();
         if (isWifiConnected) {
             isWifiConnected = false;
-            Serial.println("\nWiFi 연결 끊김.");
-            Serial.println("재연결 시도...");
-            if (!suppressAutoReconnect) {
-                WiFi.begin(ssid.c_str(), password.c_str());
+            LOG_I(wifi, "WiFi 연결 끊김.");
+            // 즉시 재접속하지 않고 지터가 적용된 시각에 첫 재시도 예약
+            reconnectPolicy.onDisconnected(nowMs);
+            disconnectedAtMs = nowMs;
+            LOG_I(wifi, "%lu ms 후 재연결 시도...", (unsigned long)reconnectPolicy.currentDelayMs());
+        }
+
+        // 캐시된 BSSID/채널로의 직접 연결이 실패하면 즉시 전체 스캔 연결로 전환
+        if (fastConnectInFlight && !suppressAutoReconnect) {
+            wl_status_t fastStatus = WiFi.status();
+            bool fastTimedOut = nowMs - connectAttemptStartMs > WIFI_FAST_CONNECT_TIMEOUT_MS;
+            if (fastTimedOut || fastStatus == WL_NO_SSID_AVAIL || fastStatus == WL_CONNECT_FAILED) {
+                connectMetrics.fastFallbackCount++;
+                if (++fastConnectCache.failures >= WIFI_FAST_CONNECT_MAX_FAILURES) {
+                    invalidateFastConnectCache("빠른 연결 연속 실패");
+                } else {
+                    saveFastConnectCache();
+                }
+                LOG_W(wifi, "빠른 연결 실패, 전체 스캔 연결로 전환");
+                WiFi.disconnect(false);
+                startWiFiConnect(false);
             }
         }
 
-        // 초기 부팅 등 아직 한 번도 연결되지 않았을 때도 주기적으로 재시도
-        static unsigned long lastRetryAttemptMs = 0;
-        const unsigned long retryIntervalMs = 5000; // 5초 주기 재시도
-        unsigned long nowMs = millis();
-        if (awaitingWifiProvisioning && !suppressAutoReconnect &&
-            nowMs - lastRetryAttemptMs >= retryIntervalMs) {
-            lastRetryAttemptMs = nowMs;
-            Serial.print("WiFi 미연결 상태, 재연결 시도: ");
-            Serial.println(ssid);
+        // 진행 중인 시도는 실패 상태나 시간 초과로 결과가 나온 뒤에만 실패로 기록
+        // (연결 중에 WiFi.begin()을 다시 부르면 진행 중인 association이 끊김)
+        if (reconnectPolicy.attemptInFlight()) {
+            wl_status_t status = WiFi.status();
+            if (status == WL_CONNECT_FAILED || status == WL_NO_SSID_AVAIL ||
+                nowMs - connectAttemptStartMs > WIFI_CONNECT_ATTEMPT_TIMEOUT_MS) {
+                reconnectPolicy.onFailed(nowMs);
+                LOG_W(wifi, "WiFi 연결 시도 실패 (상태 %d), %lu ms 후 재시도", (int)status,
+                            (unsigned long)reconnectPolicy.currentDelayMs());
+            }
+        }
+
+        // 초기 부팅 등 아직 한 번도 연결되지 않았을 때도 재연결 정책에 따라 재시도
+        if (!suppressAutoReconnect && reconnectPolicy.ready(nowMs)) {
+            reconnectPolicy.onAttempt();
+            LOG_I(wifi, "WiFi 미연결 상태, 재연결 시도: %s", ssid.c_str());
             // 강제 재시도 (세션 유지)
             WiFi.disconnect(false);
             delay(100);
-            WiFi.begin(ssid.c_str(), password.c_str());
+            startWiFiConnect();
         }
 
         if (awaitingWifiProvisioning) {
@@ -85,7 +152,7 @@ void handleWiFiConnection() {
             if (status == WL_CONNECT_FAILED) {
                 wifiRetryCount++;
                 if (wifiRetryCount >= MAX_WIFI_RETRY) {
-                    Serial.printf("WiFi 연결 실패: %d회 재시도 후 포기 (비밀번호 오류 가능성)\n", MAX_WIFI_RETRY);
+                    LOG_W(wifi, "WiFi 연결 실패: %d회 재시도 후 포기 (비밀번호 오류 가능성)", MAX_WIFI_RETRY);
                     sendWifiStatusUpdate(false, "wifi_password_incorrect");
                     awaitingWifiProvisioning = false;
                     suppressAutoReconnect = true;
@@ -93,14 +160,15 @@ void handleWiFiConnection() {
                     WiFi.disconnect(true);
                     WiFi.setAutoReconnect(false);
                 } else {
-                    Serial.printf("WiFi 연결 실패, 재시도 %d/%d\n", wifiRetryCount, MAX_WIFI_RETRY);
+                    LOG_W(wifi, "WiFi 연결 실패, 재시도 %d/%d", wifiRetryCount, MAX_WIFI_RETRY);
                     WiFi.disconnect(false);
                     delay(2000);
-                    WiFi.begin(ssid.c_str(), password.c_str());
+                    startWiFiConnect();
+                    reconnectPolicy.onAttempt();
                     provisioningStartMs = millis(); // 타이머 리셋
                 }
             } else if (status == WL_NO_SSID_AVAIL) {
-                Serial.println("WiFi 연결 실패: SSID를 찾을 수 없음");
+                LOG_W(wifi, "WiFi 연결 실패: SSID를 찾을 수 없음");
                 sendWifiStatusUpdate(false, "wifi_ssid_not_found");
                 awaitingWifiProvisioning = false;
                 suppressAutoReconnect = true;
@@ -109,7 +177,7 @@ void handleWiFiConnection() {
             } else if (timedOut) {
                 wifiRetryCount++;
                 if (wifiRetryCount >= MAX_WIFI_RETRY) {
-                    Serial.printf("WiFi 연결 실패: %d회 재시도 후 타임아웃\n", MAX_WIFI_RETRY);
+                    LOG_W(wifi, "WiFi 연결 실패: %d회 재시도 후 타임아웃", MAX_WIFI_RETRY);
                     sendWifiStatusUpdate(false, "wifi_connection_timeout");
                     awaitingWifiProvisioning = false;
                     suppressAutoReconnect = true;
@@ -117,10 +185,11 @@ void handleWiFiConnection() {
                     WiFi.disconnect(true);
                     WiFi.setAutoReconnect(false);
                 } else {
-                    Serial.printf("WiFi 연결 타임아웃, 재시도 %d/%d\n", wifiRetryCount, MAX_WIFI_RETRY);
+                    LOG_W(wifi, "WiFi 연결 타임아웃, 재시도 %d/%d", wifiRetryCount, MAX_WIFI_RETRY);
                     WiFi.disconnect(false);
                     delay(1000);
-                    WiFi.begin(ssid.c_str(), password.c_str());
+                    startWiFiConnect();
+                    reconnectPolicy.onAttempt();
                     provisioningStartMs = millis(); // 타이머 리셋
                 }
             }
@@ -130,23 +199,27 @@ void handleWiFiConnection() {
 
 void reconnectWiFi() {
     // 저장된 전역 ssid/password를 사용하여 즉시 재연결
-    Serial.println("WiFi 재연결 시도: 저장된 자격 증명 사용");
+    LOG_I(wifi, "WiFi 재연결 시도: 저장된 자격 증명 사용");
     WiFi.disconnect(true);
     delay(200);
     WiFi.mode(WIFI_STA);
     WiFi.persistent(true);
-    WiFi.setAutoReconnect(true);
+    WiFi.setAutoReconnect(false);
     delay(100);
     if (areWiFiCredentialsAvailable()) {
-        Serial.print("WiFi에 연결 시도: ");
-        Serial.println(ssid);
-        WiFi.begin(ssid.c_str(), password.c_str());
+        LOG_I(wifi, "WiFi에 연결 시도: %s", ssid.c_str());
+        // 새 자격 증명일 수 있으므로 이전 AP 캐시는 사용하지 않음
+        invalidateFastConnectCache("자격 증명 변경");
+        startWiFiConnect();
+        // 사용자 요청에 의한 연결이므로 백오프를 초기화하고 이번 시도를 기록
+        reconnectPolicy.reset(millis());
+        reconnectPolicy.onAttempt();
         awaitingWifiProvisioning = true;
         suppressAutoReconnect = false;
         provisioningStartMs = millis();
         wifiRetryCount = 0; // 새로운 연결 시도 시 재시도 카운터 리셋
     } else {
-        Serial.println("저장된 WiFi 자격 증명 없음, 재연결 불가");
+        LOG_I(wifi, "저장된 WiFi 자격 증명 없음, 재연결 불가");
         awaitingWifiProvisioning = false;
         suppressAutoReconnect = false;
     }
@@ -157,138 +230,154 @@ bool areWiFiCredentialsAvailable() {
     return ssid.length() > 0;
 }
 
+WiFiConnectMetrics getWiFiConnectMetrics() {
+    return connectMetrics;
+}
+
 String getMacAddress() {
-    // BLE 연결과 일관성을 위해 Bluetooth MAC 주소 사용
-    uint8_t mac[6];
-    esp_read_mac(mac, ESP_MAC_BT);
-    
-    char macStr[13] = {0};
-    sprintf(macStr, "%02X%02X%02X%02X%02X%02X", mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
-    
-    Serial.print("ESP Bluetooth MAC 주소: ");
-    Serial.println(macStr);
-    
-    return String(macStr);
+    return String(getMacAddressCStr());
 }
 
-String scanWifiNetworks(const String& macId) {
-    Serial.println("WiFi 네트워크 스캔 시작...");
-    
-    // 현재 WiFi 연결 상태 저장
-    bool wasConnected = (WiFi.status() == WL_CONNECTED);
-    String currentSSID = "";
-    String currentPassword = "";
-    
-    if (wasConnected) {
-        currentSSID = ssid;
-        currentPassword = password;
-        Serial.println("WiFi 연결 중... 스캔을 위해 일시 해제");
-        WiFi.disconnect();
-        delay(500); // 연결 해제 대기
+const char* getMacAddressCStr() {
+    // MAC 주소는 변하지 않으므로 최초 1회만 읽어서 캐시 (이후 호출은 로그/할당 없음)
+    static char macStr[13] = {0};
+    if (macStr[0] == '\0') {
+        // BLE 연결과 일관성을 위해 Bluetooth MAC 주소 사용
+        uint8_t mac[6];
+        esp_read_mac(mac, ESP_MAC_BT);
+        snprintf(macStr, sizeof(macStr), "%02X%02X%02X%02X%02X%02X", mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+
+        LOG_I(wifi, "ESP Bluetooth MAC 주소: %s", macStr);
     }
-    
-    // WiFi를 스캔 전용 모드로 설정
-    WiFi.mode(WIFI_STA);
-    delay(100);
-    
-    int numNetworks = WiFi.scanNetworks();
-
-    // 에러 처리: 음수 값은 에러를 의미함
-    if (numNetworks < 0) {
-        Serial.printf("WiFi 스캔 에러 발생: %d\n", numNetworks);
-        Serial.println("에러 원인:");
-        Serial.println("  -1: 스캔이 이미 진행 중");
-        Serial.println("  -2: WiFi가 초기화되지 않음");
-        return "{\"macid\":\"" + macId + "\",\"numAp\":0,\"aplist\":[],\"error\":\"wifi_scan_failed\"}";
+    return macStr;
+}
+
+void applyWiFiConfig() {
+    // 진행 중인 대기 시간은 유지하고 다음 실패부터 새 백오프 범위를 사용
+    reconnectPolicy.setDelays(getConfigU32(ConfigKey::wifiReconnectBaseMs),
+                              getConfigU32(ConfigKey::wifiReconnectMaxMs));
+}
+
+// 내부(static) 함수 구현
+
+// 캐시 유효 여부에 따라 BSSID/채널 지정 연결 또는 전체 스캔 연결을 시작
+static void startWiFiConnect(bool allowFastConnect) {
+    connectAttemptStartMs = millis();
+
+    if (allowFastConnect && fastConnectCacheValid) {
+#ifdef WIFI_REUSE_DHCP_LEASE
+        // 이전 임대 주소를 고정 IP로 재사용하여 DHCP 왕복을 생략
+        WiFi.config(IPAddress(fastConnectCache.ip), IPAddress(fastConnectCache.gateway),
+                    IPAddress(fastConnectCache.subnet), IPAddress(fastConnectCache.dns));
+#endif
+        LOG_I(wifi, "빠른 연결: 채널 %ld, BSSID %02X:%02X:%02X:%02X:%02X:%02X",
+                    (long)fastConnectCache.channel,
+                    fastConnectCache.bssid[0], fastConnectCache.bssid[1], fastConnectCache.bssid[2],
+                    fastConnectCache.bssid[3], fastConnectCache.bssid[4], fastConnectCache.bssid[5]);
+        WiFi.begin(ssid.c_str(), password.c_str(), fastConnectCache.channel, fastConnectCache.bssid);
+        fastConnectInFlight = true;
+        return;
     }
 
-    if (numNetworks == 0) {
-        Serial.println("WiFi 네트워크를 찾을 수 없습니다.");
-        return "{\"macid\":\"" + macId + "\",\"numAp\":0,\"aplist\":[]}";
+#ifdef WIFI_REUSE_DHCP_LEASE
+    // 고정 IP 설정이 남아 있지 않도록 DHCP로 되돌림
+    WiFi.config(IPAddress(), IPAddress(), IPAddress());
+#endif
+    WiFi.begin(ssid.c_str(), password.c_str());
+    fastConnectInFlight = false;
+}
+
+// 연결 성공 시 지연 시간을 기록하고, 신호 세기에 따라 캐시를 갱신하거나 무효화
+static void onWiFiConnected(unsigned long nowMs) {
+    // 첫 연결 시 SNTP 시작 (이후 SNTP가 주기적으로 재동기화, 소프트 리셋 후에도 시각 유지)
+    static bool timeSyncStarted = false;
+    if (!timeSyncStarted) {
+        configTime(0, 0, NTP_SERVER_PRIMARY, NTP_SERVER_SECONDARY);
+        timeSyncStarted = true;
     }
 
-    Serial.printf("%d 개의 네트워크를 찾았습니다.\n", numNetworks);
+    connectMetrics.lastConnectLatencyMs = nowMs - connectAttemptStartMs;
+    connectMetrics.lastConnectFast = fastConnectInFlight;
+    if (fastConnectInFlight) {
+        connectMetrics.fastConnectCount++;
+    } else {
+        connectMetrics.fullConnectCount++;
+    }
+    if (connectMetrics.bootToConnectMs == 0) {
+        connectMetrics.bootToConnectMs = nowMs;
+    }
+    if (disconnectedAtMs != 0) {
+        connectMetrics.lastReconnectMs = nowMs - disconnectedAtMs;
+        disconnectedAtMs = 0;
+    }
+    LOG_I(wifi, "WiFi 연결 경로: %s, 연결 소요 %lu ms, 재연결 소요 %lu ms",
+                fastConnectInFlight ? "빠른 연결" : "전체 스캔",
+                (unsigned long)connectMetrics.lastConnectLatencyMs,
+                (unsigned long)connectMetrics.lastReconnectMs);
+    fastConnectInFlight = false;
 
-    // 안전 확인: 최대 네트워크 수 제한
-    if (numNetworks > 50) {
-        Serial.printf("경고: 네트워크 수가 너무 많음 (%d개), 50개로 제한\n", numNetworks);
-        numNetworks = 50;
+    // 약한 신호의 AP는 캐시하지 않음 (다음 연결 시 전체 스캔으로 더 나은 AP를 찾도록)
+    int8_t rssi = WiFi.RSSI();
+    if (rssi < WIFI_FAST_CONNECT_MIN_RSSI) {
+        LOG_I(wifi, "RSSI %d dBm, 임계값 미만", rssi);
+        invalidateFastConnectCache("약한 신호");
+        return;
     }
 
-    // 네트워크 정보를 담을 구조체와 배열 생성
-    struct WiFiNetwork {
-        String ssid;
-        int32_t rssi;
-        String securityStatus;
-    };
-    
-    // 동적 할당 대신 고정 크기 배열 사용 (메모리 안전성)
-    WiFiNetwork networks[50]; // 최대 50개 네트워크
-    int validNetworks = 0;
-    
-    for (int i = 0; i < numNetworks && validNetworks < 50; ++i) {
-        // 각 네트워크 정보가 유효한지 확인
-        String ssid = WiFi.SSID(i);
-        if (ssid.length() > 0) {
-            // 보안 타입 확인: WIFI_AUTH_OPEN(0)이면 UNLOCKED, 나머지는 LOCKED
-            String security = (WiFi.encryptionType(i) == WIFI_AUTH_OPEN) ? "UNLOCKED" : "LOCKED";
-            networks[validNetworks] = {ssid, WiFi.RSSI(i), security};
-            validNetworks++;
-        }
+    FastConnectCache current;
+    memset(&current, 0, sizeof(current)); // memcmp 비교를 위해 패딩까지 초기화
+    memcpy(current.bssid, WiFi.BSSID(), sizeof(current.bssid));
+    current.channel = WiFi.channel();
+    current.ip = (uint32_t)WiFi.localIP();
+    current.gateway = (uint32_t)WiFi.gatewayIP();
+    current.subnet = (uint32_t)WiFi.subnetMask();
+    current.dns = (uint32_t)WiFi.dnsIP();
+    current.failures = 0;
+
+    // 내용이 바뀐 경우에만 NVS에 기록 (플래시 마모 방지)
+    if (!fastConnectCacheValid || memcmp(&current, &fastConnectCache, sizeof(current)) != 0) {
+        memcpy(&fastConnectCache, &current, sizeof(current));
+        fastConnectCacheValid = true;
+        saveFastConnectCache();
     }
-    
-    // 실제로 유효한 네트워크 수로 업데이트
-    numNetworks = validNetworks;
-
-    // RSSI를 기준으로 내림차순 정렬 (버블 정렬)
-    for (int i = 0; i < numNetworks - 1; ++i) {
-        for (int j = 0; j < numNetworks - i - 1; ++j) {
-            if (networks[j].rssi < networks[j + 1].rssi) {
-                WiFiNetwork temp = networks[j];
-                networks[j] = networks[j + 1];
-                networks[j + 1] = temp;
-            }
-        }
+}
+
+static void loadFastConnectCache() {
+    Preferences prefs;
+    if (!prefs.begin(FAST_CONNECT_NVS_NAMESPACE, true)) {
+        fastConnectCacheValid = false;
+        return;
     }
+    size_t length = prefs.getBytes(FAST_CONNECT_NVS_KEY, &fastConnectCache, sizeof(fastConnectCache));
+    prefs.end();
 
-    // 최대 10개까지만 선택 (신호 강도 순으로 이미 정렬됨)
-    int maxNetworks = min(numNetworks, 10);
-    
-    // ArduinoJson을 사용하여 JSON 응답 생성
-    JsonDocument doc;
-    doc["macid"] = macId;
-    doc["numAp"] = maxNetworks;
-    JsonArray apList = doc["aplist"].to<JsonArray>();
-
-    Serial.printf("--- 정렬된 WiFi 네트워크 (상위 %d개) ---\n", maxNetworks);
-    for (int i = 0; i < maxNetworks; ++i) {
-        // 각 네트워크를 객체로 생성하여 추가
-        JsonObject network = apList.add<JsonObject>();
-        network["ssid"] = networks[i].ssid;
-        network["rssi"] = networks[i].rssi;
-        network["locked"] = networks[i].securityStatus == "LOCKED";
-        
-        Serial.printf("  %d: %s (%d dBm) [%s]\n", 
-                     i + 1, 
-                     networks[i].ssid.c_str(), 
-                     networks[i].rssi,
-                     networks[i].securityStatus.c_str());
+    fastConnectCacheValid = (length == sizeof(fastConnectCache)) &&
+                            fastConnectCache.channel > 0 &&
+                            fastConnectCache.failures < WIFI_FAST_CONNECT_MAX_FAILURES;
+    LOG_I(wifi, "%s", fastConnectCacheValid ? "빠른 연결 캐시 로드 완료" : "빠른 연결 캐시 없음");
+}
+
+static void saveFastConnectCache() {
+    Preferences prefs;
+    if (!prefs.begin(FAST_CONNECT_NVS_NAMESPACE, false)) {
+        LOG_W(wifi, "빠른 연결 캐시 저장 실패");
+        return;
     }
-    
-    if (numNetworks > 10) {
-        Serial.printf("총 %d개 네트워크 중 상위 10개만 전송\n", numNetworks);
+    prefs.putBytes(FAST_CONNECT_NVS_KEY, &fastConnectCache, sizeof(fastConnectCache));
+    prefs.end();
+}
+
+static void invalidateFastConnectCache(const char* reason) {
+    fastConnectInFlight = false;
+    if (!fastConnectCacheValid) {
+        return;
     }
-    
-    String jsonOutput;
-    serializeJson(doc, jsonOutput);
-    
-    WiFi.scanDelete(); // 스캔 결과 메모리 해제
-    
-    // 이전에 연결되어 있었다면 다시 연결 시도
-    if (wasConnected && currentSSID.length() > 0) {
-        Serial.println("WiFi 스캔 완료, 이전 연결 복구 중...");
-        WiFi.begin(currentSSID.c_str(), currentPassword.c_str());
+    fastConnectCacheValid = false;
+    LOG_I(wifi, "빠른 연결 캐시 무효화: %s", reason);
+
+    Preferences prefs;
+    if (prefs.begin(FAST_CONNECT_NVS_NAMESPACE, false)) {
+        prefs.remove(FAST_CONNECT_NVS_KEY);
+        prefs.end();
     }
-    
-    return jsonOutput;
 }
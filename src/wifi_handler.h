@@ -11,6 +11,17 @@ extern String ssid;
 extern String password;
 // isWifiConnected는 globals.h에서 선언됨
 
+// WiFi 연결 지연 측정값 (빠른 연결 경로와 전체 스캔 경로 비교용)
+struct WiFiConnectMetrics {
+    uint32_t lastConnectLatencyMs; // 마지막 연결 시도 시작 → IP 획득
+    uint32_t lastReconnectMs;      // 마지막 연결 끊김 감지 → 재연결 완료
+    uint32_t bootToConnectMs;      // 부팅 → 최초 연결 완료
+    bool lastConnectFast;          // 마지막 연결이 캐시된 BSSID/채널을 사용했는지
+    uint32_t fastConnectCount;     // 빠른 연결 성공 횟수
+    uint32_t fullConnectCount;     // 전체 스캔 연결 성공 횟수
+    uint32_t fastFallbackCount;    // 빠른 연결 실패 후 전체 스캔으로 전환한 횟수
+};
+
 // --- 함수 프로토타입 (이 모듈이 제공하는 기능 목록) ---
 
 /**
@@ -31,6 +42,12 @@ void handleWiFiConnection();
  */
 bool areWiFiCredentialsAvailable();
 
+/**
+ * @brief WiFi 연결 지연 측정값을 반환합니다.
+ * @return WiFiConnectMetrics 구조체.
+ */
+WiFiConnectMetrics getWiFiConnectMetrics();
+
 /**
  * @brief ESP32 모듈의 고유 MAC 주소를 문자열 형태로 가져옵니다.
  * @return 12자리의 MAC 주소 문자열 (예: "A0B1C2D3E4F5").
@@ -38,11 +55,11 @@ bool areWiFiCredentialsAvailable();
 String getMacAddress();
 
 /**
- * @brief 주변 Wi-Fi 네트워크를 스캔하여 신호 강도 순으로 정렬된 JSON 목록을 반환합니다.
- * @param macId JSON에 포함될 이 디바이스의 MAC 주소.
- * @return 스캔 결과가 담긴 JSON 형식의 문자열.
+ * @brief getMacAddress()와 동일한 값을 캐시된 C 문자열로 반환합니다.
+ * 최초 호출 시에만 MAC을 읽고, 이후에는 힙 할당 없이 같은 버퍼를 반환합니다.
+ * @return 12자리 MAC 주소 문자열 (정적 버퍼, 해제 불필요).
  */
-String scanWifiNetworks(const String& macId);
+const char* getMacAddressCStr();
 
 /**
  * @brief 저장된 자격 증명으로 즉시 Wi‑Fi 재연결을 시도합니다.
@@ -50,4 +67,9 @@ String scanWifiNetworks(const String& macId);
  */
 void reconnectWiFi();
 
+/**
+ * @brief 설정 저장소의 WiFi 재연결 백오프 범위를 반영합니다. (재시작 없이 다음 예약부터 적용)
+ */
+void applyWiFiConfig();
+
 #endif // WIFI_HANDLER_H
\ No newline at end of file
@@ -0,0 +1,216 @@
+#include "wifi_scanner.h"
+#include "config.h" // WIFI_SCAN_* 설정을 위해 포함
+#include <WiFi.h>
+#include <ArduinoJson.h>
+#include <esp_wifi_types.h>
+#include "logger.h"
+
+// 스캔 결과 한 항목 (String 대신 고정 크기 버퍼 사용)
+struct ScanEntry {
+    char ssid[33];
+    int8_t rssi;
+    bool locked;
+};
+
+enum class ScanState { idle, scanning, collecting };
+
+// 모듈 내부에서만 사용할 변수
+static ScanState scanState = ScanState::idle;
+static int16_t scanResultCount = 0;
+static int16_t scanResultIndex = 0;
+static unsigned long scanStartMs = 0;
+
+// 수집 중인 상위 K개 (RSSI 기준 최소 힙: heap[0]이 가장 약한 AP)
+static ScanEntry heap[WIFI_SCAN_TOP_K];
+static uint8_t heapSize = 0;
+
+// 완료된 결과 캐시 (RSSI 내림차순)
+static ScanEntry cachedEntries[WIFI_SCAN_TOP_K];
+static uint8_t cachedCount = 0;
+static bool cacheValid = false;
+static unsigned long cacheUpdatedMs = 0;
+
+// 내부 함수 프로토타입
+static void offerScanEntry(const char* ssid, int8_t rssi, bool locked);
+static void siftUp(uint8_t index);
+static void siftDown(uint8_t index);
+static void finishScan();
+
+// 함수 구현
+
+bool startWifiScan() {
+    if (scanState != ScanState::idle) {
+        return true;
+    }
+
+    // 프로비저닝 전에는 WiFi가 꺼져 있을 수 있으므로 STA 모드로 전환 (연결은 건드리지 않음)
+    if (WiFi.getMode() == WIFI_OFF) {
+        WiFi.mode(WIFI_STA);
+    }
+
+    int16_t result = WiFi.scanNetworks(true); // async = true
+    if (result == WIFI_SCAN_FAILED) {
+        // 연결 진행 중에는 드라이버가 스캔을 거부할 수 있음 → 다음 요청 때 재시도
+        LOG_W(wifi, "WiFi 비동기 스캔 시작 실패");
+        return false;
+    }
+
+    scanState = ScanState::scanning;
+    scanStartMs = millis();
+    heapSize = 0;
+    LOG_I(wifi, "WiFi 비동기 스캔 시작");
+    return true;
+}
+
+void handleWifiScan() {
+    if (scanState == ScanState::scanning) {
+        int16_t result = WiFi.scanComplete();
+        if (result == WIFI_SCAN_RUNNING) {
+            return;
+        }
+        if (result < 0) {
+            LOG_I(wifi, "WiFi 스캔 에러 발생: %d", result);
+            WiFi.scanDelete();
+            scanState = ScanState::idle;
+            return;
+        }
+        scanResultCount = result;
+        scanResultIndex = 0;
+        scanState = ScanState::collecting;
+        LOG_I(wifi, "%d 개의 네트워크를 찾았습니다. (%lu ms)",
+                    result, millis() - scanStartMs);
+    }
+
+    if (scanState == ScanState::collecting) {
+        // 루프 지연을 제한하기 위해 호출마다 일부만 처리
+        int16_t end = min<int16_t>(scanResultCount, scanResultIndex + WIFI_SCAN_RESULTS_PER_POLL);
+        for (; scanResultIndex < end; scanResultIndex++) {
+            const wifi_ap_record_t* record =
+                static_cast<const wifi_ap_record_t*>(WiFi.getScanInfoByIndex(scanResultIndex));
+            if (record == nullptr || record->ssid[0] == '\0') {
+                continue; // 숨겨진 SSID 제외
+            }
+            offerScanEntry(reinterpret_cast<const char*>(record->ssid), record->rssi,
+                           record->authmode != WIFI_AUTH_OPEN);
+        }
+        if (scanResultIndex >= scanResultCount) {
+            finishScan();
+        }
+    }
+}
+
+bool isWifiScanInProgress() {
+    return scanState != ScanState::idle;
+}
+
+bool hasWifiScanResults() {
+    return cacheValid;
+}
+
+bool isWifiScanCacheFresh() {
+    return cacheValid && millis() - cacheUpdatedMs < WIFI_SCAN_CACHE_TTL_MS;
+}
+
+String getWifiScanJson(const String& macId) {
+    JsonDocument doc;
+    doc["macid"] = macId;
+    doc["numAp"] = cachedCount;
+    JsonArray apList = doc["aplist"].to<JsonArray>();
+    for (uint8_t i = 0; i < cachedCount; i++) {
+        JsonObject network = apList.add<JsonObject>();
+        network["ssid"] = cachedEntries[i].ssid;
+        network["rssi"] = cachedEntries[i].rssi;
+        network["locked"] = cachedEntries[i].locked;
+    }
+
+    String jsonOutput;
+    serializeJson(doc, jsonOutput);
+    return jsonOutput;
+}
+
+
+// 내부(static) 함수 구현
+
+// 결과 하나를 상위 K개 힙에 반영 (같은 SSID는 가장 강한 BSSID만 유지)
+static void offerScanEntry(const char* ssid, int8_t rssi, bool locked) {
+    for (uint8_t i = 0; i < heapSize; i++) {
+        if (strncmp(heap[i].ssid, ssid, sizeof(heap[i].ssid)) == 0) {
+            if (rssi > heap[i].rssi) {
+                heap[i].rssi = rssi;
+                heap[i].locked = locked;
+                siftDown(i); // 키가 커졌으므로 최소 힙에서 아래로 이동
+            }
+            return;
+        }
+    }
+
+    if (heapSize < WIFI_SCAN_TOP_K) {
+        ScanEntry& entry = heap[heapSize];
+        strlcpy(entry.ssid, ssid, sizeof(entry.ssid));
+        entry.rssi = rssi;
+        entry.locked = locked;
+        siftUp(heapSize++);
+    } else if (rssi > heap[0].rssi) {
+        // 가장 약한 항목을 교체
+        strlcpy(heap[0].ssid, ssid, sizeof(heap[0].ssid));
+        heap[0].rssi = rssi;
+        heap[0].locked = locked;
+        siftDown(0);
+    }
+}
+
+static void siftUp(uint8_t index) {
+    while (index > 0) {
+        uint8_t parent = (index - 1) / 2;
+        if (heap[parent].rssi <= heap[index].rssi) {
+            break;
+        }
+        ScanEntry temp = heap[parent];
+        heap[parent] = heap[index];
+        heap[index] = temp;
+        index = parent;
+    }
+}
+
+static void siftDown(uint8_t index) {
+    while (true) {
+        uint8_t smallest = index;
+        uint8_t left = index * 2 + 1;
+        uint8_t right = left + 1;
+        if (left < heapSize && heap[left].rssi < heap[smallest].rssi) {
+            smallest = left;
+        }
+        if (right < heapSize && heap[right].rssi < heap[smallest].rssi) {
+            smallest = right;
+        }
+        if (smallest == index) {
+            break;
+        }
+        ScanEntry temp = heap[smallest];
+        heap[smallest] = heap[index];
+        heap[index] = temp;
+        index = smallest;
+    }
+}
+
+// 힙에서 약한 순으로 꺼내 뒤에서부터 채우면 RSSI 내림차순 목록이 됨
+static void finishScan() {
+    WiFi.scanDelete(); // 드라이버 스캔 결과 메모리 해제
+
+    cachedCount = heapSize;
+    while (heapSize > 0) {
+        cachedEntries[heapSize - 1] = heap[0];
+        heap[0] = heap[--heapSize];
+        siftDown(0);
+    }
+
+    cacheValid = true;
+    cacheUpdatedMs = millis();
+    scanState = ScanState::idle;
+
+    LOG_I(wifi, "--- 정렬된 WiFi 네트워크 (상위 %u개) ---", (unsigned)cachedCount);
+    for (uint8_t i = 0; i < cachedCount; i++) {
+        LOG_I(wifi, "  %u: %s (%d dBm) [%s]", (unsigned)(i + 1), cachedEntries[i].ssid,
+                    cachedEntries[i].rssi, cachedEntries[i].locked ? "LOCKED" : "UNLOCKED");
+    }
+}
@@ -0,0 +1,43 @@
+#ifndef WIFI_SCANNER_H
+#define WIFI_SCANNER_H
+
+#include <Arduino.h>
+
+/**
+ * @brief 비동기 WiFi 스캔을 시작합니다.
+ * 이미 스캔 중이면 아무것도 하지 않으며, 연결된 WiFi를 끊지 않고 스캔합니다.
+ * @return 스캔이 시작되었거나 이미 진행 중이면 true
+ */
+bool startWifiScan();
+
+/**
+ * @brief 스캔 완료 여부를 확인하고 결과를 조금씩 처리합니다.
+ * 한 번 호출에 WIFI_SCAN_RESULTS_PER_POLL개까지만 처리하여 루프 지연을 제한하며,
+ * 신호 세기 상위 WIFI_SCAN_TOP_K개를 SSID 중복 없이 유지합니다.
+ * 스케줄러 작업("wifiScan", 100ms 주기)으로 실행됩니다.
+ */
+void handleWifiScan();
+
+/**
+ * @brief 스캔이 진행 중인지(결과 처리 포함) 확인합니다.
+ */
+bool isWifiScanInProgress();
+
+/**
+ * @brief 캐시된 스캔 결과가 있는지 확인합니다 (만료 여부 무관).
+ */
+bool hasWifiScanResults();
+
+/**
+ * @brief 캐시된 스캔 결과가 WIFI_SCAN_CACHE_TTL_MS 이내인지 확인합니다.
+ */
+bool isWifiScanCacheFresh();
+
+/**
+ * @brief 캐시된 스캔 결과를 BLE 프로비저닝용 JSON 문자열로 반환합니다.
+ * 형식: {"macid":"...","numAp":N,"aplist":[{"ssid":"...","rssi":-40,"locked":true},...]}
+ * @param macId JSON에 포함될 이 디바이스의 MAC 주소.
+ */
+String getWifiScanJson(const String& macId);
+
+#endif // WIFI_SCANNER_H
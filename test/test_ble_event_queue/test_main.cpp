@@ -0,0 +1,182 @@
+// BLE 이벤트 큐 단위 테스트와 다중 생산자 스트레스 테스트 (pio test -e native)
+// 생산자 스레드 여러 개가 동시에 쓰기를 넣는 동안 메인 스레드가 소비하며
+// 유실 집계, 생산자별 순서, 페이로드 무결성, 연결 상태 이벤트 보존을 확인합니다.
+
+#include <unity.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <string.h>
+#include "ble_event_queue.h"
+#include "ble_transport.h"
+#include "host_runtime.h"
+
+static const int STRESS_PRODUCERS = 4;
+static const uint32_t STRESS_WRITES_PER_PRODUCER = 200000;
+static const uint32_t STRESS_CONTROL_EVENTS = 2000;
+
+void setUp() {}
+void tearDown() {}
+
+static void drainQueue() {
+    while (peekBleEvent() != nullptr) {
+        releaseBleEvent();
+    }
+}
+
+static bool pushWrite(uint8_t producer, uint32_t sequence, size_t length) {
+    uint8_t payload[BLE_EVENT_MAX_PAYLOAD];
+    payload[0] = producer;
+    memcpy(payload + 1, &sequence, sizeof(sequence));
+    for (size_t i = 5; i < length; i++) {
+        payload[i] = (uint8_t)(sequence + i);
+    }
+    return pushBleEvent(BleEventType::write, payload, length);
+}
+
+// 쓰기로 큐가 가득 차도 예약 슬롯 덕분에 연결/해제/MTU 이벤트는 순서대로 들어감
+void test_control_events_survive_write_flood() {
+    drainQueue();
+    uint32_t accepted = 0;
+    while (pushWrite(0, accepted, 20)) {
+        accepted++;
+    }
+    TEST_ASSERT_EQUAL_UINT32(BLE_EVENT_QUEUE_CAPACITY - BLE_EVENT_RESERVED_SLOTS, accepted);
+
+    TEST_ASSERT_TRUE(pushBleEvent(BleEventType::disconnect));
+    uint8_t address[6] = {1, 2, 3, 4, 5, 6};
+    TEST_ASSERT_TRUE(pushBleEvent(BleEventType::connect, address, sizeof(address)));
+    TEST_ASSERT_TRUE(pushBleEvent(BleEventType::mtuChanged, nullptr, 0, BLE_MAX_MTU));
+    TEST_ASSERT_FALSE(pushWrite(0, accepted, 20));
+
+    for (uint32_t i = 0; i < accepted; i++) {
+        TEST_ASSERT_EQUAL(BleEventType::write, peekBleEvent()->type);
+        releaseBleEvent();
+    }
+    TEST_ASSERT_EQUAL(BleEventType::disconnect, peekBleEvent()->type);
+    releaseBleEvent();
+    TEST_ASSERT_EQUAL(BleEventType::connect, peekBleEvent()->type);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(address, peekBleEvent()->data, sizeof(address));
+    releaseBleEvent();
+    TEST_ASSERT_EQUAL_UINT16(BLE_MAX_MTU, peekBleEvent()->value);
+    releaseBleEvent();
+    TEST_ASSERT_NULL(peekBleEvent());
+}
+
+// 최대 MTU에서 메시지 하나의 프레임 전체와 ACK가 소비 없이도 모두 들어감
+void test_full_framed_message_fits() {
+    drainQueue();
+    size_t payloadSize = BLE_MAX_MTU - 3 - BLE_FRAME_HEADER_SIZE;
+    uint32_t frames = (BLE_MAX_MESSAGE_SIZE + payloadSize - 1) / payloadSize;
+    uint32_t dropsBefore = getBleEventDropCount();
+    for (uint32_t seq = 0; seq < frames; seq++) {
+        TEST_ASSERT_TRUE(pushWrite(1, seq, BLE_FRAME_HEADER_SIZE + payloadSize));
+    }
+    TEST_ASSERT_TRUE(pushWrite(1, frames, BLE_FRAME_HEADER_SIZE)); // ACK
+    TEST_ASSERT_EQUAL_UINT32(dropsBefore, getBleEventDropCount());
+    TEST_ASSERT_EQUAL_UINT32(frames + 1, getBleEventQueueDepth());
+    drainQueue();
+}
+
+// 생산자 여러 개가 동시에 쓰고 연결 상태 이벤트가 섞여도 손상/순서 오류 없이 전달되고
+// 버려진 쓰기 수와 받은 수의 합이 보낸 수와 같음
+void test_multi_producer_stress() {
+    drainQueue();
+    uint32_t dropsBefore = getBleEventDropCount();
+    std::atomic<int> running(STRESS_PRODUCERS + 1);
+    std::atomic<uint32_t> rejectedWrites(0);
+    std::atomic<uint32_t> rejectedControls(0);
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < STRESS_PRODUCERS; p++) {
+        producers.emplace_back([p, &running, &rejectedWrites]() {
+            for (uint32_t seq = 0; seq < STRESS_WRITES_PER_PRODUCER; seq++) {
+                if (!pushWrite((uint8_t)p, seq, 5 + seq % 64)) {
+                    rejectedWrites++;
+                }
+                if (seq % 8 == 0) {
+                    std::this_thread::yield(); // 가끔 양보해 큐가 찼다 비었다를 반복하게 함
+                }
+            }
+            running--;
+        });
+    }
+    // 연결 상태 이벤트 생산자 (BLE 스택의 서버 콜백 역할)
+    producers.emplace_back([&running, &rejectedControls]() {
+        for (uint32_t i = 0; i < STRESS_CONTROL_EVENTS; i++) {
+            BleEventType type = i % 2 == 0 ? BleEventType::disconnect : BleEventType::connect;
+            while (!pushBleEvent(type, nullptr, 0, (uint16_t)i)) {
+                rejectedControls++;
+                std::this_thread::yield();
+            }
+            std::this_thread::yield();
+        }
+        running--;
+    });
+
+    std::vector<int64_t> lastSeq(STRESS_PRODUCERS, -1);
+    uint32_t receivedWrites = 0;
+    uint32_t receivedControls = 0;
+    uint32_t corrupted = 0;
+    uint32_t reordered = 0;
+    while (running > 0 || peekBleEvent() != nullptr) {
+        const BleEvent* event = peekBleEvent();
+        if (event == nullptr) {
+            std::this_thread::yield();
+            continue;
+        }
+        if (event->type == BleEventType::write) {
+            uint8_t producer = event->data[0];
+            uint32_t seq;
+            memcpy(&seq, event->data + 1, sizeof(seq));
+            if (producer >= STRESS_PRODUCERS || event->length != 5 + seq % 64) {
+                corrupted++;
+            } else {
+                for (size_t i = 5; i < event->length; i++) {
+                    if (event->data[i] != (uint8_t)(seq + i)) {
+                        corrupted++;
+                        break;
+                    }
+                }
+                if ((int64_t)seq <= lastSeq[producer]) {
+                    reordered++;
+                }
+                lastSeq[producer] = seq;
+            }
+            receivedWrites++;
+        } else {
+            // 연결 상태 이벤트는 보낸 순서 그대로 도착해야 함
+            if (event->value != receivedControls) {
+                reordered++;
+            }
+            receivedControls++;
+        }
+        releaseBleEvent();
+    }
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+
+    char text[160];
+    snprintf(text, sizeof(text), "생산자 %d개 x %lu 쓰기: 수신 %lu, 버림 %lu / 연결 이벤트 %lu개 (재시도 %lu)",
+             STRESS_PRODUCERS, (unsigned long)STRESS_WRITES_PER_PRODUCER, (unsigned long)receivedWrites,
+             (unsigned long)rejectedWrites.load(), (unsigned long)receivedControls,
+             (unsigned long)rejectedControls.load());
+    TEST_MESSAGE(text);
+
+    TEST_ASSERT_EQUAL_UINT32(0, corrupted);
+    TEST_ASSERT_EQUAL_UINT32(0, reordered);
+    TEST_ASSERT_EQUAL_UINT32(STRESS_PRODUCERS * STRESS_WRITES_PER_PRODUCER, receivedWrites + rejectedWrites.load());
+    TEST_ASSERT_EQUAL_UINT32(rejectedWrites.load() + rejectedControls.load(), getBleEventDropCount() - dropsBefore);
+    TEST_ASSERT_EQUAL_UINT32(STRESS_CONTROL_EVENTS, receivedControls);
+    TEST_ASSERT_EQUAL_UINT32(0, getBleEventQueueDepth());
+}
+
+int main(int argc, char** argv) {
+    hostInit(argc, argv);
+    UNITY_BEGIN();
+    RUN_TEST(test_control_events_survive_write_flood);
+    RUN_TEST(test_full_framed_message_fits);
+    RUN_TEST(test_multi_producer_stress);
+    return UNITY_END();
+}
@@ -0,0 +1,157 @@
+// BLE 전송 계층 페이싱 처리량 벤치마크 (pio test -e native)
+// 호스트 BLE 링크 모델(연결 간격마다 정해진 수의 notify 전송, 버퍼가 차면 혼잡 이벤트/유실)에서
+// 프로비저닝 응답 크기의 메시지를 연속으로 보내 기존 방식과 처리량/유실을 비교합니다.
+
+#include <unity.h>
+#include <BLEDevice.h>
+#include <string.h>
+#include "ble_transport.h"
+#include "globals.h"
+#include "logger.h"
+#include "host_runtime.h"
+
+static const uint16_t LINK_INTERVAL_MS = 30;  // 휴대폰의 일반적인 연결 간격
+static const uint8_t LINK_PACKETS_PER_EVENT = 3;
+static const uint16_t LINK_MTU = BLE_MAX_MTU;
+static const size_t MESSAGE_SIZE = 2000;      // WiFi 목록 응답 크기
+static const int MESSAGE_COUNT = 8;
+
+static char message[MESSAGE_SIZE];
+static BLECharacteristic* characteristic = nullptr;
+
+class StatusCallbacks : public BLECharacteristicCallbacks {
+    void onStatus(BLECharacteristic* pCharacteristic, Status status, uint32_t code) {
+        onBleNotifyStatus(status == SUCCESS_NOTIFY || status == SUCCESS_INDICATE);
+    }
+};
+
+static void gattsEventHandler(esp_gatts_cb_event_t event, esp_gatt_if_t gattsIf, esp_ble_gatts_cb_param_t* param) {
+    if (event == ESP_GATTS_CONGEST_EVT) {
+        onBleCongestion(param->congest.congested);
+    }
+}
+
+struct LinkResult {
+    float kbPerSecond;         // 링크에서 실제로 전달된 바이트 기준
+    uint32_t droppedPackets;
+    uint32_t congestEvents;
+};
+
+// 링크를 새로 연결하고 send를 실행한 뒤 버퍼가 모두 비워질 때까지의 전달 처리량을 잼
+template <typename Send>
+static LinkResult measure(bool framed, Send send) {
+    hostBleSetLink(LINK_INTERVAL_MS, LINK_PACKETS_PER_EVENT);
+    initBleTransport(characteristic);
+    setBleTransportMtu(LINK_MTU);
+    if (framed) {
+        // 클라이언트가 프레임(ACK)을 한 번 보내면 프레임 모드로 전환됨
+        uint8_t ack[BLE_FRAME_HEADER_SIZE] = {BLE_FRAME_TYPE_ACK, 0, 0, 0, 0, 0};
+        const char* unused = nullptr;
+        size_t unusedLength = 0;
+        handleBleFrame(ack, sizeof(ack), &unused, &unusedLength);
+    }
+
+    unsigned long startMs = millis();
+    send();
+    while (hostBleLinkStats().queuedPackets > 0) {
+        delay(1);
+    }
+    unsigned long elapsedMs = millis() - startMs;
+
+    HostBleLinkStats stats = hostBleLinkStats();
+    hostBleSetLink(0, 0);
+    LinkResult result;
+    result.kbPerSecond = elapsedMs > 0 ? stats.deliveredBytes / 1.024f / elapsedMs : 0.0f;
+    result.droppedPackets = stats.droppedPackets;
+    result.congestEvents = stats.congestEvents;
+    return result;
+}
+
+// 개선 전 기존 앱 방식: 500바이트 청크마다 delay(50)
+static void sendLegacyBaseline() {
+    for (int i = 0; i < MESSAGE_COUNT; i++) {
+        for (size_t offset = 0; offset < MESSAGE_SIZE; offset += BLE_LEGACY_CHUNK_SIZE) {
+            size_t size = MESSAGE_SIZE - offset < BLE_LEGACY_CHUNK_SIZE ? MESSAGE_SIZE - offset
+                                                                        : BLE_LEGACY_CHUNK_SIZE;
+            characteristic->setValue((uint8_t*)message + offset, size);
+            characteristic->notify();
+            delay(50);
+        }
+    }
+}
+
+// 혼잡 이벤트 반영 전 프레임 방식: onStatus 성공(큐에 들어감)만 보고 바로 다음 프레임 전송
+static void sendUnpacedFrames() {
+    static uint8_t frame[BLE_MAX_MTU];
+    size_t payloadSize = LINK_MTU - 3 - BLE_FRAME_HEADER_SIZE;
+    for (int i = 0; i < MESSAGE_COUNT; i++) {
+        for (size_t offset = 0; offset < MESSAGE_SIZE; offset += payloadSize) {
+            size_t size = MESSAGE_SIZE - offset < payloadSize ? MESSAGE_SIZE - offset : payloadSize;
+            memcpy(frame + BLE_FRAME_HEADER_SIZE, message + offset, size);
+            characteristic->setValue(frame, BLE_FRAME_HEADER_SIZE + size);
+            characteristic->notify();
+        }
+    }
+}
+
+static void sendMessages() {
+    for (int i = 0; i < MESSAGE_COUNT; i++) {
+        TEST_ASSERT_TRUE(sendBleMessage(message, MESSAGE_SIZE));
+    }
+}
+
+void setUp() {
+    isBleClientConnected = true;
+}
+
+void tearDown() {
+    isBleClientConnected = false;
+}
+
+// 프레임 모드는 혼잡 이벤트/크레딧에 맞춰 보내므로 유실 없이 링크 속도에 가깝게 전송
+void test_framed_paces_on_congestion_without_loss() {
+    LinkResult unpaced = measure(true, sendUnpacedFrames);
+    LinkResult paced = measure(true, sendMessages);
+
+    char text[160];
+    snprintf(text, sizeof(text), "프레임 %d x %u bytes: 페이싱 없음 %.1f KB/s, 유실 %u / 혼잡 대기 %.1f KB/s, 유실 %u, 혼잡 %u회",
+             MESSAGE_COUNT, (unsigned)MESSAGE_SIZE, unpaced.kbPerSecond, (unsigned)unpaced.droppedPackets,
+             paced.kbPerSecond, (unsigned)paced.droppedPackets, (unsigned)paced.congestEvents);
+    TEST_MESSAGE(text);
+
+    TEST_ASSERT_GREATER_THAN_UINT32(0, unpaced.droppedPackets); // 성공 상태만으로는 버퍼 넘침을 막지 못함
+    TEST_ASSERT_EQUAL_UINT32(0, paced.droppedPackets);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, paced.congestEvents);
+}
+
+// 프레임 모드 처리량은 기존 청크+지연 방식보다 높고, 기존 앱용 청크 간격은 그대로 유지
+void test_framed_throughput_against_legacy() {
+    LinkResult baseline = measure(false, sendLegacyBaseline);
+    LinkResult legacy = measure(false, sendMessages);
+    LinkResult framed = measure(true, sendMessages);
+
+    char text[160];
+    snprintf(text, sizeof(text), "기존(청크+50ms) %.1f KB/s / 청크 모드 %.1f KB/s, 유실 %u / 프레임 모드 %.1f KB/s",
+             baseline.kbPerSecond, legacy.kbPerSecond, (unsigned)legacy.droppedPackets, framed.kbPerSecond);
+    TEST_MESSAGE(text);
+
+    TEST_ASSERT_EQUAL_UINT32(0, legacy.droppedPackets);
+    TEST_ASSERT_TRUE(legacy.kbPerSecond <= baseline.kbPerSecond * 1.5f);
+    TEST_ASSERT_TRUE(framed.kbPerSecond > baseline.kbPerSecond * 2);
+}
+
+int main(int argc, char** argv) {
+    hostInit(argc, argv);
+    setLogLevel(LogModule::ble, LogLevel::error); // 메시지별 전송 로그 생략
+    for (size_t i = 0; i < MESSAGE_SIZE; i++) {
+        message[i] = 'a' + (i % 26);
+    }
+    BLEDevice::setCustomGattsHandler(gattsEventHandler);
+    characteristic = new BLECharacteristic("test", BLECharacteristic::PROPERTY_NOTIFY);
+    characteristic->setCallbacks(new StatusCallbacks());
+
+    UNITY_BEGIN();
+    RUN_TEST(test_framed_paces_on_congestion_without_loss);
+    RUN_TEST(test_framed_throughput_against_legacy);
+    return UNITY_END();
+}
@@ -0,0 +1,241 @@
+// 설정 저장소 단위 테스트와 NVS 쓰기/마모 벤치마크 (pio test -e native)
+// 호스트 NVS 대체 구현(host/src/preferences.cpp)의 커밋 수/기록 바이트 집계로
+// 변경 시에만 쓰는 저장소와 매번 쓰는 방식, 레거시 EEPROM 블록 방식을 비교합니다.
+
+#include <unity.h>
+#include <Preferences.h>
+#include <EEPROM.h>
+#include <stdlib.h>
+#include "config.h"
+#include "config_store.h"
+#include "logger.h"
+#include "host_runtime.h"
+
+static const uint32_t BENCH_UPDATES = 1000;        // 원격 설정 반영 횟수
+static const uint32_t BENCH_CHANGE_EVERY = 10;     // 그중 실제로 값이 바뀌는 비율 (10번에 1번)
+static const uint32_t BENCH_PROVISIONINGS = 100;   // WiFi 재프로비저닝 횟수 (절반은 같은 정보)
+static const uint32_t NVS_PAGE_ENTRIES_BYTES = 126 * 32; // NVS 페이지(4KB)에 들어가는 항목 바이트
+
+// 저장소와 레거시 EEPROM을 비우고 저장소를 다시 엶 (공장 초기화 상태)
+static void eraseAll() {
+    Preferences prefs;
+    if (prefs.begin("config", false)) {
+        prefs.clear();
+        prefs.end();
+    }
+    remove(hostStatePath("eeprom.bin").c_str());
+    initConfigStore();
+}
+
+void setUp() {
+    eraseAll();
+}
+
+void tearDown() {}
+
+// 타입/범위가 맞지 않는 값은 거부되고 캐시도 바뀌지 않음
+void test_typed_keys_reject_invalid_values() {
+    TEST_ASSERT_EQUAL_UINT32(1000, getConfigU32(ConfigKey::sensorPublishIntervalMs));
+    TEST_ASSERT_FALSE(setConfigU32(ConfigKey::sensorPublishIntervalMs, 99));
+    TEST_ASSERT_FALSE(setConfigU32(ConfigKey::sensorPublishIntervalMs, 3600001));
+    TEST_ASSERT_FALSE(setConfigU32(ConfigKey::wifiSsid, 1));
+    TEST_ASSERT_FALSE(setConfigString(ConfigKey::mqttKeepAliveSec, "30"));
+    TEST_ASSERT_FALSE(setConfigString(ConfigKey::wifiSsid, "0123456789012345678901234567890123")); // 33자
+    TEST_ASSERT_EQUAL_UINT32(1000, getConfigU32(ConfigKey::sensorPublishIntervalMs));
+    TEST_ASSERT_EQUAL_STRING("", getConfigString(ConfigKey::wifiSsid));
+
+    TEST_ASSERT_TRUE(setConfigU32(ConfigKey::sensorPublishIntervalMs, 100));
+    TEST_ASSERT_TRUE(setConfigString(ConfigKey::wifiSsid, "lab"));
+    TEST_ASSERT_EQUAL_UINT32(100, getConfigU32(ConfigKey::sensorPublishIntervalMs));
+    TEST_ASSERT_EQUAL_STRING("lab", getConfigString(ConfigKey::wifiSsid));
+}
+
+// 같은 값을 다시 쓰면 NVS 커밋이 없음
+void test_unchanged_value_is_not_written() {
+    TEST_ASSERT_TRUE(setConfigU32(ConfigKey::mqttKeepAliveSec, 60));
+    TEST_ASSERT_TRUE(setConfigString(ConfigKey::wifiPassword, "secret123"));
+    uint32_t writes = getConfigWriteCount();
+    uint32_t commits = hostNvsStats().commits;
+
+    TEST_ASSERT_TRUE(setConfigU32(ConfigKey::mqttKeepAliveSec, 60));
+    TEST_ASSERT_TRUE(setConfigString(ConfigKey::wifiPassword, "secret123"));
+    TEST_ASSERT_EQUAL_UINT32(writes, getConfigWriteCount());
+    TEST_ASSERT_EQUAL_UINT32(commits, hostNvsStats().commits);
+
+    TEST_ASSERT_TRUE(setConfigU32(ConfigKey::mqttKeepAliveSec, 90));
+    TEST_ASSERT_EQUAL_UINT32(writes + 1, getConfigWriteCount());
+    TEST_ASSERT_EQUAL_UINT32(commits + 1, hostNvsStats().commits);
+}
+
+// 저장한 값은 재부팅(다시 열기) 후 캐시로 복원되고, 초기화하면 기본값과 키 삭제
+void test_values_persist_and_reset() {
+    TEST_ASSERT_TRUE(setConfigU32(ConfigKey::cameraJpegQuality, 20));
+    TEST_ASSERT_TRUE(setConfigString(ConfigKey::wifiSsid, "office"));
+    initConfigStore();
+    TEST_ASSERT_EQUAL_UINT32(20, getConfigU32(ConfigKey::cameraJpegQuality));
+    TEST_ASSERT_EQUAL_STRING("office", getConfigString(ConfigKey::wifiSsid));
+
+    // 빈 문자열은 키 삭제로 저장
+    TEST_ASSERT_TRUE(setConfigString(ConfigKey::wifiSsid, ""));
+    resetConfig(ConfigKey::cameraJpegQuality);
+    initConfigStore();
+    TEST_ASSERT_EQUAL_UINT32(10, getConfigU32(ConfigKey::cameraJpegQuality));
+    TEST_ASSERT_EQUAL_STRING("", getConfigString(ConfigKey::wifiSsid));
+
+    Preferences prefs;
+    TEST_ASSERT_TRUE(prefs.begin("config", true));
+    TEST_ASSERT_FALSE(prefs.isKey("cam_jpeg_q"));
+    TEST_ASSERT_FALSE(prefs.isKey("wifi_ssid"));
+    prefs.end();
+}
+
+// 범위를 벗어난 저장 값(다른 펌웨어가 쓴 값 등)은 무시하고 기본값 사용
+void test_out_of_range_stored_value_uses_default() {
+    Preferences prefs;
+    TEST_ASSERT_TRUE(prefs.begin("config", false));
+    prefs.putUInt("cam_jpeg_q", 200);
+    prefs.end();
+    initConfigStore();
+    TEST_ASSERT_EQUAL_UINT32(10, getConfigU32(ConfigKey::cameraJpegQuality));
+}
+
+// 스키마 v0 장치: 레거시 EEPROM의 WiFi 정보를 가져오고 EEPROM의 평문은 지움, 두 번째 부팅에는 다시 하지 않음
+void test_legacy_eeprom_migration() {
+    Preferences prefs;
+    TEST_ASSERT_TRUE(prefs.begin("config", false));
+    prefs.clear(); // 스키마 표시 없음 = v0
+    prefs.end();
+    TEST_ASSERT_TRUE(EEPROM.begin(EEPROM_SIZE));
+    EEPROM.write(EEPROM_INIT_FLAG_ADDR, EEPROM_INIT_CHECK_VALUE);
+    EEPROM.write(EEPROM_AP_INFO_FLAG_ADDR, 1);
+    EEPROM.writeString(EEPROM_SSID_ADDR, "legacy-ap");
+    EEPROM.writeString(EEPROM_PASSWD_ADDR, "legacy-pass");
+    EEPROM.end();
+
+    TEST_ASSERT_TRUE(initConfigStore());
+    TEST_ASSERT_EQUAL_STRING("legacy-ap", getConfigString(ConfigKey::wifiSsid));
+    TEST_ASSERT_EQUAL_STRING("legacy-pass", getConfigString(ConfigKey::wifiPassword));
+
+    TEST_ASSERT_TRUE(EEPROM.begin(EEPROM_SIZE));
+    TEST_ASSERT_EQUAL_UINT8(0, EEPROM.read(EEPROM_AP_INFO_FLAG_ADDR));
+    TEST_ASSERT_EQUAL_STRING("", EEPROM.readString(EEPROM_PASSWD_ADDR).c_str());
+    EEPROM.end();
+
+    TEST_ASSERT_TRUE(prefs.begin("config", true));
+    TEST_ASSERT_EQUAL_UINT16(CONFIG_SCHEMA_VERSION, prefs.getUShort("schema", 0));
+    prefs.end();
+
+    uint32_t commits = hostNvsStats().commits;
+    initConfigStore();
+    TEST_ASSERT_EQUAL_UINT32(commits, hostNvsStats().commits);
+    TEST_ASSERT_EQUAL_STRING("legacy-ap", getConfigString(ConfigKey::wifiSsid));
+}
+
+// 펌웨어보다 높은 스키마는 그대로 두고 아는 키만 사용
+void test_newer_schema_is_left_untouched() {
+    Preferences prefs;
+    TEST_ASSERT_TRUE(prefs.begin("config", false));
+    prefs.putUShort("schema", CONFIG_SCHEMA_VERSION + 1);
+    prefs.putUInt("sensor_int_ms", 5000);
+    prefs.end();
+    initConfigStore();
+    TEST_ASSERT_EQUAL_UINT32(5000, getConfigU32(ConfigKey::sensorPublishIntervalMs));
+    TEST_ASSERT_TRUE(prefs.begin("config", true));
+    TEST_ASSERT_EQUAL_UINT16(CONFIG_SCHEMA_VERSION + 1, prefs.getUShort("schema", 0));
+    prefs.end();
+}
+
+struct WearResult {
+    uint32_t commits;
+    uint64_t bytesWritten;
+};
+
+static WearResult since(const HostNvsStats& start) {
+    HostNvsStats now = hostNvsStats();
+    WearResult result = {now.commits - start.commits, now.bytesWritten - start.bytesWritten};
+    return result;
+}
+
+// 원격 설정 반영: 대부분 같은 값이 다시 오고 BENCH_CHANGE_EVERY번에 한 번만 바뀜
+static uint32_t benchIntervalValue(uint32_t update) {
+    return 1000 + (update / BENCH_CHANGE_EVERY) % 2 * 1000;
+}
+
+// 재프로비저닝: 짝수 번째는 같은 정보를 다시 보내고 홀수 번째는 비밀번호를 바꿈
+static String benchPassword(uint32_t round) {
+    return String("password-") + String((unsigned long)(round / 2));
+}
+
+// 변경 시에만 쓰는 방식과 매번 쓰는 방식, 레거시 EEPROM 블록 방식의 커밋 수/기록량 비교
+void test_commit_count_and_wear_benchmark() {
+    setLogLevel(LogModule::storage, LogLevel::error); // 저장 로그 생략
+
+    // 원격 설정: 저장소(변경 시에만 기록) vs 매번 putUInt
+    HostNvsStats start = hostNvsStats();
+    for (uint32_t i = 0; i < BENCH_UPDATES; i++) {
+        setConfigU32(ConfigKey::sensorPublishIntervalMs, benchIntervalValue(i));
+    }
+    WearResult storeUpdates = since(start);
+
+    Preferences prefs;
+    TEST_ASSERT_TRUE(prefs.begin("bench", false));
+    start = hostNvsStats();
+    for (uint32_t i = 0; i < BENCH_UPDATES; i++) {
+        prefs.putUInt("sensor_int_ms", benchIntervalValue(i));
+    }
+    WearResult naiveUpdates = since(start);
+    prefs.clear();
+    prefs.end();
+
+    // 재프로비저닝: 저장소 vs 레거시 EEPROM 블록 (writeString 두 번 + 플래그 + 전체 커밋)
+    start = hostNvsStats();
+    for (uint32_t i = 0; i < BENCH_PROVISIONINGS; i++) {
+        saveWiFiCredentials("lab", benchPassword(i));
+    }
+    WearResult storeProvisioning = since(start);
+
+    TEST_ASSERT_TRUE(EEPROM.begin(EEPROM_SIZE));
+    start = hostNvsStats();
+    for (uint32_t i = 0; i < BENCH_PROVISIONINGS; i++) {
+        EEPROM.writeString(EEPROM_SSID_ADDR, "lab");
+        EEPROM.writeString(EEPROM_PASSWD_ADDR, benchPassword(i));
+        EEPROM.write(EEPROM_AP_INFO_FLAG_ADDR, 1);
+        EEPROM.commit();
+    }
+    WearResult legacyProvisioning = since(start);
+    EEPROM.end();
+
+    char text[256];
+    snprintf(text, sizeof(text),
+             "원격 설정 %lu회(변경 1/%lu): 저장소 커밋 %lu, %llu B / 매번 쓰기 커밋 %lu, %llu B (NVS 페이지 %.2f장 분량)",
+             (unsigned long)BENCH_UPDATES, (unsigned long)BENCH_CHANGE_EVERY, (unsigned long)storeUpdates.commits,
+             (unsigned long long)storeUpdates.bytesWritten, (unsigned long)naiveUpdates.commits,
+             (unsigned long long)naiveUpdates.bytesWritten, naiveUpdates.bytesWritten / (double)NVS_PAGE_ENTRIES_BYTES);
+    TEST_MESSAGE(text);
+    snprintf(text, sizeof(text), "재프로비저닝 %lu회(절반 동일): 저장소 커밋 %lu, %llu B / 레거시 EEPROM 커밋 %lu, %llu B",
+             (unsigned long)BENCH_PROVISIONINGS, (unsigned long)storeProvisioning.commits,
+             (unsigned long long)storeProvisioning.bytesWritten, (unsigned long)legacyProvisioning.commits,
+             (unsigned long long)legacyProvisioning.bytesWritten);
+    TEST_MESSAGE(text);
+
+    // 첫 값은 기본값과 같아 기록하지 않고, 첫 프로비저닝은 SSID도 함께 기록
+    TEST_ASSERT_EQUAL_UINT32(BENCH_UPDATES / BENCH_CHANGE_EVERY - 1, storeUpdates.commits);
+    TEST_ASSERT_EQUAL_UINT32(BENCH_UPDATES, naiveUpdates.commits);
+    TEST_ASSERT_EQUAL_UINT32(BENCH_PROVISIONINGS / 2 + 1, storeProvisioning.commits);
+    TEST_ASSERT_LESS_THAN(legacyProvisioning.bytesWritten, storeProvisioning.bytesWritten);
+}
+
+int main(int argc, char** argv) {
+    setenv("HOST_STATE_DIR", ".host_state_test", 0); // 개발용 상태 디렉터리와 분리
+    hostInit(argc, argv);
+    setLogLevel(LogModule::storage, LogLevel::warn);
+    UNITY_BEGIN();
+    RUN_TEST(test_typed_keys_reject_invalid_values);
+    RUN_TEST(test_unchanged_value_is_not_written);
+    RUN_TEST(test_values_persist_and_reset);
+    RUN_TEST(test_out_of_range_stored_value_uses_default);
+    RUN_TEST(test_legacy_eeprom_migration);
+    RUN_TEST(test_newer_schema_is_left_untouched);
+    RUN_TEST(test_commit_count_and_wear_benchmark);
+    return UNITY_END();
+}
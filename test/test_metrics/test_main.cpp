@@ -0,0 +1,223 @@
+// 지표 레지스트리 단위 테스트와 갱신 비용 벤치마크 (pio test -e native)
+// 히스토그램 버킷 경계/합계/최댓값/초기화, 스레드 여러 개가 동시에 기록할 때의 집계 일치,
+// 스냅샷 JSON 형식과 최대 길이, 발행 후 commit을 확인하고 observeMetric/incrementMetric 1회 비용을 잽니다.
+
+#include <unity.h>
+#include <esp_timer.h>
+#include <string.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "config.h"
+#include "metrics.h"
+#include "host_runtime.h"
+
+static const int STRESS_THREADS = 4;
+static const uint32_t STRESS_OBSERVATIONS = 200000;
+static const uint32_t BENCH_ITERATIONS = 2000000;
+
+void setUp() {
+    for (size_t i = 0; i < (size_t)MetricHistogram::count; i++) {
+        getMetric((MetricHistogram)i, true);
+    }
+}
+
+void tearDown() {}
+
+static uint32_t bucketTotal(const HistogramSnapshot& h) {
+    uint32_t total = 0;
+    for (size_t i = 0; i < METRIC_BUCKET_COUNT; i++) {
+        total += h.buckets[i];
+    }
+    return total;
+}
+
+// 상한과 같은 값은 그 버킷에, 상한 + 1은 다음 버킷에, 마지막 상한 초과는 초과 버킷에 들어감
+void test_histogram_bucket_boundaries() {
+    MetricHistogram histogram = MetricHistogram::captureLatencyMs;
+    const uint32_t* bounds = getMetricBucketBounds(histogram);
+    uint64_t expectedSum = 0;
+    for (size_t i = 0; i < METRIC_BUCKET_BOUNDS; i++) {
+        observeMetric(histogram, bounds[i]);
+        observeMetric(histogram, bounds[i] + 1);
+        expectedSum += 2 * (uint64_t)bounds[i] + 1;
+    }
+    observeMetric(histogram, 0);
+
+    HistogramSnapshot h = getMetric(histogram);
+    TEST_ASSERT_EQUAL_UINT32(2 * METRIC_BUCKET_BOUNDS + 1, h.count);
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)expectedSum, h.sum);
+    TEST_ASSERT_EQUAL_UINT32(bounds[METRIC_BUCKET_BOUNDS - 1] + 1, h.max);
+    TEST_ASSERT_EQUAL_UINT32(2, h.buckets[0]); // 0과 bounds[0]
+    for (size_t i = 1; i < METRIC_BUCKET_BOUNDS; i++) {
+        TEST_ASSERT_EQUAL_UINT32(2, h.buckets[i]); // bounds[i - 1] + 1과 bounds[i]
+    }
+    TEST_ASSERT_EQUAL_UINT32(1, h.buckets[METRIC_BUCKET_BOUNDS]);
+    TEST_ASSERT_EQUAL_UINT32(h.count, bucketTotal(h));
+}
+
+// 읽기만 하면 값이 남고, reset 읽기는 값을 돌려준 뒤 비움 (다른 히스토그램은 그대로)
+void test_histogram_reset_only_on_request() {
+    observeMetric(MetricHistogram::uploadKBps, 30);
+    observeMetric(MetricHistogram::uploadKBps, 3000);
+    observeMetric(MetricHistogram::publishLatencyUs, 700);
+
+    TEST_ASSERT_EQUAL_UINT32(2, getMetric(MetricHistogram::uploadKBps).count);
+    HistogramSnapshot taken = getMetric(MetricHistogram::uploadKBps, true);
+    TEST_ASSERT_EQUAL_UINT32(2, taken.count);
+    TEST_ASSERT_EQUAL_UINT32(3030, taken.sum);
+    TEST_ASSERT_EQUAL_UINT32(3000, taken.max);
+
+    HistogramSnapshot cleared = getMetric(MetricHistogram::uploadKBps);
+    TEST_ASSERT_EQUAL_UINT32(0, cleared.count);
+    TEST_ASSERT_EQUAL_UINT32(0, cleared.sum);
+    TEST_ASSERT_EQUAL_UINT32(0, cleared.max);
+    TEST_ASSERT_EQUAL_UINT32(0, bucketTotal(cleared));
+    TEST_ASSERT_EQUAL_UINT32(1, getMetric(MetricHistogram::publishLatencyUs).count);
+}
+
+// 스레드 여러 개가 락 없이 동시에 기록해도 관측값이 빠지지 않음
+void test_concurrent_observations_are_not_lost() {
+    MetricHistogram histogram = MetricHistogram::loopPeriodUs;
+    uint32_t countersBefore = getMetric(MetricCounter::uploadBytes);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < STRESS_THREADS; t++) {
+        threads.emplace_back([t, histogram]() {
+            for (uint32_t i = 0; i < STRESS_OBSERVATIONS; i++) {
+                observeMetric(histogram, (i % 2000) + t);
+                incrementMetric(MetricCounter::uploadBytes, 3);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    HistogramSnapshot h = getMetric(histogram);
+    uint64_t expectedSum = 0;
+    for (int t = 0; t < STRESS_THREADS; t++) {
+        expectedSum += (uint64_t)STRESS_OBSERVATIONS / 2000 * (1999 * 2000 / 2 + 2000 * (uint64_t)t);
+    }
+    TEST_ASSERT_EQUAL_UINT32(STRESS_THREADS * STRESS_OBSERVATIONS, h.count);
+    TEST_ASSERT_EQUAL_UINT32(h.count, bucketTotal(h));
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)expectedSum, h.sum);
+    TEST_ASSERT_EQUAL_UINT32(1999 + STRESS_THREADS - 1, h.max);
+    TEST_ASSERT_EQUAL_UINT32(STRESS_THREADS * STRESS_OBSERVATIONS * 3,
+                             getMetric(MetricCounter::uploadBytes) - countersBefore);
+}
+
+// 스냅샷 히스토그램 배열은 [count,sum,max,버킷...] 순서이고 직렬화만으로는 초기화되지 않음
+void test_snapshot_json_format_keeps_histograms() {
+    observeMetric(MetricHistogram::captureWarmLatencyMs, 150);
+    static char buffer[METRICS_JSON_BUFFER_SIZE];
+    size_t length = formatMetricsJson(buffer, sizeof(buffer));
+    TEST_ASSERT_GREATER_THAN_UINT32(0, length);
+    TEST_ASSERT_EQUAL_UINT32(strlen(buffer), length);
+
+    char expected[64];
+    snprintf(expected, sizeof(expected), "{\"v\":%d,", METRICS_FORMAT_VERSION);
+    TEST_ASSERT_EQUAL_INT(0, strncmp(buffer, expected, strlen(expected)));
+    TEST_ASSERT_NOT_NULL(strstr(buffer, ",\"c\":{\"mqtt_rc\":"));
+    TEST_ASSERT_NOT_NULL(strstr(buffer, "},\"g\":{\"heap_min\":"));
+    TEST_ASSERT_NOT_NULL(strstr(buffer, "\"cap_warm_ms\":[1,150,150,0,1,0,0,0,0,0,0,0]")); // 100 < 150 <= 200
+    TEST_ASSERT_EQUAL_INT('}', buffer[length - 1]);
+    TEST_ASSERT_EQUAL_UINT32(1, getMetric(MetricHistogram::captureWarmLatencyMs).count); // 발행 실패 시 다음 주기에 다시 보냄
+    TEST_ASSERT_EQUAL_UINT32(0, formatMetricsJson(buffer, 16)); // 버퍼 부족
+    TEST_ASSERT_EQUAL_UINT32(1, getMetric(MetricHistogram::captureWarmLatencyMs).count);
+}
+
+// 발행 후 commit은 스냅샷에 담긴 만큼만 빼고, 직렬화 이후 들어온 관측값은 남김
+void test_commit_subtracts_only_published_snapshot() {
+    observeMetric(MetricHistogram::captureWarmLatencyMs, 150);
+    observeMetric(MetricHistogram::captureWarmLatencyMs, 900);
+    static char buffer[METRICS_JSON_BUFFER_SIZE];
+    TEST_ASSERT_GREATER_THAN_UINT32(0, formatMetricsJson(buffer, sizeof(buffer)));
+    observeMetric(MetricHistogram::captureWarmLatencyMs, 40); // 발행 중에 들어온 관측값
+    commitMetricsSnapshot();
+
+    HistogramSnapshot h = getMetric(MetricHistogram::captureWarmLatencyMs);
+    TEST_ASSERT_EQUAL_UINT32(1, h.count);
+    TEST_ASSERT_EQUAL_UINT32(40, h.sum);
+    TEST_ASSERT_TRUE(h.max >= 40);
+    TEST_ASSERT_EQUAL_UINT32(1, h.buckets[0]);
+    TEST_ASSERT_EQUAL_UINT32(h.count, bucketTotal(h));
+
+    commitMetricsSnapshot(); // 두 번 불러도 다시 빼지 않음
+    TEST_ASSERT_EQUAL_UINT32(1, getMetric(MetricHistogram::captureWarmLatencyMs).count);
+}
+
+// 카운터가 최대 자릿수이고 모든 버킷이 찬 스냅샷도 METRICS_JSON_BUFFER_SIZE 안에 들어감
+void test_snapshot_fits_buffer_at_max_width() {
+    for (size_t i = 0; i < (size_t)MetricCounter::count; i++) {
+        incrementMetric((MetricCounter)i, UINT32_MAX - getMetric((MetricCounter)i) - 1);
+    }
+    for (size_t i = 0; i < (size_t)MetricHistogram::count; i++) {
+        for (size_t b = 0; b <= METRIC_BUCKET_BOUNDS; b++) {
+            observeMetric((MetricHistogram)i, b < METRIC_BUCKET_BOUNDS ? getMetricBucketBounds((MetricHistogram)i)[b]
+                                                                       : 1000000000);
+        }
+    }
+    static char buffer[METRICS_JSON_BUFFER_SIZE];
+    size_t length = formatMetricsJson(buffer, sizeof(buffer));
+
+    char text[96];
+    snprintf(text, sizeof(text), "카운터 최대 자릿수 스냅샷 %u / %u bytes", (unsigned)length, (unsigned)METRICS_JSON_BUFFER_SIZE);
+    TEST_MESSAGE(text);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, length);
+}
+
+template <typename Fn>
+static double measureNsPerCall(int threads, Fn fn) {
+    std::atomic<int> ready(0);
+    std::vector<std::thread> workers;
+    int64_t startUs = esp_timer_get_time();
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&fn, &ready, threads]() {
+            ready++;
+            while (ready < threads) {
+            }
+            for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+                fn(i);
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    return (esp_timer_get_time() - startUs) * 1000.0 / BENCH_ITERATIONS;
+}
+
+// 핫 경로(loop, 발행)에서 부르는 갱신 1회 비용 (스레드 여러 개면 같은 캐시 라인 경합 포함)
+void test_update_cost_benchmark() {
+    double observeNs = measureNsPerCall(1, [](uint32_t i) {
+        observeMetric(MetricHistogram::loopPeriodUs, i & 0xFFFFF);
+    });
+    double incrementNs = measureNsPerCall(1, [](uint32_t i) {
+        incrementMetric(MetricCounter::capturesOk);
+    });
+    double contendedNs = measureNsPerCall(STRESS_THREADS, [](uint32_t i) {
+        observeMetric(MetricHistogram::loopPeriodUs, i & 0xFFFFF);
+    });
+
+    char text[160];
+    snprintf(text, sizeof(text), "1회 비용 (호스트): observeMetric %.1f ns, incrementMetric %.1f ns, 스레드 %d개 동시 observeMetric %.1f ns",
+             observeNs, incrementNs, STRESS_THREADS, contendedNs);
+    TEST_MESSAGE(text);
+
+    HistogramSnapshot h = getMetric(MetricHistogram::loopPeriodUs);
+    TEST_ASSERT_EQUAL_UINT32(h.count, bucketTotal(h));
+    TEST_ASSERT_TRUE(observeNs < 1000.0); // 락/할당이 없으므로 장치에서도 수 us 이내
+}
+
+int main(int argc, char** argv) {
+    hostInit(argc, argv);
+    UNITY_BEGIN();
+    RUN_TEST(test_histogram_bucket_boundaries);
+    RUN_TEST(test_histogram_reset_only_on_request);
+    RUN_TEST(test_concurrent_observations_are_not_lost);
+    RUN_TEST(test_snapshot_json_format_keeps_histograms);
+    RUN_TEST(test_commit_subtracts_only_published_snapshot);
+    RUN_TEST(test_snapshot_fits_buffer_at_max_width);
+    RUN_TEST(test_update_cost_benchmark);
+    return UNITY_END();
+}
@@ -0,0 +1,162 @@
+// 재연결 정책 단위 테스트와 장애 복구 시뮬레이션 (pio test -e native)
+// 시뮬레이션은 가상 시각으로 장치 수천 대가 브로커 장애에서 복구되는 과정을 돌려
+// 고정 주기 재시도 대비 초당 최대 연결 시도 수를 비교하고 최악 복구 시간 상한을 확인합니다.
+
+#include <unity.h>
+#include <algorithm>
+#include <vector>
+#include "config.h"
+#include "reconnect_policy.h"
+#include "logger.h"
+#include "host_runtime.h"
+
+static const uint32_t SIM_DEVICES = 5000;
+static const unsigned long SIM_POLL_MS = 100;       // 펌웨어 mqtt 잡 주기
+static const unsigned long SIM_OUTAGE_MS = 120000;  // 브로커 장애 시간
+static const unsigned long SIM_DURATION_MS = 1800000;
+static const uint32_t FIXED_RETRY_MS = 5000;         // 기존 고정 주기 재시도
+
+void setUp() {}
+void tearDown() {}
+
+struct RecoveryResult {
+    uint32_t peakAttemptsPerSecond; // 장애 해제 이후 초당 최대 연결 시도 수
+    uint64_t outageAttempts;        // 장애 중 시도 수 (모두 실패)
+    unsigned long allConnectedMs;   // 장애 해제 후 전체 장치가 연결되기까지 (ms)
+};
+
+// 모든 장치가 0초에 함께 끊기고 SIM_OUTAGE_MS 동안 연결 시도가 즉시 실패하는 장애
+// useFixedInterval이면 기존 동작(끊긴 뒤 FIXED_RETRY_MS마다 재시도)을 흉내냄
+static RecoveryResult simulateRecovery(bool useFixedInterval) {
+    std::vector<ReconnectPolicy> policies(SIM_DEVICES,
+                                          ReconnectPolicy(MQTT_RECONNECT_BASE_MS, MQTT_RECONNECT_MAX_MS,
+                                                          MQTT_RECONNECT_FAILURE_THRESHOLD, MQTT_RECONNECT_OPEN_MS));
+    std::vector<unsigned long> fixedNextMs(SIM_DEVICES, FIXED_RETRY_MS);
+    std::vector<bool> connected(SIM_DEVICES, false);
+    std::vector<uint32_t> attemptsPerSecond(SIM_DURATION_MS / 1000, 0);
+    for (ReconnectPolicy& policy : policies) {
+        policy.onDisconnected(0);
+    }
+
+    RecoveryResult result = {0, 0, 0};
+    uint32_t connectedCount = 0;
+    for (unsigned long now = 0; now < SIM_DURATION_MS && connectedCount < SIM_DEVICES; now += SIM_POLL_MS) {
+        bool brokerUp = now >= SIM_OUTAGE_MS;
+        for (uint32_t i = 0; i < SIM_DEVICES; i++) {
+            if (connected[i]) {
+                continue;
+            }
+            if (useFixedInterval) {
+                if (now < fixedNextMs[i]) {
+                    continue;
+                }
+                fixedNextMs[i] = now + FIXED_RETRY_MS;
+            } else {
+                if (!policies[i].ready(now)) {
+                    continue;
+                }
+                policies[i].onAttempt();
+            }
+            attemptsPerSecond[now / 1000]++;
+            if (!brokerUp) {
+                result.outageAttempts++;
+                policies[i].onFailed(now);
+                continue;
+            }
+            policies[i].onConnected();
+            connected[i] = true;
+            connectedCount++;
+            result.allConnectedMs = now - SIM_OUTAGE_MS;
+        }
+    }
+    for (size_t second = SIM_OUTAGE_MS / 1000; second < attemptsPerSecond.size(); second++) {
+        result.peakAttemptsPerSecond = std::max(result.peakAttemptsPerSecond, attemptsPerSecond[second]);
+    }
+    TEST_ASSERT_EQUAL_UINT32(SIM_DEVICES, connectedCount);
+    return result;
+}
+
+// 시도 결과가 나오기 전에는 실패로 세지 않고 다시 시작하지도 않음
+void test_attempt_counts_failure_only_on_outcome() {
+    ReconnectPolicy policy(1000, 8000, 3, 60000);
+    TEST_ASSERT_TRUE(policy.ready(0));
+    policy.onAttempt();
+    TEST_ASSERT_TRUE(policy.attemptInFlight());
+    TEST_ASSERT_EQUAL_UINT8(0, policy.consecutiveFailures());
+    TEST_ASSERT_FALSE(policy.ready(100000)); // 진행 중인 시도는 시간이 지나도 다시 시작하지 않음
+
+    policy.onFailed(100000);
+    TEST_ASSERT_FALSE(policy.attemptInFlight());
+    TEST_ASSERT_EQUAL_UINT8(1, policy.consecutiveFailures());
+    uint32_t delayMs = policy.currentDelayMs();
+    TEST_ASSERT_TRUE(delayMs >= 1000 && delayMs <= 8000);
+    TEST_ASSERT_FALSE(policy.ready(100000 + delayMs - 1)); // 백오프는 실패 시각부터
+    TEST_ASSERT_TRUE(policy.ready(100000 + delayMs));
+
+    policy.onAttempt();
+    policy.onConnected();
+    TEST_ASSERT_EQUAL_UINT8(0, policy.consecutiveFailures());
+    TEST_ASSERT_EQUAL(ReconnectState::closed, policy.state());
+}
+
+// 연속 실패가 임계값에 도달하면 서킷이 열리고, half-open 시험 결과에 따라 다시 열리거나 닫힘
+void test_circuit_breaker_transitions_on_failures() {
+    ReconnectPolicy policy(1000, 8000, 3, 60000);
+    unsigned long now = 0;
+    for (int i = 0; i < 3; i++) {
+        while (!policy.ready(now)) {
+            now += 100;
+        }
+        TEST_ASSERT_EQUAL(ReconnectState::closed, policy.state());
+        policy.onAttempt();
+        policy.onFailed(now);
+    }
+    TEST_ASSERT_EQUAL(ReconnectState::open, policy.state());
+    TEST_ASSERT_FALSE(policy.ready(now + 3999)); // 열린 시간은 min(openDurationMs, maxDelayMs)의 1/2 ~ 1배
+    TEST_ASSERT_TRUE(policy.ready(now + 8000));
+    TEST_ASSERT_EQUAL(ReconnectState::halfOpen, policy.state());
+
+    now += 8000;
+    policy.onAttempt();
+    policy.onFailed(now);
+    TEST_ASSERT_EQUAL(ReconnectState::open, policy.state());
+
+    TEST_ASSERT_TRUE(policy.ready(now + 8000));
+    policy.onAttempt();
+    policy.onConnected();
+    TEST_ASSERT_EQUAL(ReconnectState::closed, policy.state());
+    TEST_ASSERT_EQUAL_UINT8(0, policy.consecutiveFailures());
+}
+
+// 장치 수천 대가 장애에서 복구될 때 초당 최대 연결 시도 수 (고정 주기 대비)
+void test_fleet_recovery_peak_connect_rate() {
+    RecoveryResult fixed = simulateRecovery(true);
+    RecoveryResult jittered = simulateRecovery(false);
+
+    char message[192];
+    snprintf(message, sizeof(message),
+             "장치 %u대, 장애 %lu초: 초당 최대 시도 고정 %u / 정책 %u, 장애 중 시도 고정 %llu / 정책 %llu, "
+             "전체 복구 고정 %.1f초 / 정책 %.1f초",
+             (unsigned)SIM_DEVICES, SIM_OUTAGE_MS / 1000, (unsigned)fixed.peakAttemptsPerSecond,
+             (unsigned)jittered.peakAttemptsPerSecond, (unsigned long long)fixed.outageAttempts,
+             (unsigned long long)jittered.outageAttempts, fixed.allConnectedMs / 1000.0,
+             jittered.allConnectedMs / 1000.0);
+    TEST_MESSAGE(message);
+
+    // 고정 주기는 모든 장치가 같은 순간에 재시도하고, 정책은 지터로 흩어 최대 시도율을 크게 낮춤
+    TEST_ASSERT_EQUAL_UINT32(SIM_DEVICES, fixed.peakAttemptsPerSecond);
+    TEST_ASSERT_LESS_THAN_UINT32(SIM_DEVICES / 10, jittered.peakAttemptsPerSecond);
+    TEST_ASSERT_LESS_THAN(fixed.outageAttempts, jittered.outageAttempts);
+    // 서킷이 열려 있던 장치도 장애 해제 후 백오프 상한 안에 다시 시도하므로 전체 복구가 그 안에 끝남
+    TEST_ASSERT_TRUE(jittered.allConnectedMs <= MQTT_RECONNECT_MAX_MS + SIM_POLL_MS);
+}
+
+int main(int argc, char** argv) {
+    hostInit(argc, argv);
+    setLogLevel(LogModule::system, LogLevel::error); // 서킷 상태 로그 생략
+    UNITY_BEGIN();
+    RUN_TEST(test_attempt_counts_failure_only_on_outcome);
+    RUN_TEST(test_circuit_breaker_transitions_on_failures);
+    RUN_TEST(test_fleet_recovery_peak_connect_rate);
+    return UNITY_END();
+}
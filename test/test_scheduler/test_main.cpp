@@ -0,0 +1,158 @@
+// 협력형 스케줄러 단위 테스트 (pio test -e native)
+// setSchedulerClock()으로 가상 시계를 넣어 작업 실행 시간과 대기 시간을 결정적으로 흘려보내고
+// 주기/지터/예산 초과/건너뜀과 유휴율 집계를 확인합니다. 마지막 테스트만 기본 시계(vTaskDelay)를 씁니다.
+
+#include <unity.h>
+#include <esp_timer.h>
+#include "config.h"
+#include "scheduler.h"
+#include "logger.h"
+#include "host_runtime.h"
+
+static uint64_t virtualUs = 0;
+static bool sleepSpins = false;   // true면 1 tick 미만 대기를 CPU 양보 없이 돌아온 것으로 흉내
+
+static uint64_t virtualNowUs() {
+    return virtualUs;
+}
+
+static bool virtualSleepUs(uint32_t us) {
+    virtualUs += us;
+    return !(sleepSpins && us < 1000);
+}
+
+static const SchedulerClock VIRTUAL_CLOCK = {virtualNowUs, virtualSleepUs};
+
+// 작업 함수는 가상 시계를 정해진 실행 시간만큼 진행시킴
+static uint32_t fastJobCostUs = 0;
+static uint32_t slowJobCostUs = 0;
+static uint32_t slowJobLongRun = 0;  // 이 번째 실행만 오래 걸림 (0이면 없음)
+static uint32_t slowJobRuns = 0;
+
+static void fastJob() {
+    virtualUs += fastJobCostUs;
+}
+
+static void slowJob() {
+    slowJobRuns++;
+    virtualUs += slowJobRuns == slowJobLongRun ? 25000 : slowJobCostUs;
+}
+
+static void runUntil(uint64_t endUs) {
+    while (virtualUs < endUs) {
+        runScheduler();
+    }
+}
+
+void setUp() {
+    virtualUs = 1000000;
+    sleepSpins = false;
+    fastJobCostUs = 0;
+    slowJobCostUs = 0;
+    slowJobLongRun = 0;
+    slowJobRuns = 0;
+    setSchedulerClock(&VIRTUAL_CLOCK);
+    initScheduler();
+}
+
+void tearDown() {
+    setSchedulerClock(nullptr);
+}
+
+// 겹치지 않는 두 작업은 예정 시각에 정확히 시작하고, 유휴 시간 = 구간 - 실행 시간
+void test_jobs_run_on_schedule_and_idle_matches_busy_time() {
+    fastJobCostUs = 1000;
+    slowJobCostUs = 2000;
+    SchedulerJobId fast = addSchedulerJob("fast", fastJob, 10, 1, 1500);
+    SchedulerJobId slow = addSchedulerJob("slow", slowJob, 20, 1, 2500, 5);
+    runUntil(virtualUs + 1000000);
+
+    SchedulerJobStats fastStats = getSchedulerJobStats(fast);
+    SchedulerJobStats slowStats = getSchedulerJobStats(slow);
+    SchedulerStats stats = getSchedulerStats();
+    TEST_ASSERT_EQUAL_UINT32(100, fastStats.runs);
+    TEST_ASSERT_EQUAL_UINT32(50, slowStats.runs);
+    TEST_ASSERT_EQUAL_UINT32(0, fastStats.maxLatenessUs);
+    TEST_ASSERT_EQUAL_UINT32(0, slowStats.maxLatenessUs);
+    TEST_ASSERT_EQUAL_UINT32(0, fastStats.overruns + slowStats.overruns);
+    TEST_ASSERT_EQUAL_UINT32(0, fastStats.skippedPeriods + slowStats.skippedPeriods);
+    TEST_ASSERT_EQUAL_UINT64(stats.windowUs - (100 * 1000 + 50 * 2000), stats.idleUs);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.busyWaits);
+}
+
+// 한 번 오래 걸린 작업은 예산 초과와 건너뛴 주기로, 밀린 다른 작업은 마감 초과로 집계
+void test_long_run_counts_overrun_skip_and_deadline_miss() {
+    slowJobCostUs = 500;
+    slowJobLongRun = 3;
+    SchedulerJobId slow = addSchedulerJob("slow", slowJob, 10, 2, 1000);
+    SchedulerJobId fast = addSchedulerJob("fast", fastJob, 5, 1, 1000, 1);
+    runUntil(virtualUs + 100000);
+
+    // 세 번째 실행(20 ms)이 45 ms에 끝나 30/40 ms 주기를 건너뛰고 50 ms에 위상대로 재개
+    SchedulerJobStats slowStats = getSchedulerJobStats(slow);
+    SchedulerJobStats fastStats = getSchedulerJobStats(fast);
+    TEST_ASSERT_EQUAL_UINT32(1, slowStats.overruns);
+    TEST_ASSERT_EQUAL_UINT32(2, slowStats.skippedPeriods);
+    TEST_ASSERT_EQUAL_UINT32(25000, slowStats.maxRunUs);
+    TEST_ASSERT_EQUAL_UINT32(0, slowStats.deadlineMisses);
+    TEST_ASSERT_EQUAL_UINT32(1, fastStats.deadlineMisses);
+    TEST_ASSERT_EQUAL_UINT32(24000, fastStats.maxLatenessUs); // 21 ms 예정 → 45 ms 시작
+    TEST_ASSERT_GREATER_THAN_UINT32(0, fastStats.skippedPeriods);
+}
+
+// CPU를 넘기지 못하고 돌아온 짧은 대기는 유휴가 아니라 실행 시간으로 셈
+void test_sub_tick_wait_without_yield_is_busy() {
+    fastJobCostUs = 400;
+    addSchedulerJob("fast", fastJob, 1, 1, 1000);
+    sleepSpins = true;
+    runUntil(virtualUs + 100000);
+
+    SchedulerStats stats = getSchedulerStats();
+    TEST_ASSERT_EQUAL_UINT64(0, stats.idleUs);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.wakeups);
+    TEST_ASSERT_EQUAL_UINT32(100, stats.busyWaits);
+}
+
+// 기본 시계는 1 tick 미만이 남아도 vTaskDelay로 최소 1 tick 대기하므로
+// runScheduler() 호출마다 실제 시간이 1 ms 이상 흐르고 busy-spin이 없음
+static void realJob() {
+    int64_t startUs = esp_timer_get_time();
+    while (esp_timer_get_time() - startUs < 300) {
+    }
+}
+
+void test_default_clock_waits_at_least_one_tick() {
+    setSchedulerClock(nullptr);
+    initScheduler();
+    SchedulerJobId job = addSchedulerJob("real", realJob, 1, 1, 1000);
+
+    int64_t startUs = esp_timer_get_time();
+    uint32_t calls = 0;
+    while (esp_timer_get_time() - startUs < 50000) {
+        runScheduler();
+        calls++;
+    }
+    uint32_t elapsedMs = (uint32_t)((esp_timer_get_time() - startUs) / 1000);
+    SchedulerStats stats = getSchedulerStats();
+
+    char text[128];
+    snprintf(text, sizeof(text), "%lu ms 동안 runScheduler %lu회, 작업 %lu회, 대기 %lu회, 유휴 %.1f%%",
+             (unsigned long)elapsedMs, (unsigned long)calls, (unsigned long)getSchedulerJobStats(job).runs,
+             (unsigned long)stats.wakeups, stats.idleUs * 100.0 / stats.windowUs);
+    TEST_MESSAGE(text);
+
+    TEST_ASSERT_TRUE(calls <= elapsedMs + 1);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stats.wakeups);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.busyWaits);
+}
+
+int main(int argc, char** argv) {
+    hostInit(argc, argv);
+    setLogLevel(LogModule::system, LogLevel::error);
+    UNITY_BEGIN();
+    RUN_TEST(test_jobs_run_on_schedule_and_idle_matches_busy_time);
+    RUN_TEST(test_long_run_counts_overrun_skip_and_deadline_miss);
+    RUN_TEST(test_sub_tick_wait_without_yield_is_busy);
+    RUN_TEST(test_default_clock_waits_at_least_one_tick);
+    return UNITY_END();
+}
@@ -0,0 +1,165 @@
+// 시계열 저장소 벤치마크: 기록 속도, 플래시 마모, 범위 질의 지연 (pio test -e native)
+// 파일 기반 플래시 파티션(host/src/esp_idf.cpp)에 실제 spiffs 크기의 링을 1.5바퀴 채워
+// 1분 평균 요약과 섹터 재사용까지 거친 뒤 집계합니다. (시각은 호스트 시계를 그대로 사용)
+
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <time.h>
+#include "config.h"
+#include "timeseries_store.h"
+#include "logger.h"
+#include "host_runtime.h"
+
+static const uint32_t SPIFFS_SIZE = 0x3F0000;  // partitions.csv의 spiffs 파티션
+static const uint32_t SEGMENT_RECORDS = 4096 / TS_RECORD_SIZE - 1;
+static const uint32_t RAW_SEGMENTS = SPIFFS_SIZE / 4096 - TS_ROLLUP_SEGMENTS;
+static const uint32_t BENCH_RECORDS = RAW_SEGMENTS * SEGMENT_RECORDS * 3 / 2;
+static const int QUERY_REPEAT = 200;
+static const uint32_t FLASH_ENDURANCE_CYCLES = 100000; // NOR 플래시 섹터 소거 수명
+
+static uint32_t firstTimestamp = 0;
+static uint32_t lastTimestamp = 0;
+
+void setUp() {}
+void tearDown() {}
+
+// 테스트 상태 디렉터리에 spiffs만 있는 파티션 표를 만들고 플래시를 지운 상태로 시작
+static void preparePartition() {
+    String table = hostStatePath("partitions.csv");
+    FILE* file = fopen(table.c_str(), "w");
+    TEST_ASSERT_NOT_NULL(file);
+    fprintf(file, "spiffs, data, spiffs, 0x410000, 0x%lX\n", (unsigned long)SPIFFS_SIZE);
+    fclose(file);
+    setenv("HOST_PARTITIONS", table.c_str(), 1);
+    remove(hostStatePath("spiffs.bin").c_str());
+}
+
+static SensorData sample(uint32_t index) {
+    SensorData data;
+    data.proximity = (uint16_t)(index % 500);
+    data.ambientLight = (float)(index % 1000) / 10.0f;
+    data.accelX = 0.01f;
+    data.accelY = -0.02f;
+    data.accelZ = 1.0f;
+    data.gyroX = 0.5f;
+    data.gyroY = -0.5f;
+    data.gyroZ = 0.0f;
+    return data;
+}
+
+// 링을 1.5바퀴 채우는 동안의 기록 속도와 소거 횟수
+void test_append_rate_and_wear() {
+    HostFlashStats flashBefore = hostFlashStats();
+    firstTimestamp = (uint32_t)time(nullptr);
+    int64_t startUs = esp_timer_get_time();
+    for (uint32_t i = 0; i < BENCH_RECORDS; i++) {
+        // 기록 태스크가 밀리면 큐가 비워질 때까지 양보 (장치에서는 1초에 1건이라 밀리지 않음)
+        while (!appendTimeSeriesSample(sample(i))) {
+            vTaskDelay(1);
+        }
+    }
+    // 큐에 남은 레코드가 모두 기록될 때까지 대기 (기록 실패 시 단언에서 드러나도록 시간 제한)
+    while (getTimeSeriesStats().appended < BENCH_RECORDS && esp_timer_get_time() - startUs < 60000000) {
+        vTaskDelay(1);
+    }
+    int64_t elapsedUs = esp_timer_get_time() - startUs;
+    lastTimestamp = (uint32_t)time(nullptr);
+
+    TimeSeriesStats stats = getTimeSeriesStats();
+    HostFlashStats flash = hostFlashStats();
+    uint32_t erases = flash.sectorErases - flashBefore.sectorErases;
+    uint64_t bytesWritten = flash.bytesWritten - flashBefore.bytesWritten;
+
+    // 장치 기록 주기(TS_LOG_INTERVAL_MS)로 환산한 섹터당 하루 소거 횟수와 수명
+    double recordsPerDay = 86400000.0 / TS_LOG_INTERVAL_MS;
+    double rawErasesPerSectorDay = recordsPerDay / SEGMENT_RECORDS / RAW_SEGMENTS;
+    double rollupErasesPerSectorDay = recordsPerDay / 60 / SEGMENT_RECORDS / TS_ROLLUP_SEGMENTS;
+    double lifetimeYears = FLASH_ENDURANCE_CYCLES / max(rawErasesPerSectorDay, rollupErasesPerSectorDay) / 365;
+
+    char text[256];
+    snprintf(text, sizeof(text),
+             "기록 %lu건: %.0f건/s (호스트), 레코드당 쓰기 %.2f회/%.1f B, 섹터 소거 %lu (섹터당 최대 %lu), 1분 평균 %lu건",
+             (unsigned long)stats.appended, stats.appended * 1e6 / elapsedUs,
+             (flash.writes - flashBefore.writes) / (double)stats.appended, bytesWritten / (double)stats.appended,
+             (unsigned long)erases, (unsigned long)flash.maxSectorErases, (unsigned long)stats.rollupRecords);
+    TEST_MESSAGE(text);
+    snprintf(text, sizeof(text), "1Hz 기록 시 섹터당 하루 소거: 원본 %.2f회, 1분 평균 %.3f회 → 소거 수명 %lu회 기준 약 %.0f년",
+             rawErasesPerSectorDay, rollupErasesPerSectorDay, (unsigned long)FLASH_ENDURANCE_CYCLES, lifetimeYears);
+    TEST_MESSAGE(text);
+
+    TEST_ASSERT_EQUAL_UINT32(BENCH_RECORDS, stats.appended);
+    TEST_ASSERT_EQUAL_UINT32(RAW_SEGMENTS, stats.rawSegments);
+    TEST_ASSERT_TRUE(stats.rollupRecords > 0);
+    // 링 구조라 소거가 섹터 전체에 고르게 퍼짐 (1.5바퀴면 섹터당 최대 2회)
+    TEST_ASSERT_TRUE(flash.maxSectorErases <= 2);
+    // 레코드 하나는 슬롯 1회 쓰기, 헤더(min/봉인) 쓰기는 세그먼트당 몇 번뿐
+    TEST_ASSERT_TRUE(bytesWritten < (uint64_t)stats.appended * TS_RECORD_SIZE * 11 / 10);
+}
+
+struct QueryResult {
+    double averageUs;
+    size_t records;
+};
+
+static QueryResult timeQuery(uint32_t from, uint32_t to, bool rollup) {
+    static TsRecord results[TS_QUERY_MAX_RECORDS];
+    QueryResult result = {0, 0};
+    uint32_t nextTimestamp = 0;
+    int64_t startUs = esp_timer_get_time();
+    for (int i = 0; i < QUERY_REPEAT; i++) {
+        result.records = queryTimeSeries(from, to, rollup, results, TS_QUERY_MAX_RECORDS, &nextTimestamp);
+    }
+    result.averageUs = (esp_timer_get_time() - startUs) / (double)QUERY_REPEAT;
+
+    // 결과는 범위 안에서 오래된 순
+    for (size_t i = 0; i < result.records; i++) {
+        TEST_ASSERT_TRUE(results[i].timestamp >= from && results[i].timestamp <= to);
+        if (i > 0) {
+            TEST_ASSERT_TRUE(results[i].timestamp >= results[i - 1].timestamp);
+        }
+    }
+    return result;
+}
+
+// 세그먼트 인덱스 이분 탐색으로 범위 위치와 무관하게 필요한 세그먼트만 읽음
+void test_range_query_latency() {
+    HostFlashStats flashBefore = hostFlashStats();
+    QueryResult oldest = timeQuery(0, 0xFFFFFFFF, false);
+    QueryResult newest = timeQuery(lastTimestamp, 0xFFFFFFFF, false);
+    QueryResult future = timeQuery(lastTimestamp + 3600, 0xFFFFFFFF, false);
+    QueryResult rollup = timeQuery(firstTimestamp - firstTimestamp % 60, 0xFFFFFFFF, true); // 1분 평균은 분 시작 시각
+    HostFlashStats flash = hostFlashStats();
+
+    char text[256];
+    snprintf(text, sizeof(text),
+             "질의 %d회 평균: 가장 오래된 구간 %.1f us (%u건) / 최신 구간 %.1f us (%u건) / 범위 밖 %.1f us / 1분 평균 %.1f us (%u건), 질의당 플래시 읽기 %.1f KB",
+             QUERY_REPEAT, oldest.averageUs, (unsigned)oldest.records, newest.averageUs, (unsigned)newest.records,
+             future.averageUs, rollup.averageUs, (unsigned)rollup.records,
+             (flash.bytesRead - flashBefore.bytesRead) / 1024.0 / (QUERY_REPEAT * 4));
+    TEST_MESSAGE(text);
+
+    TEST_ASSERT_EQUAL_UINT32(TS_QUERY_MAX_RECORDS, oldest.records);
+    TEST_ASSERT_TRUE(newest.records > 0);
+    TEST_ASSERT_EQUAL_UINT32(0, future.records);
+    TEST_ASSERT_TRUE(rollup.records > 0);
+}
+
+int main(int argc, char** argv) {
+    setenv("HOST_STATE_DIR", ".host_state_test", 0); // 개발용 상태 디렉터리와 분리
+    hostInit(argc, argv);
+    setLogLevel(LogModule::storage, LogLevel::warn);
+    preparePartition();
+    if (!initTimeSeriesStore()) {
+        printf("시계열 저장소를 열 수 없음\n");
+        return 1;
+    }
+
+    UNITY_BEGIN();
+    RUN_TEST(test_append_rate_and_wear);
+    RUN_TEST(test_range_query_latency);
+    return UNITY_END();
+}
@@ -0,0 +1,102 @@
+// 업링크 조절 대기열 단위 테스트 (pio test -e native)
+// 발행 함수를 가짜로 바꿔 실패/연결 끊김을 흉내 내고, 대기 메시지가 버려지지 않고 순서대로 다시 나가는지
+// 그리고 성공한 발행만 건수/대기 시간으로 집계되는지 확인합니다.
+
+#include <unity.h>
+#include <string>
+#include <vector>
+#include "globals.h"
+#include "metrics.h"
+#include "uplink_shaper.h"
+#include "host_runtime.h"
+
+static bool sendSucceeds = true;
+static uint32_t sendAttempts = 0;
+static std::vector<std::string> delivered;
+
+static bool fakeSend(const char* topic, const uint8_t* payload, size_t length) {
+    sendAttempts++;
+    if (!sendSucceeds) {
+        return false;
+    }
+    delivered.push_back(std::string(topic) + ":" + std::string((const char*)payload, length));
+    return true;
+}
+
+void setUp() {
+    isMqttConnected = true;
+    sendSucceeds = true;
+    sendAttempts = 0;
+    delivered.clear();
+}
+
+void tearDown() {}
+
+// 스트리밍 중에 들어온 제어 메시지 세 개를 대기열에 넣음
+static void queueThreeControlMessages() {
+    uplinkStreamBegin();
+    TEST_ASSERT_TRUE(submitUplink(UplinkClass::control, "dev/cdone", "a", 1));
+    TEST_ASSERT_TRUE(submitUplink(UplinkClass::control, "dev/cdone", "b", 1));
+    TEST_ASSERT_TRUE(submitUplink(UplinkClass::control, "dev/cfgack", "c", 1));
+    uplinkStreamEnd();
+}
+
+// 발행이 실패하면 첫 실패에서 멈추고 메시지를 남겨 두었다가 다음 비우기에서 순서대로 보냄
+void test_failed_send_keeps_message_queued() {
+    UplinkClassStats before = getUplinkStats(UplinkClass::control);
+    uint32_t delaysBefore = getMetric(MetricHistogram::uplinkControlDelayMs).count;
+    queueThreeControlMessages();
+
+    sendSucceeds = false;
+    serviceUplink();
+    TEST_ASSERT_EQUAL_UINT32(1, sendAttempts); // 실패 뒤 같은 비우기에서 다시 시도하지 않음
+    UplinkClassStats failed = getUplinkStats(UplinkClass::control);
+    TEST_ASSERT_EQUAL_UINT32(before.sent, failed.sent);
+    TEST_ASSERT_EQUAL_UINT32(before.failed + 1, failed.failed);
+    TEST_ASSERT_EQUAL_UINT32(delaysBefore, getMetric(MetricHistogram::uplinkControlDelayMs).count);
+
+    sendSucceeds = true;
+    serviceUplink();
+    TEST_ASSERT_EQUAL_UINT32(3, delivered.size());
+    TEST_ASSERT_EQUAL_STRING("dev/cdone:a", delivered[0].c_str());
+    TEST_ASSERT_EQUAL_STRING("dev/cdone:b", delivered[1].c_str());
+    TEST_ASSERT_EQUAL_STRING("dev/cfgack:c", delivered[2].c_str());
+    TEST_ASSERT_EQUAL_UINT32(before.sent + 3, getUplinkStats(UplinkClass::control).sent);
+    TEST_ASSERT_EQUAL_UINT32(delaysBefore + 3, getMetric(MetricHistogram::uplinkControlDelayMs).count);
+}
+
+// 연결이 끊긴 동안에는 발행을 시도하지 않고, 재연결 후 남은 메시지를 모두 보냄
+void test_no_flush_while_disconnected() {
+    queueThreeControlMessages();
+
+    isMqttConnected = false;
+    serviceUplink();
+    serviceUplink();
+    TEST_ASSERT_EQUAL_UINT32(0, sendAttempts);
+
+    isMqttConnected = true;
+    serviceUplink();
+    TEST_ASSERT_EQUAL_UINT32(3, sendAttempts);
+    TEST_ASSERT_EQUAL_UINT32(3, delivered.size());
+}
+
+// 대기열을 거치지 않고 바로 보내다 실패하면 false를 돌려주고 보낸 건수에 넣지 않음
+void test_direct_send_failure_is_reported() {
+    UplinkClassStats before = getUplinkStats(UplinkClass::telemetry);
+    sendSucceeds = false;
+    TEST_ASSERT_FALSE(submitUplink(UplinkClass::telemetry, "dev/sensor", "{}", 2));
+    UplinkClassStats after = getUplinkStats(UplinkClass::telemetry);
+    TEST_ASSERT_EQUAL_UINT32(before.sent, after.sent);
+    TEST_ASSERT_EQUAL_UINT32(before.failed + 1, after.failed);
+    TEST_ASSERT_EQUAL_UINT32(before.queued, after.queued);
+}
+
+int main(int argc, char** argv) {
+    hostInit(argc, argv);
+    initUplinkShaper(fakeSend);
+    UNITY_BEGIN();
+    RUN_TEST(test_failed_send_keeps_message_queued);
+    RUN_TEST(test_no_flush_while_disconnected);
+    RUN_TEST(test_direct_send_failure_is_reported);
+    return UNITY_END();
+}
@@ -0,0 +1,67 @@
+#!/usr/bin/env python3
+"""호스트(native) 빌드용 S3 업로드 대체 서버입니다.
+
+펌웨어의 HTTP PUT 업로드를 받아 파일로 저장하고 200 OK를 돌려줍니다.
+호스트 빌드는 443 포트 연결을 기본으로 127.0.0.1:8080으로 보내므로
+(HOST_REDIRECT_443으로 변경 가능) 인증서 없이 업로드 경로 전체를 시험할 수 있습니다.
+
+사용법:
+    python tools/host_upload_server.py                      (8080 포트, ./uploads에 저장)
+    python tools/host_upload_server.py --port 9000 --dir /tmp/frames
+    python tools/host_upload_server.py --status 503         (업로드 실패 응답 시험)
+    python tools/host_upload_server.py --delay 2.5          (느린 서버 응답 시험)
+"""
+
+import argparse
+import os
+import time
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+
+def make_handler(directory, status, delay):
+    class UploadHandler(BaseHTTPRequestHandler):
+        protocol_version = "HTTP/1.1"
+
+        def do_PUT(self):
+            length = int(self.headers.get("Content-Length", "0"))
+            started = time.monotonic()
+            body = self.rfile.read(length)
+            elapsed = time.monotonic() - started
+
+            name = os.path.basename(self.path.split("?", 1)[0]) or "upload.bin"
+            path = os.path.join(directory, name)
+            with open(path, "wb") as file:
+                file.write(body)
+
+            if delay > 0:
+                time.sleep(delay)
+            self.send_response(status)
+            self.send_header("Content-Length", "0")
+            self.send_header("Connection", "close")
+            self.end_headers()
+
+            kbps = len(body) / 1024 / elapsed if elapsed > 0 else 0
+            self.log_message("%s 저장 (%d bytes, 수신 %.1f KB/s) → %d", path, len(body), kbps, status)
+
+    return UploadHandler
+
+
+def main():
+    parser = argparse.ArgumentParser(description="호스트 빌드용 HTTP PUT 업로드 서버")
+    parser.add_argument("--port", type=int, default=8080)
+    parser.add_argument("--dir", default="uploads", help="업로드 파일 저장 디렉터리")
+    parser.add_argument("--status", type=int, default=200, help="응답 상태 코드")
+    parser.add_argument("--delay", type=float, default=0.0, help="응답 전 대기 시간(초)")
+    args = parser.parse_args()
+
+    os.makedirs(args.dir, exist_ok=True)
+    server = ThreadingHTTPServer(("127.0.0.1", args.port), make_handler(args.dir, args.status, args.delay))
+    print(f"업로드 대기: http://127.0.0.1:{args.port}/ → {args.dir}/")
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,125 @@
+#!/usr/bin/env python3
+"""호스트(native) 빌드용 업로드 URL 발급기입니다.
+
+MQTT 브로커에 접속해 "+/urlreq" 요청({"n":K})을 받으면 "{deviceUid}/urls"로
+presigned URL 대신 호스트 업로드 서버(tools/host_upload_server.py)로 가는 URL을 K개 보냅니다.
+호스트 빌드는 443 포트 연결을 업로드 서버로 보내므로 호스트 이름은 아무 값이나 됩니다.
+응답 패킷이 장치의 MQTT 수신 버퍼(MQTT_BUFFER_SIZE)를 넘으면 장치가 버리므로 들어가는 만큼만 보냅니다.
+
+사용법:
+    python tools/host_url_vendor.py                         (localhost:1883, 유효 3600초)
+    python tools/host_url_vendor.py --ttl 400 --delay 0.3   (짧은 유효 시간, 느린 발급 시험)
+    python tools/host_url_vendor.py --exp                   ("ttl" 대신 "exp"(epoch 초)로 발급)
+    python tools/host_url_vendor.py --token-bytes 900       (보안 토큰이 붙은 실제 presigned URL 길이 흉내)
+"""
+
+import argparse
+import json
+import socket
+import struct
+import time
+import uuid
+
+
+def encode_length(length):
+    out = bytearray()
+    while True:
+        digit, length = length % 128, length // 128
+        out.append(digit | (0x80 if length else 0))
+        if not length:
+            return bytes(out)
+
+
+def encode_string(text):
+    data = text.encode()
+    return struct.pack("!H", len(data)) + data
+
+
+def packet(kind, body):
+    return bytes([kind]) + encode_length(len(body)) + body
+
+
+def read_packet(sock):
+    header = sock.recv(1)
+    if not header:
+        raise ConnectionError("브로커 연결 종료")
+    length, shift = 0, 0
+    while True:
+        digit = sock.recv(1)[0]
+        length |= (digit & 0x7F) << shift
+        shift += 7
+        if not digit & 0x80:
+            break
+    body = b""
+    while len(body) < length:
+        chunk = sock.recv(length - len(body))
+        if not chunk:
+            raise ConnectionError("브로커 연결 종료")
+        body += chunk
+    return header[0], body
+
+
+def make_urls(args, count):
+    urls = []
+    for _ in range(count):
+        entry = {"url": "https://{}/img/{}.jpg".format(args.upload_host, uuid.uuid4().hex)}
+        if args.token_bytes > 0:
+            entry["url"] += "?X-Amz-Security-Token=" + "A" * args.token_bytes
+        if args.exp:
+            entry["exp"] = int(time.time()) + args.ttl
+        else:
+            entry["ttl"] = args.ttl
+        urls.append(entry)
+    return urls
+
+
+def publish_packet(topic, urls):
+    return packet(0x30, encode_string(topic) + json.dumps({"urls": urls}).encode())
+
+
+def main():
+    parser = argparse.ArgumentParser(description="호스트 빌드용 업로드 URL 발급기")
+    parser.add_argument("--broker", default="127.0.0.1", help="MQTT 브로커 주소")
+    parser.add_argument("--port", type=int, default=1883, help="MQTT 브로커 포트")
+    parser.add_argument("--upload-host", default="uploads.local", help="URL의 호스트 이름")
+    parser.add_argument("--ttl", type=int, default=3600, help="URL 유효 시간 (초)")
+    parser.add_argument("--exp", action="store_true", help="ttl 대신 만료 시각(epoch 초)으로 발급")
+    parser.add_argument("--delay", type=float, default=0.0, help="응답 전 대기 (초, 클라우드 발급 지연 흉내)")
+    parser.add_argument("--token-bytes", type=int, default=0, help="URL에 붙일 보안 토큰 길이 (바이트)")
+    parser.add_argument("--max-packet", type=int, default=2048, help="장치 MQTT 수신 버퍼 크기 (MQTT_BUFFER_SIZE)")
+    args = parser.parse_args()
+
+    sock = socket.create_connection((args.broker, args.port))
+    client_id = "url-vendor-" + uuid.uuid4().hex[:8]
+    sock.sendall(packet(0x10, encode_string("MQTT") + bytes([4, 0x02]) + struct.pack("!H", 0) +
+                        encode_string(client_id)))
+    read_packet(sock)  # CONNACK
+    sock.sendall(packet(0x82, struct.pack("!H", 1) + encode_string("+/urlreq") + bytes([0])))
+    print("URL 발급 대기: +/urlreq")
+
+    while True:
+        kind, body = read_packet(sock)
+        if kind >> 4 != 3:
+            continue
+        topic_length = struct.unpack("!H", body[:2])[0]
+        topic = body[2:2 + topic_length].decode()
+        offset = 2 + topic_length + (2 if (kind >> 1) & 0x03 else 0)
+        try:
+            count = int(json.loads(body[offset:] or b"{}").get("n", 1))
+        except (ValueError, AttributeError):
+            count = 1
+        device = topic.rsplit("/", 1)[0]
+        if args.delay > 0:
+            time.sleep(args.delay)
+        urls = make_urls(args, max(1, min(count, 8)))
+        while len(urls) > 1 and len(publish_packet(device + "/urls", urls)) > args.max_packet:
+            urls.pop()
+        data = publish_packet(device + "/urls", urls)
+        if len(data) > args.max_packet:
+            print("{} → URL 1개 응답도 {}바이트로 수신 버퍼 초과".format(device, len(data)))
+        sock.sendall(data)
+        print("{} → {}개 요청, {}개 발급 ({}바이트)".format(device, count, len(urls), len(data)))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,183 @@
+#!/usr/bin/env python3
+"""LOG_TOKENIZED 빌드의 시리얼 출력을 사람이 읽는 로그로 복원합니다.
+
+펌웨어는 포맷 문자열 대신 그 주소와 인코딩된 인자만 전송하므로,
+같은 빌드의 firmware.elf에서 주소에 해당하는 문자열을 찾아 포맷합니다.
+토큰화 프레임이 아닌 바이트(부트 ROM, ESP-IDF 로그 등)는 그대로 출력합니다.
+
+사용법:
+    python tools/log_decode.py .pio/build/esp32-s3-devkitc-1/firmware.elf capture.bin
+    python tools/log_decode.py firmware.elf /dev/ttyUSB0 --baud 115200   (pyserial 필요)
+
+프레임 형식 (src/logger.cpp):
+    [00 1E][본문 길이][본문][본문 바이트 합 & 0xFF]
+    본문: 시각(ms) u32 | 레벨<<4 | 모듈 | 포맷 주소 u32 | 인자...
+    인자: 'i' u32, 'l' u32(하위) 'l' u32(상위), 'f' float32, 's' 길이 u8 + 바이트
+"""
+
+import argparse
+import codecs
+import re
+import struct
+import sys
+
+from elftools.elf.elffile import ELFFile  # pip install pyelftools
+
+MARKER = b"\x00\x1e"
+LEVELS = "-EWIDV"
+MODULES = ["sys", "wifi", "ble", "mqtt", "cam", "sensor", "store"]
+
+# C 변환 지정자: 플래그/폭/정밀도/길이 수식자 + 변환 문자
+SPEC = re.compile(r"%([-+ #0]*)(\d+|\*)?(?:\.(\d+|\*))?(hh|h|ll|l|z|j|t|L)?([diouxXeEfgGcsp%])")
+
+
+class FormatTable:
+    """ELF의 할당된 섹션에서 주소로 NUL 종료 문자열을 읽습니다."""
+
+    def __init__(self, path):
+        self.sections = []
+        with open(path, "rb") as f:
+            elf = ELFFile(f)
+            for section in elf.iter_sections():
+                if section["sh_addr"] and section["sh_type"] == "SHT_PROGBITS":
+                    self.sections.append((section["sh_addr"], section.data()))
+        self.cache = {}
+
+    def lookup(self, address):
+        if address in self.cache:
+            return self.cache[address]
+        for base, data in self.sections:
+            if base <= address < base + len(data):
+                end = data.index(b"\0", address - base)
+                text = data[address - base:end].decode("utf-8", "replace")
+                self.cache[address] = text
+                return text
+        return None
+
+
+def parse_args_blob(blob):
+    values = []
+    i = 0
+    while i < len(blob):
+        tag = chr(blob[i])
+        i += 1
+        if tag == "s":
+            length = blob[i]
+            values.append(blob[i + 1:i + 1 + length].decode("utf-8", "replace"))
+            i += 1 + length
+        elif tag == "f":
+            values.append(struct.unpack_from("<f", blob, i)[0])
+            i += 4
+        elif tag == "l":
+            low = struct.unpack_from("<I", blob, i)[0]
+            high = struct.unpack_from("<I", blob, i + 5)[0]
+            values.append((high << 32) | low)
+            i += 9
+        else:
+            values.append(struct.unpack_from("<I", blob, i)[0])
+            i += 4
+    return values
+
+
+def render(fmt, values):
+    """printf 지정자를 파이썬 % 포맷으로 바꿔 적용 (부호는 지정자 기준으로 해석)."""
+    out = []
+    pos = 0
+    index = 0
+    for match in SPEC.finditer(fmt):
+        out.append(fmt[pos:match.start()])
+        pos = match.end()
+        flags, width, precision, length, conv = match.groups()
+        if conv == "%":
+            out.append("%")
+            continue
+        value = values[index] if index < len(values) else "?"
+        index += 1
+        if value == "?":
+            out.append("?")
+            continue
+        if conv in "di" and isinstance(value, int):
+            bits = 64 if length in ("ll", "j") else 32
+            if value >= 1 << (bits - 1):
+                value -= 1 << bits
+        if conv == "p":
+            conv = "x"
+            flags = (flags or "") + "#"
+        if conv == "u":
+            conv = "d"
+        spec = "%" + (flags or "") + (width or "") + ("." + precision if precision else "") + conv
+        try:
+            out.append(spec % value)
+        except (TypeError, ValueError):
+            out.append(str(value))
+    out.append(fmt[pos:])
+    return "".join(out)
+
+
+def decode_stream(read, table, write):
+    # 프레임 밖의 텍스트는 청크 경계에서 UTF-8 문자가 잘릴 수 있으므로 점진 디코더 사용
+    passthrough = codecs.getincrementaldecoder("utf-8")("replace")
+    emit = lambda raw: write(passthrough.decode(raw))
+    buffer = b""
+    while True:
+        chunk = read()
+        if not chunk:
+            break
+        buffer += chunk
+        while True:
+            start = buffer.find(MARKER)
+            if start < 0:
+                # 마커 첫 바이트가 잘려 들어왔을 수 있으므로 마지막 1바이트는 남김
+                keep = 1 if buffer.endswith(b"\x00") else 0
+                emit(buffer[:len(buffer) - keep])
+                buffer = buffer[len(buffer) - keep:]
+                break
+            if start > 0:
+                emit(buffer[:start])
+                buffer = buffer[start:]
+            if len(buffer) < 3 or len(buffer) < 3 + buffer[2] + 1:
+                break
+            length = buffer[2]
+            body = buffer[3:3 + length]
+            checksum = buffer[3 + length]
+            if length < 9 or sum(body) & 0xFF != checksum:
+                emit(buffer[:1])
+                buffer = buffer[1:]
+                continue
+            buffer = buffer[3 + length + 1:]
+
+            timestamp, levelModule, address = struct.unpack_from("<IBI", body, 0)
+            level = LEVELS[levelModule >> 4] if (levelModule >> 4) < len(LEVELS) else "?"
+            module = MODULES[levelModule & 0x0F] if (levelModule & 0x0F) < len(MODULES) else "?"
+            fmt = table.lookup(address)
+            if fmt is None:
+                line = "<알 수 없는 포맷 0x%08x>" % address
+            else:
+                line = render(fmt, parse_args_blob(body[9:]))
+            write("[%d][%s][%s] %s\n" % (timestamp, level, module, line))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("elf", help="같은 빌드의 firmware.elf")
+    parser.add_argument("source", help="캡처 파일 경로 또는 시리얼 포트 (- 는 표준 입력)")
+    parser.add_argument("--baud", type=int, default=115200)
+    args = parser.parse_args()
+
+    table = FormatTable(args.elf)
+    write = lambda text: (sys.stdout.write(text), sys.stdout.flush())
+
+    if args.source == "-":
+        stream = sys.stdin.buffer
+        decode_stream(lambda: stream.read1(4096), table, write)
+    elif args.source.startswith("/dev/") or args.source.upper().startswith("COM"):
+        import serial  # pip install pyserial
+        port = serial.Serial(args.source, args.baud, timeout=None)
+        decode_stream(lambda: port.read(max(1, port.in_waiting)), table, write)
+    else:
+        with open(args.source, "rb") as f:
+            decode_stream(lambda: f.read(4096), table, write)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,165 @@
+#!/usr/bin/env python3
+"""MQTT 이미지 전송(upload_transport=1)의 수신 측입니다.
+
+"+/img" 청크를 받아 전송 ID별로 재조립하고 "{deviceUid}/imgack"로 누적 ACK를 보냅니다.
+순서가 맞지 않는 청크는 버리고 다음에 받을 순번을 다시 알려 장치가 그 위치부터 재전송하게 합니다.
+재연결 후 같은 전송 ID의 청크가 다시 오면 받은 위치부터 이어서 조립합니다.
+(브로커 연결이 끊기면 조립 중인 상태를 유지한 채 다시 접속하므로 장치/브로커 재시작 중에도 이어 받기 가능)
+완료된 이미지는 --dir에 저장하고 전송 시간과 처리량을 출력합니다.
+
+청크: 헤더 16 bytes (little-endian) + 이미지 데이터
+  [0] 버전 1  [1] 플래그(bit0: 마지막)  [2..3] 순번  [4..7] 전송 ID  [8..11] 오프셋  [12..15] 전체 크기
+ACK: [0..3] 전송 ID  [4..5] 다음에 받을 순번  [6] 상태(0: 정상, 1: 중단)  [7] 예약
+
+사용법:
+    python tools/mqtt_image_receiver.py --dir /tmp/frames
+    python tools/mqtt_image_receiver.py --drop-permille 20      (청크 유실 시험: go-back-N 재전송 확인)
+"""
+
+import argparse
+import os
+import random
+import socket
+import struct
+import time
+import uuid
+
+HEADER = struct.Struct("<BBHIII")
+ACK = struct.Struct("<IHBB")
+
+
+def encode_length(length):
+    out = bytearray()
+    while True:
+        digit, length = length % 128, length // 128
+        out.append(digit | (0x80 if length else 0))
+        if not length:
+            return bytes(out)
+
+
+def encode_string(text):
+    data = text.encode()
+    return struct.pack("!H", len(data)) + data
+
+
+def packet(kind, body):
+    return bytes([kind]) + encode_length(len(body)) + body
+
+
+class Reader:
+    def __init__(self, sock):
+        self.sock = sock
+        self.buffer = bytearray()
+
+    def take(self, count):
+        while len(self.buffer) < count:
+            chunk = self.sock.recv(65536)
+            if not chunk:
+                raise ConnectionError("브로커 연결 종료")
+            self.buffer += chunk
+        data = bytes(self.buffer[:count])
+        del self.buffer[:count]
+        return data
+
+    def packet(self):
+        kind = self.take(1)[0]
+        length, shift = 0, 0
+        while True:
+            digit = self.take(1)[0]
+            length |= (digit & 0x7F) << shift
+            shift += 7
+            if not digit & 0x80:
+                break
+        return kind, self.take(length)
+
+
+class Transfer:
+    def __init__(self, total):
+        self.data = bytearray(total)
+        self.next_seq = 0
+        self.received = 0
+        self.started = time.monotonic()
+        self.duplicates = 0
+        self.out_of_order = 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description="MQTT 이미지 전송 수신 측")
+    parser.add_argument("--broker", default="127.0.0.1", help="MQTT 브로커 주소")
+    parser.add_argument("--port", type=int, default=1883, help="MQTT 브로커 포트")
+    parser.add_argument("--dir", default="mqtt_images", help="완료된 이미지를 저장할 디렉터리")
+    parser.add_argument("--drop-permille", type=int, default=0, help="받은 청크를 버릴 확률 (‰, 유실 시험)")
+    args = parser.parse_args()
+    os.makedirs(args.dir, exist_ok=True)
+
+    transfers = {}
+    completed = {}  # 완료 후 늦게 도착한 중복 청크에도 완료 순번으로 ACK
+    while True:
+        try:
+            receive(args, transfers, completed)
+        except OSError as error:
+            print("브로커 연결 끊김 ({}), 1초 후 재접속 (조립 중 {}건 유지)".format(error, len(transfers)))
+            time.sleep(1)
+
+
+def receive(args, transfers, completed):
+    sock = socket.create_connection((args.broker, args.port))
+    sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+    reader = Reader(sock)
+    sock.sendall(packet(0x10, encode_string("MQTT") + bytes([4, 0x02]) + struct.pack("!H", 0) +
+                        encode_string("img-receiver-" + uuid.uuid4().hex[:8])))
+    reader.packet()  # CONNACK
+    sock.sendall(packet(0x82, struct.pack("!H", 1) + encode_string("+/img") + bytes([0])))
+    print("이미지 청크 대기: +/img")
+
+    while True:
+        kind, body = reader.packet()
+        if kind >> 4 != 3:
+            continue
+        topic_length = struct.unpack("!H", body[:2])[0]
+        topic = body[2:2 + topic_length].decode()
+        offset = 2 + topic_length + (2 if (kind >> 1) & 0x03 else 0)
+        chunk = body[offset:]
+        if len(chunk) < HEADER.size:
+            continue
+        version, flags, seq, transfer_id, data_offset, total = HEADER.unpack_from(chunk)
+        if version != 1:
+            continue
+        device = topic.rsplit("/", 1)[0]
+        if args.drop_permille and random.randrange(1000) < args.drop_permille:
+            continue
+
+        key = (device, transfer_id)
+        if key in completed:
+            sock.sendall(packet(0x30, encode_string(device + "/imgack") +
+                                ACK.pack(transfer_id, completed[key], 0, 0)))
+            continue
+        transfer = transfers.get(key)
+        if transfer is None:
+            transfer = transfers[key] = Transfer(total)
+        data = chunk[HEADER.size:]
+        if seq == transfer.next_seq and data_offset + len(data) <= total:
+            transfer.data[data_offset:data_offset + len(data)] = data
+            transfer.received += len(data)
+            transfer.next_seq += 1
+        elif seq < transfer.next_seq:
+            transfer.duplicates += 1
+        else:
+            transfer.out_of_order += 1
+        sock.sendall(packet(0x30, encode_string(device + "/imgack") +
+                            ACK.pack(transfer_id, transfer.next_seq, 0, 0)))
+
+        if flags & 0x01 and seq + 1 == transfer.next_seq:
+            elapsed = time.monotonic() - transfer.started
+            path = os.path.join(args.dir, "{}_{:08x}.jpg".format(device, transfer_id))
+            with open(path, "wb") as file:
+                file.write(transfer.data)
+            print("{} {:08x}: {} bytes, {:.0f} ms, {:.0f} KB/s (중복 {}, 순서 어긋남 {})".format(
+                device, transfer_id, total, elapsed * 1000, total / 1024 / max(elapsed, 1e-6),
+                transfer.duplicates, transfer.out_of_order))
+            completed[key] = transfer.next_seq
+            del transfers[key]
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,102 @@
+#!/usr/bin/env python3
+"""촬영 추적("{deviceId}/trace")을 Chrome Trace Event 형식으로 변환합니다.
+
+결과 파일은 Perfetto(ui.perfetto.dev), chrome://tracing, speedscope에서
+플레임 차트로 열 수 있습니다. 장치별로 프로세스, 추적 ID별로 스레드 한 줄이
+만들어지며, 각 추적은 가장 이른 구간을 0으로 맞춰 나란히 비교할 수 있습니다.
+
+사용법:
+    mosquitto_sub -h <broker> -v -t '+/trace' | tee traces.txt
+    python tools/trace_to_chrome.py traces.txt -o capture_trace.json
+    python tools/trace_to_chrome.py traces.txt --summary      (단계별 p50/p95만 출력)
+
+입력 한 줄 형식 (mosquitto_sub -v 출력 또는 JSON만 있는 줄):
+    <deviceId>/trace {"id":"a1","t0":12345678,"spans":[["capture",-1,210,1532000],...]}
+    구간: [이름, 부모 인덱스(-1은 최상위), 시작 오프셋 us, 길이 us]
+"""
+
+import argparse
+import json
+import sys
+
+
+def parse_line(line):
+    line = line.strip()
+    if not line:
+        return None
+    device = "device"
+    if not line.startswith("{"):
+        topic, _, line = line.partition(" ")
+        device = topic.split("/")[0]
+    try:
+        trace = json.loads(line)
+    except ValueError:
+        return None
+    if "spans" not in trace:
+        return None
+    return device, trace
+
+
+def to_events(records, absolute):
+    events = []
+    pids = {}
+    for tid, (device, trace) in enumerate(records, 1):
+        if device not in pids:
+            pids[device] = len(pids) + 1
+            events.append({"name": "process_name", "ph": "M", "pid": pids[device],
+                           "args": {"name": device}})
+        pid = pids[device]
+        events.append({"name": "thread_name", "ph": "M", "pid": pid, "tid": tid,
+                       "args": {"name": "trace " + trace["id"]}})
+        spans = trace["spans"]
+        base = trace["t0"] if absolute else -min([s[2] for s in spans] or [0])
+        for index, (name, parent, start, duration) in enumerate(spans):
+            events.append({
+                "name": name, "ph": "X", "pid": pid, "tid": tid,
+                "ts": base + start, "dur": duration,
+                "args": {"parent": spans[parent][0] if parent >= 0 else None, "index": index},
+            })
+    return {"traceEvents": events, "displayTimeUnit": "ms"}
+
+
+def percentile(values, fraction):
+    ordered = sorted(values)
+    return ordered[min(len(ordered) - 1, int(fraction * len(ordered)))]
+
+
+def print_summary(records):
+    stages = {}
+    for _, trace in records:
+        for name, _, _, duration in trace["spans"]:
+            stages.setdefault(name, []).append(duration)
+    print("%-12s %6s %10s %10s %10s" % ("stage", "count", "p50 ms", "p95 ms", "max ms"))
+    for name, values in stages.items():
+        print("%-12s %6d %10.1f %10.1f %10.1f" % (
+            name, len(values), percentile(values, 0.5) / 1000.0,
+            percentile(values, 0.95) / 1000.0, max(values) / 1000.0))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("input", help="mosquitto_sub -v 출력 파일 (- 는 표준 입력)")
+    parser.add_argument("-o", "--output", default="capture_trace.json")
+    parser.add_argument("--absolute", action="store_true", help="장치 부팅 기준 시각(t0)을 그대로 사용")
+    parser.add_argument("--summary", action="store_true", help="변환 대신 단계별 통계만 출력")
+    args = parser.parse_args()
+
+    source = sys.stdin if args.input == "-" else open(args.input, encoding="utf-8")
+    with source:
+        records = [r for r in (parse_line(line) for line in source) if r is not None]
+    if not records:
+        sys.exit("추적 레코드가 없습니다")
+
+    if args.summary:
+        print_summary(records)
+        return
+    with open(args.output, "w", encoding="utf-8") as f:
+        json.dump(to_events(records, args.absolute), f)
+    print("%d건 → %s" % (len(records), args.output))
+
+
+if __name__ == "__main__":
+    main()
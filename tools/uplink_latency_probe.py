@@ -0,0 +1,200 @@
+#!/usr/bin/env python3
+"""업로드 중 제어/텔레메트리 지연 측정기입니다. (업링크 조절 확인용)
+
+MQTT 브로커에 접속해 "{deviceUid}/statreq"를 일정 간격으로 보내고 "{deviceUid}/status" 응답까지의 왕복 시간과
+"{deviceUid}/sensor" 도착 간격을 잽니다. 이미지 업로드 중(첫 청크/요청 → cdone)에 보낸 요청은 따로 집계합니다.
+업로드 구간은 "{deviceUid}/cdone" 도착 시각에서 업로드 소요 시간(추적의 upload 구간, 없으면 JPEG 크기 / goodput)만큼 앞까지로 봅니다.
+마지막으로 받은 지표 스냅샷의 클래스별 대기 시간(q_ctl_ms, q_tel_ms, q_blk_ms)도 출력합니다.
+
+사용법:
+    python tools/uplink_latency_probe.py --duration 60                 (장치 ID는 첫 sensor 메시지에서 얻음)
+    python tools/uplink_latency_probe.py --device 7CDFA149C22E --interval 0.1
+"""
+
+import argparse
+import json
+import select
+import socket
+import struct
+import time
+import uuid
+
+
+def encode_length(length):
+    out = bytearray()
+    while True:
+        digit, length = length % 128, length // 128
+        out.append(digit | (0x80 if length else 0))
+        if not length:
+            return bytes(out)
+
+
+def encode_string(text):
+    data = text.encode()
+    return struct.pack("!H", len(data)) + data
+
+
+def packet(kind, body):
+    return bytes([kind]) + encode_length(len(body)) + body
+
+
+class Reader:
+    def __init__(self, sock):
+        self.sock = sock
+        self.buffer = bytearray()
+
+    def feed(self):
+        chunk = self.sock.recv(65536)
+        if not chunk:
+            raise ConnectionError("브로커 연결 종료")
+        self.buffer += chunk
+
+    def packets(self):
+        while True:
+            if len(self.buffer) < 2:
+                return
+            length, shift, index = 0, 0, 1
+            while True:
+                if index >= len(self.buffer):
+                    return
+                digit = self.buffer[index]
+                length |= (digit & 0x7F) << shift
+                shift += 7
+                index += 1
+                if not digit & 0x80:
+                    break
+            if len(self.buffer) < index + length:
+                return
+            kind = self.buffer[0]
+            body = bytes(self.buffer[index:index + length])
+            del self.buffer[:index + length]
+            yield kind, body
+
+
+def percentile(values, p):
+    if not values:
+        return 0.0
+    ordered = sorted(values)
+    return ordered[min(len(ordered) - 1, (len(ordered) * p + 99) // 100 - 1)]
+
+
+def summary(name, values):
+    if not values:
+        print("{}: 없음".format(name))
+        return
+    print("{}: {}건, p50/p95/max {:.0f}/{:.0f}/{:.0f} ms".format(
+        name, len(values), percentile(values, 50), percentile(values, 95), max(values)))
+
+
+def histogram_summary(name, values):
+    # [count, sum, max, b0..b8]
+    count, total, peak = values[0], values[1], values[2]
+    print("  {}: {}건, 평균 {:.1f} ms, 최대 {} ms".format(name, count, total / count if count else 0.0, peak))
+
+
+def upload_span_ms(args, done):
+    """cdone에서 업로드 소요 시간을 구함: 추적 구간, 없으면 JPEG 크기 / goodput (본문 전송 시간)"""
+    if args.upload_start_ms:
+        return args.upload_start_ms
+    upload_us = done.get("trace", {}).get("us", {}).get("upload")
+    if upload_us:
+        return upload_us / 1000
+    size = done.get("jpeg", {}).get("bytes", 0)
+    goodput = done.get("goodput_kbps", 0)
+    return size / goodput if goodput else 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description="업로드 중 제어/텔레메트리 지연 측정")
+    parser.add_argument("--broker", default="127.0.0.1", help="MQTT 브로커 주소")
+    parser.add_argument("--port", type=int, default=1883, help="MQTT 브로커 포트")
+    parser.add_argument("--device", help="장치 ID (없으면 첫 sensor 메시지에서 얻음)")
+    parser.add_argument("--interval", type=float, default=0.25, help="statreq 간격 (초)")
+    parser.add_argument("--duration", type=float, default=60.0, help="측정 시간 (초)")
+    parser.add_argument("--upload-start-ms", type=int, default=0,
+                        help="cdone 직전 이 시간 안에 보낸 요청을 업로드 중으로 집계 (0이면 cdone에서 계산)")
+    args = parser.parse_args()
+
+    sock = socket.create_connection((args.broker, args.port))
+    sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+    reader = Reader(sock)
+    sock.sendall(packet(0x10, encode_string("MQTT") + bytes([4, 0x02]) + struct.pack("!H", 60) +
+                        encode_string("uplink-probe-" + uuid.uuid4().hex[:8])))
+    topics = [b"+/sensor", b"+/status", b"+/cdone"]
+    body = struct.pack("!H", 1) + b"".join(struct.pack("!H", len(t)) + t + bytes([0]) for t in topics)
+    sock.sendall(packet(0x82, body))
+
+    device = args.device
+    pending = []        # 응답을 기다리는 statreq 전송 시각
+    round_trips = []    # (보낸 시각, 왕복 ms)
+    sensor_arrivals = []
+    uploads = []        # (시작, 끝)
+    last_status = None
+    next_request = time.monotonic()
+    deadline = time.monotonic() + args.duration
+    last_ping = time.monotonic()
+
+    while time.monotonic() < deadline:
+        now = time.monotonic()
+        if device and now >= next_request:
+            sock.sendall(packet(0x30, encode_string(device + "/statreq") + b"{}"))
+            pending.append(now)
+            next_request = now + args.interval
+        if now - last_ping >= 30:
+            sock.sendall(bytes([0xC0, 0]))
+            last_ping = now
+        ready, _, _ = select.select([sock], [], [], 0.01)
+        if not ready:
+            continue
+        reader.feed()
+        arrived = time.monotonic()
+        for kind, body in reader.packets():
+            if kind >> 4 != 3:
+                continue
+            topic_length = struct.unpack("!H", body[:2])[0]
+            topic = body[2:2 + topic_length].decode()
+            offset = 2 + topic_length + (2 if (kind >> 1) & 0x03 else 0)
+            payload = body[offset:]
+            uid, _, suffix = topic.rpartition("/")
+            if device is None and suffix == "sensor":
+                device = uid
+                print("장치 {} 측정 시작".format(device))
+            if uid != device:
+                continue
+            if suffix == "sensor":
+                sensor_arrivals.append(arrived)
+            elif suffix == "status":
+                if pending:
+                    sent = pending.pop(0)
+                    round_trips.append((sent, (arrived - sent) * 1000))
+                try:
+                    last_status = json.loads(payload)
+                except ValueError:
+                    pass
+            elif suffix == "cdone":
+                try:
+                    done = json.loads(payload)
+                except ValueError:
+                    done = {}
+                span_ms = upload_span_ms(args, done)
+                uploads.append((arrived - span_ms / 1000, arrived))
+
+    def during_upload(at):
+        return any(start <= at <= end for start, end in uploads)
+
+    print("업로드 {}회".format(len(uploads)))
+    summary("statreq → status (업로드 중)", [ms for sent, ms in round_trips if during_upload(sent)])
+    summary("statreq → status (그 외)", [ms for sent, ms in round_trips if not during_upload(sent)])
+    gaps = [(b - a) * 1000 for a, b in zip(sensor_arrivals, sensor_arrivals[1:])]
+    summary("sensor 도착 간격", gaps)
+    if pending:
+        print("응답 없는 statreq {}건".format(len(pending)))
+    if last_status and "h" in last_status:
+        print("마지막 지표 스냅샷의 업링크 대기:")
+        for key in ("q_ctl_ms", "q_tel_ms", "q_blk_ms"):
+            if key in last_status["h"]:
+                histogram_summary(key, last_status["h"][key])
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,131 @@
+#!/usr/bin/env python3
+"""호스트(native) 빌드로 링크 조건별 이미지 업로드 시간과 goodput을 측정합니다.
+
+각 프로파일마다 호스트 펌웨어를 HOST_BENCH_CAPTURES로 실행하고, 로그의
+"업로드 처리 완료, 소요 시간"과 "업로드 goodput" 줄을 모아 표로 출력합니다.
+업로드 서버(tools/host_upload_server.py)와 MQTT 브로커는 미리 띄워 둡니다.
+
+--transport mqtt이면 업로드 대신 MQTT 청크 전송(upload_transport=1)을 측정합니다.
+이때는 tools/mqtt_image_receiver.py를 함께 띄우고, 링크 조건은 MQTT 포트(8883) 연결에 적용합니다.
+
+링크 조건은 두 가지 방법으로 만듭니다.
+  - 기본: 호스트 WiFiClient의 링크 에뮬레이션 (HOST_LINK_*, 권한 불필요)
+  - --netem: lo 인터페이스의 업로드 포트 트래픽에 tc/netem 적용 (root, sch_netem 모듈 필요)
+
+사용법:
+    python tools/upload_link_bench.py .pio/build/native/program
+    python tools/upload_link_bench.py .pio/build/native/program --captures 10 --netem
+    python tools/upload_link_bench.py program --profile fair:300:30:5 --profile weak:60:80:30:-80
+    python tools/upload_link_bench.py .pio/build/native/program --transport mqtt
+"""
+
+import argparse
+import os
+import re
+import statistics
+import subprocess
+
+# 이름:속도(KB/s):RTT(ms):손실(permille)[:RSSI]
+DEFAULT_PROFILES = [
+    "local:0:0:0",
+    "good:600:10:0",
+    "fair:200:40:10",
+    "weak:60:80:30:-80",
+]
+
+UPLOAD_RE = re.compile(r"업로드 처리 완료, 소요 시간: (\d+) ms")
+GOODPUT_RE = re.compile(r"업로드 goodput (\d+) KB/s")
+MQTT_RE = re.compile(r"MQTT 이미지 전송 완료: (\d+) ms, (\d+) KB/s")
+
+
+def parse_profile(text):
+    fields = text.split(":")
+    if len(fields) not in (4, 5):
+        raise argparse.ArgumentTypeError("이름:KB/s:RTT:손실[:RSSI] 형식이어야 합니다: " + text)
+    name, kbps, rtt, loss = fields[0], int(fields[1]), int(fields[2]), int(fields[3])
+    rssi = int(fields[4]) if len(fields) == 5 else -55
+    return {"name": name, "kbps": kbps, "rtt": rtt, "loss": loss, "rssi": rssi}
+
+
+def netem(args, profile, port):
+    subprocess.run(["tc", "qdisc", "del", "dev", "lo", "root"], stderr=subprocess.DEVNULL)
+    if profile is None or profile["kbps"] == 0:
+        return
+    # 업로드 포트로 가는 트래픽만 netem 대역으로 보냄 (MQTT와 ACK 방향은 그대로, 지연 전체를 데이터 방향에 둠)
+    commands = [
+        "tc qdisc add dev lo root handle 1: prio bands 3 priomap 1 1 1 1 1 1 1 1 1 1 1 1 1 1 1 1",
+        "tc qdisc add dev lo parent 1:3 handle 30: netem rate {}kbit delay {}ms loss {}%".format(
+            profile["kbps"] * 8, profile["rtt"], profile["loss"] / 10.0),
+        "tc filter add dev lo parent 1: protocol ip u32 match ip dport {} 0xffff flowid 1:3".format(port),
+    ]
+    for command in commands:
+        subprocess.run(command.split(), check=True)
+
+
+def run_profile(args, profile):
+    env = dict(os.environ)
+    env.update({
+        "HOST_WIFI_SSID": env.get("HOST_WIFI_SSID", "lab"),
+        "HOST_WIFI_RSSI": str(profile["rssi"]),
+        "HOST_BENCH_CAPTURES": str(args.captures),
+        "HOST_BENCH_TARGET": str(args.target),
+        "HOST_UPLOAD_TRANSPORT": "1" if args.transport == "mqtt" else "0",
+        "HOST_LINK_PORT": str(8883 if args.transport == "mqtt" else 443),
+    })
+    port = args.port if args.transport == "https" else args.mqtt_port
+    if args.netem:
+        netem(args, profile, port)
+    elif profile["kbps"] > 0:
+        env.update({
+            "HOST_LINK_KBPS": str(profile["kbps"]),
+            "HOST_LINK_RTT_MS": str(profile["rtt"]),
+            "HOST_LINK_LOSS_PERMILLE": str(profile["loss"]),
+        })
+    try:
+        result = subprocess.run([args.program], env=env, cwd=args.cwd, capture_output=True, text=True,
+                                timeout=args.timeout)
+        output = result.stdout + result.stderr
+    finally:
+        if args.netem:
+            netem(args, None, port)
+    if args.transport == "mqtt":
+        results = MQTT_RE.findall(output)
+        return [int(ms) for ms, _ in results], [int(kbps) for _, kbps in results]
+    uploads = [int(value) for value in UPLOAD_RE.findall(output)]
+    goodputs = [int(value) for value in GOODPUT_RE.findall(output)]
+    return uploads, goodputs
+
+
+def main():
+    parser = argparse.ArgumentParser(description="링크 조건별 업로드 시간/goodput 측정")
+    parser.add_argument("program", help="호스트 빌드 실행 파일 (.pio/build/native/program)")
+    parser.add_argument("--profile", action="append", type=parse_profile,
+                        help="이름:KB/s:RTT(ms):손실(permille)[:RSSI], 여러 번 지정 가능")
+    parser.add_argument("--captures", type=int, default=8, help="프로파일당 촬영 횟수")
+    parser.add_argument("--target", type=int, default=0, help="JPEG 목표 크기 (기본 0: 고정 품질)")
+    parser.add_argument("--netem", action="store_true", help="HOST_LINK_* 대신 tc/netem 사용")
+    parser.add_argument("--port", type=int, default=8080, help="--netem을 적용할 업로드 서버 포트")
+    parser.add_argument("--transport", choices=["https", "mqtt"], default="https",
+                        help="업로드 경로 (mqtt: MQTT 청크 전송, mqtt_image_receiver.py 필요)")
+    parser.add_argument("--mqtt-port", type=int, default=1883, help="--netem을 적용할 MQTT 브로커 포트")
+    parser.add_argument("--cwd", default=".", help="실행 디렉터리 (partitions.csv가 있는 곳)")
+    parser.add_argument("--timeout", type=int, default=600, help="프로파일당 제한 시간 (초)")
+    args = parser.parse_args()
+    args.program = os.path.abspath(args.program)
+
+    profiles = args.profile or [parse_profile(text) for text in DEFAULT_PROFILES]
+    print("{:<8} {:>7} {:>5} {:>5} {:>5} {:>10} {:>10} {:>10}".format(
+        "profile", "KB/s", "RTT", "loss", "n", "upload p50", "upload max", "goodput"))
+    for profile in profiles:
+        uploads, goodputs = run_profile(args, profile)
+        if not uploads:
+            print("{:<8} 업로드 결과 없음".format(profile["name"]))
+            continue
+        print("{:<8} {:>7} {:>5} {:>5} {:>5} {:>8}ms {:>8}ms {:>6}KB/s".format(
+            profile["name"], profile["kbps"] or "-", profile["rtt"], profile["loss"], len(uploads),
+            int(statistics.median(uploads)), max(uploads),
+            int(statistics.median(goodputs)) if goodputs else "-"))
+
+
+if __name__ == "__main__":
+    main()